@@ -7,6 +7,13 @@ if(NOT TARGET BaaCommonSettings)
         _UNICODE
         _CRT_SECURE_NO_WARNINGS
     )
+    # Trace points (baa/utils/trace.h) are compiled out unless this is ON;
+    # when ON they are still off until enabled at runtime (BAA_TRACE=parser,...)
+    option(BAA_ENABLE_TRACE "Compile in structured trace instrumentation" OFF)
+    if(BAA_ENABLE_TRACE)
+        target_compile_definitions(BaaCommonSettings INTERFACE BAA_ENABLE_TRACE)
+    endif()
+
     # Add other common project-wide compile options or definitions here if needed
     # For example:
     # target_compile_options(BaaCommonSettings INTERFACE
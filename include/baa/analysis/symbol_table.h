@@ -0,0 +1,169 @@
+#ifndef BAA_SYMBOL_TABLE_H
+#define BAA_SYMBOL_TABLE_H
+
+#include "baa/ast/ast_types.h" // For BaaNode, BaaSymbol, BaaScope
+#include <stdbool.h>
+#include <stddef.h>
+#include <wchar.h>
+
+/**
+ * Scoped symbol table for semantic analysis.
+ *
+ * Names are interned in the table: every distinct name has one binding record
+ * in an open-addressing hash, holding the innermost symbol currently visible
+ * under that name. Declaring a symbol makes it the record's binding and keeps
+ * the binding it hides in BaaSymbol.shadowed, so a lookup is one hash probe no
+ * matter how deeply scopes are nested; enclosing scopes are never rescanned.
+ *
+ * Every declaration is also appended to an undo log. Entering a scope only
+ * records the log length (a checkpoint); leaving it unwinds the log back to the
+ * checkpoint, restoring each shadowed binding. Both are O(1) per declaration.
+ *
+ * Scopes and symbols are not freed when a scope is left: they persist, linked
+ * to their enclosing scope, until the table is freed, so the BaaSymbol* and
+ * BaaScope* back-pointers stored in the AST stay valid for later passes.
+ *
+ * A table can be layered over a frozen table of global symbols (see
+ * baa_symbol_table_create): names missing from it are looked up in the globals
+ * table, which is only read. Several tables can share one globals table from
+ * different threads as long as nothing declares into it any more.
+ */
+
+/**
+ * Kinds of symbols.
+ */
+typedef enum BaaSymbolKind
+{
+    BAA_SYMBOL_VARIABLE,  /**< A variable (declaration: BAA_NODE_KIND_VAR_DECL_STMT). */
+    BAA_SYMBOL_PARAMETER, /**< A function parameter (declaration: BAA_NODE_KIND_PARAMETER). */
+    BAA_SYMBOL_FUNCTION,  /**< A function (declaration: BAA_NODE_KIND_FUNCTION_DEF). */
+} BaaSymbolKind;
+
+typedef struct BaaSymbolBinding BaaSymbolBinding; // Name record in the table's hash (internal)
+
+/**
+ * A declared name.
+ */
+struct BaaSymbol
+{
+    const wchar_t *name;       /**< Interned name (owned by the table): equal names share this pointer. */
+    BaaSymbolKind kind;        /**< What the symbol names. */
+    BaaNode *declaration;      /**< The declaring node (may be NULL for built-in symbols). */
+    BaaType *type;             /**< Canonical type, filled in by the type checker (NULL until then). */
+    BaaScope *scope;           /**< The scope the symbol was declared in. */
+    BaaSymbol *shadowed;       /**< The symbol of the same name this one hides, or NULL. */
+    BaaSymbol *next_in_scope;  /**< The symbol declared before this one in the same scope, or NULL. */
+    BaaSymbolBinding *binding; /**< The name's binding record (internal). */
+};
+
+/**
+ * A scope (global, function or block).
+ */
+struct BaaScope
+{
+    BaaScope *parent;    /**< Enclosing scope, or NULL for the outermost scope. */
+    BaaSymbol *symbols;  /**< Most recently declared symbol of the scope (follow next_in_scope). */
+    size_t symbol_count; /**< Number of symbols declared in the scope. */
+    size_t depth;        /**< Nesting depth: 0 for the global scope. */
+    size_t undo_mark;    /**< Undo log length when the scope was entered (internal). */
+};
+
+/**
+ * Opaque symbol table.
+ */
+typedef struct BaaSymbolTable BaaSymbolTable;
+
+// دوال جدول الرموز
+
+/**
+ * @brief Creates a symbol table whose current scope is its outermost scope.
+ *
+ * @param globals A frozen table consulted for names this table does not bind,
+ *                or NULL. It is only read and must outlive the new table; the
+ *                new outermost scope is nested in its current scope.
+ * @return The table, or NULL on allocation failure.
+ */
+BaaSymbolTable *baa_symbol_table_create(const BaaSymbolTable *globals);
+
+/**
+ * @brief Frees the table with all of its scopes, symbols and interned names.
+ *
+ * The BaaSymbol* and BaaScope* pointers stored in the AST dangle afterwards.
+ * Safe to call with NULL.
+ */
+void baa_symbol_table_free(BaaSymbolTable *table);
+
+/**
+ * @brief Returns the table's interned copy of a name (the pointer stored in BaaSymbol.name).
+ *
+ * @return The interned name, or NULL for a NULL name or on allocation failure.
+ */
+const wchar_t *baa_symbol_table_intern(BaaSymbolTable *table, const wchar_t *name);
+
+/**
+ * @brief Enters a new scope nested in the current one.
+ *
+ * @param table The table.
+ * @param block The block statement that opens the scope, or NULL. Its
+ *              BaaBlockStmtData.scope is set to the new scope.
+ * @return The new scope, or NULL on allocation failure.
+ */
+BaaScope *baa_symbol_table_push_scope(BaaSymbolTable *table, BaaNode *block);
+
+/**
+ * @brief Leaves the current scope, making its symbols invisible again.
+ *
+ * @return false if the current scope is the table's outermost scope.
+ */
+bool baa_symbol_table_pop_scope(BaaSymbolTable *table);
+
+/**
+ * @brief Returns the current (innermost) scope.
+ */
+BaaScope *baa_symbol_table_current_scope(const BaaSymbolTable *table);
+
+/**
+ * @brief Declares a name in the current scope.
+ *
+ * The new symbol hides any symbol of the same name from enclosing scopes. When
+ * `declaration` is a variable, parameter or function node, its symbol_entry is
+ * set to the new symbol.
+ *
+ * @param table The table.
+ * @param name The name (copied into the table).
+ * @param kind The kind of symbol.
+ * @param declaration The declaring node, or NULL.
+ * @return The symbol, or NULL if the name is already declared in the current
+ *         scope (see baa_symbol_table_lookup_current) or on allocation failure.
+ */
+BaaSymbol *baa_symbol_table_declare(BaaSymbolTable *table, const wchar_t *name, BaaSymbolKind kind,
+                                    BaaNode *declaration);
+
+/**
+ * @brief Returns the innermost visible symbol named `name`, or NULL.
+ *
+ * Does not modify the table, so it may be called concurrently on a table
+ * nothing declares into.
+ */
+BaaSymbol *baa_symbol_table_lookup(const BaaSymbolTable *table, const wchar_t *name);
+
+/**
+ * @brief Returns the symbol named `name` declared in the current scope itself, or NULL.
+ */
+BaaSymbol *baa_symbol_table_lookup_current(const BaaSymbolTable *table, const wchar_t *name);
+
+/**
+ * @brief Resolves an identifier expression and stores the result in its resolved_symbol.
+ *
+ * @param table The table.
+ * @param identifier A BAA_NODE_KIND_IDENTIFIER_EXPR node.
+ * @return The symbol, or NULL if the name is not declared (resolved_symbol is then NULL).
+ */
+BaaSymbol *baa_symbol_table_resolve(const BaaSymbolTable *table, BaaNode *identifier);
+
+/**
+ * @brief Returns the number of distinct names interned in the table.
+ */
+size_t baa_symbol_table_name_count(const BaaSymbolTable *table);
+
+#endif /* BAA_SYMBOL_TABLE_H */
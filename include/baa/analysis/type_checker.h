@@ -0,0 +1,114 @@
+#ifndef BAA_TYPE_CHECKER_H
+#define BAA_TYPE_CHECKER_H
+
+#include "baa/analysis/symbol_table.h"     // For BaaSymbolTable
+#include "baa/ast/ast_types.h"             // For BaaNode
+#include "baa/diagnostics/diagnostics.h"   // For BaaDiagnostic
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * Single-pass type checker.
+ *
+ * baa_type_check_program resolves names through a BaaSymbolTable and stores a
+ * canonical BaaType* in BaaNode.resolved_type of every expression, type
+ * specification and declaration, so later passes read types instead of
+ * recomputing them. Each node is visited once:
+ *
+ * 1. Top-level declarations, in source order: every function's return and
+ *    parameter types are resolved and its name declared; global variables are
+ *    checked and declared. A function can therefore call any function of the
+ *    unit and use any global variable, wherever they are declared.
+ * 2. Function bodies, each in a function scope nested in the global scope.
+ *    Deferred bodies that were never parsed are skipped. Bodies are independent
+ *    of one another, so this phase can run on a pool of worker threads
+ *    (baa_type_checker_set_parallel): each worker has its own symbol table
+ *    layered over the global one and its own diagnostic list, while the global
+ *    symbols and the canonical type table are only read.
+ *
+ * Results are memoized in the tree: type specifications keep the type resolved
+ * in the first phase, a variable's type is computed once at its declaration and
+ * read from its BaaSymbol at every use, and operator results come from the
+ * constant rule tables of baa_validate_binary_op / baa_validate_unary_op.
+ *
+ * Errors are reported as diagnostics; an expression with an error gets the
+ * error type, and operations on an error type report nothing further.
+ */
+
+/**
+ * Opaque checker. It owns the symbol tables the AST's BaaSymbol* and BaaScope*
+ * back-pointers point into, so it must outlive any pass that follows them.
+ */
+typedef struct BaaTypeChecker BaaTypeChecker;
+
+// دوال مدقق الأنواع
+
+/**
+ * @brief Creates a checker for one program.
+ *
+ * @return The checker, or NULL on allocation failure.
+ */
+BaaTypeChecker *baa_type_checker_create(void);
+
+/**
+ * @brief Frees the checker, its symbol tables and its diagnostics. Safe to call with NULL.
+ */
+void baa_type_checker_free(BaaTypeChecker *checker);
+
+/**
+ * @brief Sets the number of threads that check function bodies (1 by default).
+ *
+ * Diagnostics and annotations do not depend on the thread count.
+ *
+ * @param checker The checker.
+ * @param thread_count Number of threads (0 = hardware concurrency, 1 = sequential).
+ */
+void baa_type_checker_set_parallel(BaaTypeChecker *checker, size_t thread_count);
+
+/**
+ * @brief Checks a program and annotates it with symbols and types.
+ *
+ * A checker checks a single program; create another one for the next.
+ *
+ * @param checker The checker.
+ * @param program A BAA_NODE_KIND_PROGRAM node.
+ * @return true if the program has no errors, false if errors were reported, the
+ *         checker was already used or memory ran out.
+ */
+bool baa_type_check_program(BaaTypeChecker *checker, BaaNode *program);
+
+/**
+ * @brief Returns the number of errors reported.
+ */
+size_t baa_type_checker_error_count(const BaaTypeChecker *checker);
+
+/**
+ * @brief Returns the diagnostics in source order (by top-level declaration),
+ *        whatever the number of threads.
+ *
+ * Diagnostics have category BAA_DIAG_SEMANTIC (names) or BAA_DIAG_TYPE (types),
+ * the span of the offending node, no source line and no fix hint.
+ *
+ * @param checker The checker.
+ * @param out_count Receives the number of diagnostics.
+ * @return The diagnostics, valid until the checker is freed; NULL if there are none.
+ */
+const BaaDiagnostic *baa_type_checker_get_diagnostics(const BaaTypeChecker *checker, size_t *out_count);
+
+/**
+ * @brief Prints every diagnostic as `file:line:column: خطأ: message` to `stream`.
+ */
+void baa_type_checker_print_diagnostics(const BaaTypeChecker *checker, FILE *stream);
+
+/**
+ * @brief Returns the table of global symbols (functions and global variables).
+ */
+const BaaSymbolTable *baa_type_checker_globals(const BaaTypeChecker *checker);
+
+/**
+ * @brief Returns the number of nodes visited by baa_type_check_program.
+ */
+size_t baa_type_checker_node_count(const BaaTypeChecker *checker);
+
+#endif /* BAA_TYPE_CHECKER_H */
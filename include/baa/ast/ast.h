@@ -1,19 +1,21 @@
 #ifndef BAA_AST_H
 #define BAA_AST_H
 
-#include "baa/ast/ast_types.h" // Include the core type definitions
-#include "baa/types/types.h"   // For BaaType
-#include <stdbool.h>           // For bool
+#include "baa/ast/ast_types.h"   // Include the core type definitions
+#include "baa/ast/ast_arena.h"   // For BaaAstArena
+#include "baa/ast/ast_visitor.h" // For baa_ast_walk
+#include "baa/types/types.h"     // For BaaType
+#include <stdbool.h>             // For bool
 
 // --- Core AST Node Lifecycle Functions ---
 
 /**
  * @brief Creates a new generic BaaNode.
  *
- * Allocates memory for a BaaNode and initializes its kind and source span.
- * The 'data' field of the newly created node will be initialized to NULL.
- * Specific node creation functions (e.g., baa_ast_new_literal_expr_node)
- * will call this and then allocate and assign the specific data structure.
+ * Allocates memory for a BaaNode (from the active AST arena, if any) and
+ * initializes its kind and source span. The 'data' field of the newly created
+ * node will be initialized to NULL. Specific node creation functions allocate
+ * their data structure in the same block as the node.
  *
  * @param kind The BaaNodeKind for the new node.
  * @param span The BaaAstSourceSpan indicating the node's location in the source code.
@@ -29,8 +31,11 @@ BaaNode *baa_ast_new_node(BaaNodeKind kind, BaaAstSourceSpan span);
  * 1. Check the node's kind.
  * 2. Call a kind-specific helper function to free the contents of node->data
  *    (which includes freeing any duplicated strings and recursively freeing child BaaNodes).
- * 3. Free the node->data pointer itself (if not NULL).
- * 4. Free the BaaNode structure.
+ * 3. Free the block holding the BaaNode and its data.
+ *
+ * Nodes allocated from an AST arena (see baa/ast/ast_arena.h) are not freed
+ * individually; this function ignores them. A program node that owns an arena
+ * destroys it, releasing the whole tree at once.
  *
  * It is safe to call this function with a NULL node pointer.
  *
@@ -172,6 +177,18 @@ BaaNode *baa_ast_new_program_node(BaaAstSourceSpan span);
  */
 bool baa_ast_add_declaration_to_program(BaaNode *program_node, BaaNode *declaration_node);
 
+/**
+ * @brief Transfers ownership of an AST arena to a program node.
+ * Freeing the program then destroys the arena (and every node in it) instead of
+ * walking the declarations.
+ *
+ * @param program_node A heap-allocated BaaNode* of kind BAA_NODE_KIND_PROGRAM.
+ * @param arena The arena holding the program's declarations.
+ * @return true on success, false if the program node is invalid, lives in an arena
+ *         itself, or already owns an arena.
+ */
+bool baa_ast_program_adopt_arena(BaaNode *program_node, BaaAstArena *arena);
+
 // == Parameter Nodes ==
 
 /**
@@ -205,6 +222,36 @@ BaaNode *baa_ast_new_function_def_node(BaaAstSourceSpan span, const wchar_t *nam
                                        BaaAstNodeModifiers modifiers, BaaNode *return_type_node,
                                        BaaNode *body, bool is_variadic);
 
+/**
+ * @brief Creates a function definition node whose body has not been parsed yet.
+ *
+ * `body` stays NULL and `body_deferred` is set; the body's source range is
+ * recorded so it can be parsed on demand (see baa_parser_function_body) and
+ * attached with baa_ast_function_set_body.
+ *
+ * @param span The source span of the function definition.
+ * @param name The function name. This function will duplicate it.
+ * @param modifiers Function modifiers (e.g., static, inline).
+ * @param return_type_node A BaaNode* of kind BAA_NODE_KIND_TYPE representing the return type. Must not be NULL.
+ * @param body_start_offset Source offset of the body's opening brace.
+ * @param body_end_offset Source offset just past the body's closing brace.
+ * @param is_variadic Whether the function accepts variable arguments.
+ * @return A pointer to the new BaaNode, or NULL on failure.
+ */
+BaaNode *baa_ast_new_deferred_function_def_node(BaaAstSourceSpan span, const wchar_t *name,
+                                                BaaAstNodeModifiers modifiers, BaaNode *return_type_node,
+                                                size_t body_start_offset, size_t body_end_offset,
+                                                bool is_variadic);
+
+/**
+ * @brief Attaches the parsed body of a function created with baa_ast_new_deferred_function_def_node.
+ *
+ * @param function_def_node A BaaNode* of kind BAA_NODE_KIND_FUNCTION_DEF with a deferred body.
+ * @param body A BaaNode* of kind BAA_NODE_KIND_BLOCK_STMT allocated like the function (same arena, or both on the heap).
+ * @return true on success, false if the body is invalid or the function already has one.
+ */
+bool baa_ast_function_set_body(BaaNode *function_def_node, BaaNode *body);
+
 /**
  * @brief Adds a parameter to a function definition node.
  * Handles dynamic array resizing as needed.
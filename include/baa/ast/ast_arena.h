@@ -0,0 +1,112 @@
+#ifndef BAA_AST_ARENA_H
+#define BAA_AST_ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <wchar.h>
+
+/**
+ * Per-translation-unit AST arena.
+ *
+ * While an arena is active on the current thread (baa_ast_arena_activate),
+ * every baa_ast_new_* constructor allocates the node and its data in one block
+ * from the arena, takes names and string values from the arena's intern pool,
+ * and grows child arrays inside the arena. Such nodes are released all at once
+ * by baa_ast_arena_destroy; baa_ast_free_node ignores them.
+ *
+ * Nodes in an arena must only reference nodes from the same arena or from
+ * arenas it adopted. The program node returned by baa_parse_program owns the
+ * arena its declarations live in (and, after a parallel parse, the arenas of
+ * the worker threads), so freeing the program releases the whole tree without
+ * walking it.
+ */
+typedef struct BaaAstArena BaaAstArena;
+
+/**
+ * Allocation statistics of an arena.
+ */
+typedef struct
+{
+    size_t bytes_reserved;   // Bytes obtained from the system (all chunks)
+    size_t bytes_used;       // Bytes handed out, including alignment padding
+    size_t chunk_count;      // Number of chunks
+    size_t node_count;       // Nodes allocated in the arena
+    size_t interned_strings; // Distinct strings in the intern pool
+} BaaAstArenaStats;
+
+// دوال ساحة الشجرة
+
+/**
+ * @brief Creates an empty arena.
+ *
+ * @return The arena, or NULL on allocation failure.
+ */
+BaaAstArena *baa_ast_arena_create(void);
+
+/**
+ * @brief Releases the arena and every node, string and array allocated from it.
+ *
+ * Does not walk the nodes; its cost depends only on the number of chunks.
+ * The arena must not be active on any thread. Safe to call with NULL.
+ */
+void baa_ast_arena_destroy(BaaAstArena *arena);
+
+/**
+ * @brief Makes `arena` own `child`: destroying `arena` also destroys `child`.
+ *
+ * Lets subtrees built in separate arenas (e.g. on worker threads) be joined
+ * under one owner; their nodes keep pointing at `child`.
+ *
+ * @return false if either arena is NULL or `child` already owns or is owned by an arena.
+ */
+bool baa_ast_arena_adopt(BaaAstArena *arena, BaaAstArena *child);
+
+/**
+ * @brief Makes `arena` the target of AST constructors on the calling thread.
+ *
+ * @param arena The arena to activate, or NULL to go back to heap-allocated nodes.
+ * @return The previously active arena (restore it when done).
+ */
+BaaAstArena *baa_ast_arena_activate(BaaAstArena *arena);
+
+/**
+ * @brief Returns the arena active on the calling thread, or NULL.
+ */
+BaaAstArena *baa_ast_arena_current(void);
+
+/**
+ * @brief Allocates `size` bytes (pointer-aligned, uninitialized) from the arena.
+ *
+ * @return The memory, or NULL on allocation failure.
+ */
+void *baa_ast_arena_alloc(BaaAstArena *arena, size_t size);
+
+/**
+ * @brief Resizes an arena allocation, extending it in place when it is the most recent one.
+ *
+ * @param arena The arena `ptr` was allocated from.
+ * @param ptr The allocation to resize (may be NULL).
+ * @param old_size Current size of the allocation.
+ * @param new_size Requested size.
+ * @return The (possibly moved) allocation with the old contents, or NULL on failure.
+ */
+void *baa_ast_arena_realloc(BaaAstArena *arena, void *ptr, size_t old_size, size_t new_size);
+
+/**
+ * @brief Returns the canonical arena copy of a string.
+ *
+ * Equal strings yield the same pointer for the lifetime of the arena.
+ *
+ * @param arena The arena.
+ * @param str The string to intern (NULL yields NULL).
+ * @param length Number of characters of str to use.
+ * @return The interned, null-terminated string, or NULL on allocation failure.
+ */
+const wchar_t *baa_ast_arena_intern(BaaAstArena *arena, const wchar_t *str, size_t length);
+
+/**
+ * @brief Fills `stats` with the arena's allocation statistics.
+ */
+void baa_ast_arena_get_stats(const BaaAstArena *arena, BaaAstArenaStats *stats);
+
+#endif /* BAA_AST_ARENA_H */
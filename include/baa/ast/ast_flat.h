@@ -0,0 +1,160 @@
+#ifndef BAA_AST_FLAT_H
+#define BAA_AST_FLAT_H
+
+#include "baa/ast/ast_types.h" // For BaaNode, BaaNodeKind, BaaAstSourceSpan
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <wchar.h>
+
+/**
+ * Flat, index-based encoding of an AST.
+ *
+ * Nodes live in one contiguous array in post-order (children before their
+ * parent, the root last) and refer to each other by 32-bit indices. Every node
+ * has the same 12-byte payload: a kind, an 8-bit tag, a file index and two
+ * 32-bit operands. Children and fields that do not fit go to `extra_data`;
+ * names and string values go to one string buffer. Source spans are kept in a
+ * parallel array of 16-byte records, so walks that do not need locations never
+ * touch them.
+ *
+ * Operand layout by kind ("extra[...]" is a run in extra_data starting at the
+ * operand, strings are offsets into `strings`):
+ *
+ *  PROGRAM          lhs = extra[decl...]           rhs = declaration count
+ *  PARAMETER        lhs = name                     rhs = type
+ *  FUNCTION_DEF     lhs = extra[name, modifiers, return type, param count, param...]
+ *                   rhs = body                     tag = is_variadic | deferred << 1
+ *                   (a deferred body appends extra[body start, body end] offsets)
+ *  EXPR_STMT        lhs = expression
+ *  BLOCK_STMT       lhs = extra[stmt...]           rhs = statement count
+ *  VAR_DECL_STMT    lhs = extra[name, modifiers, type]   rhs = initializer
+ *  IF_STMT          lhs = condition                rhs = extra[then, else]
+ *  WHILE_STMT       lhs = condition                rhs = body
+ *  FOR_STMT         lhs = extra[init, condition, increment]   rhs = body
+ *  RETURN_STMT      lhs = value
+ *  LITERAL_EXPR     tag = BaaLiteralKind           rhs = index into `types`
+ *                   lhs = value (bool, char), string (string),
+ *                         extra[low, high] (int, float bits)
+ *  IDENTIFIER_EXPR  lhs = name
+ *  BINARY_EXPR      lhs = left, rhs = right        tag = BaaBinaryOperatorKind
+ *  UNARY_EXPR       lhs = operand                  tag = BaaUnaryOperatorKind
+ *  CALL_EXPR        lhs = callee                   rhs = extra[arg count, arg...]
+ *  TYPE             tag = BaaTypeAstKind; primitive: lhs = name;
+ *                   array: lhs = element type, rhs = size expression
+ *
+ * Absent children and strings are BAA_FLAT_NONE.
+ */
+
+typedef uint32_t BaaFlatIndex;
+
+#define BAA_FLAT_NONE ((BaaFlatIndex)UINT32_MAX) // No node, string or type
+
+/**
+ * Fixed-size payload of a flat node (12 bytes).
+ */
+typedef struct
+{
+    uint8_t kind;     // BaaNodeKind
+    uint8_t tag;      // Operator, literal kind, type kind or variadic flag (see the layout above)
+    uint16_t file;    // Index into the file table
+    BaaFlatIndex lhs; // First operand
+    BaaFlatIndex rhs; // Second operand
+} BaaFlatNode;
+
+/**
+ * Source span of a flat node without filenames (16 bytes).
+ * The end location shares the start location's file.
+ */
+typedef struct
+{
+    uint32_t start_line;
+    uint32_t start_column;
+    uint32_t end_line;
+    uint32_t end_column;
+} BaaFlatSpan;
+
+/**
+ * A flat AST. All arrays are owned by the structure.
+ */
+typedef struct
+{
+    BaaFlatNode *nodes;    // Nodes in post-order
+    BaaFlatSpan *spans;    // Span of each node (parallel to nodes)
+    size_t node_count;     // Number of nodes
+    size_t node_capacity;  // Capacity of nodes and spans
+
+    uint32_t *extra_data;  // Variable-length operands
+    size_t extra_count;    // Words used
+    size_t extra_capacity; // Words allocated
+
+    wchar_t *strings;        // Null-terminated strings, each stored once
+    size_t strings_length;   // Characters used
+    size_t strings_capacity; // Characters allocated
+
+    uint32_t *files;   // String offsets of the filenames (BAA_FLAT_NONE for none)
+    size_t file_count; // Number of filenames
+
+    BaaType **types;   // Distinct literal types referenced by literal nodes
+    size_t type_count; // Number of types
+
+    BaaFlatIndex root; // Index of the root node (the last node)
+} BaaFlatAst;
+
+// دوال الشجرة المسطحة
+
+/**
+ * @brief Encodes a tree of BaaNodes as a flat AST.
+ *
+ * The tree is walked with baa_ast_walk, so depth is not limited by the
+ * call stack. Node order, strings and spans are deterministic: equal trees
+ * produce equal encodings.
+ *
+ * @param root The root of the tree (any node kind).
+ * @return The flat AST, or NULL if root is NULL, on allocation failure, or if
+ *         the tree has more nodes or files than the encoding can index.
+ */
+BaaFlatAst *baa_flat_ast_from_tree(const BaaNode *root);
+
+/**
+ * @brief Rebuilds a tree of BaaNodes from a flat AST.
+ *
+ * Nodes are created through the regular constructors in a single pass, so
+ * they come from the AST arena active on the calling thread, if any.
+ *
+ * @param ast The flat AST.
+ * @return The root of the new tree (free it with baa_ast_free_node), or NULL on failure.
+ */
+BaaNode *baa_flat_ast_to_tree(const BaaFlatAst *ast);
+
+/**
+ * @brief Frees a flat AST. Safe to call with NULL.
+ */
+void baa_flat_ast_free(BaaFlatAst *ast);
+
+/**
+ * @brief Returns the string stored at `offset`, or NULL for BAA_FLAT_NONE.
+ */
+const wchar_t *baa_flat_ast_string(const BaaFlatAst *ast, uint32_t offset);
+
+/**
+ * @brief Returns the full source span of a node, with filenames pointing into the flat AST.
+ */
+BaaAstSourceSpan baa_flat_ast_span(const BaaFlatAst *ast, BaaFlatIndex index);
+
+/**
+ * @brief Returns the value of an integer literal node (0 for other nodes).
+ */
+long long baa_flat_ast_int_value(const BaaFlatAst *ast, BaaFlatIndex index);
+
+/**
+ * @brief Compares two flat ASTs, including spans and strings.
+ */
+bool baa_flat_ast_equal(const BaaFlatAst *a, const BaaFlatAst *b);
+
+/**
+ * @brief Returns the number of bytes used by the flat AST's arrays (excluding spare capacity).
+ */
+size_t baa_flat_ast_memory_size(const BaaFlatAst *ast);
+
+#endif /* BAA_AST_FLAT_H */
@@ -0,0 +1,152 @@
+#ifndef BAA_AST_SERIALIZE_H
+#define BAA_AST_SERIALIZE_H
+
+#include "baa/ast/ast_flat.h" // For BaaFlatAst
+#include "baa/ast/ast_types.h" // For BaaNode
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <wchar.h>
+
+/**
+ * Binary AST images for caching parsed translation units.
+ *
+ * An image is a flat AST (ast_flat.h) written out section by section behind a
+ * fixed header: magic, format version, byte order, sizeof(wchar_t), the cache
+ * key it was built for, a checksum of the payload and the offset of each
+ * section. Sections start on 8-byte boundaries and hold the flat arrays
+ * exactly as they are laid out in memory, so a loaded image is used in place:
+ * the nodes, spans, extra data and strings of the returned flat AST point
+ * into the mapped file. Only the literal types are resolved on load (they are
+ * stored by kind and mapped back to the global primitive types).
+ *
+ * Images are a cache format, not an interchange format: an image written on a
+ * machine with another byte order or wchar_t size, or by another format
+ * version, is rejected and the unit is parsed again.
+ */
+
+#define BAA_AST_IMAGE_VERSION 1u // Bump on any change to the image or flat layout
+
+/**
+ * Cache key of a translation unit: a 64-bit hash of the preprocessed source
+ * (and of the filename its spans refer to) together with the source length.
+ */
+typedef struct
+{
+    uint64_t hash;
+    uint64_t length;
+} BaaAstCacheKey;
+
+/**
+ * A loaded AST image. Owns the file mapping (or the copy) its flat AST points into.
+ */
+typedef struct BaaAstImage BaaAstImage;
+
+// دوال صورة الشجرة الثنائية
+
+/**
+ * @brief Computes the cache key of a preprocessed source.
+ *
+ * The filename is part of the key because it is stored in every span of the
+ * cached tree. Characters are hashed as 32-bit code points, so the key does
+ * not depend on sizeof(wchar_t).
+ *
+ * @param source The preprocessed source.
+ * @param length Number of characters in `source`.
+ * @param filename The filename given to the lexer, or NULL.
+ */
+BaaAstCacheKey baa_ast_cache_key(const wchar_t *source, size_t length, const wchar_t *filename);
+
+/**
+ * @brief Serializes a flat AST into a newly allocated image.
+ *
+ * @param ast The flat AST.
+ * @param key The cache key stored in the image header.
+ * @param out_size Receives the image size in bytes.
+ * @return The image (free it with baa_free), or NULL on allocation failure or
+ *         if a literal type is not a primitive type.
+ */
+void *baa_ast_serialize(const BaaFlatAst *ast, BaaAstCacheKey key, size_t *out_size);
+
+/**
+ * @brief Writes the image of a flat AST to `path`.
+ *
+ * The image goes to a temporary file in the same directory that is then
+ * renamed over `path`, so concurrent readers never see a partial image.
+ *
+ * @return true if the file was written.
+ */
+bool baa_ast_image_write_file(const BaaFlatAst *ast, BaaAstCacheKey key, const char *path);
+
+/**
+ * @brief Validates an image in memory and returns a view of it.
+ *
+ * The header, section bounds and payload checksum are checked; nothing is
+ * copied, so `data` must stay valid and unchanged until the image is freed.
+ *
+ * @param data The image, aligned to 8 bytes.
+ * @param size Size of the image in bytes.
+ * @param expected_key If not NULL, images built for another key are rejected.
+ * @return The image, or NULL if the data is not a valid image for this build.
+ */
+BaaAstImage *baa_ast_image_from_memory(const void *data, size_t size, const BaaAstCacheKey *expected_key);
+
+/**
+ * @brief Maps an image file and validates it (see baa_ast_image_from_memory).
+ *
+ * Falls back to reading the file into memory where mapping is not available.
+ *
+ * @return The image, or NULL if the file is missing or not a valid image.
+ */
+BaaAstImage *baa_ast_image_load_file(const char *path, const BaaAstCacheKey *expected_key);
+
+/**
+ * @brief Returns the flat AST of an image. It stays valid until the image is freed.
+ */
+const BaaFlatAst *baa_ast_image_flat(const BaaAstImage *image);
+
+/**
+ * @brief Returns the cache key stored in an image.
+ */
+BaaAstCacheKey baa_ast_image_key(const BaaAstImage *image);
+
+/**
+ * @brief Frees an image and unmaps its file. Safe to call with NULL.
+ */
+void baa_ast_image_free(BaaAstImage *image);
+
+/**
+ * @brief Looks up a translation unit in an on-disk AST cache.
+ *
+ * The image for `key` is loaded from `directory` and rebuilt with
+ * baa_flat_ast_to_tree, so the nodes come from the AST arena active on the
+ * calling thread, if any. The spans of the tree point at filenames inside the
+ * image (as spans of a parsed tree point at the lexer's filename), so the
+ * image must be freed after the tree.
+ *
+ * @param directory The cache directory.
+ * @param key The key of the unit's preprocessed source.
+ * @param out_image Receives the loaded image on a hit.
+ * @return The rebuilt tree, or NULL on a cache miss (including stale or invalid images).
+ */
+BaaNode *baa_ast_cache_load(const char *directory, BaaAstCacheKey key, BaaAstImage **out_image);
+
+/**
+ * @brief Stores the tree of a translation unit in an on-disk AST cache.
+ *
+ * @param directory An existing directory.
+ * @param key The key of the unit's preprocessed source.
+ * @param root The root of the tree, usually the program returned by baa_parse_program.
+ * @return true if the image was written.
+ */
+bool baa_ast_cache_store(const char *directory, BaaAstCacheKey key, const BaaNode *root);
+
+/**
+ * @brief Formats the path of the image for `key` in `directory`.
+ *
+ * @return The number of characters the full path needs (excluding the
+ *         terminator), as for snprintf; the path is truncated if it does not fit.
+ */
+size_t baa_ast_cache_path(const char *directory, BaaAstCacheKey key, char *buffer, size_t buffer_size);
+
+#endif /* BAA_AST_SERIALIZE_H */
@@ -9,6 +9,9 @@
 // This avoids a direct include dependency cycle if ast_types.h were included by types.h,
 // but means we can only use BaaType* here.
 typedef struct BaaType BaaType;
+typedef struct BaaAstArena BaaAstArena; // See baa/ast/ast_arena.h
+typedef struct BaaSymbol BaaSymbol;     // See baa/analysis/symbol_table.h
+typedef struct BaaScope BaaScope;       // See baa/analysis/symbol_table.h
 
 // --- Core Source Location Structures ---
 
@@ -139,8 +142,8 @@ typedef struct BaaLiteralExprData
  */
 typedef struct BaaIdentifierExprData
 {
-    wchar_t *name; /**< Duplicated identifier name. Owner must free. */
-    // Future: BaaSymbol* resolved_symbol; /**< Link to symbol table entry after resolution. */
+    wchar_t *name;              /**< Duplicated identifier name. Owner must free. */
+    BaaSymbol *resolved_symbol; /**< Symbol the name resolves to (set by name resolution, NULL before). */
 } BaaIdentifierExprData;
 
 // == Binary Expression Data ==
@@ -222,11 +225,15 @@ struct BaaNode
 {
     BaaNodeKind kind;      /**< The specific kind of this AST node, determining the structure of 'data'. */
     BaaAstSourceSpan span; /**< The source code span (start and end location) this node represents. */
+    BaaAstArena *arena;    /**< Arena the node was allocated from (released with it), or NULL for a heap node. */
     void *data;            /**< Pointer to a kind-specific data structure containing details for this node.
                                 This must be cast to the appropriate type based on 'kind'. Can be NULL for
-                                simple nodes that don't require extra data (e.g., a break statement). */
+                                simple nodes that don't require extra data (e.g., a break statement).
+                                Lives in the same allocation as the node. */
+    BaaType *resolved_type; /**< Canonical type computed by the type checker (NULL before it ran, and for
+                                 statements). Expressions: their value's type; type specifications: the
+                                 type they denote; declarations: the declared type. */
     // Future considerations:
-    // BaaType* resolved_type;    /**< Populated by semantic analyzer: pointer to canonical BaaType. */
     // BaaNode* parent_node;      /**< Optional: pointer to the parent node in the AST. */
     // size_t unique_id;          /**< Optional: for debugging or analysis passes. */
 };
@@ -244,6 +251,7 @@ typedef struct BaaProgramData
     BaaNode **top_level_declarations; /**< Dynamic array of BaaNode* (function defs, global var decls). */
     size_t count;                     /**< Number of declarations currently stored. */
     size_t capacity;                  /**< Current capacity of the declarations array. */
+    BaaAstArena *owned_arena;         /**< Arena holding the declarations, destroyed with the program (may be NULL). */
 } BaaProgramData;
 
 /**
@@ -252,9 +260,9 @@ typedef struct BaaProgramData
  */
 typedef struct BaaParameterData
 {
-    wchar_t *name;         /**< Parameter name (duplicated string). */
-    BaaNode *type_node;    /**< Type specification (BaaNode* of kind BAA_NODE_KIND_TYPE). */
-    // Future: BaaType* resolved_type; /**< Resolved type after semantic analysis. */
+    wchar_t *name;           /**< Parameter name (duplicated string). */
+    BaaNode *type_node;      /**< Type specification (BaaNode* of kind BAA_NODE_KIND_TYPE). */
+    BaaSymbol *symbol_entry; /**< Symbol declared for the parameter (set by name resolution, NULL before). */
 } BaaParameterData;
 
 /**
@@ -269,9 +277,12 @@ typedef struct BaaFunctionDefData
     BaaNode **parameters;               /**< Dynamic array of BaaNode* (each of kind BAA_NODE_KIND_PARAMETER). */
     size_t parameter_count;             /**< Number of parameters currently stored. */
     size_t parameter_capacity;          /**< Current capacity of the parameters array. */
-    BaaNode *body;                      /**< Function body (BaaNode* of kind BAA_NODE_KIND_BLOCK_STMT). */
+    BaaNode *body;                      /**< Function body (BaaNode* of kind BAA_NODE_KIND_BLOCK_STMT), NULL while deferred. */
     bool is_variadic;                   /**< For C-style varargs (...). */
-    // Future: BaaSymbol* symbol_entry; /**< Link to symbol table after resolution. */
+    bool body_deferred;                 /**< Body not parsed yet (lazy parsing, see baa_parser_function_body). */
+    size_t body_start_offset;           /**< Source offset of the body's '{' (deferred bodies only). */
+    size_t body_end_offset;             /**< Source offset just past the body's '}' (deferred bodies only). */
+    BaaSymbol *symbol_entry;            /**< Symbol declared for the function (set by name resolution, NULL before). */
 } BaaFunctionDefData;
 
 // == Statement Data ==
@@ -293,7 +304,6 @@ typedef struct BaaBinaryExprData
     BaaNode *left_operand;               /**< Left operand expression. */
     BaaNode *right_operand;              /**< Right operand expression. */
     BaaBinaryOperatorKind operator_kind; /**< The binary operator. */
-    // Future: BaaType* result_type; /**< Type of the result after semantic analysis. */
 } BaaBinaryExprData;
 
 /**
@@ -303,7 +313,6 @@ typedef struct BaaUnaryExprData
 {
     BaaNode *operand;                   /**< The operand expression. */
     BaaUnaryOperatorKind operator_kind; /**< The unary operator. */
-    // Future: BaaType* result_type; /**< Type of the result after semantic analysis. */
 } BaaUnaryExprData;
 
 /**
@@ -316,7 +325,6 @@ typedef struct BaaCallExprData
     BaaNode **arguments;                /**< Dynamic array of BaaNode* (expression kinds) for arguments. */
     size_t argument_count;              /**< Number of arguments currently stored. */
     size_t argument_capacity;           /**< Current capacity of the arguments array. */
-    // Future: BaaType* result_type; /**< Type of the result after semantic analysis. */
 } BaaCallExprData;
 
 /**
@@ -328,7 +336,7 @@ typedef struct BaaBlockStmtData
     BaaNode **statements; /**< Dynamic array of BaaNode* (statement kinds). */
     size_t count;         /**< Number of statements currently stored. */
     size_t capacity;      /**< Current capacity of the statements array. */
-    // Future: BaaScope* scope; /**< Link to its scope in symbol table. */
+    BaaScope *scope;      /**< Scope the block opens (set by name resolution, NULL before). */
 } BaaBlockStmtData;
 
 /**
@@ -341,8 +349,7 @@ typedef struct BaaVarDeclData
     BaaAstNodeModifiers modifiers; /**< Modifiers like const (ثابت), static (مستقر), etc. */
     BaaNode *type_node;            /**< BaaNode* of kind BAA_NODE_KIND_TYPE (the declared type syntax). */
     BaaNode *initializer_expr;     /**< Optional initializer expression (BaaNode* with an expression kind). Can be NULL. */
-    // Future: BaaSymbol* symbol_entry; /**< Link to symbol table after resolution. */
-    // BaaType* resolved_canonical_type; /**< Pointer to canonical BaaType after semantic analysis. */
+    BaaSymbol *symbol_entry;       /**< Symbol declared for the variable (set by name resolution, NULL before). */
 } BaaVarDeclData;
 
 /**
@@ -422,7 +429,6 @@ typedef struct BaaTypeAstData
         } array;
         // Future: struct for pointer, struct/union/enum names
     } specifier;
-    // Future: BaaType* resolved_canonical_type; /**< Populated by semantic analyzer. */
 } BaaTypeAstData;
 
 #endif // BAA_AST_TYPES_H
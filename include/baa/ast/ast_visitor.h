@@ -0,0 +1,82 @@
+#ifndef BAA_AST_VISITOR_H
+#define BAA_AST_VISITOR_H
+
+#include "baa/ast/ast_types.h" // For BaaNode
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Generic AST traversal.
+ *
+ * baa_ast_walk visits a tree depth-first, calling `pre` when a node is entered
+ * and `post` after all of its children were visited. Children are visited in
+ * source order (the order of baa_ast_child). The walk keeps its own stack on the
+ * heap, so arbitrarily deep trees do not consume C stack.
+ *
+ * A `post` callback may free the node it is given: the walker does not touch a
+ * node again after its post callback returns.
+ */
+
+/**
+ * What the walk should do after a callback.
+ */
+typedef enum BaaAstVisitResult
+{
+    BAA_AST_VISIT_CONTINUE = 0,  /**< Keep walking. */
+    BAA_AST_VISIT_SKIP_CHILDREN, /**< From `pre`: do not visit this node's children (its `post` still runs). */
+    BAA_AST_VISIT_ABORT,         /**< Stop the walk immediately; no further callbacks run. */
+} BaaAstVisitResult;
+
+/**
+ * @brief Visitor callback.
+ *
+ * @param node The node being visited (never NULL).
+ * @param parent Its parent in this walk, or NULL for the root.
+ * @param depth Distance from the root (0 for the root).
+ * @param user_data The visitor's user_data.
+ */
+typedef BaaAstVisitResult (*BaaAstVisitFn)(BaaNode *node, BaaNode *parent, size_t depth, void *user_data);
+
+/**
+ * Callbacks of a walk. Either callback may be NULL.
+ */
+typedef struct BaaAstVisitor
+{
+    BaaAstVisitFn pre;  /**< Called before the node's children. */
+    BaaAstVisitFn post; /**< Called after the node's children. SKIP_CHILDREN is treated as CONTINUE. */
+    void *user_data;    /**< Passed to both callbacks. */
+} BaaAstVisitor;
+
+// دوال التجوال في الشجرة
+
+/**
+ * @brief Walks the tree rooted at `root` depth-first.
+ *
+ * @param root The root node (NULL walks nothing).
+ * @param visitor The callbacks.
+ * @return true if the whole tree was walked, false if a callback aborted or
+ *         the walk stack could not be grown.
+ */
+bool baa_ast_walk(BaaNode *root, const BaaAstVisitor *visitor);
+
+/**
+ * @brief Returns the number of child slots of a node.
+ *
+ * Optional children (an else branch, an initializer, ...) always have a slot,
+ * so the count depends only on the node's kind and list lengths.
+ */
+size_t baa_ast_child_count(const BaaNode *node);
+
+/**
+ * @brief Returns the child in slot `index` (source order), or NULL for an absent optional child.
+ *
+ * Slot order by kind: program: declarations; function: return type,
+ * parameters, body; parameter: type; variable: type, initializer; block:
+ * statements; if: condition, then, else; while: condition, body; for:
+ * initializer, condition, increment, body; return/expression statement: the
+ * expression; binary: left, right; unary: operand; call: callee, arguments;
+ * array type: element type, size.
+ */
+BaaNode *baa_ast_child(const BaaNode *node, size_t index);
+
+#endif /* BAA_AST_VISITOR_H */
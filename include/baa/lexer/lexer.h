@@ -44,7 +44,33 @@ typedef enum
     BAA_NUM_MEMORY_ERROR    // Memory allocation error
 } BaaNumberError;
 
+// Suffix and status flags of a parsed numeric literal
+typedef enum
+{
+    BAA_LITERAL_FLAG_UNSIGNED = 1 << 0,     // 'غ' suffix
+    BAA_LITERAL_FLAG_LONG = 1 << 1,         // 'ط' suffix
+    BAA_LITERAL_FLAG_LONG_LONG = 1 << 2,    // 'طط' suffix
+    BAA_LITERAL_FLAG_FLOAT_SUFFIX = 1 << 3, // 'ح' suffix
+    BAA_LITERAL_FLAG_FLOAT = 1 << 4,        // float_value is valid (otherwise int_value)
+    BAA_LITERAL_FLAG_OVERFLOW = 1 << 5      // Integer value does not fit in 64 bits
+} BaaLiteralFlags;
+
+/**
+ * Value of a numeric literal, computed once by the lexer.
+ * Stored inline in the token so no re-parse or allocation is needed later.
+ */
+typedef struct
+{
+    union
+    {
+        uint64_t int_value;   // Integer literals (two's complement bits for the parser)
+        double float_value;   // Float literals
+    };
+    uint8_t flags;            // BaaLiteralFlags
+} BaaLiteralValue;
+
 // Number parsing functions
+BaaNumberError baa_parse_number_value(const wchar_t *text, size_t length, BaaLiteralValue *out_value);
 BaaNumber *baa_parse_number(const wchar_t *text, size_t length, BaaNumberError *error);
 void baa_free_number(BaaNumber *number);
 const wchar_t *baa_number_error_message(BaaNumberError error);
@@ -146,7 +172,8 @@ typedef enum
 } BaaTokenType;
 
 /**
- * Enhanced source span for better error reporting
+ * Enhanced source span for better error reporting.
+ * Not stored in tokens; materialized on demand by baa_lexer_get_token_span().
  */
 typedef struct
 {
@@ -158,6 +185,17 @@ typedef struct
     size_t end_offset;    // Character offset from start of source
 } BaaLexerSourceSpan;
 
+/**
+ * Newline offset index for a source buffer.
+ * Built lazily, once per buffer, the first time a line/column is requested.
+ * line_starts[i] is the offset of the first character of line i + 1.
+ */
+typedef struct
+{
+    size_t *line_starts;  // Sorted offsets of line starts (line_starts[0] == 0)
+    size_t line_count;    // Number of entries in line_starts (0 until built)
+} BaaLineIndex;
+
 /**
  * Error recovery configuration for the lexer
  */
@@ -183,6 +221,20 @@ typedef struct
     const char *category;     // Error category ("string", "number", "character", etc.)
 } BaaErrorContext;
 
+/**
+ * Error information kept by error tokens. Only the code and the offset the
+ * diagnostic is centered on are recorded while lexing; the source context and
+ * suggestion text of BaaErrorContext are built on demand by
+ * baa_token_error_context when a diagnostic is actually printed.
+ */
+typedef struct
+{
+    uint32_t error_code;        // Unique error identifier (0 for non-error tokens)
+    const char *category;       // Error category (static string, may be NULL)
+    const wchar_t *suggestion;  // Fix suggestion given by the scanner (static string, may be NULL)
+    size_t position;            // Source offset the error context is centered on
+} BaaLexerError;
+
 /**
  * Token structure representing a lexical token
  */
@@ -191,10 +243,10 @@ typedef struct
     BaaTokenType type;        // Type of the token
     wchar_t *lexeme;          // The actual text of the token (parser will take ownership)
     size_t length;            // Length of the lexeme
-    size_t line;              // Line number in source (for backward compatibility)
-    size_t column;            // Column number in source (for backward compatibility)
-    BaaLexerSourceSpan span;  // Enhanced source location information
-    BaaErrorContext *error;   // Enhanced error context (only for error tokens, may be NULL)
+    size_t start_offset;      // Character offset of the first source character of the token
+    size_t end_offset;        // Character offset one past the last source character of the token
+    BaaLexerError error;      // Deferred error information (only set for error tokens)
+    BaaLiteralValue literal;  // Parsed value (only for BAA_TOKEN_INT_LIT/BAA_TOKEN_FLOAT_LIT)
 } BaaToken;
 
 /**
@@ -206,9 +258,7 @@ typedef struct
     size_t source_length;      // Length of the source string
     size_t start;              // Start of current token
     size_t current;            // Current position in source
-    size_t line;               // Current line number
-    size_t column;             // Current column number
-    size_t start_token_column; // Column where the current token started
+    BaaLineIndex line_index;   // Newline offsets for on-demand line/column lookup
 
     // Enhanced error recovery fields
     size_t error_count;                   // Total number of errors encountered
@@ -225,8 +275,43 @@ void baa_free_token(BaaToken *token);
 const wchar_t *baa_token_type_to_string(BaaTokenType type);
 
 // Additional lexer functions (Main API)
+// Every lexer set up with baa_init_lexer (or baa_lexer_init_range) must be released with
+// baa_cleanup_lexer: the line index is allocated by the first position lookup, which
+// error reporting performs while lexing.
 void baa_init_lexer(BaaLexer *lexer, const wchar_t *source, const wchar_t *filename);
+void baa_cleanup_lexer(BaaLexer *lexer); // Releases buffers owned by a lexer set up with baa_init_lexer
 BaaToken *baa_lexer_next_token(BaaLexer *lexer);
+// Restartable initialization: scans source[begin, end) with `end` treated as end of input.
+// Used to resume lexing at a known token boundary (parallel and incremental lexing, parallel parsing).
+void baa_lexer_init_range(BaaLexer *lexer, const wchar_t *source, size_t begin, size_t end);
+
+// Source location utilities (computed on demand from token offsets)
+
+/**
+ * @brief Converts a character offset into a 1-based line and column.
+ * Builds the lexer's newline index on first use, then binary-searches it.
+ *
+ * @param lexer The lexer that owns the source buffer.
+ * @param offset Character offset into the source (clamped to the source length).
+ * @param out_line Receives the 1-based line number (may be NULL).
+ * @param out_column Receives the 1-based column number (may be NULL).
+ * @return true on success, false if the index could not be built.
+ */
+bool baa_lexer_get_position(BaaLexer *lexer, size_t offset, size_t *out_line, size_t *out_column);
+
+/**
+ * @brief Materializes the full line/column span of a token.
+ *
+ * @param lexer The lexer that produced the token.
+ * @param token The token whose span is requested.
+ * @return The span; line/column fields are 0 if they cannot be computed.
+ */
+BaaLexerSourceSpan baa_lexer_get_token_span(BaaLexer *lexer, const BaaToken *token);
+
+// Standalone newline index helpers (used by the lexer, exposed for tools)
+bool baa_line_index_build(BaaLineIndex *index, const wchar_t *source, size_t source_length);
+void baa_line_index_free(BaaLineIndex *index);
+void baa_line_index_lookup(const BaaLineIndex *index, size_t offset, size_t *out_line, size_t *out_column);
 
 // Token utilities
 bool baa_token_is_keyword(BaaTokenType type);
@@ -240,6 +325,22 @@ BaaErrorContext *baa_create_error_context(uint32_t error_code, const char *categ
                                           const wchar_t *context_before,
                                           const wchar_t *context_after);
 void baa_free_error_context(BaaErrorContext *context);
+
+/**
+ * @brief Builds the full error context of an error token on demand.
+ *
+ * @param type Type of the error token.
+ * @param error The token's deferred error information.
+ * @param source The source buffer the token was lexed from.
+ * @return Newly allocated context (free with baa_free_error_context), or NULL
+ *         for non-error tokens or on allocation failure.
+ */
+BaaErrorContext *baa_build_error_context(BaaTokenType type, const BaaLexerError *error, const wchar_t *source);
+
+/**
+ * @brief Convenience wrapper of baa_build_error_context for a BaaToken.
+ */
+BaaErrorContext *baa_token_error_context(const BaaToken *token, const wchar_t *source);
 const wchar_t *baa_get_error_category_description(const char *category);
 const wchar_t *baa_get_error_type_description(BaaTokenType error_type);
 
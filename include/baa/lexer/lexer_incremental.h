@@ -0,0 +1,66 @@
+#ifndef BAA_LEXER_INCREMENTAL_H
+#define BAA_LEXER_INCREMENTAL_H
+
+#include "baa/lexer/token_buffer.h"
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * A single text edit: `removed_length` characters at `offset` in the old
+ * source were replaced by `inserted_length` characters of `inserted`.
+ */
+typedef struct
+{
+    size_t offset;           // Offset of the edit in the old source
+    size_t removed_length;   // Number of characters removed
+    const wchar_t *inserted; // Inserted text (may be NULL if inserted_length is 0)
+    size_t inserted_length;  // Number of characters inserted
+} BaaSourceEdit;
+
+/**
+ * Token range replaced by an incremental re-lex.
+ * Old tokens [first, first + old_count) became new tokens [first, first + new_count);
+ * tokens after the range are unchanged apart from shifted offsets.
+ */
+typedef struct
+{
+    size_t first;     // Index of the first changed token
+    size_t old_count; // Number of tokens removed from the old buffer
+    size_t new_count; // Number of tokens inserted into the buffer
+} BaaTokenRange;
+
+/**
+ * @brief Applies an edit to a source buffer.
+ *
+ * @param source Old source buffer.
+ * @param source_length Length of the old source.
+ * @param edit The edit to apply.
+ * @return Newly allocated, null-terminated source (caller frees), or NULL on
+ *         allocation failure or an out-of-range edit.
+ */
+wchar_t *baa_source_apply_edit(const wchar_t *source, size_t source_length, const BaaSourceEdit *edit);
+
+/**
+ * @brief Updates a token buffer after an edit, re-lexing only the affected region.
+ *
+ * Lexing restarts at the last token boundary whose tokens could not have seen
+ * the edited text and stops as soon as the lexer reaches a position where an
+ * old token started after the edit, at which point the rest of the stream is
+ * known to be unchanged. The result is identical to baa_lex_all(new_source).
+ *
+ * Error tokens are reused like other tokens unless the buffer reaches an error
+ * recovery limit, in which case the whole source is re-lexed. Lexing work is
+ * proportional to the edit, but splicing the token arrays and shifting the
+ * offsets of the tokens after it is O(n) in the buffer size.
+ *
+ * @param buffer Token buffer for the old source; updated in place to refer to new_source.
+ * @param new_source The source with the edit applied (e.g. from baa_source_apply_edit).
+ * @param edit The edit that turned the old source into new_source.
+ * @param out_changed Receives the changed token range (may be NULL).
+ * @return true on success, false on allocation failure or invalid arguments.
+ *         On failure the buffer is left unchanged.
+ */
+bool baa_relex_incremental(BaaTokenBuffer *buffer, const wchar_t *new_source,
+                           const BaaSourceEdit *edit, BaaTokenRange *out_changed);
+
+#endif /* BAA_LEXER_INCREMENTAL_H */
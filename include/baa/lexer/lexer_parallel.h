@@ -0,0 +1,39 @@
+#ifndef BAA_LEXER_PARALLEL_H
+#define BAA_LEXER_PARALLEL_H
+
+#include "baa/lexer/lexer.h"
+#include "baa/lexer/token_buffer.h"
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief Finds safe points at which the source can be split for parallel lexing.
+ *
+ * A quick pre-scan tracks string, raw-string, character and comment states and
+ * returns offsets of newline characters that are outside all of them. Each chunk
+ * starts at one of these newlines, so no token crosses a chunk boundary.
+ *
+ * @param source Source buffer.
+ * @param source_length Length of the source buffer.
+ * @param max_chunks Desired number of chunks (the result may have fewer).
+ * @param out_splits Receives up to max_chunks - 1 split offsets in ascending order.
+ * @return Number of split offsets written.
+ */
+size_t baa_lexer_find_split_points(const wchar_t *source, size_t source_length,
+                                   size_t max_chunks, size_t *out_splits);
+
+/**
+ * @brief Lexes a whole buffer, splitting it into chunks lexed on worker threads.
+ *
+ * The resulting token stream is identical to calling baa_lexer_next_token until
+ * EOF. If any chunk reports a lexical error, the buffer is re-lexed sequentially
+ * so error recovery and error limits behave exactly as in the sequential lexer.
+ *
+ * @param source Source buffer (null-terminated, fewer than 2^32 characters).
+ * @param thread_count Number of threads to use (0 = hardware concurrency, 1 = sequential).
+ * @param out_tokens Receives the tokens (free with baa_token_buffer_free).
+ * @return true on success, false on allocation failure or oversized input.
+ */
+bool baa_lex_parallel(const wchar_t *source, size_t thread_count, BaaTokenBuffer *out_tokens);
+
+#endif /* BAA_LEXER_PARALLEL_H */
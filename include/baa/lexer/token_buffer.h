@@ -0,0 +1,131 @@
+#ifndef BAA_TOKEN_BUFFER_H
+#define BAA_TOKEN_BUFFER_H
+
+#include "baa/lexer/lexer.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Side table entry for tokens whose data does not fit the compact arrays.
+ * Only numeric literals, tokens whose lexeme differs from their source slice
+ * (string and character literals, comments, error messages) and error
+ * tokens get an entry.
+ */
+typedef struct
+{
+    uint32_t token;          // Index of the token this entry belongs to
+    uint32_t text_length;    // Length of text (or of the inner source slice, see text_offset)
+    uint32_t text_offset;    // If non-zero and text is NULL, the lexeme is the source slice starting
+                             // text_offset characters into the token (escape-free string bodies)
+    wchar_t *text;           // Processed lexeme (owned, null-terminated), NULL if it is a source slice
+    BaaLexerError error;     // Deferred error information, only set for error tokens
+    BaaLiteralValue literal; // Parsed value of numeric literals
+} BaaTokenExtra;
+
+/**
+ * Struct-of-arrays token stream for a whole source buffer.
+ *
+ * Token i spans source[offsets[i], offsets[i] + lengths[i]). Its lexeme is that
+ * source slice unless the side table holds processed text for it. The last
+ * token is always BAA_TOKEN_EOF. The buffer borrows `source`, which must
+ * outlive it.
+ */
+typedef struct
+{
+    const wchar_t *source; // Borrowed source buffer the offsets refer to
+    uint8_t *kinds;        // BaaTokenType of each token
+    uint32_t *offsets;     // Start offset of each token
+    uint32_t *lengths;     // Number of source characters covered by each token
+    size_t count;          // Number of tokens
+    size_t capacity;       // Allocated capacity of the token arrays
+    size_t error_count;    // Number of error tokens
+
+    BaaTokenExtra *extras; // Side table, sorted by token index
+    size_t extra_count;    // Number of side table entries
+    size_t extra_capacity; // Allocated capacity of the side table
+} BaaTokenBuffer;
+
+// دوال مخزن الرموز
+
+/**
+ * @brief Initializes an empty token buffer over a source buffer.
+ */
+void baa_token_buffer_init(BaaTokenBuffer *buffer, const wchar_t *source);
+
+/**
+ * @brief Frees the token arrays, the side table and everything it owns.
+ */
+void baa_token_buffer_free(BaaTokenBuffer *buffer);
+
+/**
+ * @brief Appends a token produced by baa_lexer_next_token.
+ *
+ * The token's processed lexeme moves into the side table when it is not a
+ * slice of the source; the caller still frees the token itself with baa_free_token.
+ *
+ * @return false on allocation failure or if the token offsets do not fit in 32 bits.
+ */
+bool baa_token_buffer_push(BaaTokenBuffer *buffer, BaaToken *token);
+
+/**
+ * @brief Appends all tokens of `other` to `buffer`, taking ownership of its side table.
+ *
+ * Both buffers must refer to the same source. `other` is left empty.
+ */
+bool baa_token_buffer_append(BaaTokenBuffer *buffer, BaaTokenBuffer *other);
+
+/**
+ * @brief Replaces tokens [first, first + old_count) with all tokens of `replacement`.
+ *
+ * Side table entries of the removed tokens are freed, those of `replacement`
+ * move into `buffer`, and entries after the range are re-indexed. Offsets are
+ * copied as-is. `replacement` is left empty.
+ *
+ * @return false on allocation failure or an out-of-range request (buffer unchanged).
+ */
+bool baa_token_buffer_replace(BaaTokenBuffer *buffer, size_t first, size_t old_count,
+                              BaaTokenBuffer *replacement);
+
+/**
+ * @brief Returns the side table entry of token `index`, or NULL if it has none.
+ */
+const BaaTokenExtra *baa_token_buffer_extra(const BaaTokenBuffer *buffer, size_t index);
+
+/**
+ * @brief Returns the lexeme of token `index`.
+ *
+ * The result points either into the source buffer or into the side table and is
+ * NOT null-terminated when it is a source slice; use out_length.
+ */
+const wchar_t *baa_token_buffer_lexeme(const BaaTokenBuffer *buffer, size_t index, size_t *out_length);
+
+/**
+ * @brief Returns the deferred error information of error token `index`, or NULL.
+ */
+const BaaLexerError *baa_token_buffer_error(const BaaTokenBuffer *buffer, size_t index);
+
+/**
+ * @brief Builds the full error context of error token `index` on demand.
+ *
+ * @return Newly allocated context (free with baa_free_error_context), or NULL.
+ */
+BaaErrorContext *baa_token_buffer_error_context(const BaaTokenBuffer *buffer, size_t index);
+
+/**
+ * @brief Returns the parsed value of numeric literal token `index`, or NULL if it is not one.
+ */
+const BaaLiteralValue *baa_token_buffer_literal(const BaaTokenBuffer *buffer, size_t index);
+
+/**
+ * @brief Lexes a whole source buffer into a token buffer.
+ *
+ * The token stream is identical to calling baa_lexer_next_token until EOF.
+ *
+ * @param source Source buffer (null-terminated, fewer than 2^32 characters).
+ * @param out_buffer Receives the tokens (free with baa_token_buffer_free).
+ * @return true on success, false on allocation failure or oversized input.
+ */
+bool baa_lex_all(const wchar_t *source, BaaTokenBuffer *out_buffer);
+
+#endif /* BAA_TOKEN_BUFFER_H */
@@ -16,11 +16,11 @@ BaaToken *scan_identifier(BaaLexer *lexer);
 BaaToken *scan_number(BaaLexer *lexer);
 BaaToken *scan_string(BaaLexer *lexer);
 BaaToken *scan_char_literal(BaaLexer *lexer);
-BaaToken *scan_multiline_string_literal(BaaLexer *lexer, size_t start_line, size_t start_col);
-BaaToken *scan_raw_string_literal(BaaLexer *lexer, bool is_multiline, size_t start_line, size_t start_col);
-BaaToken *scan_doc_comment(BaaLexer *lexer, size_t start_line, size_t start_col);
+BaaToken *scan_multiline_string_literal(BaaLexer *lexer);
+BaaToken *scan_raw_string_literal(BaaLexer *lexer, bool is_multiline);
+BaaToken *scan_doc_comment(BaaLexer *lexer);
 BaaToken *scan_whitespace_sequence(BaaLexer *lexer);
-BaaToken *scan_single_line_comment(BaaLexer *lexer, size_t comment_delimiter_start_line, size_t comment_delimiter_start_col);
-BaaToken *scan_multi_line_comment(BaaLexer *lexer, size_t comment_delimiter_start_line, size_t comment_delimiter_start_col);
+BaaToken *scan_single_line_comment(BaaLexer *lexer);
+BaaToken *scan_multi_line_comment(BaaLexer *lexer);
 
 #endif // BAA_TOKEN_SCANNERS_H
@@ -0,0 +1,118 @@
+#ifndef BAA_TOKEN_STREAM_H
+#define BAA_TOKEN_STREAM_H
+
+#include "baa/lexer/lexer.h"
+#include "baa/lexer/token_buffer.h"
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * On-demand token stream over a BaaLexer with O(1) lookahead and backtracking.
+ *
+ * Tokens are numbered from 0 in lexing order and kept in a power-of-two ring
+ * (token i lives in ring[i & (capacity - 1)]). Each token is lexed exactly once:
+ * peeking ahead fills the ring, and rewinding to a mark only moves `position`
+ * back, so speculative parsing never re-lexes or re-allocates tokens.
+ *
+ * The stream owns the lexemes of the tokens in the ring. A token stays valid
+ * while its index is at least the discard point (see baa_token_stream_discard)
+ * or the outermost outstanding mark; older slots are recycled for new tokens.
+ * The ring grows only when the retained window is full.
+ *
+ * A stream can also replay an already lexed BaaTokenBuffer instead of lexing
+ * (see baa_token_stream_init_buffer); consumers cannot tell the difference.
+ */
+typedef struct
+{
+    BaaLexer *lexer;              // Lexer producing the tokens (borrowed, NULL when replaying a buffer)
+    const BaaTokenBuffer *buffer; // Token buffer replayed instead of lexing (borrowed, may be NULL)
+    size_t buffer_next;           // Index of the next buffer token to replay
+    BaaToken *ring;               // Token slots
+    size_t capacity;              // Number of slots (power of two)
+    size_t position;              // Index of the next token baa_token_stream_next returns
+    size_t lexed;                 // Number of tokens lexed so far
+    size_t discarded;             // Tokens before this index are no longer referenced by the consumer
+    size_t mark_depth;            // Number of outstanding marks
+    size_t mark_floor;            // Oldest token retained by the outermost outstanding mark
+    size_t eof_index;             // Index of the EOF token once it has been lexed
+    bool at_eof;                  // True once the lexer returned BAA_TOKEN_EOF
+    bool failed;                  // True if the lexer failed to return a token (allocation failure)
+} BaaTokenStream;
+
+/**
+ * A checkpoint in a token stream. Marks nest: every mark must be ended with
+ * exactly one baa_token_stream_rewind or baa_token_stream_release, innermost first.
+ */
+typedef struct
+{
+    size_t position;  // Stream position when the mark was taken
+    size_t discarded; // Discard point when the mark was taken
+} BaaTokenMark;
+
+// دوال تدفق الرموز
+
+/**
+ * @brief Initializes a token stream reading from `lexer`.
+ *
+ * @return false on allocation failure.
+ */
+bool baa_token_stream_init(BaaTokenStream *stream, BaaLexer *lexer);
+
+/**
+ * @brief Initializes a token stream replaying `buffer` from token `first` on.
+ *
+ * The tokens are the ones the lexer produced when the buffer was filled, so no
+ * lexing happens. The buffer and its source must outlive the stream; several
+ * streams may share one buffer, e.g. from different threads.
+ *
+ * @return false on allocation failure or if `first` is out of range.
+ */
+bool baa_token_stream_init_buffer(BaaTokenStream *stream, const BaaTokenBuffer *buffer, size_t first);
+
+/**
+ * @brief Frees the ring and every lexeme it still owns. Does not free the lexer.
+ */
+void baa_token_stream_free(BaaTokenStream *stream);
+
+/**
+ * @brief Returns the token `n` positions ahead without consuming anything.
+ *
+ * peek(0) is the token the next baa_token_stream_next call returns. Peeking
+ * past the end returns the EOF token.
+ *
+ * @return Pointer into the ring, valid until the next call that lexes or
+ *         discards tokens; NULL if the lexer failed.
+ */
+const BaaToken *baa_token_stream_peek(BaaTokenStream *stream, size_t n);
+
+/**
+ * @brief Consumes and returns the next token (the EOF token repeats at the end).
+ *
+ * @return Pointer into the ring (see baa_token_stream_peek); NULL if the lexer failed.
+ */
+const BaaToken *baa_token_stream_next(BaaTokenStream *stream);
+
+/**
+ * @brief Declares that the consumer no longer references tokens before `index`.
+ *
+ * Their slots may be recycled once no outstanding mark covers them. Consumers
+ * should call this as they go; otherwise the ring keeps every token.
+ */
+void baa_token_stream_discard(BaaTokenStream *stream, size_t index);
+
+/**
+ * @brief Checkpoints the current position in O(1).
+ */
+BaaTokenMark baa_token_stream_mark(BaaTokenStream *stream);
+
+/**
+ * @brief Returns to `mark` in O(1) and ends it. Tokens after the mark are replayed from the ring.
+ */
+void baa_token_stream_rewind(BaaTokenStream *stream, BaaTokenMark mark);
+
+/**
+ * @brief Ends `mark` without moving, committing the tokens consumed since it was taken.
+ */
+void baa_token_stream_release(BaaTokenStream *stream, BaaTokenMark mark);
+
+#endif /* BAA_TOKEN_STREAM_H */
@@ -3,6 +3,7 @@
 
 #include "baa/types/types.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <wchar.h>
 
 // Forward declarations
@@ -88,12 +89,25 @@ typedef struct {
     bool right_associative;
 } BaaOperatorInfo;
 
-// Operator functions
+// Operand type rule of an operator for given operand kinds (see operators.c)
+typedef struct {
+    bool valid;            // Whether the operator accepts these operand kinds
+    bool result_is_left;   // The result is the (left) operand's own type, e.g. for assignment
+    uint8_t result;        // BaaTypeKind of the result otherwise
+    uint8_t left_convert;  // BaaTypeKind the (left) operand is implicitly converted to
+    uint8_t right_convert; // BaaTypeKind the right operand is implicitly converted to (binary rules)
+} BaaOperatorTypeRule;
+
+// Operator functions (O(1) table lookups)
 const BaaOperatorInfo* baa_get_operator_info(BaaOperatorType op);
 BaaOperatorType baa_get_operator_from_symbol(const wchar_t* symbol);
 BaaOperatorType baa_get_operator_from_name(const wchar_t* arabic_name);
 
 // Type checking for operators
+// The rules come from tables indexed by operator and operand kinds; out-of-range
+// arguments yield an invalid rule (never NULL).
+const BaaOperatorTypeRule* baa_get_binary_op_rule(BaaOperatorType op, BaaTypeKind left_kind, BaaTypeKind right_kind);
+const BaaOperatorTypeRule* baa_get_unary_op_rule(BaaOperatorType op, BaaTypeKind operand_kind);
 bool baa_validate_unary_op(BaaOperatorType op, BaaType* operand_type, BaaType** result_type);
 bool baa_validate_binary_op(BaaOperatorType op, BaaType* left_type, BaaType* right_type, BaaType** result_type);
 
@@ -3,7 +3,10 @@
 
 #include "baa/lexer/lexer.h" // For BaaLexer
 #include "baa/ast/ast.h"     // For BaaNode (program AST root)
+#include "baa/diagnostics/diagnostics.h" // For BaaDiagnostic
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h> // For FILE
 
 // Opaque structure for the parser. Definition is internal.
 typedef struct BaaParser BaaParser;
@@ -38,10 +41,68 @@ void baa_parser_free(BaaParser *parser);
  * @param parser A pointer to an initialized BaaParser.
  * @return A pointer to the root BaaNode of the AST (typically a BAA_NODE_KIND_PROGRAM node),
  *         or NULL if parsing fails and an AST cannot be constructed.
- *         The caller is responsible for freeing the returned AST using baa_ast_free_node().
+ *         The caller is responsible for freeing the returned AST using baa_ast_free_node()
+ *         (see baa_parser_set_ast_arena).
  */
 BaaNode *baa_parse_program(BaaParser *parser);
 
+/**
+ * @brief Chooses how baa_parse_program allocates the AST (enabled by default).
+ *
+ * When enabled, the declarations are allocated from a per-translation-unit
+ * arena owned by the returned program node: nodes cannot be freed
+ * individually, and freeing the program releases the whole tree at once.
+ * When disabled, every node is heap-allocated and freed recursively.
+ *
+ * @param parser A pointer to the BaaParser.
+ * @param enabled Whether to use an arena.
+ */
+void baa_parser_set_ast_arena(BaaParser *parser, bool enabled);
+
+/**
+ * @brief Lets baa_parse_program parse top-level declarations on worker threads (off by default).
+ *
+ * A pre-pass over the token buffer finds top-level boundaries by bracket
+ * matching, and each slice of declarations is parsed on its own thread into
+ * its own AST arena. The declarations are merged in source order, so the AST
+ * is identical to a sequential parse. Inputs with lexical or syntax errors,
+ * small inputs and traced runs are parsed sequentially, so diagnostics are
+ * unchanged as well.
+ *
+ * @param parser A pointer to the BaaParser.
+ * @param thread_count Number of threads (0 = hardware concurrency, 1 = sequential).
+ */
+void baa_parser_set_parallel(BaaParser *parser, size_t thread_count);
+
+/**
+ * @brief Defers parsing of function bodies (disabled by default).
+ *
+ * When enabled, parse_function_definition skips each body by brace matching
+ * and records its source range: the function node's `body` is NULL and
+ * `body_deferred` is set until baa_parser_function_body parses it. Declaration
+ * passes then cost little more than lexing and allocate no body nodes. Errors
+ * inside a body are only reported when it is parsed.
+ *
+ * @param parser A pointer to the BaaParser.
+ * @param enabled Whether to defer function bodies.
+ */
+void baa_parser_set_lazy_bodies(BaaParser *parser, bool enabled);
+
+/**
+ * @brief Returns the body of a function definition, parsing a deferred body on first use.
+ *
+ * The body is allocated like the function (in its arena, or on the heap) and
+ * attached to it, so later calls return the same node. The parser and its
+ * lexer's source must still be alive. Not thread-safe for functions sharing
+ * an arena or for a parser whose line index has not been built yet.
+ *
+ * @param parser The parser (or any parser over the same source) that produced the function.
+ * @param function_node A BaaNode* of kind BAA_NODE_KIND_FUNCTION_DEF.
+ * @return The body, or NULL on allocation failure or if it could not be parsed (errors are recorded
+ *         as diagnostics of `parser` and its error flag is set).
+ */
+BaaNode *baa_parser_function_body(BaaParser *parser, BaaNode *function_node);
+
 /**
  * @brief Checks if the parser encountered any errors during its operation.
  *
@@ -50,7 +111,40 @@ BaaNode *baa_parse_program(BaaParser *parser);
  */
 bool baa_parser_had_error(const BaaParser *parser);
 
-// Future: Function to retrieve a list of diagnostics/errors
-// const BaaDiagnosticList* baa_parser_get_diagnostics(const BaaParser* parser);
+// دوال التشخيصات
+
+/**
+ * @brief Returns the number of diagnostics the parser has recorded.
+ *
+ * The parser never writes to stderr: lexical and syntax errors are recorded
+ * in report order. Literal messages are kept by pointer and messages with
+ * arguments (e.g. lexical errors, L"خطأ معجمي: %ls") are formatted when
+ * recorded; line/column are resolved when they are retrieved or printed.
+ * A parser only records the first error of each panic-mode episode.
+ */
+size_t baa_parser_diagnostic_count(const BaaParser *parser);
+
+/**
+ * @brief Returns the diagnostics recorded so far, in report order.
+ *
+ * Records are expanded into BaaDiagnostic structures on demand: the line and
+ * column are looked up through the parser's lexer, which must still be alive.
+ * Diagnostics produced by the parser have category BAA_DIAG_SYNTAX, no source
+ * line and no fix hint; column_end is the column just past the offending token.
+ *
+ * @param parser A pointer to the BaaParser.
+ * @param out_count Receives the number of diagnostics (0 for a NULL parser).
+ * @return The diagnostics, valid until the parser records another diagnostic
+ *         or is freed; NULL if there are none or on allocation failure.
+ */
+const BaaDiagnostic *baa_parser_get_diagnostics(BaaParser *parser, size_t *out_count);
+
+/**
+ * @brief Prints every diagnostic as `file:line:column: خطأ: message` to `stream`.
+ *
+ * @param parser A pointer to the BaaParser.
+ * @param stream The output stream, usually stderr.
+ */
+void baa_parser_print_diagnostics(BaaParser *parser, FILE *stream);
 
 #endif // BAA_PARSER_H
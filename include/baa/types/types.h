@@ -21,16 +21,23 @@ typedef enum
     BAA_TYPE_NULL,   // فارغ
     BAA_TYPE_ERROR,  // خطأ
     BAA_TYPE_ARRAY,  // مصفوفة
+
+    BAA_TYPE_KIND_COUNT // Number of type kinds (for tables indexed by kind)
 } BaaTypeKind;
 
 // Type structure
+//
+// Primitive types and every type built by a constructor (e.g. baa_create_array_type)
+// are canonical: the type system hash-conses them, so structurally equal types are
+// the same pointer and are never freed. Only baa_create_type makes standalone types.
 struct BaaType
 {
     BaaTypeKind kind;    // Type kind
     const wchar_t *name; // Type name in Arabic
     uint32_t size;       // Size in bytes
     bool is_signed;      // Whether type is signed
-    BaaType *next;       // For linked list of types
+    bool is_canonical;   // Owned by the canonical type table (compare by pointer)
+    BaaType *next;       // Next type in the same canonical table bucket
 
     // Array type information (only valid if kind == BAA_TYPE_ARRAY)
     struct BaaType *element_type; // Type of array elements
@@ -52,7 +59,10 @@ void baa_init_type_system(void);
 BaaType *baa_create_type(BaaTypeKind kind, const wchar_t *name, uint32_t size, bool is_signed);
 void baa_free_type(BaaType *type);
 
-// Type comparison and conversion
+// Number of constructed types in the canonical table (primitives excluded)
+size_t baa_type_table_size(void);
+
+// Type comparison and conversion (canonical types compare by pointer)
 bool baa_types_equal(BaaType *a, BaaType *b);
 bool baa_can_convert(BaaType *from, BaaType *to);
 const wchar_t *baa_type_to_string(BaaType *type);
@@ -71,6 +81,7 @@ BaaType *baa_get_error_type(void);
 BaaType *baa_create_primitive_type(BaaTypeKind kind);
 
 // Array type operations
+// Returns the canonical T[size] (thread-safe); the element type should be canonical
 BaaType *baa_create_array_type(BaaType *element_type, size_t size);
 BaaType *baa_get_array_element_type(BaaType *array_type);
 size_t baa_get_array_size(BaaType *array_type);
@@ -0,0 +1,93 @@
+#ifndef BAA_THREADS_H
+#define BAA_THREADS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef _WIN32
+// HANDLE is a void* on Windows; keep <windows.h> out of public headers
+typedef void *BaaThreadHandle;
+#else
+#include <pthread.h>
+typedef pthread_t BaaThreadHandle;
+#endif
+
+// Storage class for per-thread globals
+#if defined(_MSC_VER)
+#define BAA_THREAD_LOCAL __declspec(thread)
+#else
+#define BAA_THREAD_LOCAL _Thread_local
+#endif
+
+/**
+ * Mutual exclusion lock (an SRW lock on Windows, a pthread mutex elsewhere).
+ * Statically initialized with BAA_MUTEX_INIT; it needs no cleanup.
+ */
+typedef struct
+{
+#ifdef _WIN32
+    void *native; // SRWLOCK storage (pointer-sized)
+#else
+    pthread_mutex_t native;
+#endif
+} BaaMutex;
+
+#ifdef _WIN32
+#define BAA_MUTEX_INIT {NULL}
+#else
+#define BAA_MUTEX_INIT {PTHREAD_MUTEX_INITIALIZER}
+#endif
+
+/**
+ * Entry point for a worker thread. The return value is reported by baa_thread_join.
+ */
+typedef int (*BaaThreadFunc)(void *arg);
+
+/**
+ * Minimal portable thread wrapper (Win32 threads or pthreads)
+ */
+typedef struct
+{
+    BaaThreadHandle handle; // Native thread handle
+    BaaThreadFunc func;     // Function run by the thread
+    void *arg;              // Argument passed to func
+    int result;             // Value returned by func (valid after join)
+} BaaThread;
+
+// دوال إدارة الخيوط
+
+/**
+ * @brief Starts a new thread running func(arg).
+ *
+ * @param thread Thread object to initialize. Must stay valid until baa_thread_join returns.
+ * @param func Function to run.
+ * @param arg Argument passed to func.
+ * @return true if the thread was started, false otherwise.
+ */
+bool baa_thread_create(BaaThread *thread, BaaThreadFunc func, void *arg);
+
+/**
+ * @brief Waits for a thread started with baa_thread_create to finish.
+ *
+ * @param thread The thread to join.
+ * @param out_result Receives the value returned by the thread function (may be NULL).
+ * @return true on success, false if the thread could not be joined.
+ */
+bool baa_thread_join(BaaThread *thread, int *out_result);
+
+/**
+ * @brief Returns the number of hardware threads available (at least 1).
+ */
+size_t baa_thread_hardware_concurrency(void);
+
+/**
+ * @brief Acquires a mutex, blocking until it is available. Not recursive.
+ */
+void baa_mutex_lock(BaaMutex *mutex);
+
+/**
+ * @brief Releases a mutex held by the calling thread.
+ */
+void baa_mutex_unlock(BaaMutex *mutex);
+
+#endif /* BAA_THREADS_H */
@@ -0,0 +1,100 @@
+#ifndef BAA_TRACE_H
+#define BAA_TRACE_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include <wchar.h>
+
+/**
+ * Structured trace instrumentation.
+ *
+ * Trace points are written with the BAA_TRACE macro. Unless the build defines
+ * BAA_ENABLE_TRACE (CMake option -DBAA_ENABLE_TRACE=ON) the macro expands to
+ * nothing and its arguments are not evaluated. When compiled in, each
+ * subsystem is enabled at runtime (baa_trace_enable, or the BAA_TRACE
+ * environment variable, e.g. BAA_TRACE=parser,lexer or BAA_TRACE=all), so a
+ * disabled trace point costs one mask test.
+ *
+ * Events go to a buffered sink (stderr by default, BAA_TRACE_FILE to redirect)
+ * as one compact line each:
+ *
+ *     <subsystem> <event> <value> <start>..<end> <text>
+ *
+ * e.g. "P advance 16 12..15 س". The text is UTF-8 with control characters escaped.
+ * The sink is not synchronized; trace single-threaded runs.
+ */
+
+/**
+ * Subsystems that can be traced independently (bit mask).
+ */
+typedef enum
+{
+    BAA_TRACE_LEXER = 1u << 0,        // L
+    BAA_TRACE_PREPROCESSOR = 1u << 1, // C
+    BAA_TRACE_PARSER = 1u << 2,       // P
+    BAA_TRACE_SEMANTIC = 1u << 3,     // S
+    BAA_TRACE_ALL = 0xFu
+} BaaTraceSubsystem;
+
+/**
+ * Currently enabled subsystems. Read by BAA_TRACE; change it through the functions below.
+ */
+extern unsigned baa_trace_mask;
+
+// دوال التتبع
+
+/**
+ * @brief Enables tracing for the given subsystems (replaces the current mask).
+ */
+void baa_trace_enable(unsigned subsystems);
+
+/**
+ * @brief Configures tracing from BAA_TRACE and BAA_TRACE_FILE.
+ *
+ * BAA_TRACE is a comma-separated list of lexer, preprocessor, parser, semantic
+ * or all. Does nothing when trace support is compiled out.
+ *
+ * @return The enabled subsystem mask.
+ */
+unsigned baa_trace_init_from_env(void);
+
+/**
+ * @brief Redirects trace output (flushes pending output first). NULL restores stderr.
+ * The caller keeps ownership of the file.
+ */
+void baa_trace_set_sink(FILE *sink);
+
+/**
+ * @brief Appends one event to the trace buffer. Use BAA_TRACE rather than calling this directly.
+ *
+ * @param subsystem Subsystem the event belongs to.
+ * @param event Short event name (ASCII, no spaces).
+ * @param value Event-specific number (e.g. a token type).
+ * @param start Start source offset.
+ * @param end End source offset.
+ * @param text Optional text (may be NULL).
+ * @param text_length Number of characters of text.
+ */
+void baa_trace_emit(BaaTraceSubsystem subsystem, const char *event, long value,
+                    size_t start, size_t end, const wchar_t *text, size_t text_length);
+
+/**
+ * @brief Writes buffered trace output to the sink.
+ */
+void baa_trace_flush(void);
+
+#ifdef BAA_ENABLE_TRACE
+#define BAA_TRACE_ENABLED(subsystem) ((baa_trace_mask & (unsigned)(subsystem)) != 0)
+#define BAA_TRACE(subsystem, event, value, start, end, text, text_length)                 \
+    do                                                                                    \
+    {                                                                                     \
+        if (BAA_TRACE_ENABLED(subsystem))                                                 \
+            baa_trace_emit((subsystem), (event), (long)(value), (start), (end), (text),   \
+                           (text_length));                                                \
+    } while (0)
+#else
+#define BAA_TRACE_ENABLED(subsystem) 0
+#define BAA_TRACE(subsystem, event, value, start, end, text, text_length) ((void)0)
+#endif
+
+#endif /* BAA_TRACE_H */
@@ -0,0 +1,347 @@
+// src/analysis/symbol_table.c
+#include "baa/analysis/symbol_table.h"
+#include "baa/ast/ast_arena.h"
+#include "baa/utils/utils.h" // For baa_malloc, baa_realloc, baa_free
+#include <stdint.h>
+#include <string.h>
+
+#define SYMBOL_TABLE_INITIAL_BINDINGS 64 // Binding slots (power of two)
+#define SYMBOL_TABLE_INITIAL_UNDO 64     // Undo log entries
+
+// One record per distinct name; it never moves once created
+struct BaaSymbolBinding
+{
+    const wchar_t *name; // Interned name
+    size_t length;       // Length in characters
+    uint32_t hash;       // Cached hash
+    BaaSymbol *symbol;   // Innermost visible symbol of that name, or NULL
+};
+
+struct BaaSymbolTable
+{
+    BaaAstArena *arena; // Names, binding records, scopes and symbols
+
+    BaaSymbolBinding **bindings; // Open-addressing hash of binding records (NULL for an empty slot)
+    size_t binding_capacity;     // Slots (power of two)
+    size_t binding_count;        // Distinct names
+
+    BaaSymbol **undo_log; // Symbols declared in the open scopes, in declaration order
+    size_t undo_count;    // Entries in use
+    size_t undo_capacity; // Allocated entries
+
+    BaaScope *root;                // Outermost scope
+    BaaScope *current;             // Innermost open scope
+    const BaaSymbolTable *globals; // Frozen table consulted for unbound names, or NULL
+};
+
+// FNV-1a over the characters (as in the AST arena's intern pool)
+static uint32_t name_hash(const wchar_t *name, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (uint32_t)name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Returns the slot holding `name`, or the empty slot where it belongs
+static size_t find_slot(const BaaSymbolTable *table, const wchar_t *name, size_t length, uint32_t hash)
+{
+    size_t mask = table->binding_capacity - 1;
+    size_t slot = hash & mask;
+    for (;;)
+    {
+        const BaaSymbolBinding *binding = table->bindings[slot];
+        if (!binding || binding->name == name ||
+            (binding->hash == hash && binding->length == length && wmemcmp(binding->name, name, length) == 0))
+        {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+static bool grow_bindings(BaaSymbolTable *table)
+{
+    size_t capacity = table->binding_capacity ? table->binding_capacity * 2 : SYMBOL_TABLE_INITIAL_BINDINGS;
+    BaaSymbolBinding **bindings = (BaaSymbolBinding **)baa_malloc(capacity * sizeof(BaaSymbolBinding *));
+    if (!bindings)
+    {
+        return false;
+    }
+    memset(bindings, 0, capacity * sizeof(BaaSymbolBinding *));
+
+    // Records are reinserted by pointer; symbols keep pointing at them
+    for (size_t i = 0; i < table->binding_capacity; i++)
+    {
+        BaaSymbolBinding *binding = table->bindings[i];
+        if (!binding)
+        {
+            continue;
+        }
+        size_t slot = binding->hash & (capacity - 1);
+        while (bindings[slot])
+        {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        bindings[slot] = binding;
+    }
+
+    baa_free(table->bindings);
+    table->bindings = bindings;
+    table->binding_capacity = capacity;
+    return true;
+}
+
+// Returns the binding record of `name`, creating it (and interning the name) if needed
+static BaaSymbolBinding *intern_binding(BaaSymbolTable *table, const wchar_t *name)
+{
+    // Keep the load factor below 3/4
+    if ((table->binding_count + 1) * 4 > table->binding_capacity * 3 && !grow_bindings(table))
+    {
+        return NULL;
+    }
+
+    size_t length = wcslen(name);
+    uint32_t hash = name_hash(name, length);
+    size_t slot = find_slot(table, name, length, hash);
+    if (table->bindings[slot])
+    {
+        return table->bindings[slot];
+    }
+
+    BaaSymbolBinding *binding = (BaaSymbolBinding *)baa_ast_arena_alloc(table->arena, sizeof(BaaSymbolBinding));
+    const wchar_t *interned = baa_ast_arena_intern(table->arena, name, length);
+    if (!binding || !interned)
+    {
+        return NULL;
+    }
+    binding->name = interned;
+    binding->length = length;
+    binding->hash = hash;
+    binding->symbol = NULL;
+    table->bindings[slot] = binding;
+    table->binding_count++;
+    return binding;
+}
+
+static BaaScope *new_scope(BaaSymbolTable *table, BaaScope *parent)
+{
+    BaaScope *scope = (BaaScope *)baa_ast_arena_alloc(table->arena, sizeof(BaaScope));
+    if (!scope)
+    {
+        return NULL;
+    }
+    scope->parent = parent;
+    scope->symbols = NULL;
+    scope->symbol_count = 0;
+    scope->depth = parent ? parent->depth + 1 : 0;
+    scope->undo_mark = table->undo_count;
+    return scope;
+}
+
+BaaSymbolTable *baa_symbol_table_create(const BaaSymbolTable *globals)
+{
+    BaaSymbolTable *table = (BaaSymbolTable *)baa_malloc(sizeof(BaaSymbolTable));
+    if (!table)
+    {
+        return NULL;
+    }
+    memset(table, 0, sizeof(*table));
+    table->globals = globals;
+    table->arena = baa_ast_arena_create();
+    if (!table->arena || !grow_bindings(table))
+    {
+        baa_symbol_table_free(table);
+        return NULL;
+    }
+
+    table->root = new_scope(table, globals ? globals->current : NULL);
+    if (!table->root)
+    {
+        baa_symbol_table_free(table);
+        return NULL;
+    }
+    table->current = table->root;
+    return table;
+}
+
+void baa_symbol_table_free(BaaSymbolTable *table)
+{
+    if (!table)
+    {
+        return;
+    }
+    baa_free(table->bindings);
+    baa_free(table->undo_log);
+    baa_ast_arena_destroy(table->arena);
+    baa_free(table);
+}
+
+const wchar_t *baa_symbol_table_intern(BaaSymbolTable *table, const wchar_t *name)
+{
+    if (!table || !name)
+    {
+        return NULL;
+    }
+    BaaSymbolBinding *binding = intern_binding(table, name);
+    return binding ? binding->name : NULL;
+}
+
+BaaScope *baa_symbol_table_push_scope(BaaSymbolTable *table, BaaNode *block)
+{
+    if (!table)
+    {
+        return NULL;
+    }
+    BaaScope *scope = new_scope(table, table->current);
+    if (!scope)
+    {
+        return NULL;
+    }
+    table->current = scope;
+    if (block && block->kind == BAA_NODE_KIND_BLOCK_STMT)
+    {
+        ((BaaBlockStmtData *)block->data)->scope = scope;
+    }
+    return scope;
+}
+
+bool baa_symbol_table_pop_scope(BaaSymbolTable *table)
+{
+    if (!table || table->current == table->root)
+    {
+        return false;
+    }
+
+    // Unwind the scope's declarations, newest first, so each name gets back the binding it hid
+    BaaScope *scope = table->current;
+    while (table->undo_count > scope->undo_mark)
+    {
+        BaaSymbol *symbol = table->undo_log[--table->undo_count];
+        symbol->binding->symbol = symbol->shadowed;
+    }
+    table->current = scope->parent;
+    return true;
+}
+
+BaaScope *baa_symbol_table_current_scope(const BaaSymbolTable *table)
+{
+    return table ? table->current : NULL;
+}
+
+BaaSymbol *baa_symbol_table_declare(BaaSymbolTable *table, const wchar_t *name, BaaSymbolKind kind,
+                                    BaaNode *declaration)
+{
+    if (!table || !name)
+    {
+        return NULL;
+    }
+    BaaSymbolBinding *binding = intern_binding(table, name);
+    if (!binding || (binding->symbol && binding->symbol->scope == table->current))
+    {
+        return NULL;
+    }
+
+    if (table->undo_count == table->undo_capacity)
+    {
+        size_t capacity = table->undo_capacity ? table->undo_capacity * 2 : SYMBOL_TABLE_INITIAL_UNDO;
+        BaaSymbol **undo_log = (BaaSymbol **)baa_realloc(table->undo_log, capacity * sizeof(BaaSymbol *));
+        if (!undo_log)
+        {
+            return NULL;
+        }
+        table->undo_log = undo_log;
+        table->undo_capacity = capacity;
+    }
+
+    BaaSymbol *symbol = (BaaSymbol *)baa_ast_arena_alloc(table->arena, sizeof(BaaSymbol));
+    if (!symbol)
+    {
+        return NULL;
+    }
+    BaaScope *scope = table->current;
+    symbol->name = binding->name;
+    symbol->kind = kind;
+    symbol->declaration = declaration;
+    symbol->type = NULL;
+    symbol->scope = scope;
+    symbol->shadowed = binding->symbol ? binding->symbol
+                                       : (table->globals ? baa_symbol_table_lookup(table->globals, name) : NULL);
+    symbol->next_in_scope = scope->symbols;
+    symbol->binding = binding;
+
+    binding->symbol = symbol;
+    scope->symbols = symbol;
+    scope->symbol_count++;
+    table->undo_log[table->undo_count++] = symbol;
+
+    if (declaration)
+    {
+        switch (declaration->kind)
+        {
+        case BAA_NODE_KIND_VAR_DECL_STMT:
+            ((BaaVarDeclData *)declaration->data)->symbol_entry = symbol;
+            break;
+        case BAA_NODE_KIND_PARAMETER:
+            ((BaaParameterData *)declaration->data)->symbol_entry = symbol;
+            break;
+        case BAA_NODE_KIND_FUNCTION_DEF:
+            ((BaaFunctionDefData *)declaration->data)->symbol_entry = symbol;
+            break;
+        default:
+            break;
+        }
+    }
+    return symbol;
+}
+
+BaaSymbol *baa_symbol_table_lookup(const BaaSymbolTable *table, const wchar_t *name)
+{
+    if (!table || !name)
+    {
+        return NULL;
+    }
+
+    // The name is hashed once for this table and the globals it is layered over
+    size_t length = wcslen(name);
+    uint32_t hash = name_hash(name, length);
+    for (; table; table = table->globals)
+    {
+        const BaaSymbolBinding *binding = table->bindings[find_slot(table, name, length, hash)];
+        if (binding && binding->symbol)
+        {
+            return binding->symbol;
+        }
+    }
+    return NULL;
+}
+
+BaaSymbol *baa_symbol_table_lookup_current(const BaaSymbolTable *table, const wchar_t *name)
+{
+    if (!table || !name)
+    {
+        return NULL;
+    }
+    size_t length = wcslen(name);
+    const BaaSymbolBinding *binding = table->bindings[find_slot(table, name, length, name_hash(name, length))];
+    return binding && binding->symbol && binding->symbol->scope == table->current ? binding->symbol : NULL;
+}
+
+BaaSymbol *baa_symbol_table_resolve(const BaaSymbolTable *table, BaaNode *identifier)
+{
+    if (!identifier || identifier->kind != BAA_NODE_KIND_IDENTIFIER_EXPR)
+    {
+        return NULL;
+    }
+    BaaIdentifierExprData *data = (BaaIdentifierExprData *)identifier->data;
+    data->resolved_symbol = baa_symbol_table_lookup(table, data->name);
+    return data->resolved_symbol;
+}
+
+size_t baa_symbol_table_name_count(const BaaSymbolTable *table)
+{
+    return table ? table->binding_count : 0;
+}
@@ -0,0 +1,958 @@
+// src/analysis/type_checker.c
+#include "baa/analysis/type_checker.h"
+#include "baa/ast/ast_arena.h"
+#include "baa/ast/ast_visitor.h"
+#include "baa/operators/operators.h"
+#include "baa/types/types.h"
+#include "baa/utils/threads.h"
+#include "baa/utils/utils.h" // For baa_malloc, baa_realloc, baa_free
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Messages are formatted into a stack buffer of this size
+#define CHECK_MESSAGE_CHARS 512
+
+// Phases of baa_type_check_program (diagnostics of a declaration are ordered by phase)
+#define CHECK_PHASE_DECLARATIONS 0
+#define CHECK_PHASE_BODIES 1
+
+// Function bodies are handed to workers this many at a time
+#define CHECK_PARALLEL_BATCH 16
+#define CHECK_PARALLEL_MAX_THREADS 64
+
+// --- Diagnostics ---
+
+typedef struct
+{
+    size_t unit;              // Index of the top-level declaration being checked
+    size_t sequence;          // Report order within its list
+    uint8_t phase;            // CHECK_PHASE_*
+    BaaDiagnostic diagnostic; // Message allocated from the list's arena
+} CheckDiagnosticRecord;
+
+typedef struct
+{
+    CheckDiagnosticRecord *records;
+    size_t count;
+    size_t capacity;
+    BaaAstArena *arena; // Message text
+} CheckDiagnosticList;
+
+// Function bodies still to be checked, shared by the workers
+typedef struct
+{
+    BaaNode **declarations; // The program's top-level declarations
+    size_t *units;          // Indexes of the functions with bodies, in source order
+    size_t count;
+    size_t next;   // First unit not yet handed out
+    bool abort;    // A worker ran out of memory
+    BaaMutex lock; // Guards next and abort
+} CheckQueue;
+
+// One worker of the body phase; its table and diagnostics outlive the check
+typedef struct
+{
+    BaaSymbolTable *symbols;         // Function scopes, layered over the globals
+    CheckDiagnosticList diagnostics; // Reported while checking its bodies
+    CheckQueue *queue;
+    size_t node_count;
+    bool out_of_memory;
+} CheckWorker;
+
+struct BaaTypeChecker
+{
+    BaaSymbolTable *globals; // Functions and global variables
+
+    CheckDiagnosticList declaration_diagnostics; // Reported while checking top-level declarations
+    CheckWorker *workers;                        // Body phase workers
+    size_t worker_count;
+    BaaDiagnostic *diagnostics; // All lists in source order
+    size_t diagnostic_count;
+
+    size_t thread_count; // Requested body phase threads (0 = hardware concurrency)
+    size_t node_count;
+    bool used; // baa_type_check_program was called
+};
+
+// State of one walk
+typedef struct
+{
+    BaaSymbolTable *symbols;          // Table names are declared in and resolved through
+    CheckDiagnosticList *diagnostics; // Where errors go
+    BaaNode *function;                // Function whose body is being checked, or NULL
+    size_t unit;                      // Index of the top-level declaration being checked
+    uint8_t phase;                    // CHECK_PHASE_*
+    size_t node_count;                // Nodes visited
+    bool out_of_memory;
+} CheckContext;
+
+static void report(CheckContext *ctx, const BaaNode *node, BaaDiagnosticCategory category, const wchar_t *format, ...)
+{
+    CheckDiagnosticList *list = ctx->diagnostics;
+    if (list->count == list->capacity)
+    {
+        size_t capacity = list->capacity ? list->capacity * 2 : 16;
+        CheckDiagnosticRecord *records = (CheckDiagnosticRecord *)baa_realloc(
+            list->records, capacity * sizeof(CheckDiagnosticRecord));
+        if (!records)
+        {
+            ctx->out_of_memory = true;
+            return;
+        }
+        list->records = records;
+        list->capacity = capacity;
+    }
+    if (!list->arena && !(list->arena = baa_ast_arena_create()))
+    {
+        ctx->out_of_memory = true;
+        return;
+    }
+
+    wchar_t buffer[CHECK_MESSAGE_CHARS];
+    va_list args;
+    va_start(args, format);
+    int written = vswprintf(buffer, CHECK_MESSAGE_CHARS, format, args);
+    va_end(args);
+
+    // A message too long for the buffer is kept unformatted
+    const wchar_t *text = written >= 0 ? buffer : format;
+    size_t length = written >= 0 ? (size_t)written : wcslen(format);
+    wchar_t *message = (wchar_t *)baa_ast_arena_alloc(list->arena, (length + 1) * sizeof(wchar_t));
+    if (!message)
+    {
+        ctx->out_of_memory = true;
+        return;
+    }
+    wmemcpy(message, text, length);
+    message[length] = L'\0';
+
+    CheckDiagnosticRecord *record = &list->records[list->count];
+    record->unit = ctx->unit;
+    record->sequence = list->count;
+    record->phase = ctx->phase;
+    record->diagnostic.severity = BAA_DIAG_ERROR;
+    record->diagnostic.category = category;
+    record->diagnostic.location = node->span.start;
+    record->diagnostic.message = message;
+    record->diagnostic.source_line = NULL;
+    record->diagnostic.column_start = node->span.start.column;
+    record->diagnostic.column_end = node->span.end.column;
+    record->diagnostic.fix_hint = NULL;
+    list->count++;
+}
+
+static void free_diagnostic_list(CheckDiagnosticList *list)
+{
+    baa_free(list->records);
+    baa_ast_arena_destroy(list->arena);
+    memset(list, 0, sizeof(*list));
+}
+
+// --- Types ---
+
+static BaaType *primitive_type_by_name(const wchar_t *name)
+{
+    static BaaType *(*const getters[])(void) = {baa_get_int_type,    baa_get_float_type, baa_get_char_type,
+                                                baa_get_string_type, baa_get_bool_type,  baa_get_void_type};
+    for (size_t i = 0; i < sizeof(getters) / sizeof(getters[0]); i++)
+    {
+        BaaType *type = getters[i]();
+        if (wcscmp(type->name, name) == 0)
+        {
+            return type;
+        }
+    }
+    return NULL;
+}
+
+static BaaType *literal_type(const BaaLiteralExprData *data)
+{
+    if (data->determined_type)
+    {
+        return data->determined_type;
+    }
+    switch (data->literal_kind)
+    {
+    case BAA_LITERAL_KIND_BOOL:
+        return baa_get_bool_type();
+    case BAA_LITERAL_KIND_INT:
+        return baa_get_int_type();
+    case BAA_LITERAL_KIND_FLOAT:
+        return baa_get_float_type();
+    case BAA_LITERAL_KIND_CHAR:
+        return baa_get_char_type();
+    case BAA_LITERAL_KIND_STRING:
+        return baa_get_string_type();
+    case BAA_LITERAL_KIND_NULL:
+    default:
+        return baa_get_null_type();
+    }
+}
+
+static bool is_error(const BaaType *type)
+{
+    return !type || type->kind == BAA_TYPE_ERROR;
+}
+
+// Whether a value of type `from` can be stored in (or passed as) `to`
+static bool can_assign(BaaType *from, BaaType *to)
+{
+    BaaType *result;
+    if (from->kind == BAA_TYPE_ARRAY || to->kind == BAA_TYPE_ARRAY)
+    {
+        // Canonical array types are equal only when they are the same object;
+        // a string literal initializes a character array
+        return from == to || (from->kind == BAA_TYPE_STRING && baa_get_array_element_type(to) == baa_get_char_type());
+    }
+    if (baa_validate_binary_op(BAA_OP_ASSIGN, to, from, &result) || baa_can_convert(from, to))
+    {
+        return true;
+    }
+    // Conditions and comparisons yield int; int and bool are interchangeable
+    return (from->kind == BAA_TYPE_INT || from->kind == BAA_TYPE_BOOL) &&
+           (to->kind == BAA_TYPE_INT || to->kind == BAA_TYPE_BOOL);
+}
+
+static BaaOperatorType binary_operator(BaaBinaryOperatorKind kind)
+{
+    switch (kind)
+    {
+    case BAA_BINARY_OP_ADD:
+        return BAA_OP_ADD;
+    case BAA_BINARY_OP_SUBTRACT:
+        return BAA_OP_SUB;
+    case BAA_BINARY_OP_MULTIPLY:
+        return BAA_OP_MUL;
+    case BAA_BINARY_OP_DIVIDE:
+        return BAA_OP_DIV;
+    case BAA_BINARY_OP_MODULO:
+        return BAA_OP_MOD;
+    case BAA_BINARY_OP_EQUAL:
+        return BAA_OP_EQ;
+    case BAA_BINARY_OP_NOT_EQUAL:
+        return BAA_OP_NE;
+    case BAA_BINARY_OP_LESS_THAN:
+        return BAA_OP_LT;
+    case BAA_BINARY_OP_LESS_EQUAL:
+        return BAA_OP_LE;
+    case BAA_BINARY_OP_GREATER_THAN:
+        return BAA_OP_GT;
+    case BAA_BINARY_OP_GREATER_EQUAL:
+        return BAA_OP_GE;
+    case BAA_BINARY_OP_LOGICAL_AND:
+        return BAA_OP_AND;
+    case BAA_BINARY_OP_LOGICAL_OR:
+        return BAA_OP_OR;
+    default:
+        return BAA_OP_NONE;
+    }
+}
+
+static BaaOperatorType unary_operator(BaaUnaryOperatorKind kind)
+{
+    switch (kind)
+    {
+    case BAA_UNARY_OP_PLUS:
+        return BAA_OP_ADD;
+    case BAA_UNARY_OP_MINUS:
+        return BAA_OP_SUB;
+    case BAA_UNARY_OP_LOGICAL_NOT:
+        return BAA_OP_NOT;
+    default:
+        return BAA_OP_NONE;
+    }
+}
+
+static const wchar_t *operator_symbol(BaaOperatorType op)
+{
+    const BaaOperatorInfo *info = baa_get_operator_info(op);
+    return info ? info->symbol : L"?";
+}
+
+// --- Nodes ---
+
+static BaaType *check_type_node(CheckContext *ctx, BaaNode *node)
+{
+    BaaTypeAstData *data = (BaaTypeAstData *)node->data;
+    switch (data->type_ast_kind)
+    {
+    case BAA_TYPE_AST_KIND_PRIMITIVE:
+    {
+        BaaType *type = primitive_type_by_name(data->specifier.primitive.name);
+        if (!type)
+        {
+            report(ctx, node, BAA_DIAG_TYPE, L"نوع غير معروف '%ls'", data->specifier.primitive.name);
+            return baa_get_error_type();
+        }
+        return type;
+    }
+    case BAA_TYPE_AST_KIND_ARRAY:
+    {
+        BaaNode *element_node = data->specifier.array.element_type_node;
+        BaaNode *size_node = data->specifier.array.size_expr;
+        BaaType *element = element_node ? element_node->resolved_type : NULL;
+        if (is_error(element))
+        {
+            return baa_get_error_type();
+        }
+
+        size_t size = 0;
+        if (size_node)
+        {
+            const BaaLiteralExprData *literal = size_node->kind == BAA_NODE_KIND_LITERAL_EXPR
+                                                    ? (const BaaLiteralExprData *)size_node->data
+                                                    : NULL;
+            if (!literal || literal->literal_kind != BAA_LITERAL_KIND_INT || literal->value.int_value < 0)
+            {
+                report(ctx, size_node, BAA_DIAG_TYPE, L"حجم المصفوفة يجب أن يكون عدداً صحيحاً ثابتاً");
+                return baa_get_error_type();
+            }
+            size = (size_t)literal->value.int_value;
+        }
+        BaaType *type = baa_create_array_type(element, size);
+        if (!type)
+        {
+            ctx->out_of_memory = true;
+            return baa_get_error_type();
+        }
+        return type;
+    }
+    default:
+        report(ctx, node, BAA_DIAG_TYPE, L"نوع غير مدعوم");
+        return baa_get_error_type();
+    }
+}
+
+static BaaType *check_identifier(CheckContext *ctx, BaaNode *node)
+{
+    BaaSymbol *symbol = baa_symbol_table_resolve(ctx->symbols, node);
+    if (!symbol)
+    {
+        report(ctx, node, BAA_DIAG_SEMANTIC, L"المعرف '%ls' غير معرّف", ((BaaIdentifierExprData *)node->data)->name);
+        return baa_get_error_type();
+    }
+    // A function name has the function's return type
+    return symbol->type ? symbol->type : baa_get_error_type();
+}
+
+static BaaType *check_binary(CheckContext *ctx, BaaNode *node)
+{
+    BaaBinaryExprData *data = (BaaBinaryExprData *)node->data;
+    BaaType *left = data->left_operand ? data->left_operand->resolved_type : NULL;
+    BaaType *right = data->right_operand ? data->right_operand->resolved_type : NULL;
+    if (is_error(left) || is_error(right))
+    {
+        return baa_get_error_type();
+    }
+
+    BaaOperatorType op = binary_operator(data->operator_kind);
+    BaaType *result;
+    if (!baa_validate_binary_op(op, left, right, &result))
+    {
+        report(ctx, node, BAA_DIAG_TYPE, L"العملية '%ls' غير صالحة بين النوعين '%ls' و '%ls'", operator_symbol(op),
+               baa_type_to_string(left), baa_type_to_string(right));
+    }
+    return result;
+}
+
+static BaaType *check_unary(CheckContext *ctx, BaaNode *node)
+{
+    BaaUnaryExprData *data = (BaaUnaryExprData *)node->data;
+    BaaType *operand = data->operand ? data->operand->resolved_type : NULL;
+    if (is_error(operand))
+    {
+        return baa_get_error_type();
+    }
+
+    BaaOperatorType op = unary_operator(data->operator_kind);
+    BaaType *result;
+    if (!baa_validate_unary_op(op, operand, &result))
+    {
+        report(ctx, node, BAA_DIAG_TYPE, L"العملية '%ls' غير صالحة للنوع '%ls'", operator_symbol(op),
+               baa_type_to_string(operand));
+    }
+    return result;
+}
+
+static BaaType *check_call(CheckContext *ctx, BaaNode *node)
+{
+    BaaCallExprData *data = (BaaCallExprData *)node->data;
+    BaaNode *callee = data->callee_expr;
+    if (!callee || is_error(callee->resolved_type))
+    {
+        return baa_get_error_type();
+    }
+    BaaSymbol *symbol = callee->kind == BAA_NODE_KIND_IDENTIFIER_EXPR
+                            ? ((BaaIdentifierExprData *)callee->data)->resolved_symbol
+                            : NULL;
+    if (!symbol || symbol->kind != BAA_SYMBOL_FUNCTION)
+    {
+        report(ctx, callee, BAA_DIAG_SEMANTIC, L"لا يمكن استدعاء '%ls' لأنه ليس دالة",
+               symbol ? symbol->name : L"التعبير");
+        return baa_get_error_type();
+    }
+
+    const BaaNode *declaration = symbol->declaration;
+    if (declaration && declaration->kind == BAA_NODE_KIND_FUNCTION_DEF)
+    {
+        const BaaFunctionDefData *function = (const BaaFunctionDefData *)declaration->data;
+        if (data->argument_count < function->parameter_count ||
+            (data->argument_count > function->parameter_count && !function->is_variadic))
+        {
+            report(ctx, node, BAA_DIAG_SEMANTIC, L"الدالة '%ls' تتوقع %zu وسيط(ات) لكن استُدعيت بـ %zu",
+                   symbol->name, function->parameter_count, data->argument_count);
+        }
+        else
+        {
+            // Parameter types were resolved with the declarations
+            for (size_t i = 0; i < function->parameter_count; i++)
+            {
+                BaaNode *argument = data->arguments[i];
+                const BaaParameterData *parameter = (const BaaParameterData *)function->parameters[i]->data;
+                BaaType *expected = parameter->type_node ? parameter->type_node->resolved_type : NULL;
+                BaaType *actual = argument->resolved_type;
+                if (!is_error(expected) && !is_error(actual) && !can_assign(actual, expected))
+                {
+                    report(ctx, argument, BAA_DIAG_TYPE, L"لا يمكن تمرير قيمة من النوع '%ls' لمعامل من النوع '%ls'",
+                           baa_type_to_string(actual), baa_type_to_string(expected));
+                }
+            }
+        }
+    }
+    return symbol->type ? symbol->type : baa_get_error_type();
+}
+
+static void declare(CheckContext *ctx, BaaNode *node, const wchar_t *name, BaaSymbolKind kind, BaaType *type)
+{
+    BaaSymbol *symbol = baa_symbol_table_declare(ctx->symbols, name, kind, node);
+    if (!symbol)
+    {
+        if (baa_symbol_table_lookup_current(ctx->symbols, name))
+        {
+            report(ctx, node, BAA_DIAG_SEMANTIC, L"'%ls' معرّف مسبقاً في هذا النطاق", name);
+        }
+        else
+        {
+            ctx->out_of_memory = true;
+        }
+        return;
+    }
+    symbol->type = type;
+}
+
+static void check_var_decl(CheckContext *ctx, BaaNode *node)
+{
+    BaaVarDeclData *data = (BaaVarDeclData *)node->data;
+    BaaType *type = data->type_node ? data->type_node->resolved_type : NULL;
+    if (!type)
+    {
+        type = baa_get_error_type();
+    }
+    else if (type->kind == BAA_TYPE_VOID)
+    {
+        report(ctx, node, BAA_DIAG_TYPE, L"لا يمكن تعريف المتغير '%ls' من النوع '%ls'", data->name,
+               baa_type_to_string(type));
+        type = baa_get_error_type();
+    }
+
+    BaaNode *initializer = data->initializer_expr;
+    if (initializer && !is_error(type) && !is_error(initializer->resolved_type) &&
+        !can_assign(initializer->resolved_type, type))
+    {
+        report(ctx, initializer, BAA_DIAG_TYPE, L"لا يمكن تهيئة '%ls' من النوع '%ls' بقيمة من النوع '%ls'", data->name,
+               baa_type_to_string(type), baa_type_to_string(initializer->resolved_type));
+    }
+
+    // Declared after its initializer: a variable is not visible in its own initializer
+    node->resolved_type = type;
+    declare(ctx, node, data->name, BAA_SYMBOL_VARIABLE, type);
+}
+
+static void check_condition(CheckContext *ctx, BaaNode *condition)
+{
+    BaaType *type = condition ? condition->resolved_type : NULL;
+    if (is_error(type))
+    {
+        return;
+    }
+    if (type->kind != BAA_TYPE_INT && type->kind != BAA_TYPE_BOOL && type->kind != BAA_TYPE_CHAR &&
+        type->kind != BAA_TYPE_FLOAT)
+    {
+        report(ctx, condition, BAA_DIAG_TYPE, L"لا يمكن استخدام قيمة من النوع '%ls' كشرط", baa_type_to_string(type));
+    }
+}
+
+static void check_return(CheckContext *ctx, BaaNode *node)
+{
+    if (!ctx->function)
+    {
+        return;
+    }
+    BaaType *expected = ctx->function->resolved_type;
+    BaaNode *value = ((BaaReturnStmtData *)node->data)->value_expr;
+    if (is_error(expected))
+    {
+        return;
+    }
+    if (!value)
+    {
+        if (expected->kind != BAA_TYPE_VOID)
+        {
+            report(ctx, node, BAA_DIAG_TYPE, L"يجب أن تُرجع الدالة قيمة من النوع '%ls'", baa_type_to_string(expected));
+        }
+    }
+    else if (expected->kind == BAA_TYPE_VOID)
+    {
+        report(ctx, value, BAA_DIAG_TYPE, L"لا يمكن إرجاع قيمة من دالة من النوع '%ls'", baa_type_to_string(expected));
+    }
+    else if (!is_error(value->resolved_type) && !can_assign(value->resolved_type, expected))
+    {
+        report(ctx, value, BAA_DIAG_TYPE, L"لا يمكن إرجاع قيمة من النوع '%ls' من دالة من النوع '%ls'",
+               baa_type_to_string(value->resolved_type), baa_type_to_string(expected));
+    }
+}
+
+// --- Walk ---
+
+static BaaAstVisitResult check_pre(BaaNode *node, BaaNode *parent, size_t depth, void *user_data)
+{
+    (void)parent;
+    (void)depth;
+    CheckContext *ctx = (CheckContext *)user_data;
+
+    // Type specifications were resolved with the declarations: reuse the result
+    if (node->kind == BAA_NODE_KIND_TYPE && node->resolved_type)
+    {
+        return BAA_AST_VISIT_SKIP_CHILDREN;
+    }
+    ctx->node_count++;
+
+    bool scope_ok = true;
+    switch (node->kind)
+    {
+    case BAA_NODE_KIND_FUNCTION_DEF:
+        // Parameters live in a function scope around the body's block scope
+        ctx->function = node;
+        scope_ok = baa_symbol_table_push_scope(ctx->symbols, NULL) != NULL;
+        break;
+    case BAA_NODE_KIND_BLOCK_STMT:
+        scope_ok = baa_symbol_table_push_scope(ctx->symbols, node) != NULL;
+        break;
+    case BAA_NODE_KIND_FOR_STMT:
+        scope_ok = baa_symbol_table_push_scope(ctx->symbols, NULL) != NULL;
+        break;
+    default:
+        break;
+    }
+    if (!scope_ok)
+    {
+        ctx->out_of_memory = true;
+        return BAA_AST_VISIT_ABORT;
+    }
+    return BAA_AST_VISIT_CONTINUE;
+}
+
+static BaaAstVisitResult check_post(BaaNode *node, BaaNode *parent, size_t depth, void *user_data)
+{
+    (void)parent;
+    (void)depth;
+    CheckContext *ctx = (CheckContext *)user_data;
+
+    switch (node->kind)
+    {
+    case BAA_NODE_KIND_TYPE:
+        if (!node->resolved_type)
+        {
+            node->resolved_type = check_type_node(ctx, node);
+        }
+        break;
+    case BAA_NODE_KIND_LITERAL_EXPR:
+        node->resolved_type = literal_type((const BaaLiteralExprData *)node->data);
+        break;
+    case BAA_NODE_KIND_IDENTIFIER_EXPR:
+        node->resolved_type = check_identifier(ctx, node);
+        break;
+    case BAA_NODE_KIND_BINARY_EXPR:
+        node->resolved_type = check_binary(ctx, node);
+        break;
+    case BAA_NODE_KIND_UNARY_EXPR:
+        node->resolved_type = check_unary(ctx, node);
+        break;
+    case BAA_NODE_KIND_CALL_EXPR:
+        node->resolved_type = check_call(ctx, node);
+        break;
+    case BAA_NODE_KIND_PARAMETER:
+    {
+        BaaParameterData *data = (BaaParameterData *)node->data;
+        BaaType *type = data->type_node && data->type_node->resolved_type ? data->type_node->resolved_type
+                                                                          : baa_get_error_type();
+        node->resolved_type = type;
+        declare(ctx, node, data->name, BAA_SYMBOL_PARAMETER, type);
+        break;
+    }
+    case BAA_NODE_KIND_VAR_DECL_STMT:
+        check_var_decl(ctx, node);
+        break;
+    case BAA_NODE_KIND_IF_STMT:
+        check_condition(ctx, ((BaaIfStmtData *)node->data)->condition_expr);
+        break;
+    case BAA_NODE_KIND_WHILE_STMT:
+        check_condition(ctx, ((BaaWhileStmtData *)node->data)->condition_expr);
+        break;
+    case BAA_NODE_KIND_FOR_STMT:
+        check_condition(ctx, ((BaaForStmtData *)node->data)->condition_expr);
+        baa_symbol_table_pop_scope(ctx->symbols);
+        break;
+    case BAA_NODE_KIND_RETURN_STMT:
+        check_return(ctx, node);
+        break;
+    case BAA_NODE_KIND_BLOCK_STMT:
+        baa_symbol_table_pop_scope(ctx->symbols);
+        break;
+    case BAA_NODE_KIND_FUNCTION_DEF:
+        baa_symbol_table_pop_scope(ctx->symbols);
+        ctx->function = NULL;
+        break;
+    default:
+        break;
+    }
+    return ctx->out_of_memory ? BAA_AST_VISIT_ABORT : BAA_AST_VISIT_CONTINUE;
+}
+
+static void check_subtree(CheckContext *ctx, BaaNode *node)
+{
+    BaaAstVisitor visitor = {.pre = check_pre, .post = check_post, .user_data = ctx};
+    if (node && !baa_ast_walk(node, &visitor))
+    {
+        ctx->out_of_memory = true;
+    }
+}
+
+// Resolves a function's signature and declares it; its body is checked later
+static void check_function_declaration(CheckContext *ctx, BaaNode *node)
+{
+    BaaFunctionDefData *data = (BaaFunctionDefData *)node->data;
+    check_subtree(ctx, data->return_type_node);
+    for (size_t i = 0; i < data->parameter_count; i++)
+    {
+        check_subtree(ctx, ((BaaParameterData *)data->parameters[i]->data)->type_node);
+    }
+    BaaType *return_type = data->return_type_node && data->return_type_node->resolved_type
+                               ? data->return_type_node->resolved_type
+                               : baa_get_error_type();
+    node->resolved_type = return_type;
+    declare(ctx, node, data->name, BAA_SYMBOL_FUNCTION, return_type);
+}
+
+// --- Body phase ---
+
+// Worker loop: takes batches of bodies off the queue until it is empty
+static int check_bodies(void *arg)
+{
+    CheckWorker *worker = (CheckWorker *)arg;
+    CheckQueue *queue = worker->queue;
+    CheckContext ctx = {.symbols = worker->symbols, .diagnostics = &worker->diagnostics, .phase = CHECK_PHASE_BODIES};
+    for (;;)
+    {
+        baa_mutex_lock(&queue->lock);
+        size_t begin = queue->abort ? queue->count : queue->next;
+        size_t end = queue->count - begin > CHECK_PARALLEL_BATCH ? begin + CHECK_PARALLEL_BATCH : queue->count;
+        queue->next = end;
+        baa_mutex_unlock(&queue->lock);
+        if (begin == end)
+        {
+            break;
+        }
+
+        for (size_t i = begin; i < end && !ctx.out_of_memory; i++)
+        {
+            ctx.unit = queue->units[i];
+            check_subtree(&ctx, queue->declarations[ctx.unit]);
+        }
+        if (ctx.out_of_memory)
+        {
+            baa_mutex_lock(&queue->lock);
+            queue->abort = true;
+            baa_mutex_unlock(&queue->lock);
+            break;
+        }
+    }
+    worker->node_count = ctx.node_count;
+    worker->out_of_memory = ctx.out_of_memory;
+    return 0;
+}
+
+// Checks the bodies on worker threads. Each worker has its own symbol table
+// and diagnostic list; the globals and the type table are only read.
+static bool run_body_phase(BaaTypeChecker *checker, CheckQueue *queue)
+{
+    size_t thread_count = checker->thread_count ? checker->thread_count : baa_thread_hardware_concurrency();
+    size_t batches = (queue->count + CHECK_PARALLEL_BATCH - 1) / CHECK_PARALLEL_BATCH;
+    if (thread_count > CHECK_PARALLEL_MAX_THREADS)
+    {
+        thread_count = CHECK_PARALLEL_MAX_THREADS;
+    }
+    if (thread_count > batches)
+    {
+        thread_count = batches;
+    }
+    if (thread_count < 1)
+    {
+        thread_count = 1;
+    }
+
+    checker->workers = (CheckWorker *)baa_malloc(thread_count * sizeof(CheckWorker));
+    BaaThread *threads = (BaaThread *)baa_malloc(thread_count * sizeof(BaaThread));
+    bool *started = (bool *)baa_malloc(thread_count * sizeof(bool));
+    if (!checker->workers || !threads || !started)
+    {
+        baa_free(threads);
+        baa_free(started);
+        return false;
+    }
+    memset(checker->workers, 0, thread_count * sizeof(CheckWorker));
+    checker->worker_count = thread_count;
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        checker->workers[i].queue = queue;
+        checker->workers[i].symbols = baa_symbol_table_create(checker->globals);
+        started[i] = false;
+        if (!checker->workers[i].symbols)
+        {
+            baa_free(threads);
+            baa_free(started);
+            return false;
+        }
+    }
+
+    // The calling thread is the first worker; a thread that fails to start
+    // leaves its share of the queue to the others
+    for (size_t i = 1; i < thread_count; i++)
+    {
+        started[i] = baa_thread_create(&threads[i], check_bodies, &checker->workers[i]);
+    }
+    check_bodies(&checker->workers[0]);
+
+    bool ok = true;
+    for (size_t i = 0; i < thread_count; i++)
+    {
+        if (started[i] && !baa_thread_join(&threads[i], NULL))
+        {
+            ok = false;
+        }
+        ok = ok && !checker->workers[i].out_of_memory;
+    }
+    baa_free(threads);
+    baa_free(started);
+    return ok;
+}
+
+// --- Diagnostic merge ---
+
+static int compare_records(const void *a, const void *b)
+{
+    const CheckDiagnosticRecord *x = *(const CheckDiagnosticRecord *const *)a;
+    const CheckDiagnosticRecord *y = *(const CheckDiagnosticRecord *const *)b;
+    if (x->unit != y->unit)
+    {
+        return x->unit < y->unit ? -1 : 1;
+    }
+    if (x->phase != y->phase)
+    {
+        return x->phase < y->phase ? -1 : 1;
+    }
+    return x->sequence < y->sequence ? -1 : (x->sequence > y->sequence ? 1 : 0);
+}
+
+// Orders the diagnostics of all lists by declaration, phase and report order
+static bool merge_diagnostics(BaaTypeChecker *checker, CheckDiagnosticList *const *lists, size_t list_count)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < list_count; i++)
+    {
+        total += lists[i]->count;
+    }
+    if (total == 0)
+    {
+        return true;
+    }
+
+    const CheckDiagnosticRecord **order =
+        (const CheckDiagnosticRecord **)baa_malloc(total * sizeof(CheckDiagnosticRecord *));
+    BaaDiagnostic *diagnostics = (BaaDiagnostic *)baa_malloc(total * sizeof(BaaDiagnostic));
+    if (!order || !diagnostics)
+    {
+        baa_free(order);
+        baa_free(diagnostics);
+        return false;
+    }
+    size_t n = 0;
+    for (size_t i = 0; i < list_count; i++)
+    {
+        for (size_t j = 0; j < lists[i]->count; j++)
+        {
+            order[n++] = &lists[i]->records[j];
+        }
+    }
+    qsort(order, total, sizeof(*order), compare_records);
+    for (size_t i = 0; i < total; i++)
+    {
+        diagnostics[i] = order[i]->diagnostic;
+    }
+    baa_free(order);
+
+    checker->diagnostics = diagnostics;
+    checker->diagnostic_count = total;
+    return true;
+}
+
+// --- Public API ---
+
+BaaTypeChecker *baa_type_checker_create(void)
+{
+    BaaTypeChecker *checker = (BaaTypeChecker *)baa_malloc(sizeof(BaaTypeChecker));
+    if (!checker)
+    {
+        return NULL;
+    }
+    memset(checker, 0, sizeof(*checker));
+    checker->thread_count = 1;
+    checker->globals = baa_symbol_table_create(NULL);
+    if (!checker->globals)
+    {
+        baa_type_checker_free(checker);
+        return NULL;
+    }
+    return checker;
+}
+
+void baa_type_checker_free(BaaTypeChecker *checker)
+{
+    if (!checker)
+    {
+        return;
+    }
+    for (size_t i = 0; i < checker->worker_count; i++)
+    {
+        baa_symbol_table_free(checker->workers[i].symbols);
+        free_diagnostic_list(&checker->workers[i].diagnostics);
+    }
+    baa_free(checker->workers);
+    baa_symbol_table_free(checker->globals);
+    free_diagnostic_list(&checker->declaration_diagnostics);
+    baa_free(checker->diagnostics);
+    baa_free(checker);
+}
+
+void baa_type_checker_set_parallel(BaaTypeChecker *checker, size_t thread_count)
+{
+    if (checker)
+    {
+        checker->thread_count = thread_count;
+    }
+}
+
+bool baa_type_check_program(BaaTypeChecker *checker, BaaNode *program)
+{
+    if (!checker || checker->used || !program || program->kind != BAA_NODE_KIND_PROGRAM)
+    {
+        return false;
+    }
+    checker->used = true;
+    BaaProgramData *data = (BaaProgramData *)program->data;
+
+    // Phase 1: top-level declarations, all in the global scope
+    CheckContext ctx = {.symbols = checker->globals,
+                        .diagnostics = &checker->declaration_diagnostics,
+                        .phase = CHECK_PHASE_DECLARATIONS};
+    for (size_t i = 0; i < data->count && !ctx.out_of_memory; i++)
+    {
+        BaaNode *declaration = data->top_level_declarations[i];
+        ctx.unit = i;
+        if (declaration->kind == BAA_NODE_KIND_FUNCTION_DEF)
+        {
+            check_function_declaration(&ctx, declaration);
+        }
+        else
+        {
+            check_subtree(&ctx, declaration);
+        }
+    }
+    size_t node_count = ctx.node_count + 1; // And the program node
+    bool out_of_memory = ctx.out_of_memory;
+
+    // Phase 2: function bodies, each in a function scope nested in the global scope
+    CheckQueue queue = {.declarations = data->top_level_declarations, .lock = BAA_MUTEX_INIT};
+    queue.units = data->count ? (size_t *)baa_malloc(data->count * sizeof(size_t)) : NULL;
+    if (data->count && !queue.units)
+    {
+        out_of_memory = true;
+    }
+    for (size_t i = 0; i < data->count && !out_of_memory; i++)
+    {
+        BaaNode *declaration = data->top_level_declarations[i];
+        if (declaration->kind == BAA_NODE_KIND_FUNCTION_DEF && ((BaaFunctionDefData *)declaration->data)->body)
+        {
+            queue.units[queue.count++] = i;
+        }
+    }
+    if (!out_of_memory && queue.count && !run_body_phase(checker, &queue))
+    {
+        out_of_memory = true;
+    }
+    baa_free(queue.units);
+
+    CheckDiagnosticList *lists[CHECK_PARALLEL_MAX_THREADS + 1] = {&checker->declaration_diagnostics};
+    for (size_t i = 0; i < checker->worker_count; i++)
+    {
+        node_count += checker->workers[i].node_count;
+        lists[i + 1] = &checker->workers[i].diagnostics;
+    }
+    checker->node_count = node_count;
+
+    // Each body is checked by one worker, so ordering by declaration gives the same list for any thread count
+    if (!merge_diagnostics(checker, lists, checker->worker_count + 1))
+    {
+        out_of_memory = true;
+    }
+    return !out_of_memory && checker->diagnostic_count == 0;
+}
+
+size_t baa_type_checker_error_count(const BaaTypeChecker *checker)
+{
+    return checker ? checker->diagnostic_count : 0;
+}
+
+const BaaDiagnostic *baa_type_checker_get_diagnostics(const BaaTypeChecker *checker, size_t *out_count)
+{
+    if (out_count)
+    {
+        *out_count = checker ? checker->diagnostic_count : 0;
+    }
+    return checker && checker->diagnostic_count ? checker->diagnostics : NULL;
+}
+
+void baa_type_checker_print_diagnostics(const BaaTypeChecker *checker, FILE *stream)
+{
+    size_t count = 0;
+    const BaaDiagnostic *diagnostics = baa_type_checker_get_diagnostics(checker, &count);
+    for (size_t i = 0; i < count; i++)
+    {
+        const BaaDiagnostic *diagnostic = &diagnostics[i];
+        fwprintf(stream, L"%ls:%zu:%zu: خطأ: %ls\n",
+                 diagnostic->location.filename ? diagnostic->location.filename : L"<unknown_source>",
+                 diagnostic->location.line, diagnostic->location.column, diagnostic->message);
+    }
+}
+
+const BaaSymbolTable *baa_type_checker_globals(const BaaTypeChecker *checker)
+{
+    return checker ? checker->globals : NULL;
+}
+
+size_t baa_type_checker_node_count(const BaaTypeChecker *checker)
+{
+    return checker ? checker->node_count : 0;
+}
@@ -0,0 +1,28 @@
+#ifndef BAA_AST_ALLOC_H
+#define BAA_AST_ALLOC_H
+
+#include "baa/ast/ast_types.h" // For BaaNode, BaaNodeKind, BaaAstSourceSpan
+#include <stdbool.h>
+#include <wchar.h>
+
+/**
+ * @brief Allocates a node with `data_size` bytes of zeroed kind-specific data in the same block.
+ *
+ * Uses the arena active on the calling thread, or the heap when none is active.
+ * node->data points into the block (NULL when data_size is 0) and must not be
+ * freed separately.
+ */
+BaaNode *baa_ast_alloc_node(BaaNodeKind kind, BaaAstSourceSpan span, size_t data_size);
+
+/**
+ * @brief Copies a string for a field of `owner`: interned for arena nodes, baa_strdup otherwise.
+ * Returns NULL for a NULL string or on allocation failure.
+ */
+wchar_t *baa_ast_copy_string(BaaNode *owner, const wchar_t *str);
+
+/**
+ * @brief Doubles a child array of `owner` (capacity 0 becomes 4), in the owner's arena or on the heap.
+ */
+bool baa_ast_grow_children(BaaNode *owner, BaaNode ***array, size_t *capacity);
+
+#endif // BAA_AST_ALLOC_H
@@ -0,0 +1,378 @@
+// src/ast/ast_arena.c
+#include "baa/ast/ast_arena.h"
+#include "ast_alloc.h"           // For the node allocation helpers implemented here
+#include "baa/utils/utils.h"     // For baa_malloc, baa_realloc, baa_free, baa_strdup
+#include "baa/utils/threads.h"   // For BAA_THREAD_LOCAL
+#include <stdint.h>
+#include <string.h>
+
+#define AST_ARENA_ALIGN 8                    // Covers pointers, size_t, long long and double
+#define AST_ARENA_FIRST_CHUNK (64u * 1024u)  // Size of the first chunk
+#define AST_ARENA_MAX_CHUNK (1024u * 1024u)  // Chunks double up to this size
+#define AST_ARENA_LARGE (16u * 1024u)        // Larger allocations get a chunk of their own
+#define AST_INTERN_INITIAL_CAPACITY 1024     // Intern table slots (power of two)
+
+#define AST_ALIGN_UP(n) (((n) + (AST_ARENA_ALIGN - 1)) & ~(size_t)(AST_ARENA_ALIGN - 1))
+
+// Offset of the kind-specific data that follows a node in the same block
+#define AST_NODE_DATA_OFFSET AST_ALIGN_UP(sizeof(BaaNode))
+
+typedef struct BaaAstArenaChunk
+{
+    struct BaaAstArenaChunk *next; // Previously filled chunk
+    size_t size;                   // Usable bytes after the header
+    size_t used;                   // Bytes handed out
+} BaaAstArenaChunk;
+
+#define AST_CHUNK_HEADER AST_ALIGN_UP(sizeof(BaaAstArenaChunk))
+
+typedef struct
+{
+    const wchar_t *str; // Interned string (NULL for an empty slot)
+    size_t length;      // Length in characters
+    uint32_t hash;      // Cached hash
+} BaaAstInternEntry;
+
+struct BaaAstArena
+{
+    BaaAstArenaChunk *chunk;  // Current chunk (head of the chunk list)
+    size_t next_chunk_size;   // Size of the next regular chunk
+    void *last_allocation;    // Most recent allocation (can be extended in place)
+    BaaAstArenaStats stats;   // Running statistics
+
+    BaaAstInternEntry *intern_table; // Open-addressing table of interned strings
+    size_t intern_capacity;          // Slots (power of two)
+
+    BaaAstArena *adopted;      // First arena destroyed together with this one
+    BaaAstArena *next_adopted; // Next arena adopted by the same owner
+};
+
+static BAA_THREAD_LOCAL BaaAstArena *active_arena = NULL;
+
+BaaAstArena *baa_ast_arena_create(void)
+{
+    BaaAstArena *arena = (BaaAstArena *)baa_malloc(sizeof(BaaAstArena));
+    if (!arena)
+    {
+        return NULL;
+    }
+    memset(arena, 0, sizeof(*arena));
+    arena->next_chunk_size = AST_ARENA_FIRST_CHUNK;
+    return arena;
+}
+
+void baa_ast_arena_destroy(BaaAstArena *arena)
+{
+    if (!arena)
+    {
+        return;
+    }
+
+    BaaAstArena *adopted = arena->adopted;
+    while (adopted)
+    {
+        BaaAstArena *next = adopted->next_adopted;
+        baa_ast_arena_destroy(adopted);
+        adopted = next;
+    }
+
+    BaaAstArenaChunk *chunk = arena->chunk;
+    while (chunk)
+    {
+        BaaAstArenaChunk *next = chunk->next;
+        baa_free(chunk);
+        chunk = next;
+    }
+    baa_free(arena->intern_table);
+    baa_free(arena);
+}
+
+bool baa_ast_arena_adopt(BaaAstArena *arena, BaaAstArena *child)
+{
+    if (!arena || !child || child == arena || child->adopted || child->next_adopted)
+    {
+        return false;
+    }
+    child->next_adopted = arena->adopted;
+    arena->adopted = child;
+    return true;
+}
+
+BaaAstArena *baa_ast_arena_activate(BaaAstArena *arena)
+{
+    BaaAstArena *previous = active_arena;
+    active_arena = arena;
+    return previous;
+}
+
+BaaAstArena *baa_ast_arena_current(void)
+{
+    return active_arena;
+}
+
+// Allocates an empty chunk with `size` usable bytes (not linked yet)
+static BaaAstArenaChunk *arena_new_chunk(BaaAstArena *arena, size_t size)
+{
+    BaaAstArenaChunk *chunk = (BaaAstArenaChunk *)baa_malloc(AST_CHUNK_HEADER + size);
+    if (!chunk)
+    {
+        return NULL;
+    }
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+    arena->stats.bytes_reserved += size;
+    arena->stats.chunk_count++;
+    return chunk;
+}
+
+void *baa_ast_arena_alloc(BaaAstArena *arena, size_t size)
+{
+    if (!arena)
+    {
+        return NULL;
+    }
+    size = AST_ALIGN_UP(size ? size : 1);
+
+    BaaAstArenaChunk *chunk = arena->chunk;
+    if (!chunk || chunk->size - chunk->used < size)
+    {
+        if (size > AST_ARENA_LARGE)
+        {
+            // Dedicated chunk, linked behind the current one so its free space stays in use
+            BaaAstArenaChunk *large = arena_new_chunk(arena, size);
+            if (!large)
+            {
+                return NULL;
+            }
+            large->used = size;
+            if (chunk)
+            {
+                large->next = chunk->next;
+                chunk->next = large;
+            }
+            else
+            {
+                arena->chunk = large;
+            }
+            arena->stats.bytes_used += size;
+            arena->last_allocation = NULL;
+            return (char *)large + AST_CHUNK_HEADER;
+        }
+
+        chunk = arena_new_chunk(arena, arena->next_chunk_size);
+        if (!chunk)
+        {
+            return NULL;
+        }
+        if (arena->next_chunk_size < AST_ARENA_MAX_CHUNK)
+        {
+            arena->next_chunk_size *= 2;
+        }
+        chunk->next = arena->chunk;
+        arena->chunk = chunk;
+    }
+
+    void *memory = (char *)chunk + AST_CHUNK_HEADER + chunk->used;
+    chunk->used += size;
+    arena->stats.bytes_used += size;
+    arena->last_allocation = memory;
+    return memory;
+}
+
+void *baa_ast_arena_realloc(BaaAstArena *arena, void *ptr, size_t old_size, size_t new_size)
+{
+    if (!ptr)
+    {
+        return baa_ast_arena_alloc(arena, new_size);
+    }
+
+    old_size = AST_ALIGN_UP(old_size);
+    size_t aligned_new = AST_ALIGN_UP(new_size);
+    if (aligned_new <= old_size)
+    {
+        return ptr;
+    }
+
+    // The most recent allocation can grow into the rest of its chunk
+    BaaAstArenaChunk *chunk = arena->chunk;
+    if (ptr == arena->last_allocation && chunk->size - chunk->used >= aligned_new - old_size)
+    {
+        chunk->used += aligned_new - old_size;
+        arena->stats.bytes_used += aligned_new - old_size;
+        return ptr;
+    }
+
+    void *moved = baa_ast_arena_alloc(arena, new_size);
+    if (moved)
+    {
+        memcpy(moved, ptr, old_size);
+    }
+    return moved;
+}
+
+// FNV-1a over the characters
+static uint32_t intern_hash(const wchar_t *str, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (uint32_t)str[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool intern_grow(BaaAstArena *arena)
+{
+    size_t capacity = arena->intern_capacity ? arena->intern_capacity * 2 : AST_INTERN_INITIAL_CAPACITY;
+    BaaAstInternEntry *table = (BaaAstInternEntry *)baa_malloc(capacity * sizeof(BaaAstInternEntry));
+    if (!table)
+    {
+        return false;
+    }
+    memset(table, 0, capacity * sizeof(BaaAstInternEntry));
+
+    for (size_t i = 0; i < arena->intern_capacity; i++)
+    {
+        BaaAstInternEntry *entry = &arena->intern_table[i];
+        if (!entry->str)
+        {
+            continue;
+        }
+        size_t slot = entry->hash & (capacity - 1);
+        while (table[slot].str)
+        {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        table[slot] = *entry;
+    }
+
+    baa_free(arena->intern_table);
+    arena->intern_table = table;
+    arena->intern_capacity = capacity;
+    return true;
+}
+
+const wchar_t *baa_ast_arena_intern(BaaAstArena *arena, const wchar_t *str, size_t length)
+{
+    if (!arena || !str)
+    {
+        return NULL;
+    }
+
+    // Keep the load factor below 3/4
+    if ((arena->stats.interned_strings + 1) * 4 > arena->intern_capacity * 3 && !intern_grow(arena))
+    {
+        return NULL;
+    }
+
+    uint32_t hash = intern_hash(str, length);
+    size_t mask = arena->intern_capacity - 1;
+    size_t slot = hash & mask;
+    while (arena->intern_table[slot].str)
+    {
+        BaaAstInternEntry *entry = &arena->intern_table[slot];
+        if (entry->hash == hash && entry->length == length && wmemcmp(entry->str, str, length) == 0)
+        {
+            return entry->str;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    wchar_t *copy = (wchar_t *)baa_ast_arena_alloc(arena, (length + 1) * sizeof(wchar_t));
+    if (!copy)
+    {
+        return NULL;
+    }
+    wmemcpy(copy, str, length);
+    copy[length] = L'\0';
+
+    arena->intern_table[slot].str = copy;
+    arena->intern_table[slot].length = length;
+    arena->intern_table[slot].hash = hash;
+    arena->stats.interned_strings++;
+    return copy;
+}
+
+void baa_ast_arena_get_stats(const BaaAstArena *arena, BaaAstArenaStats *stats)
+{
+    if (!stats)
+    {
+        return;
+    }
+    if (!arena)
+    {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = arena->stats;
+}
+
+// --- Node allocation helpers (ast_alloc.h) ---
+
+BaaNode *baa_ast_alloc_node(BaaNodeKind kind, BaaAstSourceSpan span, size_t data_size)
+{
+    size_t block_size = data_size ? AST_NODE_DATA_OFFSET + data_size : sizeof(BaaNode);
+    BaaAstArena *arena = active_arena;
+
+    BaaNode *node = arena ? (BaaNode *)baa_ast_arena_alloc(arena, block_size)
+                          : (BaaNode *)baa_malloc(block_size);
+    if (!node)
+    {
+        return NULL;
+    }
+
+    node->kind = kind;
+    node->span = span; // Struct copy
+    node->arena = arena;
+    node->data = NULL;
+    node->resolved_type = NULL;
+    if (data_size)
+    {
+        node->data = (char *)node + AST_NODE_DATA_OFFSET;
+        memset(node->data, 0, data_size);
+    }
+
+    if (arena)
+    {
+        arena->stats.node_count++;
+    }
+    return node;
+}
+
+wchar_t *baa_ast_copy_string(BaaNode *owner, const wchar_t *str)
+{
+    if (!str)
+    {
+        return NULL;
+    }
+    if (owner->arena)
+    {
+        // Interned strings are shared and must not be modified
+        return (wchar_t *)baa_ast_arena_intern(owner->arena, str, wcslen(str));
+    }
+    return baa_strdup(str);
+}
+
+bool baa_ast_grow_children(BaaNode *owner, BaaNode ***array, size_t *capacity)
+{
+    size_t new_capacity = *capacity == 0 ? 4 : *capacity * 2;
+    BaaNode **grown;
+    if (owner->arena)
+    {
+        grown = (BaaNode **)baa_ast_arena_realloc(owner->arena, *array, *capacity * sizeof(BaaNode *),
+                                                  new_capacity * sizeof(BaaNode *));
+    }
+    else
+    {
+        grown = (BaaNode **)baa_realloc(*array, new_capacity * sizeof(BaaNode *));
+    }
+    if (!grown)
+    {
+        return false;
+    }
+    *array = grown;
+    *capacity = new_capacity;
+    return true;
+}
@@ -1,6 +1,7 @@
 #include "ast_declarations.h"
 #include "baa/ast/ast.h"
 #include "baa/utils/utils.h"
+#include "ast_alloc.h"
 
 /**
  * @file ast_declarations.c
@@ -16,24 +17,17 @@ BaaNode *baa_ast_new_var_decl_node(BaaAstSourceSpan span, const wchar_t *name,
                                    BaaAstNodeModifiers modifiers, BaaNode *type_node,
                                    BaaNode *initializer_expr)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_VAR_DECL_STMT, span);
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_VAR_DECL_STMT, span, sizeof(BaaVarDeclData));
     if (!node)
     {
-        return NULL; // Allocation for BaaNode failed
-    }
-
-    BaaVarDeclData *data = (BaaVarDeclData *)baa_malloc(sizeof(BaaVarDeclData));
-    if (!data)
-    {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // Allocation for the node failed
     }
 
     // Initialize the data structure
-    data->name = baa_strdup(name); // Duplicate the variable name
+    BaaVarDeclData *data = (BaaVarDeclData *)node->data;
+    data->name = baa_ast_copy_string(node, name); // Duplicate (or intern) the variable name
     if (!data->name && name != NULL)
-    { // Check if baa_strdup failed for non-NULL input
-        baa_free(data);
+    { // Check if the copy failed for non-NULL input
         baa_ast_free_node(node);
         return NULL;
     }
@@ -42,7 +36,6 @@ BaaNode *baa_ast_new_var_decl_node(BaaAstSourceSpan span, const wchar_t *name,
     data->type_node = type_node;               // Take ownership of the type node
     data->initializer_expr = initializer_expr; // Take ownership of the initializer expression (can be NULL)
 
-    node->data = data;
     return node;
 }
 
@@ -50,104 +43,106 @@ BaaNode *baa_ast_new_var_decl_node(BaaAstSourceSpan span, const wchar_t *name,
 
 BaaNode *baa_ast_new_parameter_node(BaaAstSourceSpan span, const wchar_t *name, BaaNode *type_node)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_PARAMETER, span);
-    if (!node)
-    {
-        return NULL; // Allocation for BaaNode failed
-    }
-
     if (!type_node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Type node is required
+        return NULL; // Type node is required
     }
 
     // Validate that type_node is actually a type node
     if (type_node->kind != BAA_NODE_KIND_TYPE)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Type node must be a type node
+        return NULL; // Type node must be a type node
     }
 
-    BaaParameterData *data = (BaaParameterData *)baa_malloc(sizeof(BaaParameterData));
-    if (!data)
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_PARAMETER, span, sizeof(BaaParameterData));
+    if (!node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // Allocation for the node failed
     }
 
     // Initialize the data structure
-    data->name = baa_strdup(name); // Duplicate the parameter name
+    BaaParameterData *data = (BaaParameterData *)node->data;
+    data->name = baa_ast_copy_string(node, name); // Duplicate (or intern) the parameter name
     if (!data->name && name != NULL)
-    { // Check if baa_strdup failed for non-NULL input
-        baa_free(data);
+    { // Check if the copy failed for non-NULL input
         baa_ast_free_node(node);
         return NULL;
     }
 
     data->type_node = type_node; // Take ownership of the type node
 
-    node->data = data;
     return node;
 }
 
 // --- Function Definition Node Creation ---
 
-BaaNode *baa_ast_new_function_def_node(BaaAstSourceSpan span, const wchar_t *name,
-                                       BaaAstNodeModifiers modifiers, BaaNode *return_type_node,
-                                       BaaNode *body, bool is_variadic)
+// Allocates a function definition node; `body` may be NULL for a deferred body
+static BaaNode *new_function_def_node(BaaAstSourceSpan span, const wchar_t *name, BaaAstNodeModifiers modifiers,
+                                      BaaNode *return_type_node, BaaNode *body, bool is_variadic)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_FUNCTION_DEF, span);
-    if (!node)
+    // Validate that return_type_node is actually a type node
+    if (!return_type_node || return_type_node->kind != BAA_NODE_KIND_TYPE)
     {
-        return NULL; // Allocation for BaaNode failed
+        return NULL; // Return type node must be a type node
     }
 
-    if (!return_type_node || !body)
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_FUNCTION_DEF, span, sizeof(BaaFunctionDefData));
+    if (!node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Return type and body are required
+        return NULL; // Allocation for the node failed
     }
 
-    // Validate that return_type_node is actually a type node
-    if (return_type_node->kind != BAA_NODE_KIND_TYPE)
-    {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Return type node must be a type node
+    // Initialize the data structure (the parameters array starts empty)
+    BaaFunctionDefData *data = (BaaFunctionDefData *)node->data;
+    data->name = baa_ast_copy_string(node, name); // Duplicate (or intern) the function name
+    if (!data->name && name != NULL)
+    { // Check if the copy failed for non-NULL input
+        baa_ast_free_node(node);
+        return NULL;
     }
 
+    data->modifiers = modifiers;
+    data->return_type_node = return_type_node; // Take ownership of the return type node
+    data->body = body;                         // Take ownership of the body
+    data->is_variadic = is_variadic;
+
+    return node;
+}
+
+BaaNode *baa_ast_new_function_def_node(BaaAstSourceSpan span, const wchar_t *name,
+                                       BaaAstNodeModifiers modifiers, BaaNode *return_type_node,
+                                       BaaNode *body, bool is_variadic)
+{
     // Validate that body is actually a block statement
-    if (body->kind != BAA_NODE_KIND_BLOCK_STMT)
+    if (!body || body->kind != BAA_NODE_KIND_BLOCK_STMT)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Body must be a block statement
+        return NULL; // Body must be a block statement
     }
 
-    BaaFunctionDefData *data = (BaaFunctionDefData *)baa_malloc(sizeof(BaaFunctionDefData));
-    if (!data)
+    return new_function_def_node(span, name, modifiers, return_type_node, body, is_variadic);
+}
+
+BaaNode *baa_ast_new_deferred_function_def_node(BaaAstSourceSpan span, const wchar_t *name,
+                                                BaaAstNodeModifiers modifiers, BaaNode *return_type_node,
+                                                size_t body_start_offset, size_t body_end_offset,
+                                                bool is_variadic)
+{
+    if (body_end_offset <= body_start_offset)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // A body spans at least its braces
     }
 
-    // Initialize the data structure
-    data->name = baa_strdup(name); // Duplicate the function name
-    if (!data->name && name != NULL)
-    { // Check if baa_strdup failed for non-NULL input
-        baa_free(data);
-        baa_ast_free_node(node);
+    BaaNode *node = new_function_def_node(span, name, modifiers, return_type_node, NULL, is_variadic);
+    if (!node)
+    {
         return NULL;
     }
 
-    data->modifiers = modifiers;
-    data->return_type_node = return_type_node; // Take ownership of the return type node
-    data->parameters = NULL;                   // Initialize empty parameters array
-    data->parameter_count = 0;
-    data->parameter_capacity = 0;
-    data->body = body;                         // Take ownership of the body
-    data->is_variadic = is_variadic;
+    BaaFunctionDefData *data = (BaaFunctionDefData *)node->data;
+    data->body_deferred = true;
+    data->body_start_offset = body_start_offset;
+    data->body_end_offset = body_end_offset;
 
-    node->data = data;
     return node;
 }
 
@@ -178,16 +173,10 @@ bool baa_ast_add_function_parameter(BaaNode *function_def_node, BaaNode *paramet
     }
 
     // Check if we need to resize the parameters array
-    if (data->parameter_count >= data->parameter_capacity)
+    if (data->parameter_count >= data->parameter_capacity &&
+        !baa_ast_grow_children(function_def_node, &data->parameters, &data->parameter_capacity))
     {
-        size_t new_capacity = (data->parameter_capacity == 0) ? 4 : data->parameter_capacity * 2;
-        BaaNode **new_parameters = (BaaNode **)baa_realloc(data->parameters, new_capacity * sizeof(BaaNode *));
-        if (!new_parameters)
-        {
-            return false; // Memory allocation failed
-        }
-        data->parameters = new_parameters;
-        data->parameter_capacity = new_capacity;
+        return false; // Memory allocation failed
     }
 
     // Add the parameter to the array
@@ -197,6 +186,31 @@ bool baa_ast_add_function_parameter(BaaNode *function_def_node, BaaNode *paramet
     return true;
 }
 
+bool baa_ast_function_set_body(BaaNode *function_def_node, BaaNode *body)
+{
+    if (!function_def_node || function_def_node->kind != BAA_NODE_KIND_FUNCTION_DEF ||
+        !body || body->kind != BAA_NODE_KIND_BLOCK_STMT)
+    {
+        return false;
+    }
+
+    BaaFunctionDefData *data = (BaaFunctionDefData *)function_def_node->data;
+    if (!data->body_deferred)
+    {
+        return false; // The function already has its body
+    }
+
+    // A body in another allocation domain would be freed with the wrong owner
+    if (body->arena != function_def_node->arena)
+    {
+        return false;
+    }
+
+    data->body = body;
+    data->body_deferred = false;
+    return true;
+}
+
 // --- Variable Declaration Node Data Freeing ---
 
 void baa_ast_free_var_decl_data(BaaVarDeclData *data)
@@ -211,20 +225,6 @@ void baa_ast_free_var_decl_data(BaaVarDeclData *data)
     {
         baa_free(data->name);
     }
-
-    // Recursively free the type node
-    if (data->type_node)
-    {
-        baa_ast_free_node(data->type_node);
-    }
-
-    // Recursively free the initializer expression (if present)
-    if (data->initializer_expr)
-    {
-        baa_ast_free_node(data->initializer_expr);
-    }
-
-    baa_free(data); // Free the BaaVarDeclData struct itself
 }
 
 // --- Parameter Node Data Freeing ---
@@ -241,15 +241,6 @@ void baa_ast_free_parameter_data(BaaParameterData *data)
     {
         baa_free(data->name);
     }
-
-    // Recursively free the type node
-    if (data->type_node)
-    {
-        baa_ast_free_node(data->type_node);
-    }
-
-    // Free the data structure itself
-    baa_free(data);
 }
 
 // --- Function Definition Node Data Freeing ---
@@ -267,31 +258,5 @@ void baa_ast_free_function_def_data(BaaFunctionDefData *data)
         baa_free(data->name);
     }
 
-    // Recursively free the return type node
-    if (data->return_type_node)
-    {
-        baa_ast_free_node(data->return_type_node);
-    }
-
-    // Recursively free all parameter nodes
-    if (data->parameters)
-    {
-        for (size_t i = 0; i < data->parameter_count; i++)
-        {
-            if (data->parameters[i])
-            {
-                baa_ast_free_node(data->parameters[i]);
-            }
-        }
-        baa_free(data->parameters); // Free the parameters array itself
-    }
-
-    // Recursively free the function body
-    if (data->body)
-    {
-        baa_ast_free_node(data->body);
-    }
-
-    // Free the data structure itself
-    baa_free(data);
+    baa_free(data->parameters); // The elements were freed by the walk
 }
@@ -16,9 +16,7 @@
 
 /**
  * @brief Frees the data associated with a BAA_NODE_KIND_VAR_DECL_STMT.
- * Recursively frees the type_node and initializer_expr if they exist.
  * Frees the duplicated variable name.
- * Finally frees the BaaVarDeclData struct itself.
  *
  * @param data Pointer to the BaaVarDeclData to free. Must not be NULL.
  */
@@ -28,9 +26,7 @@ void baa_ast_free_var_decl_data(BaaVarDeclData *data);
 
 /**
  * @brief Frees the data associated with a BAA_NODE_KIND_PARAMETER.
- * Recursively frees the type_node if it exists.
  * Frees the duplicated parameter name.
- * Finally frees the BaaParameterData struct itself.
  *
  * @param data Pointer to the BaaParameterData to free. Must not be NULL.
  */
@@ -40,9 +36,8 @@ void baa_ast_free_parameter_data(BaaParameterData *data);
 
 /**
  * @brief Frees the data associated with a BAA_NODE_KIND_FUNCTION_DEF.
- * Recursively frees the return_type_node, all parameter nodes, and body if they exist.
- * Frees the duplicated function name and parameters array.
- * Finally frees the BaaFunctionDefData struct itself.
+ * Frees the duplicated function name and the parameters array. The child
+ * nodes are freed by baa_ast_free_node's walk.
  *
  * @param data Pointer to the BaaFunctionDefData to free. Must not be NULL.
  */
@@ -2,6 +2,7 @@
 #include "baa/ast/ast.h"       // For BaaNode, BaaAstSourceSpan, specific node creation prototypes
 #include "baa/ast/ast_types.h" // For BaaNodeKind, BaaLiteralExprData, BaaLiteralKind
 #include "ast_expressions.h"   // For internal prototypes like baa_ast_free_literal_expr_data
+#include "ast_alloc.h"         // For baa_ast_alloc_node, baa_ast_copy_string, baa_ast_grow_children
 
 #include "baa/utils/utils.h" // For baa_malloc, baa_free, baa_strdup
 #include "baa/types/types.h" // For BaaType (used as non-owned pointer)
@@ -13,55 +14,40 @@
 
 BaaNode *baa_ast_new_literal_int_node(BaaAstSourceSpan span, long long value, BaaType *type)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_LITERAL_EXPR, span);
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_LITERAL_EXPR, span, sizeof(BaaLiteralExprData));
     if (!node)
     {
-        return NULL; // Allocation for BaaNode failed
-    }
-
-    BaaLiteralExprData *data = (BaaLiteralExprData *)baa_malloc(sizeof(BaaLiteralExprData));
-    if (!data)
-    {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // Allocation for the node failed
     }
 
+    BaaLiteralExprData *data = (BaaLiteralExprData *)node->data;
     data->literal_kind = BAA_LITERAL_KIND_INT;
     data->value.int_value = value;
     data->determined_type = type; // Store the canonical type
     // data->original_lexeme = NULL; // If we add this field
 
-    node->data = data;
     return node;
 }
 
 BaaNode *baa_ast_new_literal_string_node(BaaAstSourceSpan span, const wchar_t *value, BaaType *type)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_LITERAL_EXPR, span);
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_LITERAL_EXPR, span, sizeof(BaaLiteralExprData));
     if (!node)
     {
         return NULL;
     }
 
-    BaaLiteralExprData *data = (BaaLiteralExprData *)baa_malloc(sizeof(BaaLiteralExprData));
-    if (!data)
-    {
-        baa_ast_free_node(node);
-        return NULL;
-    }
-
+    BaaLiteralExprData *data = (BaaLiteralExprData *)node->data;
     data->literal_kind = BAA_LITERAL_KIND_STRING;
-    data->value.string_value = baa_strdup(value); // Duplicate the string
+    data->value.string_value = baa_ast_copy_string(node, value); // Duplicate (or intern) the string
     if (!data->value.string_value && value != NULL)
-    { // Check if baa_strdup failed for non-NULL input
-        baa_free(data);
+    { // Check if the copy failed for non-NULL input
         baa_ast_free_node(node);
         return NULL;
     }
     data->determined_type = type;
     // data->original_lexeme = NULL;
 
-    node->data = data;
     return node;
 }
 
@@ -71,28 +57,20 @@ BaaNode *baa_ast_new_literal_string_node(BaaAstSourceSpan span, const wchar_t *v
 
 BaaNode *baa_ast_new_identifier_expr_node(BaaAstSourceSpan span, const wchar_t *name)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_IDENTIFIER_EXPR, span);
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_IDENTIFIER_EXPR, span, sizeof(BaaIdentifierExprData));
     if (!node)
     {
-        return NULL; // Allocation for BaaNode failed
+        return NULL; // Allocation for the node failed
     }
 
-    BaaIdentifierExprData *data = (BaaIdentifierExprData *)baa_malloc(sizeof(BaaIdentifierExprData));
-    if (!data)
-    {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
-    }
-
-    data->name = baa_strdup(name); // Duplicate the identifier name
+    BaaIdentifierExprData *data = (BaaIdentifierExprData *)node->data;
+    data->name = baa_ast_copy_string(node, name); // Duplicate (or intern) the identifier name
     if (!data->name && name != NULL)
-    { // Check if baa_strdup failed for non-NULL input
-        baa_free(data);
+    { // Check if the copy failed for non-NULL input
         baa_ast_free_node(node);
         return NULL;
     }
 
-    node->data = data;
     return node;
 }
 
@@ -100,30 +78,22 @@ BaaNode *baa_ast_new_identifier_expr_node(BaaAstSourceSpan span, const wchar_t *
 
 BaaNode *baa_ast_new_binary_expr_node(BaaAstSourceSpan span, BaaNode *left_operand, BaaNode *right_operand, BaaBinaryOperatorKind operator_kind)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_BINARY_EXPR, span);
-    if (!node)
-    {
-        return NULL; // Allocation for BaaNode failed
-    }
-
     if (!left_operand || !right_operand)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Invalid operands
+        return NULL; // Invalid operands
     }
 
-    BaaBinaryExprData *data = (BaaBinaryExprData *)baa_malloc(sizeof(BaaBinaryExprData));
-    if (!data)
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_BINARY_EXPR, span, sizeof(BaaBinaryExprData));
+    if (!node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // Allocation for the node failed
     }
 
+    BaaBinaryExprData *data = (BaaBinaryExprData *)node->data;
     data->left_operand = left_operand;
     data->right_operand = right_operand;
     data->operator_kind = operator_kind;
 
-    node->data = data;
     return node;
 }
 
@@ -131,29 +101,21 @@ BaaNode *baa_ast_new_binary_expr_node(BaaAstSourceSpan span, BaaNode *left_opera
 
 BaaNode *baa_ast_new_unary_expr_node(BaaAstSourceSpan span, BaaNode *operand, BaaUnaryOperatorKind operator_kind)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_UNARY_EXPR, span);
-    if (!node)
-    {
-        return NULL; // Allocation for BaaNode failed
-    }
-
     if (!operand)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Invalid operand
+        return NULL; // Invalid operand
     }
 
-    BaaUnaryExprData *data = (BaaUnaryExprData *)baa_malloc(sizeof(BaaUnaryExprData));
-    if (!data)
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_UNARY_EXPR, span, sizeof(BaaUnaryExprData));
+    if (!node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // Allocation for the node failed
     }
 
+    BaaUnaryExprData *data = (BaaUnaryExprData *)node->data;
     data->operand = operand;
     data->operator_kind = operator_kind;
 
-    node->data = data;
     return node;
 }
 
@@ -161,32 +123,21 @@ BaaNode *baa_ast_new_unary_expr_node(BaaAstSourceSpan span, BaaNode *operand, Ba
 
 BaaNode *baa_ast_new_call_expr_node(BaaAstSourceSpan span, BaaNode *callee_expr)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_CALL_EXPR, span);
-    if (!node)
-    {
-        return NULL; // Allocation for BaaNode failed
-    }
-
     if (!callee_expr)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Callee expression is required
+        return NULL; // Callee expression is required
     }
 
-    BaaCallExprData *data = (BaaCallExprData *)baa_malloc(sizeof(BaaCallExprData));
-    if (!data)
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_CALL_EXPR, span, sizeof(BaaCallExprData));
+    if (!node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // Allocation for the node failed
     }
 
-    // Initialize the data structure
+    // The arguments array starts empty (zeroed)
+    BaaCallExprData *data = (BaaCallExprData *)node->data;
     data->callee_expr = callee_expr; // Take ownership of the callee expression
-    data->arguments = NULL;          // Initialize empty arguments array
-    data->argument_count = 0;
-    data->argument_capacity = 0;
 
-    node->data = data;
     return node;
 }
 
@@ -212,16 +163,10 @@ bool baa_ast_add_call_argument(BaaNode *call_expr_node, BaaNode *argument_node)
     }
 
     // Check if we need to resize the arguments array
-    if (data->argument_count >= data->argument_capacity)
+    if (data->argument_count >= data->argument_capacity &&
+        !baa_ast_grow_children(call_expr_node, &data->arguments, &data->argument_capacity))
     {
-        size_t new_capacity = (data->argument_capacity == 0) ? 4 : data->argument_capacity * 2;
-        BaaNode **new_arguments = (BaaNode **)baa_realloc(data->arguments, new_capacity * sizeof(BaaNode *));
-        if (!new_arguments)
-        {
-            return false; // Memory allocation failed
-        }
-        data->arguments = new_arguments;
-        data->argument_capacity = new_capacity;
+        return false; // Memory allocation failed
     }
 
     // Add the argument to the array
@@ -251,8 +196,6 @@ void baa_ast_free_literal_expr_data(BaaLiteralExprData *data)
     // }
 
     // Note: data->determined_type is a non-owned pointer to a canonical type, so we don't free it here.
-
-    baa_free(data); // Free the BaaLiteralExprData struct itself
 }
 
 // --- Identifier Expression Node Data Freeing ---
@@ -268,49 +211,6 @@ void baa_ast_free_identifier_expr_data(BaaIdentifierExprData *data)
     {
         baa_free(data->name); // Free the duplicated identifier name
     }
-
-    baa_free(data); // Free the BaaIdentifierExprData struct itself
-}
-
-// --- Binary Expression Node Data Freeing ---
-
-void baa_ast_free_binary_expr_data(BaaBinaryExprData *data)
-{
-    if (!data)
-    {
-        return;
-    }
-
-    // Recursively free the operands
-    if (data->left_operand)
-    {
-        baa_ast_free_node(data->left_operand);
-    }
-
-    if (data->right_operand)
-    {
-        baa_ast_free_node(data->right_operand);
-    }
-
-    baa_free(data); // Free the BaaBinaryExprData struct itself
-}
-
-// --- Unary Expression Node Data Freeing ---
-
-void baa_ast_free_unary_expr_data(BaaUnaryExprData *data)
-{
-    if (!data)
-    {
-        return;
-    }
-
-    // Recursively free the operand
-    if (data->operand)
-    {
-        baa_ast_free_node(data->operand);
-    }
-
-    baa_free(data); // Free the BaaUnaryExprData struct itself
 }
 
 // --- Call Expression Node Data Freeing ---
@@ -322,25 +222,5 @@ void baa_ast_free_call_expr_data(BaaCallExprData *data)
         return;
     }
 
-    // Recursively free the callee expression
-    if (data->callee_expr)
-    {
-        baa_ast_free_node(data->callee_expr);
-    }
-
-    // Recursively free all argument expressions
-    if (data->arguments)
-    {
-        for (size_t i = 0; i < data->argument_count; i++)
-        {
-            if (data->arguments[i])
-            {
-                baa_ast_free_node(data->arguments[i]);
-            }
-        }
-        baa_free(data->arguments); // Free the arguments array itself
-    }
-
-    // Free the data structure itself
-    baa_free(data);
+    baa_free(data->arguments); // The elements were freed by the walk
 }
@@ -6,7 +6,6 @@
 /**
  * @brief Frees the data associated with a BAA_NODE_KIND_LITERAL_EXPR.
  * Specifically, it frees the duplicated string if the literal is a string.
- * It then frees the BaaLiteralExprData struct itself.
  *
  * @param data Pointer to the BaaLiteralExprData to free. Must not be NULL.
  */
@@ -15,34 +14,15 @@ void baa_ast_free_literal_expr_data(BaaLiteralExprData *data);
 /**
  * @brief Frees the data associated with a BAA_NODE_KIND_IDENTIFIER_EXPR.
  * Specifically, it frees the duplicated identifier name.
- * It then frees the BaaIdentifierExprData struct itself.
  *
  * @param data Pointer to the BaaIdentifierExprData to free. Must not be NULL.
  */
 void baa_ast_free_identifier_expr_data(BaaIdentifierExprData *data);
 
-/**
- * @brief Frees the data associated with a BAA_NODE_KIND_BINARY_EXPR.
- * Recursively frees the left and right operands.
- * It then frees the BaaBinaryExprData struct itself.
- *
- * @param data Pointer to the BaaBinaryExprData to free. Must not be NULL.
- */
-void baa_ast_free_binary_expr_data(BaaBinaryExprData *data);
-
-/**
- * @brief Frees the data associated with a BAA_NODE_KIND_UNARY_EXPR.
- * Recursively frees the operand.
- * It then frees the BaaUnaryExprData struct itself.
- *
- * @param data Pointer to the BaaUnaryExprData to free. Must not be NULL.
- */
-void baa_ast_free_unary_expr_data(BaaUnaryExprData *data);
-
 /**
  * @brief Frees the data associated with a BAA_NODE_KIND_CALL_EXPR.
- * Recursively frees the callee expression and all argument expressions.
- * Frees the arguments array and the BaaCallExprData struct itself.
+ * Frees the arguments array; the callee and argument nodes are freed by
+ * baa_ast_free_node's walk.
  *
  * @param data Pointer to the BaaCallExprData to free. Must not be NULL.
  */
@@ -0,0 +1,832 @@
+// src/ast/ast_flat.c
+#include "baa/ast/ast_flat.h"
+#include "baa/ast/ast.h"     // For the node constructors, baa_ast_free_node and baa_ast_child
+#include "ast_alloc.h"       // For baa_ast_alloc_node, baa_ast_copy_string
+#include "baa/utils/utils.h" // For baa_malloc, baa_realloc, baa_free
+#include <stdint.h>
+#include <string.h>
+
+#define FLAT_STRING_TABLE_INITIAL 256 // Slots of the builder's string table (power of two)
+#define FLAT_MAX_FILES UINT16_MAX     // File indices are 16-bit
+
+// --- Building (tree to flat) ---
+
+typedef struct
+{
+    BaaFlatAst *ast;
+
+    uint32_t *string_table;     // Open-addressing table of string offsets (BAA_FLAT_NONE = empty)
+    size_t string_table_size;   // Slots (power of two)
+    size_t string_table_count;  // Strings stored
+
+    const wchar_t *last_filename; // Most recently seen filename pointer
+    uint16_t last_file;           // Its file index
+    bool has_last_file;
+
+    BaaFlatIndex *values;    // Flat indices of visited nodes not yet consumed by their parent
+    size_t value_count;
+    size_t value_capacity;
+    BaaFlatIndex *slots;     // Scratch: child slots of the node being emitted
+    size_t slot_capacity;
+} BaaFlatBuilder;
+
+static bool grow_array(void **array, size_t *capacity, size_t needed, size_t element_size)
+{
+    if (needed <= *capacity)
+    {
+        return true;
+    }
+    size_t new_capacity = *capacity ? *capacity : 64;
+    while (new_capacity < needed)
+    {
+        new_capacity *= 2;
+    }
+    void *grown = baa_realloc(*array, new_capacity * element_size);
+    if (!grown)
+    {
+        return false;
+    }
+    *array = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+// FNV-1a over the characters
+static uint32_t flat_hash(const wchar_t *str, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (uint32_t)str[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool string_table_grow(BaaFlatBuilder *builder)
+{
+    size_t size = builder->string_table_size ? builder->string_table_size * 2 : FLAT_STRING_TABLE_INITIAL;
+    uint32_t *table = (uint32_t *)baa_malloc(size * sizeof(uint32_t));
+    if (!table)
+    {
+        return false;
+    }
+    memset(table, 0xFF, size * sizeof(uint32_t)); // All slots BAA_FLAT_NONE
+
+    for (size_t i = 0; i < builder->string_table_size; i++)
+    {
+        uint32_t offset = builder->string_table[i];
+        if (offset == BAA_FLAT_NONE)
+        {
+            continue;
+        }
+        const wchar_t *str = builder->ast->strings + offset;
+        size_t slot = flat_hash(str, wcslen(str)) & (size - 1);
+        while (table[slot] != BAA_FLAT_NONE)
+        {
+            slot = (slot + 1) & (size - 1);
+        }
+        table[slot] = offset;
+    }
+
+    baa_free(builder->string_table);
+    builder->string_table = table;
+    builder->string_table_size = size;
+    return true;
+}
+
+// Stores a string once and returns its offset (BAA_FLAT_NONE for NULL, or on failure with *ok cleared)
+static uint32_t flat_add_string(BaaFlatBuilder *builder, const wchar_t *str, bool *ok)
+{
+    if (!str)
+    {
+        return BAA_FLAT_NONE;
+    }
+    if ((builder->string_table_count + 1) * 4 > builder->string_table_size * 3 && !string_table_grow(builder))
+    {
+        *ok = false;
+        return BAA_FLAT_NONE;
+    }
+
+    BaaFlatAst *ast = builder->ast;
+    size_t length = wcslen(str);
+    size_t mask = builder->string_table_size - 1;
+    size_t slot = flat_hash(str, length) & mask;
+    while (builder->string_table[slot] != BAA_FLAT_NONE)
+    {
+        const wchar_t *existing = ast->strings + builder->string_table[slot];
+        if (wcscmp(existing, str) == 0)
+        {
+            return builder->string_table[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    if (ast->strings_length + length + 1 >= BAA_FLAT_NONE ||
+        !grow_array((void **)&ast->strings, &ast->strings_capacity, ast->strings_length + length + 1, sizeof(wchar_t)))
+    {
+        *ok = false;
+        return BAA_FLAT_NONE;
+    }
+    uint32_t offset = (uint32_t)ast->strings_length;
+    wmemcpy(ast->strings + offset, str, length + 1);
+    ast->strings_length += length + 1;
+
+    builder->string_table[slot] = offset;
+    builder->string_table_count++;
+    return offset;
+}
+
+static uint16_t flat_add_file(BaaFlatBuilder *builder, const wchar_t *filename, bool *ok)
+{
+    if (builder->has_last_file && builder->last_filename == filename)
+    {
+        return builder->last_file;
+    }
+
+    BaaFlatAst *ast = builder->ast;
+    uint32_t offset = flat_add_string(builder, filename, ok);
+    size_t index = 0;
+    while (index < ast->file_count && ast->files[index] != offset)
+    {
+        index++;
+    }
+    if (index == ast->file_count)
+    {
+        size_t capacity = ast->file_count; // Grown one entry at a time; files are few
+        if (ast->file_count >= FLAT_MAX_FILES || !grow_array((void **)&ast->files, &capacity, ast->file_count + 1, sizeof(uint32_t)))
+        {
+            *ok = false;
+            return 0;
+        }
+        ast->files[ast->file_count++] = offset;
+    }
+
+    builder->last_filename = filename;
+    builder->last_file = (uint16_t)index;
+    builder->has_last_file = true;
+    return (uint16_t)index;
+}
+
+static uint32_t flat_add_type(BaaFlatAst *ast, BaaType *type, bool *ok)
+{
+    if (!type)
+    {
+        return BAA_FLAT_NONE;
+    }
+    for (size_t i = 0; i < ast->type_count; i++)
+    {
+        if (ast->types[i] == type)
+        {
+            return (uint32_t)i;
+        }
+    }
+    size_t capacity = ast->type_count;
+    if (!grow_array((void **)&ast->types, &capacity, ast->type_count + 1, sizeof(BaaType *)))
+    {
+        *ok = false;
+        return BAA_FLAT_NONE;
+    }
+    ast->types[ast->type_count] = type;
+    return (uint32_t)ast->type_count++;
+}
+
+// Reserves `count` words of extra data and returns the index of the first
+static uint32_t flat_reserve_extra(BaaFlatAst *ast, size_t count, bool *ok)
+{
+    if (ast->extra_count + count >= BAA_FLAT_NONE ||
+        !grow_array((void **)&ast->extra_data, &ast->extra_capacity, ast->extra_count + count, sizeof(uint32_t)))
+    {
+        *ok = false;
+        return BAA_FLAT_NONE;
+    }
+    uint32_t start = (uint32_t)ast->extra_count;
+    ast->extra_count += count;
+    return start;
+}
+
+// Makes room for one more node and its span
+static bool flat_reserve_node(BaaFlatAst *ast)
+{
+    if (ast->node_count < ast->node_capacity)
+    {
+        return true;
+    }
+    size_t capacity = ast->node_capacity ? ast->node_capacity * 2 : 64;
+    BaaFlatNode *nodes = (BaaFlatNode *)baa_realloc(ast->nodes, capacity * sizeof(BaaFlatNode));
+    if (!nodes)
+    {
+        return false;
+    }
+    ast->nodes = nodes;
+    BaaFlatSpan *spans = (BaaFlatSpan *)baa_realloc(ast->spans, capacity * sizeof(BaaFlatSpan));
+    if (!spans)
+    {
+        return false;
+    }
+    ast->spans = spans;
+    ast->node_capacity = capacity;
+    return true;
+}
+
+// Appends the flat form of `node`, whose child slots were already emitted as `children`
+static BaaFlatIndex flat_emit(BaaFlatBuilder *builder, const BaaNode *node, const BaaFlatIndex *children,
+                              size_t child_count)
+{
+    BaaFlatAst *ast = builder->ast;
+    bool ok = true;
+
+    if (ast->node_count >= BAA_FLAT_NONE || !flat_reserve_node(ast))
+    {
+        return BAA_FLAT_NONE;
+    }
+
+    BaaFlatNode flat = {(uint8_t)node->kind, 0, 0, BAA_FLAT_NONE, BAA_FLAT_NONE};
+    flat.file = flat_add_file(builder, node->span.start.filename, &ok);
+    uint32_t *extra;
+    uint32_t start;
+
+    switch (node->kind)
+    {
+    case BAA_NODE_KIND_PROGRAM:
+    case BAA_NODE_KIND_BLOCK_STMT:
+        start = flat_reserve_extra(ast, child_count, &ok);
+        if (ok)
+        {
+            memcpy(ast->extra_data + start, children, child_count * sizeof(BaaFlatIndex));
+            flat.lhs = start;
+            flat.rhs = (uint32_t)child_count;
+        }
+        break;
+    case BAA_NODE_KIND_PARAMETER:
+        flat.lhs = flat_add_string(builder, ((const BaaParameterData *)node->data)->name, &ok);
+        flat.rhs = children[0];
+        break;
+    case BAA_NODE_KIND_FUNCTION_DEF:
+    {
+        const BaaFunctionDefData *data = node->data;
+        size_t parameter_count = child_count - 2;
+        uint32_t name = flat_add_string(builder, data->name, &ok);
+        start = flat_reserve_extra(ast, 4 + parameter_count + (data->body_deferred ? 2 : 0), &ok);
+        if (ok && data->body_deferred &&
+            (data->body_start_offset > UINT32_MAX || data->body_end_offset > UINT32_MAX))
+        {
+            ok = false;
+        }
+        if (ok)
+        {
+            extra = ast->extra_data + start;
+            extra[0] = name;
+            extra[1] = data->modifiers;
+            extra[2] = children[0];
+            extra[3] = (uint32_t)parameter_count;
+            memcpy(extra + 4, children + 1, parameter_count * sizeof(BaaFlatIndex));
+            flat.lhs = start;
+            flat.rhs = children[child_count - 1];
+            flat.tag = (uint8_t)((data->is_variadic ? 1 : 0) | (data->body_deferred ? 2 : 0));
+            if (data->body_deferred)
+            {
+                extra[4 + parameter_count] = (uint32_t)data->body_start_offset;
+                extra[5 + parameter_count] = (uint32_t)data->body_end_offset;
+            }
+        }
+        break;
+    }
+    case BAA_NODE_KIND_VAR_DECL_STMT:
+    {
+        const BaaVarDeclData *data = node->data;
+        uint32_t name = flat_add_string(builder, data->name, &ok);
+        start = flat_reserve_extra(ast, 3, &ok);
+        if (ok)
+        {
+            extra = ast->extra_data + start;
+            extra[0] = name;
+            extra[1] = data->modifiers;
+            extra[2] = children[0];
+            flat.lhs = start;
+            flat.rhs = children[1];
+        }
+        break;
+    }
+    case BAA_NODE_KIND_IF_STMT:
+        start = flat_reserve_extra(ast, 2, &ok);
+        if (ok)
+        {
+            ast->extra_data[start] = children[1];
+            ast->extra_data[start + 1] = children[2];
+            flat.lhs = children[0];
+            flat.rhs = start;
+        }
+        break;
+    case BAA_NODE_KIND_FOR_STMT:
+        start = flat_reserve_extra(ast, 3, &ok);
+        if (ok)
+        {
+            memcpy(ast->extra_data + start, children, 3 * sizeof(BaaFlatIndex));
+            flat.lhs = start;
+            flat.rhs = children[3];
+        }
+        break;
+    case BAA_NODE_KIND_EXPR_STMT:
+    case BAA_NODE_KIND_RETURN_STMT:
+        flat.lhs = children[0];
+        break;
+    case BAA_NODE_KIND_WHILE_STMT:
+        flat.lhs = children[0];
+        flat.rhs = children[1];
+        break;
+    case BAA_NODE_KIND_LITERAL_EXPR:
+    {
+        const BaaLiteralExprData *data = node->data;
+        flat.tag = (uint8_t)data->literal_kind;
+        flat.rhs = flat_add_type(ast, data->determined_type, &ok);
+        uint64_t bits = 0;
+        switch (data->literal_kind)
+        {
+        case BAA_LITERAL_KIND_BOOL:
+            flat.lhs = data->value.bool_value ? 1 : 0;
+            break;
+        case BAA_LITERAL_KIND_CHAR:
+            flat.lhs = (uint32_t)data->value.char_value;
+            break;
+        case BAA_LITERAL_KIND_STRING:
+            flat.lhs = flat_add_string(builder, data->value.string_value, &ok);
+            break;
+        case BAA_LITERAL_KIND_INT:
+        case BAA_LITERAL_KIND_FLOAT:
+            if (data->literal_kind == BAA_LITERAL_KIND_INT)
+                bits = (uint64_t)data->value.int_value;
+            else
+                memcpy(&bits, &data->value.float_value, sizeof(bits));
+            start = flat_reserve_extra(ast, 2, &ok);
+            if (ok)
+            {
+                ast->extra_data[start] = (uint32_t)bits;
+                ast->extra_data[start + 1] = (uint32_t)(bits >> 32);
+                flat.lhs = start;
+            }
+            break;
+        default:
+            break;
+        }
+        break;
+    }
+    case BAA_NODE_KIND_IDENTIFIER_EXPR:
+        flat.lhs = flat_add_string(builder, ((const BaaIdentifierExprData *)node->data)->name, &ok);
+        break;
+    case BAA_NODE_KIND_BINARY_EXPR:
+        flat.tag = (uint8_t)((const BaaBinaryExprData *)node->data)->operator_kind;
+        flat.lhs = children[0];
+        flat.rhs = children[1];
+        break;
+    case BAA_NODE_KIND_UNARY_EXPR:
+        flat.tag = (uint8_t)((const BaaUnaryExprData *)node->data)->operator_kind;
+        flat.lhs = children[0];
+        break;
+    case BAA_NODE_KIND_CALL_EXPR:
+        start = flat_reserve_extra(ast, child_count, &ok);
+        if (ok)
+        {
+            ast->extra_data[start] = (uint32_t)(child_count - 1);
+            memcpy(ast->extra_data + start + 1, children + 1, (child_count - 1) * sizeof(BaaFlatIndex));
+            flat.lhs = children[0];
+            flat.rhs = start;
+        }
+        break;
+    case BAA_NODE_KIND_TYPE:
+    {
+        const BaaTypeAstData *data = node->data;
+        flat.tag = (uint8_t)data->type_ast_kind;
+        if (data->type_ast_kind == BAA_TYPE_AST_KIND_PRIMITIVE)
+        {
+            flat.lhs = flat_add_string(builder, data->specifier.primitive.name, &ok);
+        }
+        else if (data->type_ast_kind == BAA_TYPE_AST_KIND_ARRAY)
+        {
+            flat.lhs = children[0];
+            flat.rhs = children[1];
+        }
+        break;
+    }
+    default:
+        break; // Nodes without data (break, continue, unknown)
+    }
+
+    if (!ok)
+    {
+        return BAA_FLAT_NONE;
+    }
+
+    BaaFlatIndex index = (BaaFlatIndex)ast->node_count++;
+    ast->nodes[index] = flat;
+    BaaFlatSpan *span = &ast->spans[index];
+    span->start_line = (uint32_t)node->span.start.line;
+    span->start_column = (uint32_t)node->span.start.column;
+    span->end_line = (uint32_t)node->span.end.line;
+    span->end_column = (uint32_t)node->span.end.column;
+    return index;
+}
+
+// Post-order callback: gathers the child slots (absent children are not visited) and emits the node
+static BaaAstVisitResult flat_leave(BaaNode *node, BaaNode *parent, size_t depth, void *user_data)
+{
+    (void)parent;
+    (void)depth;
+    BaaFlatBuilder *builder = (BaaFlatBuilder *)user_data;
+
+    size_t slot_count = baa_ast_child_count(node);
+    if (!grow_array((void **)&builder->slots, &builder->slot_capacity, slot_count, sizeof(BaaFlatIndex)))
+    {
+        return BAA_AST_VISIT_ABORT;
+    }
+    for (size_t i = slot_count; i-- > 0;)
+    {
+        builder->slots[i] = baa_ast_child(node, i) ? builder->values[--builder->value_count] : BAA_FLAT_NONE;
+    }
+
+    BaaFlatIndex index = flat_emit(builder, node, builder->slots, slot_count);
+    if (index == BAA_FLAT_NONE ||
+        !grow_array((void **)&builder->values, &builder->value_capacity, builder->value_count + 1, sizeof(BaaFlatIndex)))
+    {
+        return BAA_AST_VISIT_ABORT;
+    }
+    builder->values[builder->value_count++] = index;
+    return BAA_AST_VISIT_CONTINUE;
+}
+
+BaaFlatAst *baa_flat_ast_from_tree(const BaaNode *root)
+{
+    if (!root)
+    {
+        return NULL;
+    }
+
+    BaaFlatAst *ast = (BaaFlatAst *)baa_malloc(sizeof(BaaFlatAst));
+    if (!ast)
+    {
+        return NULL;
+    }
+    memset(ast, 0, sizeof(*ast));
+    ast->root = BAA_FLAT_NONE;
+
+    BaaFlatBuilder builder;
+    memset(&builder, 0, sizeof(builder));
+    builder.ast = ast;
+
+    // The walk only reads the tree
+    BaaAstVisitor visitor = {NULL, flat_leave, &builder};
+    bool ok = string_table_grow(&builder) && baa_ast_walk((BaaNode *)root, &visitor);
+
+    baa_free(builder.values);
+    baa_free(builder.slots);
+    baa_free(builder.string_table);
+    if (!ok)
+    {
+        baa_flat_ast_free(ast);
+        return NULL;
+    }
+    ast->root = (BaaFlatIndex)(ast->node_count - 1);
+    return ast;
+}
+
+// --- Rebuilding (flat to tree) ---
+
+typedef struct
+{
+    const BaaFlatAst *ast;
+    BaaNode **built;  // Tree node for each flat node
+    bool *unowned;    // Built but not yet attached to a parent
+} BaaFlatRebuild;
+
+static BaaNode *rebuild_child(BaaFlatRebuild *rebuild, BaaFlatIndex index)
+{
+    return index == BAA_FLAT_NONE ? NULL : rebuild->built[index];
+}
+
+// Marks children as attached once their parent holds them
+static void rebuild_adopt(BaaFlatRebuild *rebuild, BaaFlatIndex index)
+{
+    if (index != BAA_FLAT_NONE)
+    {
+        rebuild->unowned[index] = false;
+    }
+}
+
+// Creates the tree node for flat node `index` from its already rebuilt children
+static BaaNode *rebuild_node(BaaFlatRebuild *rebuild, BaaFlatIndex index)
+{
+    const BaaFlatAst *ast = rebuild->ast;
+    const BaaFlatNode *flat = &ast->nodes[index];
+    const uint32_t *extra;
+    BaaAstSourceSpan span = baa_flat_ast_span(ast, index);
+    BaaNode *node = NULL;
+
+    switch ((BaaNodeKind)flat->kind)
+    {
+    case BAA_NODE_KIND_PROGRAM:
+    case BAA_NODE_KIND_BLOCK_STMT:
+    {
+        bool is_program = flat->kind == BAA_NODE_KIND_PROGRAM;
+        node = is_program ? baa_ast_new_program_node(span) : baa_ast_new_block_stmt_node(span);
+        for (uint32_t i = 0; node && i < flat->rhs; i++)
+        {
+            BaaFlatIndex child = ast->extra_data[flat->lhs + i];
+            bool added = is_program ? baa_ast_add_declaration_to_program(node, rebuild_child(rebuild, child))
+                                    : baa_ast_add_stmt_to_block(node, rebuild_child(rebuild, child));
+            if (!added)
+            {
+                baa_ast_free_node(node);
+                return NULL;
+            }
+            rebuild_adopt(rebuild, child);
+        }
+        return node;
+    }
+    case BAA_NODE_KIND_PARAMETER:
+        node = baa_ast_new_parameter_node(span, baa_flat_ast_string(ast, flat->lhs), rebuild_child(rebuild, flat->rhs));
+        if (node)
+            rebuild_adopt(rebuild, flat->rhs);
+        return node;
+    case BAA_NODE_KIND_FUNCTION_DEF:
+        extra = ast->extra_data + flat->lhs;
+        if (flat->tag & 2)
+        {
+            node = baa_ast_new_deferred_function_def_node(span, baa_flat_ast_string(ast, extra[0]), extra[1],
+                                                          rebuild_child(rebuild, extra[2]), extra[4 + extra[3]],
+                                                          extra[5 + extra[3]], (flat->tag & 1) != 0);
+        }
+        else
+        {
+            node = baa_ast_new_function_def_node(span, baa_flat_ast_string(ast, extra[0]), extra[1],
+                                                 rebuild_child(rebuild, extra[2]), rebuild_child(rebuild, flat->rhs),
+                                                 (flat->tag & 1) != 0);
+        }
+        if (!node)
+            return NULL;
+        rebuild_adopt(rebuild, extra[2]);
+        rebuild_adopt(rebuild, flat->rhs);
+        for (uint32_t i = 0; i < extra[3]; i++)
+        {
+            if (!baa_ast_add_function_parameter(node, rebuild_child(rebuild, extra[4 + i])))
+            {
+                // The return type and body belong to the function now
+                baa_ast_free_node(node);
+                return NULL;
+            }
+            rebuild_adopt(rebuild, extra[4 + i]);
+        }
+        return node;
+    case BAA_NODE_KIND_EXPR_STMT:
+        node = baa_ast_new_expr_stmt_node(span, rebuild_child(rebuild, flat->lhs));
+        break;
+    case BAA_NODE_KIND_VAR_DECL_STMT:
+        extra = ast->extra_data + flat->lhs;
+        node = baa_ast_new_var_decl_node(span, baa_flat_ast_string(ast, extra[0]), extra[1],
+                                         rebuild_child(rebuild, extra[2]), rebuild_child(rebuild, flat->rhs));
+        if (node)
+        {
+            rebuild_adopt(rebuild, extra[2]);
+            rebuild_adopt(rebuild, flat->rhs);
+        }
+        return node;
+    case BAA_NODE_KIND_IF_STMT:
+        extra = ast->extra_data + flat->rhs;
+        node = baa_ast_new_if_stmt_node(span, rebuild_child(rebuild, flat->lhs), rebuild_child(rebuild, extra[0]),
+                                        rebuild_child(rebuild, extra[1]));
+        if (node)
+        {
+            rebuild_adopt(rebuild, flat->lhs);
+            rebuild_adopt(rebuild, extra[0]);
+            rebuild_adopt(rebuild, extra[1]);
+        }
+        return node;
+    case BAA_NODE_KIND_WHILE_STMT:
+        node = baa_ast_new_while_stmt_node(span, rebuild_child(rebuild, flat->lhs), rebuild_child(rebuild, flat->rhs));
+        break;
+    case BAA_NODE_KIND_FOR_STMT:
+        extra = ast->extra_data + flat->lhs;
+        node = baa_ast_new_for_stmt_node(span, rebuild_child(rebuild, extra[0]), rebuild_child(rebuild, extra[1]),
+                                         rebuild_child(rebuild, extra[2]), rebuild_child(rebuild, flat->rhs));
+        if (node)
+        {
+            for (int i = 0; i < 3; i++)
+                rebuild_adopt(rebuild, extra[i]);
+            rebuild_adopt(rebuild, flat->rhs);
+        }
+        return node;
+    case BAA_NODE_KIND_RETURN_STMT:
+        node = baa_ast_new_return_stmt_node(span, rebuild_child(rebuild, flat->lhs));
+        break;
+    case BAA_NODE_KIND_LITERAL_EXPR:
+    {
+        BaaType *type = flat->rhs == BAA_FLAT_NONE ? NULL : ast->types[flat->rhs];
+        if (flat->tag == BAA_LITERAL_KIND_INT)
+            return baa_ast_new_literal_int_node(span, baa_flat_ast_int_value(ast, index), type);
+        if (flat->tag == BAA_LITERAL_KIND_STRING)
+            return baa_ast_new_literal_string_node(span, baa_flat_ast_string(ast, flat->lhs), type);
+
+        // Literal kinds without a dedicated constructor
+        node = baa_ast_alloc_node(BAA_NODE_KIND_LITERAL_EXPR, span, sizeof(BaaLiteralExprData));
+        if (!node)
+            return NULL;
+        BaaLiteralExprData *data = (BaaLiteralExprData *)node->data;
+        data->literal_kind = (BaaLiteralKind)flat->tag;
+        data->determined_type = type;
+        if (flat->tag == BAA_LITERAL_KIND_BOOL)
+            data->value.bool_value = flat->lhs != 0;
+        else if (flat->tag == BAA_LITERAL_KIND_CHAR)
+            data->value.char_value = (wchar_t)flat->lhs;
+        else if (flat->tag == BAA_LITERAL_KIND_FLOAT)
+        {
+            uint64_t bits = (uint64_t)ast->extra_data[flat->lhs] | ((uint64_t)ast->extra_data[flat->lhs + 1] << 32);
+            memcpy(&data->value.float_value, &bits, sizeof(bits));
+        }
+        return node;
+    }
+    case BAA_NODE_KIND_IDENTIFIER_EXPR:
+        return baa_ast_new_identifier_expr_node(span, baa_flat_ast_string(ast, flat->lhs));
+    case BAA_NODE_KIND_BINARY_EXPR:
+        node = baa_ast_new_binary_expr_node(span, rebuild_child(rebuild, flat->lhs), rebuild_child(rebuild, flat->rhs),
+                                            (BaaBinaryOperatorKind)flat->tag);
+        break;
+    case BAA_NODE_KIND_UNARY_EXPR:
+        node = baa_ast_new_unary_expr_node(span, rebuild_child(rebuild, flat->lhs), (BaaUnaryOperatorKind)flat->tag);
+        break;
+    case BAA_NODE_KIND_CALL_EXPR:
+        node = baa_ast_new_call_expr_node(span, rebuild_child(rebuild, flat->lhs));
+        if (!node)
+            return NULL;
+        rebuild_adopt(rebuild, flat->lhs);
+        extra = ast->extra_data + flat->rhs;
+        for (uint32_t i = 0; i < extra[0]; i++)
+        {
+            if (!baa_ast_add_call_argument(node, rebuild_child(rebuild, extra[1 + i])))
+            {
+                baa_ast_free_node(node);
+                return NULL;
+            }
+            rebuild_adopt(rebuild, extra[1 + i]);
+        }
+        return node;
+    case BAA_NODE_KIND_TYPE:
+        if (flat->tag == BAA_TYPE_AST_KIND_PRIMITIVE)
+            return baa_ast_new_primitive_type_node(span, baa_flat_ast_string(ast, flat->lhs));
+        if (flat->tag == BAA_TYPE_AST_KIND_ARRAY)
+        {
+            node = baa_ast_new_array_type_node(span, rebuild_child(rebuild, flat->lhs), rebuild_child(rebuild, flat->rhs));
+            break;
+        }
+        return baa_ast_new_node(BAA_NODE_KIND_TYPE, span);
+    default:
+        return baa_ast_new_node((BaaNodeKind)flat->kind, span);
+    }
+
+    // Kinds whose children are the lhs and rhs operands
+    if (node)
+    {
+        rebuild_adopt(rebuild, flat->lhs);
+        rebuild_adopt(rebuild, flat->rhs);
+    }
+    return node;
+}
+
+BaaNode *baa_flat_ast_to_tree(const BaaFlatAst *ast)
+{
+    if (!ast || ast->node_count == 0)
+    {
+        return NULL;
+    }
+
+    BaaFlatRebuild rebuild;
+    rebuild.ast = ast;
+    rebuild.built = (BaaNode **)baa_malloc(ast->node_count * sizeof(BaaNode *));
+    rebuild.unowned = (bool *)baa_malloc(ast->node_count * sizeof(bool));
+    if (!rebuild.built || !rebuild.unowned)
+    {
+        baa_free(rebuild.built);
+        baa_free(rebuild.unowned);
+        return NULL;
+    }
+
+    // Post-order: every child is built before its parent
+    size_t built_count = 0;
+    for (; built_count < ast->node_count; built_count++)
+    {
+        BaaNode *node = rebuild_node(&rebuild, (BaaFlatIndex)built_count);
+        if (!node)
+        {
+            break;
+        }
+        rebuild.built[built_count] = node;
+        rebuild.unowned[built_count] = true;
+    }
+
+    BaaNode *root = NULL;
+    if (built_count == ast->node_count)
+    {
+        root = rebuild.built[ast->root];
+    }
+    else
+    {
+        for (size_t i = 0; i < built_count; i++)
+        {
+            if (rebuild.unowned[i])
+            {
+                baa_ast_free_node(rebuild.built[i]);
+            }
+        }
+    }
+
+    baa_free(rebuild.built);
+    baa_free(rebuild.unowned);
+    return root;
+}
+
+// --- Access ---
+
+void baa_flat_ast_free(BaaFlatAst *ast)
+{
+    if (!ast)
+    {
+        return;
+    }
+    baa_free(ast->nodes);
+    baa_free(ast->spans);
+    baa_free(ast->extra_data);
+    baa_free(ast->strings);
+    baa_free(ast->files);
+    baa_free(ast->types);
+    baa_free(ast);
+}
+
+const wchar_t *baa_flat_ast_string(const BaaFlatAst *ast, uint32_t offset)
+{
+    if (!ast || offset == BAA_FLAT_NONE || offset >= ast->strings_length)
+    {
+        return NULL;
+    }
+    return ast->strings + offset;
+}
+
+BaaAstSourceSpan baa_flat_ast_span(const BaaFlatAst *ast, BaaFlatIndex index)
+{
+    BaaAstSourceSpan span;
+    memset(&span, 0, sizeof(span));
+    if (!ast || index >= ast->node_count)
+    {
+        return span;
+    }
+
+    const BaaFlatSpan *flat = &ast->spans[index];
+    const wchar_t *filename = baa_flat_ast_string(ast, ast->files[ast->nodes[index].file]);
+    span.start.filename = filename;
+    span.start.line = flat->start_line;
+    span.start.column = flat->start_column;
+    span.end.filename = filename;
+    span.end.line = flat->end_line;
+    span.end.column = flat->end_column;
+    return span;
+}
+
+long long baa_flat_ast_int_value(const BaaFlatAst *ast, BaaFlatIndex index)
+{
+    if (!ast || index >= ast->node_count)
+    {
+        return 0;
+    }
+    const BaaFlatNode *flat = &ast->nodes[index];
+    if (flat->kind != BAA_NODE_KIND_LITERAL_EXPR || flat->tag != BAA_LITERAL_KIND_INT)
+    {
+        return 0;
+    }
+    uint64_t bits = (uint64_t)ast->extra_data[flat->lhs] | ((uint64_t)ast->extra_data[flat->lhs + 1] << 32);
+    return (long long)bits;
+}
+
+bool baa_flat_ast_equal(const BaaFlatAst *a, const BaaFlatAst *b)
+{
+    if (!a || !b)
+    {
+        return a == b;
+    }
+    return a->node_count == b->node_count && a->extra_count == b->extra_count &&
+           a->strings_length == b->strings_length && a->file_count == b->file_count &&
+           a->type_count == b->type_count && a->root == b->root &&
+           (a->node_count == 0 || (memcmp(a->nodes, b->nodes, a->node_count * sizeof(BaaFlatNode)) == 0 &&
+                                   memcmp(a->spans, b->spans, a->node_count * sizeof(BaaFlatSpan)) == 0)) &&
+           (a->extra_count == 0 || memcmp(a->extra_data, b->extra_data, a->extra_count * sizeof(uint32_t)) == 0) &&
+           (a->strings_length == 0 || wmemcmp(a->strings, b->strings, a->strings_length) == 0) &&
+           (a->file_count == 0 || memcmp(a->files, b->files, a->file_count * sizeof(uint32_t)) == 0) &&
+           (a->type_count == 0 || memcmp(a->types, b->types, a->type_count * sizeof(BaaType *)) == 0);
+}
+
+size_t baa_flat_ast_memory_size(const BaaFlatAst *ast)
+{
+    if (!ast)
+    {
+        return 0;
+    }
+    return sizeof(BaaFlatAst) + ast->node_count * (sizeof(BaaFlatNode) + sizeof(BaaFlatSpan)) +
+           ast->extra_count * sizeof(uint32_t) + ast->strings_length * sizeof(wchar_t) +
+           ast->file_count * sizeof(uint32_t) + ast->type_count * sizeof(BaaType *);
+}
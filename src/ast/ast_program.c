@@ -2,6 +2,7 @@
 #include "baa/ast/ast.h"       // For BaaNode, BaaAstSourceSpan, specific node creation prototypes
 #include "baa/ast/ast_types.h" // For BaaNodeKind, BaaProgramData
 #include "ast_program.h"       // For internal prototypes like baa_ast_free_program_data
+#include "ast_alloc.h"         // For baa_ast_alloc_node, baa_ast_grow_children
 
 #include "baa/utils/utils.h" // For baa_malloc, baa_free
 
@@ -12,25 +13,13 @@
 
 BaaNode *baa_ast_new_program_node(BaaAstSourceSpan span)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_PROGRAM, span);
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_PROGRAM, span, sizeof(BaaProgramData));
     if (!node)
     {
-        return NULL; // Allocation for BaaNode failed
+        return NULL; // Allocation for the node failed
     }
 
-    BaaProgramData *data = (BaaProgramData *)baa_malloc(sizeof(BaaProgramData));
-    if (!data)
-    {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
-    }
-
-    // Initialize the dynamic array
-    data->top_level_declarations = NULL;
-    data->count = 0;
-    data->capacity = 0;
-
-    node->data = data;
+    // The zeroed data is an empty declarations array without an arena
     return node;
 }
 
@@ -59,20 +48,10 @@ bool baa_ast_add_declaration_to_program(BaaNode *program_node, BaaNode *declarat
     BaaProgramData *data = (BaaProgramData *)program_node->data;
 
     // Check if we need to resize the array
-    if (data->count >= data->capacity)
+    if (data->count >= data->capacity &&
+        !baa_ast_grow_children(program_node, &data->top_level_declarations, &data->capacity))
     {
-        size_t new_capacity = data->capacity == 0 ? 4 : data->capacity * 2;
-        BaaNode **new_declarations = (BaaNode **)baa_realloc(
-            data->top_level_declarations,
-            new_capacity * sizeof(BaaNode *)
-        );
-        if (!new_declarations)
-        {
-            return false; // Memory allocation failed
-        }
-
-        data->top_level_declarations = new_declarations;
-        data->capacity = new_capacity;
+        return false; // Memory allocation failed
     }
 
     // Add the declaration
@@ -82,6 +61,23 @@ bool baa_ast_add_declaration_to_program(BaaNode *program_node, BaaNode *declarat
     return true;
 }
 
+bool baa_ast_program_adopt_arena(BaaNode *program_node, BaaAstArena *arena)
+{
+    if (!program_node || program_node->kind != BAA_NODE_KIND_PROGRAM || !program_node->data ||
+        program_node->arena || !arena)
+    {
+        return false; // The program must be a heap node to outlive the arena
+    }
+
+    BaaProgramData *data = (BaaProgramData *)program_node->data;
+    if (data->owned_arena)
+    {
+        return false;
+    }
+    data->owned_arena = arena;
+    return true;
+}
+
 // --- Program Node Data Freeing ---
 
 void baa_ast_free_program_data(BaaProgramData *data)
@@ -91,19 +87,13 @@ void baa_ast_free_program_data(BaaProgramData *data)
         return;
     }
 
-    // Recursively free all top-level declarations
-    if (data->top_level_declarations)
+    if (data->owned_arena)
     {
-        for (size_t i = 0; i < data->count; i++)
-        {
-            if (data->top_level_declarations[i])
-            {
-                baa_ast_free_node(data->top_level_declarations[i]);
-            }
-        }
-        baa_free(data->top_level_declarations);
+        // Every declaration lives in the arena: release them in one go
+        baa_ast_arena_destroy(data->owned_arena);
+        data->owned_arena = NULL;
     }
 
-    // Free the BaaProgramData struct itself
-    baa_free(data);
+    // The declarations array belongs to the (heap) program node
+    baa_free(data->top_level_declarations);
 }
@@ -5,7 +5,9 @@
 
 /**
  * @brief Frees the data associated with a BAA_NODE_KIND_PROGRAM.
- * Recursively frees all top-level declarations and then frees the BaaProgramData struct itself.
+ * Destroys the owned arena if there is one (releasing the declarations in it),
+ * then frees the declarations array. Heap declarations are freed by
+ * baa_ast_free_node's walk before this is called.
  *
  * @param data Pointer to the BaaProgramData to free. Must not be NULL.
  */
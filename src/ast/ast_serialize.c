@@ -0,0 +1,531 @@
+// src/ast/ast_serialize.c
+#include "baa/ast/ast_serialize.h"
+#include "baa/types/types.h" // For baa_create_primitive_type
+#include "baa/utils/utils.h" // For baa_malloc, baa_free
+#include "baa/utils/threads.h" // For BAA_THREAD_LOCAL
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h> // For _getpid
+#define image_getpid _getpid
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define image_getpid getpid
+#endif
+
+#define IMAGE_MAGIC "BAAAST\r\n"   // 8 bytes; the CR LF catches text-mode copies
+#define IMAGE_BYTE_ORDER 0x01020304u // Reads back differently on a machine with another byte order
+#define IMAGE_ALIGNMENT 8u         // Alignment of every section
+#define IMAGE_EXTENSION ".baast"
+
+typedef enum
+{
+    IMAGE_SECTION_NODES,
+    IMAGE_SECTION_SPANS,
+    IMAGE_SECTION_EXTRA,
+    IMAGE_SECTION_STRINGS,
+    IMAGE_SECTION_FILES,
+    IMAGE_SECTION_TYPES,
+    IMAGE_SECTION_COUNT
+} BaaImageSection;
+
+static const size_t image_element_sizes[IMAGE_SECTION_COUNT] = {
+    sizeof(BaaFlatNode), sizeof(BaaFlatSpan), sizeof(uint32_t), sizeof(wchar_t), sizeof(uint32_t),
+    sizeof(uint32_t), // Type kinds
+};
+
+/**
+ * Fixed header at offset 0 of an image (152 bytes). Everything after the
+ * header is covered by the checksum.
+ */
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t wchar_size;
+    uint32_t root;
+    uint64_t key_hash;
+    uint64_t key_length;
+    uint64_t image_size;
+    uint64_t checksum;
+    uint64_t counts[IMAGE_SECTION_COUNT];  // Elements in each section
+    uint64_t offsets[IMAGE_SECTION_COUNT]; // Byte offset of each section
+} BaaAstImageHeader;
+
+struct BaaAstImage
+{
+    BaaFlatAst flat;    // Arrays point into the image data (types excepted)
+    BaaAstCacheKey key;
+    void *mapping;      // Mapped file, or NULL
+    size_t mapping_size;
+    void *buffer;       // File read into memory when mapping failed, or NULL
+};
+
+static size_t image_align(size_t offset)
+{
+    return (offset + IMAGE_ALIGNMENT - 1) & ~(size_t)(IMAGE_ALIGNMENT - 1);
+}
+
+// FNV-1a over 64-bit words; `size` is a multiple of 8 and `data` is 8-byte aligned
+static uint64_t image_checksum(const unsigned char *data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        hash ^= word;
+        hash *= 1099511628211ull;
+    }
+    return hash ^ (hash >> 29);
+}
+
+// FNV-1a with one 32-bit code point per step
+static uint64_t key_hash_chars(uint64_t hash, const wchar_t *chars, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (uint32_t)chars[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+BaaAstCacheKey baa_ast_cache_key(const wchar_t *source, size_t length, const wchar_t *filename)
+{
+    BaaAstCacheKey key;
+    uint64_t hash = 14695981039346656037ull;
+    if (filename)
+    {
+        hash = key_hash_chars(hash, filename, wcslen(filename));
+    }
+    hash ^= 0xFFu; // Separates the filename from the source
+    hash *= 1099511628211ull;
+    key.hash = key_hash_chars(hash, source, source ? length : 0);
+    key.length = source ? (uint64_t)length : 0;
+    return key;
+}
+
+// --- Writing ---
+
+void *baa_ast_serialize(const BaaFlatAst *ast, BaaAstCacheKey key, size_t *out_size)
+{
+    if (!ast || !out_size)
+    {
+        return NULL;
+    }
+
+    // Literal types are stored by kind and resolved to the global primitive types on load
+    for (size_t i = 0; i < ast->type_count; i++)
+    {
+        if (!ast->types[i] || !baa_create_primitive_type(ast->types[i]->kind))
+        {
+            return NULL;
+        }
+    }
+
+    const void *sections[IMAGE_SECTION_COUNT] = {ast->nodes, ast->spans, ast->extra_data, ast->strings, ast->files, NULL};
+    BaaAstImageHeader header;
+    memset(&header, 0, sizeof(header));
+    header.counts[IMAGE_SECTION_NODES] = ast->node_count;
+    header.counts[IMAGE_SECTION_SPANS] = ast->node_count;
+    header.counts[IMAGE_SECTION_EXTRA] = ast->extra_count;
+    header.counts[IMAGE_SECTION_STRINGS] = ast->strings_length;
+    header.counts[IMAGE_SECTION_FILES] = ast->file_count;
+    header.counts[IMAGE_SECTION_TYPES] = ast->type_count;
+
+    size_t size = image_align(sizeof(BaaAstImageHeader));
+    for (int section = 0; section < IMAGE_SECTION_COUNT; section++)
+    {
+        header.offsets[section] = size;
+        size = image_align(size + (size_t)header.counts[section] * image_element_sizes[section]);
+    }
+
+    unsigned char *image = (unsigned char *)baa_malloc(size);
+    if (!image)
+    {
+        return NULL;
+    }
+    memset(image, 0, size); // Padding is part of the checksum
+    for (int section = 0; section < IMAGE_SECTION_TYPES; section++)
+    {
+        if (header.counts[section] > 0)
+        {
+            memcpy(image + header.offsets[section], sections[section],
+                   (size_t)header.counts[section] * image_element_sizes[section]);
+        }
+    }
+    uint32_t *kinds = (uint32_t *)(image + header.offsets[IMAGE_SECTION_TYPES]);
+    for (size_t i = 0; i < ast->type_count; i++)
+    {
+        kinds[i] = (uint32_t)ast->types[i]->kind;
+    }
+
+    memcpy(header.magic, IMAGE_MAGIC, sizeof(header.magic));
+    header.version = BAA_AST_IMAGE_VERSION;
+    header.byte_order = IMAGE_BYTE_ORDER;
+    header.wchar_size = (uint32_t)sizeof(wchar_t);
+    header.root = ast->root;
+    header.key_hash = key.hash;
+    header.key_length = key.length;
+    header.image_size = size;
+    size_t payload = image_align(sizeof(BaaAstImageHeader));
+    header.checksum = image_checksum(image + payload, size - payload);
+    memcpy(image, &header, sizeof(header));
+
+    *out_size = size;
+    return image;
+}
+
+bool baa_ast_image_write_file(const BaaFlatAst *ast, BaaAstCacheKey key, const char *path)
+{
+    if (!path)
+    {
+        return false;
+    }
+    size_t size = 0;
+    void *image = baa_ast_serialize(ast, key, &size);
+    if (!image)
+    {
+        return false;
+    }
+
+    // The process id and the address of a thread-local make the temporary name unique per writer
+    static BAA_THREAD_LOCAL int writer_tag;
+    size_t temp_size = strlen(path) + 64;
+    char *temp_path = (char *)baa_malloc(temp_size);
+    if (!temp_path)
+    {
+        baa_free(image);
+        return false;
+    }
+    snprintf(temp_path, temp_size, "%s.%ld.%p.tmp", path, (long)image_getpid(), (void *)&writer_tag);
+
+    FILE *file = fopen(temp_path, "wb");
+    bool written = file && fwrite(image, 1, size, file) == size;
+    if (file && fclose(file) != 0)
+    {
+        written = false;
+    }
+    baa_free(image);
+
+#ifdef _WIN32
+    written = written && MoveFileExA(temp_path, path, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    written = written && rename(temp_path, path) == 0;
+#endif
+    if (!written && file)
+    {
+        remove(temp_path);
+    }
+    baa_free(temp_path);
+    return written;
+}
+
+// --- Loading ---
+
+static bool image_section_valid(const BaaAstImageHeader *header, int section, size_t size)
+{
+    uint64_t offset = header->offsets[section];
+    uint64_t count = header->counts[section];
+    return offset % IMAGE_ALIGNMENT == 0 && offset >= sizeof(BaaAstImageHeader) && offset <= size &&
+           count <= (size - offset) / image_element_sizes[section];
+}
+
+static bool image_init(BaaAstImage *image, const void *data, size_t size, const BaaAstCacheKey *expected_key)
+{
+    if (!data || size < sizeof(BaaAstImageHeader) || (uintptr_t)data % IMAGE_ALIGNMENT != 0)
+    {
+        return false;
+    }
+    const BaaAstImageHeader *header = (const BaaAstImageHeader *)data;
+    if (memcmp(header->magic, IMAGE_MAGIC, sizeof(header->magic)) != 0 || header->version != BAA_AST_IMAGE_VERSION ||
+        header->byte_order != IMAGE_BYTE_ORDER || header->wchar_size != sizeof(wchar_t) ||
+        header->image_size != size || size % IMAGE_ALIGNMENT != 0)
+    {
+        return false;
+    }
+    if (expected_key && (header->key_hash != expected_key->hash || header->key_length != expected_key->length))
+    {
+        return false;
+    }
+    for (int section = 0; section < IMAGE_SECTION_COUNT; section++)
+    {
+        if (!image_section_valid(header, section, size))
+        {
+            return false;
+        }
+    }
+
+    const unsigned char *bytes = (const unsigned char *)data;
+    size_t payload = image_align(sizeof(BaaAstImageHeader));
+    if (image_checksum(bytes + payload, size - payload) != header->checksum)
+    {
+        return false;
+    }
+
+    // The payload is trusted from here on (the cache only holds images written by the compiler)
+    size_t node_count = (size_t)header->counts[IMAGE_SECTION_NODES];
+    size_t strings_length = (size_t)header->counts[IMAGE_SECTION_STRINGS];
+    const wchar_t *strings = (const wchar_t *)(bytes + header->offsets[IMAGE_SECTION_STRINGS]);
+    if (node_count != header->counts[IMAGE_SECTION_SPANS] || node_count >= BAA_FLAT_NONE ||
+        (node_count > 0 && header->root >= node_count) || (strings_length > 0 && strings[strings_length - 1] != L'\0'))
+    {
+        return false;
+    }
+
+    BaaFlatAst *flat = &image->flat;
+    flat->type_count = (size_t)header->counts[IMAGE_SECTION_TYPES];
+    if (flat->type_count > 0)
+    {
+        flat->types = (BaaType **)baa_malloc(flat->type_count * sizeof(BaaType *));
+        if (!flat->types)
+        {
+            return false;
+        }
+        const uint32_t *kinds = (const uint32_t *)(bytes + header->offsets[IMAGE_SECTION_TYPES]);
+        for (size_t i = 0; i < flat->type_count; i++)
+        {
+            flat->types[i] = kinds[i] == BAA_TYPE_ARRAY ? NULL : baa_create_primitive_type((BaaTypeKind)kinds[i]);
+            if (!flat->types[i])
+            {
+                baa_free(flat->types);
+                flat->types = NULL;
+                return false;
+            }
+        }
+    }
+
+    // The flat arrays are used in place; the view never writes through them
+    flat->nodes = (BaaFlatNode *)(bytes + header->offsets[IMAGE_SECTION_NODES]);
+    flat->spans = (BaaFlatSpan *)(bytes + header->offsets[IMAGE_SECTION_SPANS]);
+    flat->node_count = flat->node_capacity = node_count;
+    flat->extra_data = (uint32_t *)(bytes + header->offsets[IMAGE_SECTION_EXTRA]);
+    flat->extra_count = flat->extra_capacity = (size_t)header->counts[IMAGE_SECTION_EXTRA];
+    flat->strings = (wchar_t *)strings;
+    flat->strings_length = flat->strings_capacity = strings_length;
+    flat->files = (uint32_t *)(bytes + header->offsets[IMAGE_SECTION_FILES]);
+    flat->file_count = (size_t)header->counts[IMAGE_SECTION_FILES];
+    flat->root = header->root;
+
+    image->key.hash = header->key_hash;
+    image->key.length = header->key_length;
+    return true;
+}
+
+BaaAstImage *baa_ast_image_from_memory(const void *data, size_t size, const BaaAstCacheKey *expected_key)
+{
+    BaaAstImage *image = (BaaAstImage *)baa_malloc(sizeof(BaaAstImage));
+    if (!image)
+    {
+        return NULL;
+    }
+    memset(image, 0, sizeof(BaaAstImage));
+    if (!image_init(image, data, size, expected_key))
+    {
+        baa_free(image);
+        return NULL;
+    }
+    return image;
+}
+
+// Maps the whole file read-only; returns NULL if the file is missing, empty or cannot be mapped
+static void *image_map_file(const char *path, size_t *out_size)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return NULL;
+    }
+    LARGE_INTEGER size;
+    void *view = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && (unsigned long long)size.QuadPart <= SIZE_MAX)
+    {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping)
+        {
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping); // The view keeps the mapping alive
+        }
+        *out_size = (size_t)size.QuadPart;
+    }
+    CloseHandle(file);
+    return view;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    struct stat info;
+    void *view = NULL;
+    if (fstat(fd, &info) == 0 && info.st_size > 0 && (unsigned long long)info.st_size <= SIZE_MAX)
+    {
+        view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED)
+        {
+            view = NULL;
+        }
+        *out_size = (size_t)info.st_size;
+    }
+    close(fd); // The mapping stays valid
+    return view;
+#endif
+}
+
+static void image_unmap_file(void *view, size_t size)
+{
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(view);
+#else
+    munmap(view, size);
+#endif
+}
+
+// Reads the whole file into an 8-byte aligned buffer
+static void *image_read_file(const char *path, size_t *out_size)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+    {
+        return NULL;
+    }
+    void *buffer = NULL;
+    long size = (fseek(file, 0, SEEK_END) == 0) ? ftell(file) : -1;
+    if (size > 0 && fseek(file, 0, SEEK_SET) == 0)
+    {
+        buffer = baa_malloc((size_t)size); // malloc alignment covers IMAGE_ALIGNMENT
+        if (buffer && fread(buffer, 1, (size_t)size, file) != (size_t)size)
+        {
+            baa_free(buffer);
+            buffer = NULL;
+        }
+        *out_size = (size_t)size;
+    }
+    fclose(file);
+    return buffer;
+}
+
+BaaAstImage *baa_ast_image_load_file(const char *path, const BaaAstCacheKey *expected_key)
+{
+    if (!path)
+    {
+        return NULL;
+    }
+    BaaAstImage *image = (BaaAstImage *)baa_malloc(sizeof(BaaAstImage));
+    if (!image)
+    {
+        return NULL;
+    }
+    memset(image, 0, sizeof(BaaAstImage));
+
+    size_t size = 0;
+    image->mapping = image_map_file(path, &size);
+    if (image->mapping)
+    {
+        image->mapping_size = size;
+    }
+    else
+    {
+        image->buffer = image_read_file(path, &size);
+    }
+
+    const void *data = image->mapping ? image->mapping : image->buffer;
+    if (!data || !image_init(image, data, size, expected_key))
+    {
+        baa_ast_image_free(image);
+        return NULL;
+    }
+    return image;
+}
+
+const BaaFlatAst *baa_ast_image_flat(const BaaAstImage *image)
+{
+    return image ? &image->flat : NULL;
+}
+
+BaaAstCacheKey baa_ast_image_key(const BaaAstImage *image)
+{
+    BaaAstCacheKey key = {0, 0};
+    return image ? image->key : key;
+}
+
+void baa_ast_image_free(BaaAstImage *image)
+{
+    if (!image)
+    {
+        return;
+    }
+    if (image->mapping)
+    {
+        image_unmap_file(image->mapping, image->mapping_size);
+    }
+    baa_free(image->buffer);
+    baa_free(image->flat.types);
+    baa_free(image);
+}
+
+// --- Cache directory ---
+
+size_t baa_ast_cache_path(const char *directory, BaaAstCacheKey key, char *buffer, size_t buffer_size)
+{
+    int length = snprintf(buffer, buffer_size, "%s/%016llx%016llx" IMAGE_EXTENSION, directory ? directory : ".",
+                          (unsigned long long)key.hash, (unsigned long long)key.length);
+    return length < 0 ? 0 : (size_t)length;
+}
+
+// Returns the cache path for `key` (free it with baa_free), or NULL on allocation failure
+static char *cache_path_alloc(const char *directory, BaaAstCacheKey key)
+{
+    size_t length = baa_ast_cache_path(directory, key, NULL, 0);
+    char *path = (char *)baa_malloc(length + 1);
+    if (path)
+    {
+        baa_ast_cache_path(directory, key, path, length + 1);
+    }
+    return path;
+}
+
+BaaNode *baa_ast_cache_load(const char *directory, BaaAstCacheKey key, BaaAstImage **out_image)
+{
+    if (!out_image)
+    {
+        return NULL;
+    }
+    *out_image = NULL;
+    char *path = cache_path_alloc(directory, key);
+    if (!path)
+    {
+        return NULL;
+    }
+    BaaAstImage *image = baa_ast_image_load_file(path, &key);
+    baa_free(path);
+
+    BaaNode *root = image ? baa_flat_ast_to_tree(&image->flat) : NULL;
+    if (!root)
+    {
+        baa_ast_image_free(image);
+        return NULL;
+    }
+    *out_image = image;
+    return root;
+}
+
+bool baa_ast_cache_store(const char *directory, BaaAstCacheKey key, const BaaNode *root)
+{
+    BaaFlatAst *flat = baa_flat_ast_from_tree(root);
+    char *path = flat ? cache_path_alloc(directory, key) : NULL;
+    bool stored = path && baa_ast_image_write_file(flat, key, path);
+    baa_free(path);
+    baa_flat_ast_free(flat);
+    return stored;
+}
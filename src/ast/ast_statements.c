@@ -2,6 +2,7 @@
 #include "baa/ast/ast.h"       // For BaaNode, BaaAstSourceSpan, specific node creation prototypes
 #include "baa/ast/ast_types.h" // For BaaNodeKind, BaaExprStmtData
 #include "ast_statements.h"    // For internal prototypes like baa_ast_free_expr_stmt_data
+#include "ast_alloc.h"         // For baa_ast_alloc_node, baa_ast_grow_children
 
 #include "baa/utils/utils.h" // For baa_malloc, baa_free
 
@@ -11,28 +12,20 @@
 
 BaaNode *baa_ast_new_expr_stmt_node(BaaAstSourceSpan span, BaaNode *expression_node)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_EXPR_STMT, span);
-    if (!node)
-    {
-        return NULL; // Allocation for BaaNode failed
-    }
-
     if (!expression_node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Invalid expression node
+        return NULL; // Invalid expression node
     }
 
-    BaaExprStmtData *data = (BaaExprStmtData *)baa_malloc(sizeof(BaaExprStmtData));
-    if (!data)
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_EXPR_STMT, span, sizeof(BaaExprStmtData));
+    if (!node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // Allocation for the node failed
     }
 
+    BaaExprStmtData *data = (BaaExprStmtData *)node->data;
     data->expression = expression_node;
 
-    node->data = data;
     return node;
 }
 
@@ -40,25 +33,14 @@ BaaNode *baa_ast_new_expr_stmt_node(BaaAstSourceSpan span, BaaNode *expression_n
 
 BaaNode *baa_ast_new_block_stmt_node(BaaAstSourceSpan span)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_BLOCK_STMT, span);
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_BLOCK_STMT, span, sizeof(BaaBlockStmtData));
     if (!node)
     {
-        return NULL; // Allocation for BaaNode failed
+        return NULL; // Allocation for the node failed
     }
 
-    BaaBlockStmtData *data = (BaaBlockStmtData *)baa_malloc(sizeof(BaaBlockStmtData));
-    if (!data)
-    {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
-    }
-
-    // Initialize the dynamic array
-    data->statements = NULL;
-    data->count = 0;
-    data->capacity = 0;
+    // The zeroed data is an empty statements array
 
-    node->data = data;
     return node;
 }
 
@@ -87,19 +69,10 @@ bool baa_ast_add_stmt_to_block(BaaNode *block_node, BaaNode *statement_node)
     BaaBlockStmtData *data = (BaaBlockStmtData *)block_node->data;
 
     // Check if we need to resize the array
-    if (data->count >= data->capacity)
+    if (data->count >= data->capacity &&
+        !baa_ast_grow_children(block_node, &data->statements, &data->capacity))
     {
-        size_t new_capacity = data->capacity == 0 ? 4 : data->capacity * 2;
-        BaaNode **new_statements = (BaaNode **)baa_realloc(
-            data->statements,
-            new_capacity * sizeof(BaaNode *));
-        if (!new_statements)
-        {
-            return false; // Memory allocation failed
-        }
-
-        data->statements = new_statements;
-        data->capacity = new_capacity;
+        return false; // Memory allocation failed
     }
 
     // Add the statement
@@ -109,27 +82,6 @@ bool baa_ast_add_stmt_to_block(BaaNode *block_node, BaaNode *statement_node)
     return true;
 }
 
-// --- Statement Node Data Freeing ---
-
-// --- Expression Statement Node Data Freeing ---
-
-void baa_ast_free_expr_stmt_data(BaaExprStmtData *data)
-{
-    if (!data)
-    {
-        return;
-    }
-
-    // Recursively free the expression
-    if (data->expression)
-    {
-        baa_ast_free_node(data->expression);
-    }
-
-    // Free the BaaExprStmtData struct itself
-    baa_free(data);
-}
-
 // --- Block Statement Node Data Freeing ---
 
 void baa_ast_free_block_stmt_data(BaaBlockStmtData *data)
@@ -139,21 +91,7 @@ void baa_ast_free_block_stmt_data(BaaBlockStmtData *data)
         return;
     }
 
-    // Recursively free all statements
-    if (data->statements)
-    {
-        for (size_t i = 0; i < data->count; i++)
-        {
-            if (data->statements[i])
-            {
-                baa_ast_free_node(data->statements[i]);
-            }
-        }
-        baa_free(data->statements);
-    }
-
-    // Free the BaaBlockStmtData struct itself
-    baa_free(data);
+    baa_free(data->statements); // The elements were freed by the walk
 }
 
 // --- Control Flow Statement Node Creation ---
@@ -162,30 +100,22 @@ void baa_ast_free_block_stmt_data(BaaBlockStmtData *data)
 
 BaaNode *baa_ast_new_if_stmt_node(BaaAstSourceSpan span, BaaNode *condition_expr, BaaNode *then_stmt, BaaNode *else_stmt)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_IF_STMT, span);
-    if (!node)
-    {
-        return NULL; // Allocation for BaaNode failed
-    }
-
     if (!condition_expr || !then_stmt)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Invalid required parameters
+        return NULL; // Invalid required parameters
     }
 
-    BaaIfStmtData *data = (BaaIfStmtData *)baa_malloc(sizeof(BaaIfStmtData));
-    if (!data)
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_IF_STMT, span, sizeof(BaaIfStmtData));
+    if (!node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // Allocation for the node failed
     }
 
+    BaaIfStmtData *data = (BaaIfStmtData *)node->data;
     data->condition_expr = condition_expr;
     data->then_stmt = then_stmt;
     data->else_stmt = else_stmt; // Can be NULL
 
-    node->data = data;
     return node;
 }
 
@@ -193,29 +123,21 @@ BaaNode *baa_ast_new_if_stmt_node(BaaAstSourceSpan span, BaaNode *condition_expr
 
 BaaNode *baa_ast_new_while_stmt_node(BaaAstSourceSpan span, BaaNode *condition_expr, BaaNode *body_stmt)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_WHILE_STMT, span);
-    if (!node)
-    {
-        return NULL; // Allocation for BaaNode failed
-    }
-
     if (!condition_expr || !body_stmt)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Invalid required parameters
+        return NULL; // Invalid required parameters
     }
 
-    BaaWhileStmtData *data = (BaaWhileStmtData *)baa_malloc(sizeof(BaaWhileStmtData));
-    if (!data)
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_WHILE_STMT, span, sizeof(BaaWhileStmtData));
+    if (!node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // Allocation for the node failed
     }
 
+    BaaWhileStmtData *data = (BaaWhileStmtData *)node->data;
     data->condition_expr = condition_expr;
     data->body_stmt = body_stmt;
 
-    node->data = data;
     return node;
 }
 
@@ -223,31 +145,23 @@ BaaNode *baa_ast_new_while_stmt_node(BaaAstSourceSpan span, BaaNode *condition_e
 
 BaaNode *baa_ast_new_for_stmt_node(BaaAstSourceSpan span, BaaNode *initializer_stmt, BaaNode *condition_expr, BaaNode *increment_expr, BaaNode *body_stmt)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_FOR_STMT, span);
-    if (!node)
-    {
-        return NULL; // Allocation for BaaNode failed
-    }
-
     if (!body_stmt)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Body statement is required
+        return NULL; // Body statement is required
     }
 
-    BaaForStmtData *data = (BaaForStmtData *)baa_malloc(sizeof(BaaForStmtData));
-    if (!data)
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_FOR_STMT, span, sizeof(BaaForStmtData));
+    if (!node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // Allocation for the node failed
     }
 
+    BaaForStmtData *data = (BaaForStmtData *)node->data;
     data->initializer_stmt = initializer_stmt; // Can be NULL
     data->condition_expr = condition_expr;     // Can be NULL
     data->increment_expr = increment_expr;     // Can be NULL
     data->body_stmt = body_stmt;
 
-    node->data = data;
     return node;
 }
 
@@ -255,22 +169,15 @@ BaaNode *baa_ast_new_for_stmt_node(BaaAstSourceSpan span, BaaNode *initializer_s
 
 BaaNode *baa_ast_new_return_stmt_node(BaaAstSourceSpan span, BaaNode *value_expr)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_RETURN_STMT, span);
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_RETURN_STMT, span, sizeof(BaaReturnStmtData));
     if (!node)
     {
-        return NULL; // Allocation for BaaNode failed
-    }
-
-    BaaReturnStmtData *data = (BaaReturnStmtData *)baa_malloc(sizeof(BaaReturnStmtData));
-    if (!data)
-    {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // Allocation for the node failed
     }
 
+    BaaReturnStmtData *data = (BaaReturnStmtData *)node->data;
     data->value_expr = value_expr; // Can be NULL for void returns
 
-    node->data = data;
     return node;
 }
 
@@ -278,14 +185,13 @@ BaaNode *baa_ast_new_return_stmt_node(BaaAstSourceSpan span, BaaNode *value_expr
 
 BaaNode *baa_ast_new_break_stmt_node(BaaAstSourceSpan span)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_BREAK_STMT, span);
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_BREAK_STMT, span, 0);
     if (!node)
     {
-        return NULL; // Allocation for BaaNode failed
+        return NULL; // Allocation for the node failed
     }
 
-    // Break statements don't need additional data
-    node->data = NULL;
+    // Break statements don't need additional data (node->data is NULL)
     return node;
 }
 
@@ -293,127 +199,12 @@ BaaNode *baa_ast_new_break_stmt_node(BaaAstSourceSpan span)
 
 BaaNode *baa_ast_new_continue_stmt_node(BaaAstSourceSpan span)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_CONTINUE_STMT, span);
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_CONTINUE_STMT, span, 0);
     if (!node)
     {
-        return NULL; // Allocation for BaaNode failed
+        return NULL; // Allocation for the node failed
     }
 
-    // Continue statements don't need additional data
-    node->data = NULL;
+    // Continue statements don't need additional data (node->data is NULL)
     return node;
 }
-
-// --- Control Flow Statement Node Data Freeing ---
-
-// --- If Statement Node Data Freeing ---
-
-void baa_ast_free_if_stmt_data(BaaIfStmtData *data)
-{
-    if (!data)
-    {
-        return;
-    }
-
-    // Recursively free the condition expression
-    if (data->condition_expr)
-    {
-        baa_ast_free_node(data->condition_expr);
-    }
-
-    // Recursively free the then statement
-    if (data->then_stmt)
-    {
-        baa_ast_free_node(data->then_stmt);
-    }
-
-    // Recursively free the else statement (if present)
-    if (data->else_stmt)
-    {
-        baa_ast_free_node(data->else_stmt);
-    }
-
-    // Free the BaaIfStmtData struct itself
-    baa_free(data);
-}
-
-// --- While Statement Node Data Freeing ---
-
-void baa_ast_free_while_stmt_data(BaaWhileStmtData *data)
-{
-    if (!data)
-    {
-        return;
-    }
-
-    // Recursively free the condition expression
-    if (data->condition_expr)
-    {
-        baa_ast_free_node(data->condition_expr);
-    }
-
-    // Recursively free the body statement
-    if (data->body_stmt)
-    {
-        baa_ast_free_node(data->body_stmt);
-    }
-
-    // Free the BaaWhileStmtData struct itself
-    baa_free(data);
-}
-
-// --- For Statement Node Data Freeing ---
-
-void baa_ast_free_for_stmt_data(BaaForStmtData *data)
-{
-    if (!data)
-    {
-        return;
-    }
-
-    // Recursively free the initializer statement (if present)
-    if (data->initializer_stmt)
-    {
-        baa_ast_free_node(data->initializer_stmt);
-    }
-
-    // Recursively free the condition expression (if present)
-    if (data->condition_expr)
-    {
-        baa_ast_free_node(data->condition_expr);
-    }
-
-    // Recursively free the increment expression (if present)
-    if (data->increment_expr)
-    {
-        baa_ast_free_node(data->increment_expr);
-    }
-
-    // Recursively free the body statement
-    if (data->body_stmt)
-    {
-        baa_ast_free_node(data->body_stmt);
-    }
-
-    // Free the BaaForStmtData struct itself
-    baa_free(data);
-}
-
-// --- Return Statement Node Data Freeing ---
-
-void baa_ast_free_return_stmt_data(BaaReturnStmtData *data)
-{
-    if (!data)
-    {
-        return;
-    }
-
-    // Recursively free the value expression (if present)
-    if (data->value_expr)
-    {
-        baa_ast_free_node(data->value_expr);
-    }
-
-    // Free the BaaReturnStmtData struct itself
-    baa_free(data);
-}
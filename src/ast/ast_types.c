@@ -2,81 +2,64 @@
 #include "baa/ast/ast_types.h"
 #include "baa/utils/utils.h"
 #include "ast_types.h"
+#include "ast_alloc.h"
 #include <wchar.h>
 
 // == Type Representation Node Creation ==
 
 BaaNode *baa_ast_new_primitive_type_node(BaaAstSourceSpan span, const wchar_t *type_name)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_TYPE, span);
-    if (!node)
-    {
-        return NULL; // Allocation for BaaNode failed
-    }
-
     if (!type_name)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Invalid type name
+        return NULL; // Invalid type name
     }
 
-    BaaTypeAstData *data = (BaaTypeAstData *)baa_malloc(sizeof(BaaTypeAstData));
-    if (!data)
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_TYPE, span, sizeof(BaaTypeAstData));
+    if (!node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // Allocation for the node failed
     }
 
     // Initialize the data structure
+    BaaTypeAstData *data = (BaaTypeAstData *)node->data;
     data->type_ast_kind = BAA_TYPE_AST_KIND_PRIMITIVE;
 
-    // Duplicate the type name
-    data->specifier.primitive.name = baa_strdup(type_name);
+    // Duplicate (or intern) the type name
+    data->specifier.primitive.name = baa_ast_copy_string(node, type_name);
     if (!data->specifier.primitive.name)
     {
-        baa_free(data);
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
+        baa_ast_free_node(node);
         return NULL;
     }
 
-    node->data = data;
     return node;
 }
 
 BaaNode *baa_ast_new_array_type_node(BaaAstSourceSpan span, BaaNode *element_type_node, BaaNode *size_expr)
 {
-    BaaNode *node = baa_ast_new_node(BAA_NODE_KIND_TYPE, span);
-    if (!node)
-    {
-        return NULL; // Allocation for BaaNode failed
-    }
-
     if (!element_type_node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Invalid element type node
+        return NULL; // Invalid element type node
     }
 
     // Validate that element_type_node is actually a type node
     if (element_type_node->kind != BAA_NODE_KIND_TYPE)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;             // Element type node must be a type node
+        return NULL; // Element type node must be a type node
     }
 
-    BaaTypeAstData *data = (BaaTypeAstData *)baa_malloc(sizeof(BaaTypeAstData));
-    if (!data)
+    BaaNode *node = baa_ast_alloc_node(BAA_NODE_KIND_TYPE, span, sizeof(BaaTypeAstData));
+    if (!node)
     {
-        baa_ast_free_node(node); // Clean up the partially created BaaNode
-        return NULL;
+        return NULL; // Allocation for the node failed
     }
 
     // Initialize the data structure
+    BaaTypeAstData *data = (BaaTypeAstData *)node->data;
     data->type_ast_kind = BAA_TYPE_AST_KIND_ARRAY;
     data->specifier.array.element_type_node = element_type_node;
     data->specifier.array.size_expr = size_expr; // Can be NULL for dynamic arrays
 
-    node->data = data;
     return node;
 }
 
@@ -99,16 +82,7 @@ void baa_ast_free_type_ast_data(BaaTypeAstData *data)
         break;
 
     case BAA_TYPE_AST_KIND_ARRAY:
-        // Free the element type node recursively
-        if (data->specifier.array.element_type_node)
-        {
-            baa_ast_free_node(data->specifier.array.element_type_node);
-        }
-        // Free the size expression node recursively (if present)
-        if (data->specifier.array.size_expr)
-        {
-            baa_ast_free_node(data->specifier.array.size_expr);
-        }
+        // The element type and size expression are separate nodes, freed by the walk
         break;
 
     case BAA_TYPE_AST_KIND_POINTER:
@@ -120,6 +94,4 @@ void baa_ast_free_type_ast_data(BaaTypeAstData *data)
         // Unknown type kind - nothing to free
         break;
     }
-
-    baa_free(data);
 }
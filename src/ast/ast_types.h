@@ -17,9 +17,8 @@
 /**
  * @brief Frees the data associated with a BaaTypeAstData structure.
  * 
- * This function recursively frees all memory associated with a BaaTypeAstData
- * structure, including any child nodes (for array types) and duplicated strings
- * (for primitive types).
+ * Frees the duplicated name of a primitive type. The element type and size
+ * nodes of an array type are freed by baa_ast_free_node's walk.
  * 
  * @param data The BaaTypeAstData structure to free. Can be NULL.
  */
@@ -0,0 +1,218 @@
+// src/ast/ast_visitor.c
+#include "baa/ast/ast_visitor.h"
+#include "baa/utils/utils.h" // For baa_malloc, baa_realloc, baa_free
+#include <string.h>
+
+#define AST_WALK_INLINE_FRAMES 64 // Frames kept on the C stack before the walk moves to the heap
+
+typedef struct
+{
+    BaaNode *node;
+    BaaNode *parent;
+    size_t next_child;  // Next child slot to visit
+    size_t child_count; // Slots to visit (0 when the children are skipped)
+} BaaAstWalkFrame;
+
+size_t baa_ast_child_count(const BaaNode *node)
+{
+    if (!node || !node->data)
+    {
+        return 0;
+    }
+    switch (node->kind)
+    {
+    case BAA_NODE_KIND_PROGRAM:
+        return ((const BaaProgramData *)node->data)->count;
+    case BAA_NODE_KIND_PARAMETER:
+    case BAA_NODE_KIND_EXPR_STMT:
+    case BAA_NODE_KIND_RETURN_STMT:
+    case BAA_NODE_KIND_UNARY_EXPR:
+        return 1;
+    case BAA_NODE_KIND_FUNCTION_DEF:
+        return ((const BaaFunctionDefData *)node->data)->parameter_count + 2;
+    case BAA_NODE_KIND_BLOCK_STMT:
+        return ((const BaaBlockStmtData *)node->data)->count;
+    case BAA_NODE_KIND_VAR_DECL_STMT:
+    case BAA_NODE_KIND_WHILE_STMT:
+    case BAA_NODE_KIND_BINARY_EXPR:
+        return 2;
+    case BAA_NODE_KIND_IF_STMT:
+        return 3;
+    case BAA_NODE_KIND_FOR_STMT:
+        return 4;
+    case BAA_NODE_KIND_CALL_EXPR:
+        return ((const BaaCallExprData *)node->data)->argument_count + 1;
+    case BAA_NODE_KIND_TYPE:
+        return ((const BaaTypeAstData *)node->data)->type_ast_kind == BAA_TYPE_AST_KIND_ARRAY ? 2 : 0;
+    default:
+        return 0; // Literals, identifiers, break, continue
+    }
+}
+
+BaaNode *baa_ast_child(const BaaNode *node, size_t index)
+{
+    if (index >= baa_ast_child_count(node))
+    {
+        return NULL;
+    }
+
+    switch (node->kind)
+    {
+    case BAA_NODE_KIND_PROGRAM:
+        return ((const BaaProgramData *)node->data)->top_level_declarations[index];
+    case BAA_NODE_KIND_PARAMETER:
+        return ((const BaaParameterData *)node->data)->type_node;
+    case BAA_NODE_KIND_FUNCTION_DEF:
+    {
+        const BaaFunctionDefData *data = node->data;
+        if (index == 0)
+            return data->return_type_node;
+        if (index <= data->parameter_count)
+            return data->parameters[index - 1];
+        return data->body;
+    }
+    case BAA_NODE_KIND_EXPR_STMT:
+        return ((const BaaExprStmtData *)node->data)->expression;
+    case BAA_NODE_KIND_BLOCK_STMT:
+        return ((const BaaBlockStmtData *)node->data)->statements[index];
+    case BAA_NODE_KIND_VAR_DECL_STMT:
+    {
+        const BaaVarDeclData *data = node->data;
+        return index == 0 ? data->type_node : data->initializer_expr;
+    }
+    case BAA_NODE_KIND_IF_STMT:
+    {
+        const BaaIfStmtData *data = node->data;
+        return index == 0 ? data->condition_expr : index == 1 ? data->then_stmt : data->else_stmt;
+    }
+    case BAA_NODE_KIND_WHILE_STMT:
+    {
+        const BaaWhileStmtData *data = node->data;
+        return index == 0 ? data->condition_expr : data->body_stmt;
+    }
+    case BAA_NODE_KIND_FOR_STMT:
+    {
+        const BaaForStmtData *data = node->data;
+        BaaNode *children[4] = {data->initializer_stmt, data->condition_expr, data->increment_expr, data->body_stmt};
+        return children[index];
+    }
+    case BAA_NODE_KIND_RETURN_STMT:
+        return ((const BaaReturnStmtData *)node->data)->value_expr;
+    case BAA_NODE_KIND_BINARY_EXPR:
+    {
+        const BaaBinaryExprData *data = node->data;
+        return index == 0 ? data->left_operand : data->right_operand;
+    }
+    case BAA_NODE_KIND_UNARY_EXPR:
+        return ((const BaaUnaryExprData *)node->data)->operand;
+    case BAA_NODE_KIND_CALL_EXPR:
+    {
+        const BaaCallExprData *data = node->data;
+        return index == 0 ? data->callee_expr : data->arguments[index - 1];
+    }
+    case BAA_NODE_KIND_TYPE:
+    {
+        const BaaTypeAstData *data = node->data;
+        return index == 0 ? data->specifier.array.element_type_node : data->specifier.array.size_expr;
+    }
+    default:
+        return NULL;
+    }
+}
+
+// Makes room for one more frame, moving the stack to the heap when the inline frames run out
+static bool walk_reserve(BaaAstWalkFrame **frames, size_t *capacity, size_t count, BaaAstWalkFrame *inline_frames)
+{
+    if (count < *capacity)
+    {
+        return true;
+    }
+
+    size_t new_capacity = *capacity * 2;
+    BaaAstWalkFrame *grown;
+    if (*frames == inline_frames)
+    {
+        grown = (BaaAstWalkFrame *)baa_malloc(new_capacity * sizeof(BaaAstWalkFrame));
+        if (grown)
+        {
+            memcpy(grown, inline_frames, count * sizeof(BaaAstWalkFrame));
+        }
+    }
+    else
+    {
+        grown = (BaaAstWalkFrame *)baa_realloc(*frames, new_capacity * sizeof(BaaAstWalkFrame));
+    }
+    if (!grown)
+    {
+        return false;
+    }
+    *frames = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+bool baa_ast_walk(BaaNode *root, const BaaAstVisitor *visitor)
+{
+    if (!root || !visitor)
+    {
+        return true;
+    }
+
+    BaaAstWalkFrame inline_frames[AST_WALK_INLINE_FRAMES];
+    BaaAstWalkFrame *frames = inline_frames;
+    size_t capacity = AST_WALK_INLINE_FRAMES;
+    size_t count = 0;
+    bool completed = true;
+
+    BaaNode *node = root;
+    BaaNode *parent = NULL;
+    while (completed)
+    {
+        if (node)
+        {
+            // Enter `node` at depth `count`
+            BaaAstVisitResult result = visitor->pre ? visitor->pre(node, parent, count, visitor->user_data)
+                                                    : BAA_AST_VISIT_CONTINUE;
+            if (result == BAA_AST_VISIT_ABORT || !walk_reserve(&frames, &capacity, count, inline_frames))
+            {
+                completed = false;
+                break;
+            }
+            frames[count].node = node;
+            frames[count].parent = parent;
+            frames[count].next_child = 0;
+            frames[count].child_count = result == BAA_AST_VISIT_SKIP_CHILDREN ? 0 : baa_ast_child_count(node);
+            count++;
+            node = NULL;
+        }
+
+        if (count == 0)
+        {
+            break;
+        }
+
+        BaaAstWalkFrame *frame = &frames[count - 1];
+        if (frame->next_child < frame->child_count)
+        {
+            // Absent optional children are skipped by the next iteration's NULL check
+            node = baa_ast_child(frame->node, frame->next_child++);
+            parent = frame->node;
+            continue;
+        }
+
+        // Leave the node; the post callback may free it
+        BaaNode *done = frame->node;
+        BaaNode *done_parent = frame->parent;
+        count--;
+        if (visitor->post && visitor->post(done, done_parent, count, visitor->user_data) == BAA_AST_VISIT_ABORT)
+        {
+            completed = false;
+        }
+    }
+
+    if (frames != inline_frames)
+    {
+        baa_free(frames);
+    }
+    return completed;
+}
@@ -82,12 +82,14 @@ int compile_baa_file(const char* filename) {
         // Ensure lexeme is printed correctly, it's a const wchar_t*
             // Need to handle potential NULL lexeme for EOF/Error if lexer sets it that way
         const wchar_t* type_str = baa_token_type_to_string(token->type);
+        size_t token_line = 0, token_column = 0;
+        baa_lexer_get_position(&lexer, token->start_offset, &token_line, &token_column);
         wprintf(L"Token %03d: Type=%ls, Lexeme='%.*ls', Line=%zu, Col=%zu\n",
                 token_count++,
                 type_str ? type_str : L"UNKNOWN_TYPE",
                 (int)token->length, token->lexeme ? token->lexeme : L"",
-                token->line,
-                token->column);
+                token_line,
+                token_column);
 
         // Check for termination condition *after* processing/printing
         BaaTokenType token_type = token->type; // Store type before freeing
@@ -147,6 +149,7 @@ int compile_baa_file(const char* filename) {
     if (!output_filename) {
         fprintf(stderr, "Error: Memory allocation failed for output filename.\n");
         // baa_free_program(program); // Removed as AST is being removed
+        baa_cleanup_lexer(&lexer);
         free(source);
         free(wfilename);
         return 1;
@@ -157,6 +160,7 @@ int compile_baa_file(const char* filename) {
     if (err_cpy != 0) {
         fprintf(stderr, "Error: wcscpy_s failed for output filename.\n");
         // baa_free_program(program); // Removed as AST is being removed
+        baa_cleanup_lexer(&lexer);
         free(source);
         free(wfilename);
         free(output_filename); // Free allocated memory
@@ -171,6 +175,7 @@ int compile_baa_file(const char* filename) {
          if (err_ext_cpy != 0) {
             fprintf(stderr, "Error: wcscpy_s failed for extension replacement.\n");
             // baa_free_program(program); // Removed as AST is being removed
+            baa_cleanup_lexer(&lexer);
             free(source);
             free(wfilename);
             free(output_filename);
@@ -182,6 +187,7 @@ int compile_baa_file(const char* filename) {
         if (err_cat != 0) {
             fprintf(stderr, "Error: wcscat_s failed for appending extension.\n");
             // baa_free_program(program); // Removed as AST is being removed
+            baa_cleanup_lexer(&lexer);
             free(source);
             free(wfilename);
             free(output_filename);
@@ -215,6 +221,7 @@ int compile_baa_file(const char* filename) {
     // baa_free_program(program); // Free the AST - Removed as AST is being removed
 
     // Clean up resources used by preprocessor/lexer
+    baa_cleanup_lexer(&lexer);
     free(source);
     free(wfilename);
 
@@ -63,18 +63,9 @@ wchar_t advance(BaaLexer *lexer)
 {
     if (is_at_end(lexer))
         return L'\0';
-    wchar_t c = lexer->source[lexer->current++];
-    wchar_t char_consumed = c; // For debug
-    if (c == L'\n')
-    {
-        lexer->line++;
-        lexer->column = 1; // Reset to 1 for new line
-    }
-    else
-    {
-        lexer->column++; // Increment for non-newline char
-    }
-    return char_consumed; // Return the character that was consumed
+    // Line/column are not tracked here; they are derived from offsets on demand
+    // (see baa_lexer_get_position), which keeps this hot path to a single increment.
+    return lexer->source[lexer->current++];
 }
 
 bool match(BaaLexer *lexer, wchar_t expected)
@@ -100,9 +91,8 @@ void baa_init_lexer(BaaLexer *lexer, const wchar_t *source, const wchar_t *filen
     lexer->source_length = wcslen(source); // Calculate and store source length
     lexer->start = 0;
     lexer->current = 0;
-    lexer->line = 1;
-    lexer->column = 1;             // Columns should be 1-based for users
-    lexer->start_token_column = 1; // Initialize start_token_column
+    lexer->line_index.line_starts = NULL; // Built lazily on first position lookup
+    lexer->line_index.line_count = 0;
 
     // Initialize enhanced error recovery fields
     lexer->error_count = 0;
@@ -111,6 +101,22 @@ void baa_init_lexer(BaaLexer *lexer, const wchar_t *source, const wchar_t *filen
     baa_init_error_recovery_config(&lexer->recovery_config);
 }
 
+// Initializes a lexer that scans source[begin, end) with `end` treated as end of input.
+// Used to restart lexing at a known token boundary (parallel and incremental lexing).
+void baa_lexer_init_range(BaaLexer *lexer, const wchar_t *source, size_t begin, size_t end)
+{
+    lexer->source = source;
+    lexer->source_length = end;
+    lexer->start = begin;
+    lexer->current = begin;
+    lexer->line_index.line_starts = NULL;
+    lexer->line_index.line_count = 0;
+    lexer->error_count = 0;
+    lexer->consecutive_errors = 0;
+    lexer->error_limit_reached = false;
+    baa_init_error_recovery_config(&lexer->recovery_config);
+}
+
 // Creates a token by copying the lexeme from the source
 BaaToken *make_token(BaaLexer *lexer, BaaTokenType type)
 {
@@ -135,19 +141,12 @@ BaaToken *make_token(BaaLexer *lexer, BaaTokenType type)
     }
     wcsncpy_s((wchar_t *)token->lexeme, token->length + 1, &lexer->source[lexer->start], token->length);
     ((wchar_t *)token->lexeme)[token->length] = L'\0'; // Null-terminate
-    token->line = lexer->line;
-    token->column = lexer->start_token_column; // Use the recorded start column
-    
-    // Initialize span (enhanced source location)
-    token->span.start_line = lexer->line;
-    token->span.start_column = lexer->start_token_column;
-    token->span.end_line = lexer->line;
-    token->span.end_column = lexer->column;
-    token->span.start_offset = lexer->start;
-    token->span.end_offset = lexer->current;
+    token->start_offset = lexer->start;
+    token->end_offset = lexer->current;
     
-    // Initialize error context to NULL for non-error tokens
-    token->error = NULL;
+    // Non-error tokens carry no error information
+    token->error = (BaaLexerError){0};
+    token->literal = (BaaLiteralValue){0};
     
     return token;
 }
@@ -235,44 +234,17 @@ BaaToken *make_specific_error_token(BaaLexer *lexer, BaaTokenType error_type,
     token->type = error_type;
     token->lexeme = buffer;
     token->length = wcslen(buffer);
-    token->line = lexer->line;
-    token->column = lexer->column;
-    
-    // Initialize span for error tokens
-    token->span.start_line = lexer->line;
-    token->span.start_column = lexer->column > 0 ? lexer->column - 1 : 1;
-    token->span.end_line = lexer->line;
-    token->span.end_column = lexer->column;
-    token->span.start_offset = lexer->current > 0 ? lexer->current - 1 : 0;
-    token->span.end_offset = lexer->current;
-
-    // Step 4: Enhanced Error Context - Extract source context and generate smart suggestions
-    wchar_t *before_context = NULL;
-    wchar_t *after_context = NULL;
-    size_t error_position = calculate_error_character_position(lexer);
-    extract_error_context(lexer, error_position, &before_context, &after_context);
-
-    // Generate enhanced suggestion if none provided or enhance existing one
-    wchar_t *enhanced_suggestion = NULL;
-    if (!suggestion)
-    {
-        enhanced_suggestion = generate_error_suggestion(error_type, before_context);
-    }
-    else
-    {
-        // Use provided suggestion but could enhance it in the future
-        enhanced_suggestion = baa_strdup(suggestion);
-    }
-
-    token->error = baa_create_error_context(error_code, category,
-                                           enhanced_suggestion ? enhanced_suggestion : suggestion,
-                                           before_context, after_context);
-
-    // Clean up temporary allocations
-    if (enhanced_suggestion && enhanced_suggestion != suggestion)
-    {
-        free(enhanced_suggestion);
-    }
+    // Error tokens point at the last consumed character
+    token->start_offset = lexer->current > 0 ? lexer->current - 1 : 0;
+    token->end_offset = lexer->current;
+
+    // Step 4: Enhanced Error Context - only the code and position are recorded here;
+    // source context and suggestions are built by baa_token_error_context on demand
+    token->error.error_code = error_code;
+    token->error.category = category;
+    token->error.suggestion = suggestion;
+    token->error.position = calculate_error_character_position(lexer);
+    token->literal = (BaaLiteralValue){0};
 
     return token;
 }
@@ -286,8 +258,8 @@ BaaLexer *baa_create_lexer(const wchar_t *source)
     lexer->source_length = wcslen(source);
     lexer->start = 0;
     lexer->current = 0;
-    lexer->line = 1;
-    lexer->column = 0;
+    lexer->line_index.line_starts = NULL;
+    lexer->line_index.line_count = 0;
 
     // Initialize enhanced error recovery fields
     lexer->error_count = 0;
@@ -298,14 +270,123 @@ BaaLexer *baa_create_lexer(const wchar_t *source)
     return lexer;
 }
 
+void baa_cleanup_lexer(BaaLexer *lexer)
+{
+    if (lexer)
+    {
+        baa_line_index_free(&lexer->line_index);
+    }
+}
+
 void baa_free_lexer(BaaLexer *lexer)
 {
     if (lexer)
     {
+        baa_cleanup_lexer(lexer);
         free(lexer);
     }
 }
 
+bool baa_line_index_build(BaaLineIndex *index, const wchar_t *source, size_t source_length)
+{
+    if (!index || !source)
+        return false;
+
+    // First pass counts newlines so the offsets array is allocated exactly once
+    size_t count = 1;
+    for (size_t i = 0; i < source_length; i++)
+    {
+        if (source[i] == L'\n')
+            count++;
+    }
+
+    size_t *starts = malloc(count * sizeof(size_t));
+    if (!starts)
+        return false;
+
+    size_t n = 0;
+    starts[n++] = 0;
+    for (size_t i = 0; i < source_length; i++)
+    {
+        if (source[i] == L'\n')
+            starts[n++] = i + 1;
+    }
+
+    index->line_starts = starts;
+    index->line_count = count;
+    return true;
+}
+
+void baa_line_index_free(BaaLineIndex *index)
+{
+    if (index)
+    {
+        free(index->line_starts);
+        index->line_starts = NULL;
+        index->line_count = 0;
+    }
+}
+
+void baa_line_index_lookup(const BaaLineIndex *index, size_t offset, size_t *out_line, size_t *out_column)
+{
+    size_t line = 0;
+    size_t column = 0;
+    if (index && index->line_count > 0)
+    {
+        // Find the last line start <= offset
+        size_t lo = 0;
+        size_t hi = index->line_count;
+        while (hi - lo > 1)
+        {
+            size_t mid = lo + (hi - lo) / 2;
+            if (index->line_starts[mid] <= offset)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        line = lo + 1;
+        column = offset - index->line_starts[lo] + 1;
+    }
+    if (out_line)
+        *out_line = line;
+    if (out_column)
+        *out_column = column;
+}
+
+bool baa_lexer_get_position(BaaLexer *lexer, size_t offset, size_t *out_line, size_t *out_column)
+{
+    if (out_line)
+        *out_line = 0;
+    if (out_column)
+        *out_column = 0;
+    if (!lexer || !lexer->source)
+        return false;
+
+    if (lexer->line_index.line_count == 0 &&
+        !baa_line_index_build(&lexer->line_index, lexer->source, lexer->source_length))
+    {
+        return false;
+    }
+
+    if (offset > lexer->source_length)
+        offset = lexer->source_length;
+    baa_line_index_lookup(&lexer->line_index, offset, out_line, out_column);
+    return true;
+}
+
+BaaLexerSourceSpan baa_lexer_get_token_span(BaaLexer *lexer, const BaaToken *token)
+{
+    BaaLexerSourceSpan span = {0};
+    if (!token)
+        return span;
+
+    span.start_offset = token->start_offset;
+    span.end_offset = token->end_offset;
+    baa_lexer_get_position(lexer, token->start_offset, &span.start_line, &span.start_column);
+    baa_lexer_get_position(lexer, token->end_offset, &span.end_line, &span.end_column);
+    return span;
+}
+
 void baa_free_token(BaaToken *token)
 {
     if (token)
@@ -314,10 +395,6 @@ void baa_free_token(BaaToken *token)
         {
             free((wchar_t *)token->lexeme);
         }
-        if (token->error)
-        {
-            baa_free_error_context(token->error);
-        }
         free(token);
     }
 }
@@ -634,36 +711,27 @@ BaaToken *make_successful_token(BaaLexer *lexer, BaaTokenType type)
 
 /**
  * Extract source context around error location
- * @param lexer The lexer instance
+ * @param source The null-terminated source buffer
  * @param error_position Character position of the error in source
  * @param before_context Output parameter for context before error (caller must free)
  * @param after_context Output parameter for context after error (caller must free)
  */
-void extract_error_context(BaaLexer *lexer, size_t error_position,
+void extract_error_context(const wchar_t *source, size_t error_position,
                           wchar_t **before_context, wchar_t **after_context)
 {
-    if (!lexer || !lexer->source || !before_context || !after_context)
-    {
-        if (before_context) *before_context = NULL;
-        if (after_context) *after_context = NULL;
+    if (before_context) *before_context = NULL;
+    if (after_context) *after_context = NULL;
+    if (!source || !before_context || !after_context)
         return;
-    }
 
     const size_t context_length = 30; // Characters to show before/after error
-    size_t start_pos = 0;
-    size_t end_pos = lexer->source_length;
+    size_t start_pos = error_position > context_length ? error_position - context_length : 0;
 
-    // Calculate before context start position
-    if (error_position > context_length)
-    {
-        start_pos = error_position - context_length;
-    }
-
-    // Calculate after context end position
-    if (error_position + context_length < lexer->source_length)
-    {
-        end_pos = error_position + context_length;
-    }
+    // The context is built long after lexing, so the end of input is found by
+    // scanning at most context_length characters for the terminator
+    size_t after_len = 0;
+    while (after_len < context_length && source[error_position + after_len] != L'\0')
+        after_len++;
 
     // Extract before context
     if (error_position > start_pos)
@@ -672,30 +740,21 @@ void extract_error_context(BaaLexer *lexer, size_t error_position,
         *before_context = malloc((before_len + 1) * sizeof(wchar_t));
         if (*before_context)
         {
-            wcsncpy_s(*before_context, before_len + 1, lexer->source + start_pos, before_len);
+            wcsncpy_s(*before_context, before_len + 1, source + start_pos, before_len);
             (*before_context)[before_len] = L'\0';
         }
     }
-    else
-    {
-        *before_context = NULL;
-    }
 
     // Extract after context
-    if (error_position < end_pos)
+    if (after_len > 0)
     {
-        size_t after_len = end_pos - error_position;
         *after_context = malloc((after_len + 1) * sizeof(wchar_t));
         if (*after_context)
         {
-            wcsncpy_s(*after_context, after_len + 1, lexer->source + error_position, after_len);
+            wcsncpy_s(*after_context, after_len + 1, source + error_position, after_len);
             (*after_context)[after_len] = L'\0';
         }
     }
-    else
-    {
-        *after_context = NULL;
-    }
 }
 
 /**
@@ -724,32 +783,19 @@ wchar_t* get_current_line_content(BaaLexer *lexer, size_t line_number)
         return NULL;
 
     const wchar_t *source = lexer->source;
-    size_t current_line = 1;
-    size_t line_start = 0;
-    size_t line_end = 0;
-    size_t pos = 0;
 
-    // Find the start of the requested line
-    while (pos < lexer->source_length && current_line < line_number)
-    {
-        if (source[pos] == L'\n')
-        {
-            current_line++;
-            line_start = pos + 1;
-        }
-        pos++;
-    }
+    // Make sure the newline index exists, then look the line up directly
+    if (!baa_lexer_get_position(lexer, 0, NULL, NULL))
+        return NULL;
 
     // If we didn't find the line, return NULL
-    if (current_line != line_number)
+    if (line_number > lexer->line_index.line_count)
         return NULL;
 
-    // Find the end of the line
-    line_end = line_start;
-    while (line_end < lexer->source_length && source[line_end] != L'\n')
-    {
-        line_end++;
-    }
+    size_t line_start = lexer->line_index.line_starts[line_number - 1];
+    size_t line_end = (line_number < lexer->line_index.line_count)
+                          ? lexer->line_index.line_starts[line_number] - 1 // Exclude the '\n'
+                          : lexer->source_length;
 
     // Extract the line content
     size_t line_length = line_end - line_start;
@@ -808,64 +854,67 @@ wchar_t* generate_error_suggestion(BaaTokenType error_type, const wchar_t* error
  */
 wchar_t* suggest_escape_sequence_fix(wchar_t invalid_escape_char)
 {
-    wchar_t *suggestion = malloc(300 * sizeof(wchar_t));
-    if (!suggestion)
-        return NULL;
+    const wchar_t *suggestion = NULL;
 
     switch (invalid_escape_char)
     {
         case L'س':
-            wcscpy_s(suggestion, 300, L"استخدم \\س للسطر الجديد (SEEN)");
+            suggestion = L"استخدم \\س للسطر الجديد (SEEN)";
             break;
         case L'م':
-            wcscpy_s(suggestion, 300, L"استخدم \\م للتبويب (MEEM)");
+            suggestion = L"استخدم \\م للتبويب (MEEM)";
             break;
         case L'ر':
-            wcscpy_s(suggestion, 300, L"استخدم \\ر للإرجاع (REH)");
+            suggestion = L"استخدم \\ر للإرجاع (REH)";
             break;
         case L'ص':
-            wcscpy_s(suggestion, 300, L"استخدم \\ص للحرف الفارغ (SAD)");
+            suggestion = L"استخدم \\ص للحرف الفارغ (SAD)";
             break;
         case L'\\':
-            wcscpy_s(suggestion, 300, L"استخدم \\\\ للشرطة المائلة العكسية");
+            suggestion = L"استخدم \\\\ للشرطة المائلة العكسية";
             break;
         case L'"':
-            wcscpy_s(suggestion, 300, L"استخدم \\\" لعلامة الاقتباس المزدوجة");
+            suggestion = L"استخدم \\\" لعلامة الاقتباس المزدوجة";
             break;
         case L'\'':
-            wcscpy_s(suggestion, 300, L"استخدم \\' لعلامة الاقتباس المفردة");
+            suggestion = L"استخدم \\' لعلامة الاقتباس المفردة";
             break;
         case L'ي':
-            wcscpy_s(suggestion, 300, L"استخدم \\يXXXX للهروب اليونيكود (مثل \\ي0623 للحرف 'أ') - YEH مع 4 أرقام سداسية عشرية");
+            suggestion = L"استخدم \\يXXXX للهروب اليونيكود (مثل \\ي0623 للحرف 'أ') - YEH مع 4 أرقام سداسية عشرية";
             break;
         case L'ه':
-            wcscpy_s(suggestion, 300, L"استخدم \\هـHH للهروب السداسي عشري (مثل \\هـ41 للحرف A) - HEH مع تطويل ثم رقمان سداسيان");
+            suggestion = L"استخدم \\هـHH للهروب السداسي عشري (مثل \\هـ41 للحرف A) - HEH مع تطويل ثم رقمان سداسيان";
             break;
         // Common mistakes - suggest correct Baa equivalents
         case L'n':
-            wcscpy_s(suggestion, 300, L"استخدم \\س بدلاً من \\n للسطر الجديد - باء تستخدم الأحرف العربية للهروب");
+            suggestion = L"استخدم \\س بدلاً من \\n للسطر الجديد - باء تستخدم الأحرف العربية للهروب";
             break;
         case L't':
-            wcscpy_s(suggestion, 300, L"استخدم \\م بدلاً من \\t للتبويب - باء تستخدم الأحرف العربية للهروب");
+            suggestion = L"استخدم \\م بدلاً من \\t للتبويب - باء تستخدم الأحرف العربية للهروب";
             break;
         case L'r':
-            wcscpy_s(suggestion, 300, L"استخدم \\ر بدلاً من \\r للإرجاع - باء تستخدم الأحرف العربية للهروب");
+            suggestion = L"استخدم \\ر بدلاً من \\r للإرجاع - باء تستخدم الأحرف العربية للهروب";
             break;
         case L'0':
-            wcscpy_s(suggestion, 300, L"استخدم \\ص بدلاً من \\0 للحرف الفارغ - باء تستخدم الأحرف العربية للهروب");
+            suggestion = L"استخدم \\ص بدلاً من \\0 للحرف الفارغ - باء تستخدم الأحرف العربية للهروب";
             break;
         case L'u':
-            wcscpy_s(suggestion, 300, L"استخدم \\يXXXX بدلاً من \\uXXXX للهروب اليونيكود - باء تستخدم \\ي مع 4 أرقام سداسية");
+            suggestion = L"استخدم \\يXXXX بدلاً من \\uXXXX للهروب اليونيكود - باء تستخدم \\ي مع 4 أرقام سداسية";
             break;
         case L'x':
-            wcscpy_s(suggestion, 300, L"استخدم \\هـHH بدلاً من \\xHH للهروب السداسي عشري - باء تستخدم \\هـ مع رقمين سداسيين");
+            suggestion = L"استخدم \\هـHH بدلاً من \\xHH للهروب السداسي عشري - باء تستخدم \\هـ مع رقمين سداسيين";
             break;
         default:
-            swprintf(suggestion, 300, L"تسلسل هروب غير صالح '\\%lc' - استخدم: \\س (سطر جديد)، \\م (تبويب)، \\ر (إرجاع)، \\ص (فارغ)، \\\\، \\\"، \\'، \\يXXXX (يونيكود)، \\هـHH (سداسي عشري)", invalid_escape_char);
-            break;
+        {
+            // The only suggestion that embeds the offending character
+            wchar_t *formatted = malloc(300 * sizeof(wchar_t));
+            if (formatted)
+                swprintf(formatted, 300, L"تسلسل هروب غير صالح '\\%lc' - استخدم: \\س (سطر جديد)، \\م (تبويب)، \\ر (إرجاع)، \\ص (فارغ)، \\\\، \\\"، \\'، \\يXXXX (يونيكود)، \\هـHH (سداسي عشري)", invalid_escape_char);
+            return formatted;
+        }
     }
 
-    return suggestion;
+    return baa_strdup(suggestion);
 }
 
 /**
@@ -875,55 +924,53 @@ wchar_t* suggest_escape_sequence_fix(wchar_t invalid_escape_char)
  */
 wchar_t* suggest_number_format_fix(const wchar_t* invalid_number)
 {
-    wchar_t *suggestion = malloc(400 * sizeof(wchar_t));
-    if (!suggestion)
-        return NULL;
+    const wchar_t *suggestion = NULL;
 
     if (!invalid_number)
     {
-        wcscpy_s(suggestion, 400, L"تأكد من صيغة الرقم الصحيحة: ١٢٣ أو 123 للأعداد الصحيحة، ٣٫١٤ أو 3.14 للأعداد العشرية");
-        return suggestion;
+        suggestion = L"تأكد من صيغة الرقم الصحيحة: ١٢٣ أو 123 للأعداد الصحيحة، ٣٫١٤ أو 3.14 للأعداد العشرية";
+        return baa_strdup(suggestion);
     }
 
     // Check for common number format issues
     if (wcschr(invalid_number, L'.') && wcschr(invalid_number, L'٫'))
     {
-        wcscpy_s(suggestion, 400, L"لا تخلط بين النقطة العشرية الإنجليزية (.) والعربية (٫) - استخدم واحدة فقط");
+        suggestion = L"لا تخلط بين النقطة العشرية الإنجليزية (.) والعربية (٫) - استخدم واحدة فقط";
     }
     else if (wcsstr(invalid_number, L"..") || wcsstr(invalid_number, L"٫٫"))
     {
-        wcscpy_s(suggestion, 400, L"لا تستخدم فاصلتين عشريتين متتاليتين - استخدم فاصلة واحدة فقط (. أو ٫)");
+        suggestion = L"لا تستخدم فاصلتين عشريتين متتاليتين - استخدم فاصلة واحدة فقط (. أو ٫)";
     }
     else if (wcschr(invalid_number, L'e') || wcschr(invalid_number, L'E'))
     {
-        wcscpy_s(suggestion, 400, L"استخدم 'أ' بدلاً من 'e' أو 'E' للترميز العلمي (مثل: ١٫٥أ٣ أو 1.5أ3)");
+        suggestion = L"استخدم 'أ' بدلاً من 'e' أو 'E' للترميز العلمي (مثل: ١٫٥أ٣ أو 1.5أ3)";
     }
     else if (wcsstr(invalid_number, L"__"))
     {
-        wcscpy_s(suggestion, 400, L"لا تستخدم شرطتين سفليتين متتاليتين - استخدم شرطة واحدة للفصل (مثل: ١_٠٠٠_٠٠٠)");
+        suggestion = L"لا تستخدم شرطتين سفليتين متتاليتين - استخدم شرطة واحدة للفصل (مثل: ١_٠٠٠_٠٠٠)";
     }
     else if (wcsstr(invalid_number, L"0x") && !wcschr(invalid_number, L'أ'))
     {
-        wcscpy_s(suggestion, 400, L"للأرقام السداسية العشرية، تأكد من الصيغة الصحيحة: 0x1A2B أو استخدم اللواحق العربية");
+        suggestion = L"للأرقام السداسية العشرية، تأكد من الصيغة الصحيحة: 0x1A2B أو استخدم اللواحق العربية";
     }
     else if (wcsstr(invalid_number, L"ll") || wcsstr(invalid_number, L"LL"))
     {
-        wcscpy_s(suggestion, 400, L"استخدم اللاحقة العربية 'طط' بدلاً من 'll' أو 'LL' للأعداد الطويلة جداً");
+        suggestion = L"استخدم اللاحقة العربية 'طط' بدلاً من 'll' أو 'LL' للأعداد الطويلة جداً";
     }
     else if (wcschr(invalid_number, L'u') || wcschr(invalid_number, L'U'))
     {
-        wcscpy_s(suggestion, 400, L"استخدم اللاحقة العربية 'غ' بدلاً من 'u' أو 'U' للأعداد غير المُوقعة");
+        suggestion = L"استخدم اللاحقة العربية 'غ' بدلاً من 'u' أو 'U' للأعداد غير المُوقعة";
     }
     else if (wcschr(invalid_number, L'f') || wcschr(invalid_number, L'F'))
     {
-        wcscpy_s(suggestion, 400, L"استخدم اللاحقة العربية 'ح' بدلاً من 'f' أو 'F' للأعداد الحقيقية");
+        suggestion = L"استخدم اللاحقة العربية 'ح' بدلاً من 'f' أو 'F' للأعداد الحقيقية";
     }
     else
     {
-        wcscpy_s(suggestion, 400, L"تحقق من صيغة الرقم: الأرقام (٠-٩ أو 0-9)، الفاصلة العشرية (٫ أو .)، الترميز العلمي (أ)، اللواحق (غ، ط، طط، ح)");
+        suggestion = L"تحقق من صيغة الرقم: الأرقام (٠-٩ أو 0-9)، الفاصلة العشرية (٫ أو .)، الترميز العلمي (أ)، اللواحق (غ، ط، طط، ح)";
     }
 
-    return suggestion;
+    return baa_strdup(suggestion);
 }
 
 /**
@@ -933,32 +980,30 @@ wchar_t* suggest_number_format_fix(const wchar_t* invalid_number)
  */
 wchar_t* suggest_string_termination_fix(const wchar_t* partial_string)
 {
-    wchar_t *suggestion = malloc(250 * sizeof(wchar_t));
-    if (!suggestion)
-        return NULL;
+    const wchar_t *suggestion = NULL;
 
     if (!partial_string)
     {
-        wcscpy_s(suggestion, 250, L"أضف علامة اقتباس مزدوجة \" لإنهاء السلسلة النصية");
-        return suggestion;
+        suggestion = L"أضف علامة اقتباس مزدوجة \" لإنهاء السلسلة النصية";
+        return baa_strdup(suggestion);
     }
 
     // Check if it looks like a multiline string attempt
     if (wcschr(partial_string, L'\n'))
     {
-        wcscpy_s(suggestion, 250, L"للسلاسل متعددة الأسطر، استخدم \"\"\" في البداية والنهاية");
+        suggestion = L"للسلاسل متعددة الأسطر، استخدم \"\"\" في البداية والنهاية";
     }
     // Check if it looks like a raw string attempt
     else if (wcslen(partial_string) > 0 && partial_string[0] == L'خ')
     {
-        wcscpy_s(suggestion, 250, L"للسلاسل الخام، استخدم خ\" في البداية و \" في النهاية");
+        suggestion = L"للسلاسل الخام، استخدم خ\" في البداية و \" في النهاية";
     }
     else
     {
-        wcscpy_s(suggestion, 250, L"أضف علامة اقتباس مزدوجة \" في نهاية السلسلة النصية");
+        suggestion = L"أضف علامة اقتباس مزدوجة \" في نهاية السلسلة النصية";
     }
 
-    return suggestion;
+    return baa_strdup(suggestion);
 }
 
 BaaToken *baa_lexer_next_token(BaaLexer *lexer)
@@ -971,7 +1016,6 @@ BaaToken *baa_lexer_next_token(BaaLexer *lexer)
     }
 
     lexer->start = lexer->current;
-    lexer->start_token_column = lexer->column; // Record column at start of token
 
     if (lexer->current >= lexer->source_length)
     {
@@ -984,7 +1028,7 @@ BaaToken *baa_lexer_next_token(BaaLexer *lexer)
     // 1. Handle Newlines first
     if (c == L'\n')
     {
-        advance(lexer); // Consumes \n, advance updates line/col
+        advance(lexer); // Consumes \n
                         // make_token will use the updated lexer->start which was set before this check,
         // and lexer->current which is now after the \n. Lexeme will be L"\n".
         return make_token(lexer, BAA_TOKEN_NEWLINE);
@@ -1015,19 +1059,14 @@ BaaToken *baa_lexer_next_token(BaaLexer *lexer)
     {
         if (peek_next(lexer) == L'/')
         { // Single-line comment: //
-            size_t comment_start_line = lexer->line;
-            size_t comment_start_col = lexer->column; // Column of the first '/'
-            advance(lexer);                           // Consume first /
-            advance(lexer);                           // Consume second /
+            advance(lexer); // Consume first /
+            advance(lexer); // Consume second /
             // scan_single_line_comment will consume content until newline.
             // Newline itself will be tokenized in the next call to baa_lexer_next_token.
-            return scan_single_line_comment(lexer, comment_start_line, comment_start_col);
+            return scan_single_line_comment(lexer);
         }
         else if (peek_next(lexer) == L'*')
         { // Multi-line: /* or Doc: /**
-            size_t comment_start_line = lexer->line;
-            size_t comment_start_col = lexer->column; // Column of the first '/'
-
             advance(lexer); // Consume /
             advance(lexer); // Consume *
 
@@ -1035,12 +1074,12 @@ BaaToken *baa_lexer_next_token(BaaLexer *lexer)
             {                   // Doc comment: /** (and not /**/)
                 advance(lexer); // Consume the second '*' of /**
                 // scan_doc_comment handles from here, consumes content and '*/'
-                return scan_doc_comment(lexer, comment_start_line, comment_start_col);
+                return scan_doc_comment(lexer);
             }
             else
             { // Regular /* or empty /**/
                 // scan_multi_line_comment handles from here, consumes content and '*/'
-                return scan_multi_line_comment(lexer, comment_start_line, comment_start_col);
+                return scan_multi_line_comment(lexer);
             }
         }
         // If just '/', it's not a comment starter here, fall through to operator handling below.
@@ -1057,24 +1096,20 @@ BaaToken *baa_lexer_next_token(BaaLexer *lexer)
                 lexer->source[lexer->current + 3] == L'"')
             {
                 // Raw multiline string: خ"""..."""
-                size_t start_line = lexer->line;
-                size_t start_col = lexer->column;
                 // FIX: Consume the opening 'خ"""' delimiter before calling scanner
                 advance(lexer); // 'خ'
                 advance(lexer); // First '"'
                 advance(lexer); // Second '"'
                 advance(lexer); // Third '"'
-                return scan_raw_string_literal(lexer, true, start_line, start_col);
+                return scan_raw_string_literal(lexer, true);
             }
             else
             {
                 // Raw single-line string: خ"..."
-                size_t start_line = lexer->line;
-                size_t start_col = lexer->column;
                 // FIX: Consume the opening 'خ"' delimiter before calling scanner
                 advance(lexer); // 'خ'
                 advance(lexer); // '"'
-                return scan_raw_string_literal(lexer, false, start_line, start_col);
+                return scan_raw_string_literal(lexer, false);
             }
         }
     }
@@ -1085,13 +1120,11 @@ BaaToken *baa_lexer_next_token(BaaLexer *lexer)
             lexer->source[lexer->current + 1] == L'"' &&
             lexer->source[lexer->current + 2] == L'"')
         {
-            size_t start_line = lexer->line;
-            size_t start_col = lexer->column;
             // FIX: Consume the opening '"""' delimiter before calling scanner
             advance(lexer); // First '"'
             advance(lexer); // Second '"'
             advance(lexer); // Third '"'
-            return scan_multiline_string_literal(lexer, start_line, start_col);
+            return scan_multiline_string_literal(lexer);
         }
         else
         {
@@ -1205,8 +1238,8 @@ BaaToken *baa_lexer_next_token(BaaLexer *lexer)
         BAA_TOKEN_ERROR_INVALID_CHARACTER,
         1009, "character",
         L"تحقق من صحة الحرف أو احذفه",
-        L"حرف غير متوقع: '%lc' (الكود: %u) في السطر %zu، العمود %zu",
-        c, (unsigned int)c, lexer->line, lexer->column);
+        L"حرف غير متوقع: '%lc' (الكود: %u)",
+        c, (unsigned int)c);
     baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_CHARACTER);
     enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_CHARACTER);
     return error_token;
@@ -1429,6 +1462,36 @@ void baa_free_error_context(BaaErrorContext *context)
     }
 }
 
+BaaErrorContext *baa_build_error_context(BaaTokenType type, const BaaLexerError *error, const wchar_t *source)
+{
+    if (!error || !source || !baa_token_is_error(type))
+        return NULL;
+
+    wchar_t *before_context = NULL;
+    wchar_t *after_context = NULL;
+    extract_error_context(source, error->position, &before_context, &after_context);
+
+    // Scanner-provided suggestions win; otherwise derive one from the context
+    wchar_t *generated_suggestion = NULL;
+    if (!error->suggestion)
+        generated_suggestion = generate_error_suggestion(type, before_context);
+
+    BaaErrorContext *context = baa_create_error_context(error->error_code, error->category,
+                                                        error->suggestion ? error->suggestion : generated_suggestion,
+                                                        before_context, after_context);
+    free(generated_suggestion);
+    free(before_context);
+    free(after_context);
+    return context;
+}
+
+BaaErrorContext *baa_token_error_context(const BaaToken *token, const wchar_t *source)
+{
+    if (!token)
+        return NULL;
+    return baa_build_error_context(token->type, &token->error, source);
+}
+
 const wchar_t *baa_get_error_category_description(const char *category)
 {
     if (!category) return L"غير محدد";
@@ -0,0 +1,198 @@
+// src/lexer/lexer_incremental.c
+#include "baa/lexer/lexer_incremental.h"
+#include "lexer_internal.h" // For baa_lexer_init_range
+#include <stdlib.h>
+#include <string.h>
+
+// How far past the end of a token the scanners may look before deciding where it
+// ends (e.g. "1أ+" peeks two characters beyond the 'أ'). A token is reused only if
+// the edit starts beyond this window.
+#define BAA_RELEX_LOOKAHEAD 3
+
+wchar_t *baa_source_apply_edit(const wchar_t *source, size_t source_length, const BaaSourceEdit *edit)
+{
+    if (!source || !edit || edit->offset > source_length ||
+        edit->removed_length > source_length - edit->offset ||
+        (edit->inserted_length > 0 && !edit->inserted))
+        return NULL;
+
+    size_t tail = source_length - edit->offset - edit->removed_length;
+    size_t new_length = edit->offset + edit->inserted_length + tail;
+    wchar_t *result = malloc((new_length + 1) * sizeof(wchar_t));
+    if (!result)
+        return NULL;
+
+    wmemcpy(result, source, edit->offset);
+    if (edit->inserted_length > 0)
+        wmemcpy(result + edit->offset, edit->inserted, edit->inserted_length);
+    wmemcpy(result + edit->offset + edit->inserted_length, source + edit->offset + edit->removed_length, tail);
+    result[new_length] = L'\0';
+    return result;
+}
+
+// Error recovery counts errors across the whole source and ends the stream once a
+// limit is hit. Below the smallest limit it never triggers, so the token stream
+// only depends on positions and a partial re-lex matches a full one.
+static size_t relex_error_limit(void)
+{
+    BaaErrorRecoveryConfig config;
+    baa_init_error_recovery_config(&config);
+    return config.max_consecutive_errors < config.max_errors ? config.max_consecutive_errors : config.max_errors;
+}
+
+// Re-lexes the whole new source; used when error recovery limits make reuse unsafe
+static bool relex_full(BaaTokenBuffer *buffer, const wchar_t *new_source, BaaTokenRange *out_changed)
+{
+    BaaTokenBuffer fresh;
+    if (!baa_lex_all(new_source, &fresh))
+        return false;
+
+    if (out_changed)
+    {
+        out_changed->first = 0;
+        out_changed->old_count = buffer->count;
+        out_changed->new_count = fresh.count;
+    }
+    baa_token_buffer_free(buffer);
+    *buffer = fresh;
+    return true;
+}
+
+bool baa_relex_incremental(BaaTokenBuffer *buffer, const wchar_t *new_source,
+                           const BaaSourceEdit *edit, BaaTokenRange *out_changed)
+{
+    if (!buffer || !new_source || !edit || buffer->count == 0 ||
+        buffer->kinds[buffer->count - 1] != BAA_TOKEN_EOF)
+        return false;
+
+    // A buffer that hit an error limit ends early, and its EOF is not at the end of the source
+    size_t error_limit = relex_error_limit();
+    if (buffer->error_count >= error_limit)
+        return relex_full(buffer, new_source, out_changed);
+
+    // The EOF token sits at the end of the old source
+    size_t old_length = buffer->offsets[buffer->count - 1];
+    if (edit->offset > old_length || edit->removed_length > old_length - edit->offset)
+        return false;
+    size_t new_length = old_length - edit->removed_length + edit->inserted_length;
+    if (new_length > UINT32_MAX)
+        return false;
+
+    // Keep every token whose successor starts (plus scanner lookahead) before the
+    // edit: the lexer looked at nothing past that point while producing it, even
+    // when it skipped ahead to recover from an error.
+    size_t keep = 0;
+    {
+        size_t low = 0;
+        size_t high = buffer->count - 1; // EOF is never kept
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+            if ((size_t)buffer->offsets[mid + 1] + BAA_RELEX_LOOKAHEAD <= edit->offset)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        keep = low;
+    }
+    // Error tokens point at the character where lexing failed, not where their
+    // call started, so lexing restarts at a regular token where the lexer holds no state
+    while (keep > 0 && baa_token_is_error((BaaTokenType)buffer->kinds[keep]))
+        keep--;
+    size_t restart = keep > 0 ? buffer->offsets[keep] : 0;
+
+    size_t edit_end = edit->offset + edit->inserted_length; // End of the edit in the new source
+
+    BaaTokenBuffer fresh;
+    baa_token_buffer_init(&fresh, new_source);
+
+    BaaLexer lexer;
+    baa_lexer_init_range(&lexer, new_source, restart, new_length);
+
+    size_t resync = buffer->count; // First old token that is reused after the edit
+    size_t cursor = keep;
+    bool ok = true;
+    for (;;)
+    {
+        // Past the edit, the source from here on is the old source shifted. If an old
+        // token started at the same place, the lexer would reproduce it and every
+        // token after it.
+        size_t position = lexer.current;
+        if (position >= edit_end)
+        {
+            size_t old_position = position - edit->inserted_length + edit->removed_length;
+            while (cursor < buffer->count && buffer->offsets[cursor] < old_position)
+                cursor++;
+            if (cursor < buffer->count && buffer->offsets[cursor] == old_position &&
+                !baa_token_is_error((BaaTokenType)buffer->kinds[cursor]))
+            {
+                resync = cursor;
+                break;
+            }
+        }
+
+        BaaToken *token = baa_lexer_next_token(&lexer);
+        if (!token)
+        {
+            ok = false;
+            break;
+        }
+
+        BaaTokenType type = token->type;
+        ok = baa_token_buffer_push(&fresh, token);
+        baa_free_token(token);
+        if (!ok || type == BAA_TOKEN_EOF)
+            break;
+    }
+    baa_cleanup_lexer(&lexer);
+
+    if (!ok)
+    {
+        baa_token_buffer_free(&fresh);
+        return false;
+    }
+
+    size_t old_count = resync - keep;
+    size_t new_count = fresh.count;
+
+    // Reused error tokens stay valid as long as no error limit is reached anywhere
+    size_t removed_errors = 0;
+    for (size_t i = keep; i < resync; i++)
+        removed_errors += baa_token_is_error((BaaTokenType)buffer->kinds[i]);
+    if (buffer->error_count - removed_errors + fresh.error_count >= error_limit)
+    {
+        baa_token_buffer_free(&fresh);
+        return relex_full(buffer, new_source, out_changed);
+    }
+
+    if (!baa_token_buffer_replace(buffer, keep, old_count, &fresh))
+    {
+        baa_token_buffer_free(&fresh);
+        return false;
+    }
+
+    // Reused tokens keep their kind and length; only their position moves
+    uint32_t shift_add = (uint32_t)edit->inserted_length;
+    uint32_t shift_sub = (uint32_t)edit->removed_length;
+    for (size_t i = keep + new_count; i < buffer->count; i++)
+        buffer->offsets[i] = buffer->offsets[i] + shift_add - shift_sub;
+
+    // Error messages carry no positions; only the offset the context centers on moves
+    for (size_t i = buffer->extra_count; buffer->error_count > 0 && i > 0; i--)
+    {
+        BaaTokenExtra *extra = &buffer->extras[i - 1];
+        if (extra->token < keep + new_count)
+            break;
+        if (baa_token_is_error((BaaTokenType)buffer->kinds[extra->token]))
+            extra->error.position = extra->error.position + shift_add - shift_sub;
+    }
+    buffer->source = new_source;
+
+    if (out_changed)
+    {
+        out_changed->first = keep;
+        out_changed->old_count = old_count;
+        out_changed->new_count = new_count;
+    }
+    return true;
+}
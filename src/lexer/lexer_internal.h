@@ -34,12 +34,8 @@ void synchronize_number_error(BaaLexer *lexer);      // Find next non-digit char
 void synchronize_comment_error(BaaLexer *lexer);     // Find next */ or EOF
 void synchronize_general_error(BaaLexer *lexer);     // Current basic strategy
 
-// Source span utilities
-BaaLexerSourceSpan calculate_source_span(BaaLexer *lexer, size_t start_offset);
-void update_token_span(BaaToken *token, BaaLexer *lexer);
-
 // Step 4: Error Context Enhancement - Source Context Extraction
-void extract_error_context(BaaLexer *lexer, size_t error_position,
+void extract_error_context(const wchar_t *source, size_t error_position,
                           wchar_t **before_context, wchar_t **after_context);
 size_t calculate_error_character_position(BaaLexer *lexer);
 wchar_t* get_current_line_content(BaaLexer *lexer, size_t line_number);
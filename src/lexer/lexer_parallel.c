@@ -0,0 +1,332 @@
+// src/lexer/lexer_parallel.c
+#include "baa/lexer/lexer_parallel.h"
+#include "baa/utils/threads.h"
+#include "lexer_internal.h" // For is_arabic_letter and friends
+#include <stdlib.h>
+#include <string.h>
+#include <wctype.h>
+
+// Chunks smaller than this are not worth a thread of their own
+#define BAA_PARALLEL_MIN_CHUNK_CHARS 16384
+
+// Upper bound on worker threads, regardless of what the caller asks for
+#define BAA_PARALLEL_MAX_THREADS 64
+
+// --- Safe split point pre-scan ---
+
+typedef enum
+{
+    PRESCAN_NORMAL,
+    PRESCAN_LINE_COMMENT,
+    PRESCAN_BLOCK_COMMENT,        // Also covers doc comments /** */
+    PRESCAN_STRING,               // "..."
+    PRESCAN_MULTILINE_STRING,     // """..."""
+    PRESCAN_RAW_STRING,           // خ"..."
+    PRESCAN_RAW_MULTILINE_STRING, // خ"""..."""
+    PRESCAN_CHAR                  // '...'
+} BaaPrescanState;
+
+static bool is_triple_quote(const wchar_t *source, size_t length, size_t i)
+{
+    return i + 2 < length && source[i] == L'"' && source[i + 1] == L'"' && source[i + 2] == L'"';
+}
+
+size_t baa_lexer_find_split_points(const wchar_t *source, size_t source_length,
+                                   size_t max_chunks, size_t *out_splits)
+{
+    if (!source || !out_splits || max_chunks < 2 || source_length == 0)
+        return 0;
+
+    size_t wanted = max_chunks - 1;
+    size_t found = 0;
+    size_t next_target = source_length / max_chunks;
+
+    BaaPrescanState state = PRESCAN_NORMAL;
+    bool in_identifier = false; // Tracks whether 'خ' would continue an identifier
+    size_t i = 0;
+
+    while (i < source_length && found < wanted)
+    {
+        wchar_t c = source[i];
+        switch (state)
+        {
+        case PRESCAN_NORMAL:
+            if (c == L'\n')
+            {
+                in_identifier = false;
+                // "\r\n" is a single NEWLINE token, so never split between the two
+                if (i >= next_target && (i == 0 || source[i - 1] != L'\r'))
+                {
+                    out_splits[found++] = i;
+                    next_target = (found + 1) * (source_length / max_chunks);
+                }
+                i++;
+            }
+            else if (c == L'/' && i + 1 < source_length && source[i + 1] == L'/')
+            {
+                state = PRESCAN_LINE_COMMENT;
+                in_identifier = false;
+                i += 2;
+            }
+            else if (c == L'/' && i + 1 < source_length && source[i + 1] == L'*')
+            {
+                state = PRESCAN_BLOCK_COMMENT;
+                in_identifier = false;
+                i += 2;
+            }
+            else if (c == L'"')
+            {
+                bool triple = is_triple_quote(source, source_length, i);
+                state = triple ? PRESCAN_MULTILINE_STRING : PRESCAN_STRING;
+                in_identifier = false;
+                i += triple ? 3 : 1;
+            }
+            else if (c == L'\'')
+            {
+                state = PRESCAN_CHAR;
+                in_identifier = false;
+                i++;
+            }
+            else if (c == L'\u062E' && !in_identifier && i + 1 < source_length && source[i + 1] == L'"')
+            {
+                bool triple = is_triple_quote(source, source_length, i + 1);
+                state = triple ? PRESCAN_RAW_MULTILINE_STRING : PRESCAN_RAW_STRING;
+                i += triple ? 4 : 2;
+            }
+            else
+            {
+                // Mirrors the identifier rules of baa_lexer_next_token/scan_identifier
+                if (in_identifier)
+                    in_identifier = iswalnum(c) || c == L'_' || is_arabic_letter(c) || is_arabic_digit(c);
+                else
+                    in_identifier = iswalpha(c) || c == L'_' || is_arabic_letter(c);
+                i++;
+            }
+            break;
+
+        case PRESCAN_LINE_COMMENT:
+            if (c == L'\n')
+                state = PRESCAN_NORMAL; // Newline is handled (and may split) in normal state
+            else
+                i++;
+            break;
+
+        case PRESCAN_BLOCK_COMMENT:
+            if (c == L'*' && i + 1 < source_length && source[i + 1] == L'/')
+            {
+                state = PRESCAN_NORMAL;
+                i += 2;
+            }
+            else
+                i++;
+            break;
+
+        case PRESCAN_STRING:
+            if (c == L'\\')
+                i += 2;
+            else
+            {
+                if (c == L'"')
+                    state = PRESCAN_NORMAL;
+                i++;
+            }
+            break;
+
+        case PRESCAN_MULTILINE_STRING:
+            if (c == L'\\')
+                i += 2;
+            else if (is_triple_quote(source, source_length, i))
+            {
+                state = PRESCAN_NORMAL;
+                i += 3;
+            }
+            else
+                i++;
+            break;
+
+        case PRESCAN_RAW_STRING:
+            if (c == L'\n')
+                state = PRESCAN_NORMAL; // Lexer reports an error here; the newline is not consumed
+            else
+            {
+                if (c == L'"')
+                    state = PRESCAN_NORMAL;
+                i++;
+            }
+            break;
+
+        case PRESCAN_RAW_MULTILINE_STRING:
+            if (is_triple_quote(source, source_length, i))
+            {
+                state = PRESCAN_NORMAL;
+                i += 3;
+            }
+            else
+                i++;
+            break;
+
+        case PRESCAN_CHAR:
+            if (c == L'\\')
+                i += 2;
+            else if (c == L'\n')
+                state = PRESCAN_NORMAL;
+            else
+            {
+                if (c == L'\'')
+                    state = PRESCAN_NORMAL;
+                i++;
+            }
+            break;
+        }
+    }
+
+    return found;
+}
+
+// --- Chunk lexing ---
+
+typedef struct
+{
+    const wchar_t *source;
+    size_t begin;       // First offset of the chunk
+    size_t end;         // One past the last offset of the chunk
+    bool is_last;       // Only the last chunk keeps its EOF token
+    BaaTokenBuffer tokens;
+    bool had_error;     // A lexical error token was produced
+    bool failed;        // Allocation failure
+} BaaLexChunk;
+
+/**
+ * Lexes [begin, end) of the source with a lexer that sees `end` as the end of input.
+ * Stops early on the first lexical error, since the caller then falls back to
+ * sequential lexing anyway.
+ */
+static int lex_chunk(void *arg)
+{
+    BaaLexChunk *chunk = (BaaLexChunk *)arg;
+
+    BaaLexer lexer;
+    baa_lexer_init_range(&lexer, chunk->source, chunk->begin, chunk->end);
+
+    for (;;)
+    {
+        BaaToken *token = baa_lexer_next_token(&lexer);
+        if (!token)
+        {
+            chunk->failed = true;
+            break;
+        }
+
+        BaaTokenType type = token->type;
+        if (baa_token_is_error(type))
+        {
+            chunk->had_error = true;
+            baa_free_token(token);
+            break;
+        }
+
+        if ((type != BAA_TOKEN_EOF || chunk->is_last) && !baa_token_buffer_push(&chunk->tokens, token))
+        {
+            chunk->failed = true;
+            baa_free_token(token);
+            break;
+        }
+        baa_free_token(token);
+
+        if (type == BAA_TOKEN_EOF)
+            break;
+    }
+
+    baa_cleanup_lexer(&lexer);
+    return chunk->failed ? 1 : 0;
+}
+
+bool baa_lex_parallel(const wchar_t *source, size_t thread_count, BaaTokenBuffer *out_tokens)
+{
+    if (!source || !out_tokens)
+        return false;
+
+    baa_token_buffer_init(out_tokens, source);
+
+    size_t source_length = wcslen(source);
+    if (source_length > UINT32_MAX)
+        return false;
+    if (thread_count == 0)
+        thread_count = baa_thread_hardware_concurrency();
+    if (thread_count > BAA_PARALLEL_MAX_THREADS)
+        thread_count = BAA_PARALLEL_MAX_THREADS;
+    if (thread_count > source_length / BAA_PARALLEL_MIN_CHUNK_CHARS)
+        thread_count = source_length / BAA_PARALLEL_MIN_CHUNK_CHARS;
+
+    size_t splits[BAA_PARALLEL_MAX_THREADS];
+    size_t split_count = 0;
+    if (thread_count >= 2)
+        split_count = baa_lexer_find_split_points(source, source_length, thread_count, splits);
+
+    if (split_count == 0)
+        return baa_lex_all(source, out_tokens);
+
+    size_t chunk_count = split_count + 1;
+    BaaLexChunk *chunks = calloc(chunk_count, sizeof(BaaLexChunk));
+    BaaThread *threads = calloc(chunk_count, sizeof(BaaThread));
+    bool *started = calloc(chunk_count, sizeof(bool));
+    if (!chunks || !threads || !started)
+    {
+        free(chunks);
+        free(threads);
+        free(started);
+        return false;
+    }
+
+    for (size_t i = 0; i < chunk_count; i++)
+    {
+        chunks[i].source = source;
+        chunks[i].begin = i == 0 ? 0 : splits[i - 1];
+        chunks[i].end = i == split_count ? source_length : splits[i];
+        chunks[i].is_last = i == split_count;
+        baa_token_buffer_init(&chunks[i].tokens, source);
+    }
+
+    // The calling thread lexes the first chunk itself
+    for (size_t i = 1; i < chunk_count; i++)
+    {
+        started[i] = baa_thread_create(&threads[i], lex_chunk, &chunks[i]);
+        if (!started[i])
+            lex_chunk(&chunks[i]); // Could not start a thread; do the work inline
+    }
+    lex_chunk(&chunks[0]);
+
+    bool failed = false;
+    bool had_error = false;
+    for (size_t i = 0; i < chunk_count; i++)
+    {
+        if (started[i] && !baa_thread_join(&threads[i], NULL))
+            chunks[i].failed = true;
+        failed = failed || chunks[i].failed;
+        had_error = had_error || chunks[i].had_error;
+    }
+
+    bool ok = !failed;
+    if (ok && !had_error)
+    {
+        // Stitch the chunk buffers together in source order
+        for (size_t i = 0; i < chunk_count && ok; i++)
+            ok = baa_token_buffer_append(out_tokens, &chunks[i].tokens);
+    }
+
+    for (size_t i = 0; i < chunk_count; i++)
+        baa_token_buffer_free(&chunks[i].tokens);
+    free(chunks);
+    free(threads);
+    free(started);
+
+    if (ok && had_error)
+    {
+        // Error recovery may cross a chunk boundary and error limits are global,
+        // so reproduce the exact sequential behaviour.
+        return baa_lex_all(source, out_tokens);
+    }
+    if (!ok)
+        baa_token_buffer_free(out_tokens);
+    return ok;
+}
@@ -3,6 +3,14 @@
 #include <string.h>
 #include <math.h>
 #include <limits.h>
+#include <stdint.h>
+#include <wchar.h>
+#include <stdio.h>
+#include "number_parser_pow5.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 
 // Forward declaration for baa_is_arabic_digit
 bool baa_is_arabic_digit(wchar_t c);
@@ -13,23 +21,6 @@ static const wchar_t ARABIC_TAH_SUFFIX = L'ط';   // U+0637 (long)
 static const wchar_t ARABIC_HAH_SUFFIX = L'ح';   // U+062D (float)
 
 
-// Arabic-Indic digits (٠١٢٣٤٥٦٧٨٩)
-static const wchar_t ARABIC_DIGITS[] = {0x0660, 0x0661, 0x0662, 0x0663, 0x0664,
-                                        0x0665, 0x0666, 0x0667, 0x0668, 0x0669};
-
-// Convert Arabic-Indic digit to decimal value
-static int arabic_to_decimal(wchar_t c)
-{
-    for (int i = 0; i < 10; i++)
-    {
-        if (c == ARABIC_DIGITS[i])
-        {
-            return i;
-        }
-    }
-    return -1; // Not an Arabic digit
-}
-
 // Convert hexadecimal digit to decimal value
 static int hex_to_decimal(wchar_t c)
 {
@@ -71,311 +62,608 @@ bool baa_is_number_start(wchar_t c)
     return baa_is_digit(c) || c == '.' || c == L'٫' || c == '0'; // 0 might be start of hex/bin
 }
 
-// Parse hexadecimal integer
-static BaaNumberError parse_hex_integer(const wchar_t *text, size_t *pos, size_t length, long long *value)
+// Value of an ASCII or Arabic-Indic decimal digit, or -1
+static inline int decimal_digit_value(wchar_t c)
 {
-    long long result = 0;
-    bool has_digits = false;
+    if ((unsigned)(c - L'0') < 10u)
+        return (int)(c - L'0');
+    if ((unsigned)(c - 0x0660) < 10u)
+        return (int)(c - 0x0660);
+    return -1;
+}
+
+// Largest exponent magnitude tracked; anything beyond already over/underflows a double
+#define BAA_NUMBER_EXPONENT_LIMIT 100000
 
-    while (*pos < length && baa_is_hex_digit(text[*pos]))
+/**
+ * Parses the digits of an 'أ' exponent (optional sign, digits, underscores).
+ * The exponent is clamped so huge values cannot overflow an int.
+ */
+static BaaNumberError parse_exponent_digits(const wchar_t *text, size_t *pos, size_t length, int *out_exponent)
+{
+    bool is_negative = false;
+    if (*pos < length && (text[*pos] == L'+' || text[*pos] == L'-'))
     {
-        has_digits = true;
-        int digit = hex_to_decimal(text[*pos]);
+        is_negative = text[*pos] == L'-';
+        (*pos)++;
+    }
 
-        // Check for overflow (16 is the hexadecimal base)
-        if (result > (LLONG_MAX - digit) / 16)
+    int exponent = 0;
+    bool has_digits = false;
+    for (; *pos < length; (*pos)++)
+    {
+        int digit = decimal_digit_value(text[*pos]);
+        if (digit < 0)
         {
-            return BAA_NUM_OVERFLOW;
+            if (text[*pos] == L'_')
+                continue;
+            break;
         }
-
-        result = result * 16 + digit;
-        (*pos)++;
+        has_digits = true;
+        if (exponent < BAA_NUMBER_EXPONENT_LIMIT)
+            exponent = exponent * 10 + digit;
     }
 
     if (!has_digits)
-    {
         return BAA_NUM_INVALID_FORMAT;
-    }
 
-    *value = result;
+    *out_exponent = is_negative ? -exponent : exponent;
     return BAA_NUM_SUCCESS;
 }
 
-// Parse binary integer
-static BaaNumberError parse_binary_integer(const wchar_t *text, size_t *pos, size_t length, long long *value)
-{
-    long long result = 0;
-    bool has_digits = false;
+// --- Decimal to double conversion (Eisel-Lemire) ---
 
-    while (*pos < length && (text[*pos] == '0' || text[*pos] == '1'))
-    {
-        has_digits = true;
-        int digit = text[*pos] - '0';
+// Exactly representable powers of ten (10^0 .. 10^22)
+static const double EXACT_POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
 
-        // Check for overflow (2 is the binary base)
-        if (result > (LLONG_MAX - digit) / 2)
-        {
-            return BAA_NUM_OVERFLOW;
-        }
+// IEEE-754 binary64 parameters
+#define BAA_DOUBLE_MANTISSA_BITS 52
+#define BAA_DOUBLE_MIN_EXPONENT (-1023)
+#define BAA_DOUBLE_INFINITE_POWER 0x7FF
 
-        result = result * 2 + digit;
-        (*pos)++;
-    }
+// Significant digits kept by the slow path; more cannot change the rounding
+#define BAA_SLOW_PATH_DIGITS 800
 
-    if (!has_digits)
+static inline int leading_zeros64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return 63 - (int)index;
+#else
+    int count = 0;
+    while (!(x & 0x8000000000000000ULL))
     {
-        return BAA_NUM_INVALID_FORMAT;
+        x <<= 1;
+        count++;
     }
+    return count;
+#endif
+}
 
-    *value = result;
-    return BAA_NUM_SUCCESS;
+// Full 64x64 -> 128 bit multiplication
+static inline void multiply_64x64(uint64_t a, uint64_t b, uint64_t *out_high, uint64_t *out_low)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = (unsigned __int128)a * b;
+    *out_high = (uint64_t)(product >> 64);
+    *out_low = (uint64_t)product;
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *out_low = _umul128(a, b, out_high);
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+    *out_high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    *out_low = (cross << 32) | (uint32_t)lo_lo;
+#endif
 }
 
-// Parse exponent part of scientific notation
-static BaaNumberError parse_exponent(const wchar_t *text, size_t *pos, size_t length, int *exponent)
+static inline double double_from_parts(uint64_t mantissa, int32_t power2)
 {
-    bool is_negative = false;
-    if (*pos < length && (text[*pos] == '+' || text[*pos] == '-'))
+    uint64_t bits = mantissa | ((uint64_t)power2 << BAA_DOUBLE_MANTISSA_BITS);
+    double result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+/**
+ * Eisel-Lemire conversion of w * 10^q to the nearest double.
+ * Correctly rounded for every w that is the exact decimal significand.
+ * See Lemire, "Number Parsing at a Gigabyte per Second" (2021).
+ */
+static double eisel_lemire(uint64_t w, int q)
+{
+    if (w == 0 || q < BAA_POW5_MIN_EXPONENT)
+        return 0.0;
+    if (q > BAA_POW5_MAX_EXPONENT)
+        return double_from_parts(0, BAA_DOUBLE_INFINITE_POWER);
+
+    int lz = leading_zeros64(w);
+    w <<= lz;
+
+    // 128-bit product with the truncated power of five; the second word is
+    // only needed when the bits below the mantissa might all be ones
+    size_t index = 2 * (size_t)(q - BAA_POW5_MIN_EXPONENT);
+    uint64_t high, low;
+    multiply_64x64(w, BAA_POW5_128[index], &high, &low);
+    const uint64_t precision_mask = 0xFFFFFFFFFFFFFFFFULL >> (BAA_DOUBLE_MANTISSA_BITS + 3);
+    if ((high & precision_mask) == precision_mask)
     {
-        is_negative = (text[*pos] == '-');
-        (*pos)++;
+        uint64_t second_high, second_low;
+        multiply_64x64(w, BAA_POW5_128[index + 1], &second_high, &second_low);
+        low += second_high;
+        if (second_high > low)
+            high++;
     }
 
-    int exp_value = 0;
-    bool has_digits = false;
+    int upper_bit = (int)(high >> 63);
+    int shift = upper_bit + 64 - BAA_DOUBLE_MANTISSA_BITS - 3;
+    uint64_t mantissa = high >> shift;
+    // floor(q * log2(10)) + 63, the binary exponent of 10^q scaled to 64 bits
+    int32_t power2 = (int32_t)((((152170 + 65536) * q) >> 16) + 63 + upper_bit - lz - BAA_DOUBLE_MIN_EXPONENT);
 
-    while (*pos < length && baa_is_digit(text[*pos]))
+    if (power2 <= 0)
     {
-        has_digits = true;
-        int digit;
+        // Subnormal result
+        if (-power2 + 1 >= 64)
+            return 0.0;
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        power2 = mantissa < (1ULL << BAA_DOUBLE_MANTISSA_BITS) ? 0 : 1;
+        return double_from_parts(mantissa & ~(1ULL << BAA_DOUBLE_MANTISSA_BITS), power2);
+    }
 
-        if (baa_is_arabic_digit(text[*pos]))
+    // Exactly halfway between two doubles: round to even
+    if (low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == high)
+        mantissa &= ~1ULL;
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (2ULL << BAA_DOUBLE_MANTISSA_BITS))
+    {
+        mantissa = 1ULL << BAA_DOUBLE_MANTISSA_BITS;
+        power2++;
+    }
+    mantissa &= ~(1ULL << BAA_DOUBLE_MANTISSA_BITS);
+
+    if (power2 >= BAA_DOUBLE_INFINITE_POWER)
+        return double_from_parts(0, BAA_DOUBLE_INFINITE_POWER);
+    return double_from_parts(mantissa, power2);
+}
+
+/**
+ * Slow path for literals with more than 19 significant digits whose rounding
+ * depends on the dropped digits. The significant digits are copied into a
+ * fixed-size stack buffer as "DDDD...e<exp>" and handed to strtod.
+ * Digits past BAA_SLOW_PATH_DIGITS only act as a sticky bit.
+ */
+static double slow_decimal_to_double(const wchar_t *text, size_t length)
+{
+    char buffer[BAA_SLOW_PATH_DIGITS + 32];
+    size_t count = 0;
+    long point = 0; // Position of the decimal point relative to the first significant digit
+    bool seen_point = false;
+    bool seen_nonzero = false;
+    bool sticky = false;
+    int exponent = 0;
+
+    for (size_t pos = 0; pos < length; pos++)
+    {
+        wchar_t c = text[pos];
+        int digit = decimal_digit_value(c);
+        if (digit >= 0)
         {
-            digit = arabic_to_decimal(text[*pos]);
+            if (!seen_nonzero && digit == 0)
+            {
+                if (seen_point)
+                    point--;
+                continue;
+            }
+            seen_nonzero = true;
+            if (!seen_point)
+                point++;
+            if (count < BAA_SLOW_PATH_DIGITS)
+                buffer[count++] = (char)('0' + digit);
+            else if (digit != 0)
+                sticky = true;
         }
-        else
+        else if (c == L'.' || c == L'٫')
+            seen_point = true;
+        else if (c == L'أ')
         {
-            digit = text[*pos] - '0';
+            pos++;
+            parse_exponent_digits(text, &pos, length, &exponent);
+            break;
         }
+        else if (c != L'_')
+            break; // Suffix
+    }
 
-        // Limit exponent to reasonable size to prevent overflow
-        if (exp_value > (INT_MAX - digit) / 10)
-        {
-            return BAA_NUM_OVERFLOW;
-        }
+    if (count == 0)
+        return 0.0;
+    if (sticky)
+        buffer[count++] = '1'; // One more digit, already scaled by `count` below
 
-        exp_value = exp_value * 10 + digit;
-        (*pos)++;
-    }
+    // The digits are an integer, so no locale-dependent decimal point is needed
+    snprintf(buffer + count, sizeof(buffer) - count, "e%ld", point - (long)count + exponent);
+    return strtod(buffer, NULL);
+}
 
-    if (!has_digits)
+/**
+ * Converts a parsed decimal literal to the nearest double.
+ *
+ * @param mantissa First (up to) 19 significant digits.
+ * @param exp10 Decimal exponent such that the value is mantissa * 10^exp10.
+ * @param truncated True if non-zero digits were dropped from the mantissa.
+ * @param text Full literal text, used only by the slow path.
+ * @param length Length of text.
+ */
+static double decimal_to_double(uint64_t mantissa, int exp10, bool truncated,
+                                const wchar_t *text, size_t length)
+{
+    // Clinger's fast path: both operands are exact, so one IEEE operation rounds correctly
+    if (!truncated && mantissa <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22)
     {
-        return BAA_NUM_INVALID_FORMAT;
+        double m = (double)mantissa;
+        return exp10 < 0 ? m / EXACT_POWERS_OF_TEN[-exp10] : m * EXACT_POWERS_OF_TEN[exp10];
     }
 
-    *exponent = is_negative ? -exp_value : exp_value;
-    return BAA_NUM_SUCCESS;
+    double result = eisel_lemire(mantissa, exp10);
+    if (!truncated)
+        return result;
+
+    // The true value lies between mantissa and mantissa + 1 (times 10^exp10)
+    if (eisel_lemire(mantissa + 1, exp10) == result)
+        return result;
+    return slow_decimal_to_double(text, length);
 }
 
-static BaaNumberError parse_integer_part(const wchar_t *text, size_t *pos, size_t length, long long *value)
+/**
+ * Parses Arabic numeric suffixes (غ، ط، طط، ح) into literal flags.
+ * Stops at the first character that is not an acceptable suffix.
+ */
+static void parse_suffix_flags(const wchar_t *text, size_t *pos, size_t length, BaaLiteralValue *value)
 {
-    long long result = 0;
-    bool has_digits = false;
+    bool ghain_seen = false;
+    int tah_count = 0; // 0 = none, 1 = long, 2 = long long
 
-    while (*pos < length && baa_is_digit(text[*pos]))
+    // Process up to 3 suffix characters (max possible: ططغ)
+    for (int i = 0; i < 3 && *pos < length; ++i)
     {
-        has_digits = true;
-        int digit;
+        wchar_t current_char = text[*pos];
 
-        if (baa_is_arabic_digit(text[*pos]))
+        if (current_char == ARABIC_TAH_SUFFIX && tah_count < 2)
         {
-            digit = arabic_to_decimal(text[*pos]);
+            tah_count++;
+            (*pos)++;
+        }
+        else if (current_char == ARABIC_GHAIN_SUFFIX && !ghain_seen)
+        {
+            ghain_seen = true;
+            value->flags |= BAA_LITERAL_FLAG_UNSIGNED;
+            (*pos)++;
+        }
+        else if (current_char == ARABIC_HAH_SUFFIX)
+        {
+            // Float suffix - promote integer to float if needed
+            if (!(value->flags & BAA_LITERAL_FLAG_FLOAT))
+            {
+                value->float_value = (double)value->int_value;
+                value->flags |= BAA_LITERAL_FLAG_FLOAT;
+            }
+            value->flags |= BAA_LITERAL_FLAG_FLOAT_SUFFIX;
+            (*pos)++;
+            break; // Float suffix should be last
         }
         else
         {
-            digit = text[*pos] - '0';
+            break; // Not a recognized suffix character
         }
+    }
+
+    if (tah_count == 1)
+        value->flags |= BAA_LITERAL_FLAG_LONG;
+    else if (tah_count == 2)
+        value->flags |= BAA_LITERAL_FLAG_LONG_LONG;
+}
 
-        // Check for overflow
-        if (result > (LLONG_MAX - digit) / 10)
+// Parses a 0x/0X literal (integer or hexadecimal float) starting after the prefix
+static BaaNumberError parse_hex_value(const wchar_t *text, size_t *pos, size_t length, BaaLiteralValue *value)
+{
+    uint64_t mantissa = 0;
+    int exp2 = 0;
+    bool has_digits = false;
+    bool overflow = false;
+
+    for (; *pos < length; (*pos)++)
+    {
+        int digit = hex_to_decimal(text[*pos]);
+        if (digit < 0)
+        {
+            if (text[*pos] == L'_')
+                continue;
+            break;
+        }
+        has_digits = true;
+        if (mantissa >> 60)
         {
-            return BAA_NUM_OVERFLOW;
+            overflow = true; // Keep the leading bits; only matters for floats
+            exp2 += 4;
         }
+        else
+            mantissa = mantissa * 16 + (uint64_t)digit;
+    }
 
-        result = result * 10 + digit;
+    bool is_float = false;
+    if (*pos < length && (text[*pos] == L'.' || text[*pos] == L'٫'))
+    {
+        is_float = true;
         (*pos)++;
+        for (; *pos < length; (*pos)++)
+        {
+            int digit = hex_to_decimal(text[*pos]);
+            if (digit < 0)
+            {
+                if (text[*pos] == L'_')
+                    continue;
+                break;
+            }
+            has_digits = true;
+            if (!(mantissa >> 60))
+            {
+                mantissa = mantissa * 16 + (uint64_t)digit;
+                exp2 -= 4;
+            }
+        }
     }
 
     if (!has_digits)
-    {
         return BAA_NUM_INVALID_FORMAT;
+
+    if (*pos < length && text[*pos] == L'أ')
+    {
+        (*pos)++;
+        int exponent = 0;
+        BaaNumberError error = parse_exponent_digits(text, pos, length, &exponent);
+        if (error != BAA_NUM_SUCCESS)
+            return error;
+        exp2 += exponent;
+        is_float = true;
     }
 
-    *value = result;
+    if (is_float)
+    {
+        value->float_value = ldexp((double)mantissa, exp2);
+        value->flags |= BAA_LITERAL_FLAG_FLOAT;
+    }
+    else
+    {
+        value->int_value = mantissa;
+        if (overflow)
+            value->flags |= BAA_LITERAL_FLAG_OVERFLOW;
+    }
     return BAA_NUM_SUCCESS;
 }
 
-// Parse the fractional part of a hexadecimal float
-static BaaNumberError parse_hex_fractional_part(const wchar_t *text, size_t *pos, size_t length, double *value)
+// Parses a 0b/0B integer literal starting after the prefix
+static BaaNumberError parse_binary_value(const wchar_t *text, size_t *pos, size_t length, BaaLiteralValue *value)
 {
-    double result = 0;
-    double place = 1.0 / 16.0;
+    uint64_t result = 0;
     bool has_digits = false;
 
-    while (*pos < length && baa_is_hex_digit(text[*pos]))
+    for (; *pos < length; (*pos)++)
     {
+        wchar_t c = text[*pos];
+        if (c == L'_')
+            continue;
+        if (c != L'0' && c != L'1')
+            break;
         has_digits = true;
-        int digit = hex_to_decimal(text[*pos]);
-        result += digit * place;
-        place /= 16.0;
-        (*pos)++;
+        if (result >> 63)
+            value->flags |= BAA_LITERAL_FLAG_OVERFLOW;
+        result = result * 2 + (uint64_t)(c - L'0');
     }
 
-    // It's okay to have no digits after the point, e.g., "0x1."
-    *value = result;
+    if (!has_digits)
+        return BAA_NUM_INVALID_FORMAT;
+
+    value->int_value = result;
     return BAA_NUM_SUCCESS;
 }
 
-static BaaNumberError parse_decimal_part(const wchar_t *text, size_t *pos, size_t length, double *value)
+// Parses a decimal literal (ASCII/Arabic-Indic digits, '.'/'٫', 'أ' exponent)
+static BaaNumberError parse_decimal_value(const wchar_t *text, size_t *pos, size_t length, BaaLiteralValue *value)
 {
-    double result = 0;
-    double place = 0.1;
+    uint64_t integer = 0;     // Full integer value, valid unless overflow is set
+    uint64_t mantissa = 0;    // Up to 19 significant digits, for floats
+    int significant = 0;      // Significant digits kept in mantissa
+    int exp10 = 0;            // Decimal exponent adjustment for dropped/fraction digits
+    bool truncated = false;   // Non-zero digits were dropped from mantissa
     bool has_digits = false;
+    bool overflow = false;
+    bool is_float = false;
 
-    while (*pos < length && baa_is_digit(text[*pos]))
+    // Integer part
+    for (; *pos < length; (*pos)++)
     {
+        int digit = decimal_digit_value(text[*pos]);
+        if (digit < 0)
+        {
+            if (text[*pos] == L'_')
+                continue;
+            break;
+        }
         has_digits = true;
-        int digit;
-
-        if (baa_is_arabic_digit(text[*pos]))
+        if (integer > (UINT64_MAX - (uint64_t)digit) / 10)
+            overflow = true;
+        integer = integer * 10 + (uint64_t)digit;
+        if (significant < 19)
         {
-            digit = arabic_to_decimal(text[*pos]);
+            mantissa = mantissa * 10 + (uint64_t)digit;
+            if (mantissa != 0)
+                significant++;
         }
         else
         {
-            digit = text[*pos] - '0';
+            exp10++; // Dropped digit, still scales the value
+            truncated = truncated || digit != 0;
         }
+    }
 
-        result += digit * place;
-        place /= 10;
+    // Fractional part
+    if (*pos < length && (text[*pos] == L'.' || text[*pos] == L'٫'))
+    {
+        is_float = true;
         (*pos)++;
+        for (; *pos < length; (*pos)++)
+        {
+            wchar_t c = text[*pos];
+            int digit = decimal_digit_value(c);
+            if (digit < 0)
+            {
+                if (c == L'_')
+                    continue;
+                if (c == L'.' || c == L'٫')
+                    return BAA_NUM_MULTIPLE_DOTS;
+                break;
+            }
+            has_digits = true;
+            if (significant < 19)
+            {
+                mantissa = mantissa * 10 + (uint64_t)digit;
+                if (mantissa != 0)
+                    significant++;
+                exp10--;
+            }
+            else
+                truncated = truncated || digit != 0;
+        }
     }
 
     if (!has_digits)
-    {
         return BAA_NUM_INVALID_FORMAT;
+
+    // Exponent part
+    if (*pos < length && text[*pos] == L'أ')
+    {
+        (*pos)++;
+        int exponent = 0;
+        BaaNumberError error = parse_exponent_digits(text, pos, length, &exponent);
+        if (error != BAA_NUM_SUCCESS)
+            return error;
+        exp10 += exponent;
+        is_float = true;
     }
 
-    *value = result;
-    return BAA_NUM_SUCCESS;
-}
+    if (is_float)
+    {
+        value->float_value = decimal_to_double(mantissa, exp10, truncated, text, length);
+        value->flags |= BAA_LITERAL_FLAG_FLOAT;
+        return BAA_NUM_SUCCESS;
+    }
 
-/**
- * Initialize suffix flags in a BaaNumber struct to false.
- * Should be called when creating a new BaaNumber.
- */
-static void initialize_suffix_flags(BaaNumber *number)
-{
-    number->is_unsigned = false;
-    number->is_long = false;
-    number->is_long_long = false;
-    number->has_float_suffix = false;
+    value->int_value = integer;
+    if (overflow)
+        value->flags |= BAA_LITERAL_FLAG_OVERFLOW;
+    return BAA_NUM_SUCCESS;
 }
 
 /**
- * Parse Arabic numeric suffixes from the text starting at position *pos.
- * Updates the BaaNumber struct with appropriate suffix flags.
+ * Parses a numeric literal lexeme into a value and suffix flags without allocating.
  *
- * @param text The input text containing the number and suffixes
- * @param pos Pointer to current position (will be updated)
- * @param length Total length of the text
- * @param number The BaaNumber struct to update with suffix information
+ * Accepts everything scan_number produces: ASCII and Arabic-Indic digits,
+ * '_' separators, 0x/0b prefixes, '.' or '٫' decimal separators, 'أ'
+ * exponents and the غ/ط/طط/ح suffixes. Integer overflow is reported through
+ * BAA_LITERAL_FLAG_OVERFLOW rather than as an error.
  */
-static void parse_arabic_suffixes(const wchar_t *text, size_t *pos, size_t length, BaaNumber *number)
+BaaNumberError baa_parse_number_value(const wchar_t *text, size_t length, BaaLiteralValue *out_value)
 {
-    bool ghain_seen = false;
-    int tah_count = 0; // 0 = none, 1 = long, 2 = long long
+    if (!text || !out_value || length == 0)
+        return BAA_NUM_INVALID_FORMAT;
 
-    // Process up to 3 suffix characters (max possible: ططغ)
-    for (int i = 0; i < 3 && *pos < length; ++i)
-    {
-        wchar_t current_char = text[*pos];
+    out_value->int_value = 0;
+    out_value->flags = 0;
 
-        if (current_char == ARABIC_TAH_SUFFIX)
-        {
-           if (tah_count < 2)
-           { // Allow up to 2 'ط' characters
-                tah_count++;
-                (*pos)++;
-            }
-            else
-            {
-                break; // Already have طط, can't have more
-            }
-        }
-       else if (current_char == ARABIC_GHAIN_SUFFIX)
-        {
-            if (ghain_seen)
-            {
-                break; // Can't have غ twice
-            }
-            number->is_unsigned = true;
-            ghain_seen = true;
-            (*pos)++;
-        }
-        else if (current_char == ARABIC_HAH_SUFFIX)
+    // Fast path: plain decimal integer of at most 19 ASCII or Arabic-Indic digits
+    if (length <= 19)
+    {
+        uint64_t result = 0;
+        size_t i = 0;
+        for (; i < length; i++)
         {
-            // Float suffix - promote integer to float if needed
-            if (number->type == BAA_NUM_INTEGER)
-            {
-                number->type = BAA_NUM_DECIMAL;
-                number->decimal_value = (double)number->int_value;
-            }
-            number->has_float_suffix = true;
-            (*pos)++;
-            break; // Float suffix should be last
+            int digit = decimal_digit_value(text[i]);
+            if (digit < 0)
+                break;
+            result = result * 10 + (uint64_t)digit;
         }
-        else
+        if (i == length)
         {
-            break; // Not a recognized suffix character
+            out_value->int_value = result;
+            return BAA_NUM_SUCCESS;
         }
     }
 
-    // Set final long/long long flags based on count
-    if (tah_count == 1)
+    size_t pos = 0;
+    BaaNumberError error;
+    if (length >= 2 && text[0] == L'0' && (text[1] == L'x' || text[1] == L'X'))
     {
-        number->is_long = true;
+        pos = 2;
+        error = parse_hex_value(text, &pos, length, out_value);
     }
-    else if (tah_count == 2)
+    else if (length >= 2 && text[0] == L'0' && (text[1] == L'b' || text[1] == L'B'))
     {
-        number->is_long_long = true;
+        pos = 2;
+        error = parse_binary_value(text, &pos, length, out_value);
     }
-}
+    else
+    {
+        error = parse_decimal_value(text, &pos, length, out_value);
+    }
+
+    if (error != BAA_NUM_SUCCESS)
+        return error;
 
+    parse_suffix_flags(text, &pos, length, out_value);
+
+    // Unprocessed characters left in the number lexeme
+    if (pos < length)
+        return BAA_NUM_INVALID_FORMAT;
+    return BAA_NUM_SUCCESS;
+}
 
 BaaNumber *baa_parse_number(const wchar_t *text, size_t length, BaaNumberError *error)
 {
-    if (!text || length == 0)
-    {
-        if (error)
-            *error = BAA_NUM_INVALID_FORMAT;
-        return NULL;
-    }
+    BaaLiteralValue value;
+    BaaNumberError parse_error = baa_parse_number_value(text, length, &value);
 
-    BaaNumber *number = (BaaNumber *)malloc(sizeof(BaaNumber));
-    if (!number)
+    // BaaNumber holds signed integers, so anything above LLONG_MAX overflows
+    if (parse_error == BAA_NUM_SUCCESS && !(value.flags & BAA_LITERAL_FLAG_FLOAT) &&
+        ((value.flags & BAA_LITERAL_FLAG_OVERFLOW) || value.int_value > (uint64_t)LLONG_MAX))
+        parse_error = BAA_NUM_OVERFLOW;
+
+    if (parse_error != BAA_NUM_SUCCESS)
     {
         if (error)
-            *error = BAA_NUM_MEMORY_ERROR;
+            *error = parse_error;
         return NULL;
     }
-    initialize_suffix_flags(number); // Initialize new suffix flags
 
-    // Copy the raw text
+    BaaNumber *number = (BaaNumber *)malloc(sizeof(BaaNumber));
     wchar_t *raw_text = (wchar_t *)malloc((length + 1) * sizeof(wchar_t));
-    if (!raw_text)
+    if (!number || !raw_text)
     {
         free(number);
+        free(raw_text);
         if (error)
             *error = BAA_NUM_MEMORY_ERROR;
         return NULL;
@@ -385,218 +673,20 @@ BaaNumber *baa_parse_number(const wchar_t *text, size_t length, BaaNumberError *
 
     number->raw_text = raw_text;
     number->text_length = length;
+    number->is_unsigned = (value.flags & BAA_LITERAL_FLAG_UNSIGNED) != 0;
+    number->is_long = (value.flags & BAA_LITERAL_FLAG_LONG) != 0;
+    number->is_long_long = (value.flags & BAA_LITERAL_FLAG_LONG_LONG) != 0;
+    number->has_float_suffix = (value.flags & BAA_LITERAL_FLAG_FLOAT_SUFFIX) != 0;
 
-    size_t pos = 0;
-    BaaNumberError parse_error = BAA_NUM_SUCCESS;
-
-    // Handle hexadecimal format (0x...)
-    if (length >= 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+    if (value.flags & BAA_LITERAL_FLAG_FLOAT)
     {
-        pos = 2; // Skip "0x" prefix
-
-        // Check for hex float (must have 'أ' for exponent)
-        bool is_hex_float = false;
-        for (size_t i = pos; i < length; i++) {
-            if (text[i] == L'أ') {
-                is_hex_float = true;
-                break;
-            }
-        }
-
-        if (is_hex_float) {
-            long long int_part = 0;
-            double frac_part = 0.0;
-
-            // Parse integer part (can be empty)
-            size_t start_pos = pos;
-            if (text[pos] != '.') {
-                parse_error = parse_hex_integer(text, &pos, length, &int_part);
-            } else {
-                parse_error = BAA_NUM_SUCCESS; // No integer part, which is valid
-            }
-
-            // Parse fractional part if a dot is present
-            if (pos < length && text[pos] == '.') {
-                pos++; // Skip '.'
-                parse_error = parse_hex_fractional_part(text, &pos, length, &frac_part);
-            }
-
-            if (parse_error == BAA_NUM_SUCCESS) {
-                // Parse exponent
-                if (pos < length && text[pos] == L'أ') {
-                    pos++; // Skip 'أ'
-                    int exponent;
-                    parse_error = parse_exponent(text, &pos, length, &exponent);
-                    if (parse_error == BAA_NUM_SUCCESS) {
-                        number->type = BAA_NUM_SCIENTIFIC;
-                        double mantissa = (double)int_part + frac_part;
-                        number->decimal_value = mantissa * pow(2.0, exponent);
-                    }
-                } else {
-                    parse_error = BAA_NUM_INVALID_FORMAT; // Missing exponent
-                }
-            }
-        } else {
-            // Regular hex integer
-            long long int_value;
-            parse_error = parse_hex_integer(text, &pos, length, &int_value);
-
-            if (parse_error == BAA_NUM_SUCCESS)
-            {
-                number->type = BAA_NUM_INTEGER;
-                number->int_value = int_value;
-            }
-        }
-    }
-    // Handle binary format (0b...)
-    else if (length >= 2 && text[0] == '0' && (text[1] == 'b' || text[1] == 'B'))
-    {
-        pos = 2; // Skip "0b" prefix
-        long long int_value;
-        parse_error = parse_binary_integer(text, &pos, length, &int_value);
-
-        if (parse_error == BAA_NUM_SUCCESS)
-        {
-            number->type = BAA_NUM_INTEGER;
-            number->int_value = int_value;
-        }
+        number->type = wmemchr(text, L'أ', length) ? BAA_NUM_SCIENTIFIC : BAA_NUM_DECIMAL;
+        number->decimal_value = value.float_value;
     }
     else
     {
-        // Check for scientific notation or decimal point
-        bool is_decimal = false;
-        bool is_scientific = false;
-        
-        for (size_t i = 0; i < length; i++)
-        {
-            if (text[i] == '.' || text[i] == L'٫')
-            {
-                if (is_decimal)
-                {
-                    free(raw_text);
-                    free(number);
-                    if (error)
-                        *error = BAA_NUM_MULTIPLE_DOTS;
-                    return NULL;
-                }
-                is_decimal = true;
-            }
-            // UPDATED: Check for Arabic exponent marker 'أ' instead of 'e'/'E'
-            else if (text[i] == L'أ')
-            {
-                is_scientific = true;
-                break;
-            }
-        }
-
-        if (!is_decimal && !is_scientific)
-        {
-            // Parse regular integer
-            long long int_value;
-            parse_error = parse_integer_part(text, &pos, length, &int_value);
-
-            if (parse_error == BAA_NUM_SUCCESS)
-            {
-                number->type = BAA_NUM_INTEGER;
-                number->int_value = int_value;
-            }
-        }
-        else if (is_scientific)
-        {
-            // Parse scientific notation (e.g., 1.23e4 or 5e-3)
-            long long int_part = 0;
-            double dec_part = 0.0;
-            bool has_dec_point = false;
-            
-            // Find position of 'e' or 'E'
-            size_t e_pos = 0;
-            for (e_pos = 0; e_pos < length; e_pos++)
-            {
-                // UPDATED: Check for Arabic exponent marker 'أ' instead of 'e'/'E'
-                if (text[e_pos] == L'أ')
-                    break;
-                if (text[e_pos] == '.' || text[e_pos] == L'٫')
-                    has_dec_point = true;
-            }
-            
-            // Parse mantissa (part before 'e')
-            if (has_dec_point)
-            {
-                // Parse integer part
-                parse_error = parse_integer_part(text, &pos, e_pos, &int_part);
-                
-                if (parse_error == BAA_NUM_SUCCESS)
-                {
-                    // Skip decimal point
-                    pos++;
-                    
-                    // Parse decimal part
-                    parse_error = parse_decimal_part(text, &pos, e_pos, &dec_part);
-                }
-            }
-            else
-            {
-                // No decimal point, just parse integer
-                parse_error = parse_integer_part(text, &pos, e_pos, &int_part);
-            }
-            
-            // Parse exponent
-            if (parse_error == BAA_NUM_SUCCESS)
-            {
-                pos = e_pos + 1; // Skip 'e' or 'E'
-                int exponent;
-                parse_error = parse_exponent(text, &pos, length, &exponent);
-                
-                if (parse_error == BAA_NUM_SUCCESS)
-                {
-                    number->type = BAA_NUM_SCIENTIFIC;
-                    double mantissa = (double)int_part + dec_part;
-                    number->decimal_value = mantissa * pow(10.0, exponent);
-                }
-            }
-        }
-        else
-        {
-            // Parse regular decimal number
-            long long int_part = 0;
-            double dec_part = 0.0;
-
-            // Parse integer part
-            parse_error = parse_integer_part(text, &pos, length, &int_part);
-            if (parse_error == BAA_NUM_SUCCESS)
-            {
-                // Skip decimal point
-                pos++;
-
-                // Parse decimal part
-                parse_error = parse_decimal_part(text, &pos, length, &dec_part);
-                if (parse_error == BAA_NUM_SUCCESS)
-                {
-                    number->type = BAA_NUM_DECIMAL;
-                    number->decimal_value = (double)int_part + dec_part;
-                }
-            }
-        }
-    }
-
-    if (parse_error != BAA_NUM_SUCCESS)
-    {
-        free(raw_text);
-        free(number);
-        if (error)
-            *error = BAA_NUM_SUCCESS;
-        return NULL;
-    }
-
-    // --- NEW: Parse Arabic suffixes ---
-    parse_arabic_suffixes(text, &pos, length, number);
-
-    if (pos < length) {
-        // There are unprocessed characters left in the number lexeme
-        free(raw_text);
-        free(number);
-        if (error) *error = BAA_NUM_INVALID_FORMAT;
-        return NULL;
+        number->type = BAA_NUM_INTEGER;
+        number->int_value = (long long)value.int_value;
     }
 
     if (error)
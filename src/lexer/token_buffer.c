@@ -0,0 +1,359 @@
+// src/lexer/token_buffer.c
+#include "baa/lexer/token_buffer.h"
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+void baa_token_buffer_init(BaaTokenBuffer *buffer, const wchar_t *source)
+{
+    if (!buffer)
+        return;
+    memset(buffer, 0, sizeof(BaaTokenBuffer));
+    buffer->source = source;
+}
+
+void baa_token_buffer_free(BaaTokenBuffer *buffer)
+{
+    if (!buffer)
+        return;
+
+    for (size_t i = 0; i < buffer->extra_count; i++)
+        free(buffer->extras[i].text);
+    free(buffer->extras);
+    free(buffer->kinds);
+    free(buffer->offsets);
+    free(buffer->lengths);
+    baa_token_buffer_init(buffer, buffer->source);
+}
+
+static bool token_buffer_reserve(BaaTokenBuffer *buffer, size_t needed)
+{
+    if (needed <= buffer->capacity)
+        return true;
+
+    size_t new_capacity = buffer->capacity ? buffer->capacity : 64;
+    while (new_capacity < needed)
+        new_capacity *= 2;
+
+    // Each array is grown separately; a failure leaves the old ones valid
+    uint8_t *kinds = realloc(buffer->kinds, new_capacity * sizeof(uint8_t));
+    if (!kinds)
+        return false;
+    buffer->kinds = kinds;
+
+    uint32_t *offsets = realloc(buffer->offsets, new_capacity * sizeof(uint32_t));
+    if (!offsets)
+        return false;
+    buffer->offsets = offsets;
+
+    uint32_t *lengths = realloc(buffer->lengths, new_capacity * sizeof(uint32_t));
+    if (!lengths)
+        return false;
+    buffer->lengths = lengths;
+
+    buffer->capacity = new_capacity;
+    return true;
+}
+
+static bool token_buffer_reserve_extras(BaaTokenBuffer *buffer, size_t needed)
+{
+    if (needed <= buffer->extra_capacity)
+        return true;
+
+    size_t new_capacity = buffer->extra_capacity ? buffer->extra_capacity : 16;
+    while (new_capacity < needed)
+        new_capacity *= 2;
+
+    BaaTokenExtra *extras = realloc(buffer->extras, new_capacity * sizeof(BaaTokenExtra));
+    if (!extras)
+        return false;
+
+    buffer->extras = extras;
+    buffer->extra_capacity = new_capacity;
+    return true;
+}
+
+// Longest opening delimiter of a string literal (خ""")
+#define BAA_STRING_MAX_OPENING 4
+
+// Returns where a string token's lexeme starts within its source span, or 0 if
+// the lexeme is not a slice of the span (the literal had escapes)
+static uint32_t string_body_offset(const BaaTokenBuffer *buffer, const BaaToken *token, size_t span_length)
+{
+    if (token->type != BAA_TOKEN_STRING_LIT || !token->lexeme || !buffer->source)
+        return 0;
+
+    for (size_t offset = 1; offset <= BAA_STRING_MAX_OPENING && offset + token->length <= span_length; offset++)
+    {
+        if (wmemcmp(token->lexeme, buffer->source + token->start_offset + offset, token->length) == 0)
+            return (uint32_t)offset;
+    }
+    return 0;
+}
+
+bool baa_token_buffer_push(BaaTokenBuffer *buffer, BaaToken *token)
+{
+    if (!buffer || !token || token->end_offset < token->start_offset)
+        return false;
+    if (token->end_offset > UINT32_MAX)
+        return false;
+    if (!token_buffer_reserve(buffer, buffer->count + 1))
+        return false;
+
+    size_t span_length = token->end_offset - token->start_offset;
+
+    // Most lexemes are exactly their source slice and need no side table entry
+    bool text_is_slice = token->lexeme && buffer->source &&
+                         token->length == span_length &&
+                         wmemcmp(token->lexeme, buffer->source + token->start_offset, span_length) == 0;
+    bool is_number = token->type == BAA_TOKEN_INT_LIT || token->type == BAA_TOKEN_FLOAT_LIT;
+    bool is_error = baa_token_is_error(token->type);
+    if (!text_is_slice || is_error || is_number)
+    {
+        if (!token_buffer_reserve_extras(buffer, buffer->extra_count + 1))
+            return false;
+
+        BaaTokenExtra *extra = &buffer->extras[buffer->extra_count++];
+        extra->token = (uint32_t)buffer->count;
+        extra->text = NULL;
+        extra->text_length = 0;
+        extra->text_offset = 0;
+        extra->error = token->error;
+        extra->literal = token->literal;
+
+        // Escape-free string bodies are the span minus the delimiters (", """, خ", خ""")
+        uint32_t inner_offset = text_is_slice ? 0 : string_body_offset(buffer, token, span_length);
+        if (inner_offset)
+        {
+            extra->text_offset = inner_offset;
+            extra->text_length = (uint32_t)token->length;
+        }
+        else if (!text_is_slice)
+        {
+            extra->text = token->lexeme;
+            extra->text_length = (uint32_t)token->length;
+            token->lexeme = NULL;
+        }
+    }
+
+    if (is_error)
+        buffer->error_count++;
+
+    size_t index = buffer->count++;
+    buffer->kinds[index] = (uint8_t)token->type;
+    buffer->offsets[index] = (uint32_t)token->start_offset;
+    buffer->lengths[index] = (uint32_t)span_length;
+    return true;
+}
+
+bool baa_token_buffer_append(BaaTokenBuffer *buffer, BaaTokenBuffer *other)
+{
+    if (!buffer || !other)
+        return false;
+    if (!token_buffer_reserve(buffer, buffer->count + other->count) ||
+        !token_buffer_reserve_extras(buffer, buffer->extra_count + other->extra_count))
+        return false;
+
+    memcpy(buffer->kinds + buffer->count, other->kinds, other->count * sizeof(uint8_t));
+    memcpy(buffer->offsets + buffer->count, other->offsets, other->count * sizeof(uint32_t));
+    memcpy(buffer->lengths + buffer->count, other->lengths, other->count * sizeof(uint32_t));
+
+    for (size_t i = 0; i < other->extra_count; i++)
+    {
+        BaaTokenExtra extra = other->extras[i];
+        extra.token += (uint32_t)buffer->count;
+        buffer->extras[buffer->extra_count++] = extra;
+    }
+    buffer->count += other->count;
+    buffer->error_count += other->error_count;
+
+    // Side table entries now belong to `buffer`
+    other->extra_count = 0;
+    baa_token_buffer_free(other);
+    return true;
+}
+
+// Returns the index of the first side table entry whose token is >= index
+static size_t token_buffer_lower_bound(const BaaTokenBuffer *buffer, size_t index)
+{
+    // Entries are appended in token order, so binary search by token index
+    size_t low = 0;
+    size_t high = buffer->extra_count;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (buffer->extras[mid].token < index)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+bool baa_token_buffer_replace(BaaTokenBuffer *buffer, size_t first, size_t old_count,
+                              BaaTokenBuffer *replacement)
+{
+    if (!buffer || !replacement || first > buffer->count || old_count > buffer->count - first)
+        return false;
+
+    size_t new_count = buffer->count - old_count + replacement->count;
+    if (new_count > UINT32_MAX)
+        return false;
+
+    size_t extra_begin = token_buffer_lower_bound(buffer, first);
+    size_t extra_end = token_buffer_lower_bound(buffer, first + old_count);
+    size_t new_extra_count = buffer->extra_count - (extra_end - extra_begin) + replacement->extra_count;
+
+    // Grow first so a failure leaves the buffer untouched
+    if (!token_buffer_reserve(buffer, new_count) ||
+        !token_buffer_reserve_extras(buffer, new_extra_count))
+        return false;
+
+    // Error tokens always have a side table entry, so the removed ones are found there
+    size_t removed_errors = 0;
+    for (size_t i = extra_begin; i < extra_end; i++)
+    {
+        removed_errors += baa_token_is_error((BaaTokenType)buffer->kinds[buffer->extras[i].token]);
+        free(buffer->extras[i].text);
+    }
+
+    // Tokens after the replaced range shift to their new position
+    size_t tail = buffer->count - first - old_count;
+    size_t src = first + old_count;
+    size_t dst = first + replacement->count;
+    memmove(buffer->kinds + dst, buffer->kinds + src, tail * sizeof(uint8_t));
+    memmove(buffer->offsets + dst, buffer->offsets + src, tail * sizeof(uint32_t));
+    memmove(buffer->lengths + dst, buffer->lengths + src, tail * sizeof(uint32_t));
+    memcpy(buffer->kinds + first, replacement->kinds, replacement->count * sizeof(uint8_t));
+    memcpy(buffer->offsets + first, replacement->offsets, replacement->count * sizeof(uint32_t));
+    memcpy(buffer->lengths + first, replacement->lengths, replacement->count * sizeof(uint32_t));
+
+    size_t extra_tail = buffer->extra_count - extra_end;
+    memmove(buffer->extras + extra_begin + replacement->extra_count, buffer->extras + extra_end,
+            extra_tail * sizeof(BaaTokenExtra));
+    for (size_t i = 0; i < extra_tail; i++)
+    {
+        BaaTokenExtra *extra = &buffer->extras[extra_begin + replacement->extra_count + i];
+        extra->token = (uint32_t)(extra->token - old_count + replacement->count);
+    }
+    for (size_t i = 0; i < replacement->extra_count; i++)
+    {
+        BaaTokenExtra extra = replacement->extras[i];
+        extra.token += (uint32_t)first;
+        buffer->extras[extra_begin + i] = extra;
+    }
+
+    buffer->count = new_count;
+    buffer->extra_count = new_extra_count;
+    buffer->error_count = buffer->error_count - removed_errors + replacement->error_count;
+
+    // Side table entries now belong to `buffer`
+    replacement->extra_count = 0;
+    baa_token_buffer_free(replacement);
+    return true;
+}
+
+const BaaTokenExtra *baa_token_buffer_extra(const BaaTokenBuffer *buffer, size_t index)
+{
+    if (!buffer || buffer->extra_count == 0)
+        return NULL;
+
+    size_t low = token_buffer_lower_bound(buffer, index);
+    if (low < buffer->extra_count && buffer->extras[low].token == index)
+        return &buffer->extras[low];
+    return NULL;
+}
+
+const wchar_t *baa_token_buffer_lexeme(const BaaTokenBuffer *buffer, size_t index, size_t *out_length)
+{
+    if (!buffer || index >= buffer->count)
+    {
+        if (out_length)
+            *out_length = 0;
+        return NULL;
+    }
+
+    const BaaTokenExtra *extra = baa_token_buffer_extra(buffer, index);
+    if (extra && extra->text)
+    {
+        if (out_length)
+            *out_length = extra->text_length;
+        return extra->text;
+    }
+    if (extra && extra->text_offset)
+    {
+        if (out_length)
+            *out_length = extra->text_length;
+        return buffer->source + buffer->offsets[index] + extra->text_offset;
+    }
+
+    if (out_length)
+        *out_length = buffer->lengths[index];
+    return buffer->source + buffer->offsets[index];
+}
+
+const BaaLexerError *baa_token_buffer_error(const BaaTokenBuffer *buffer, size_t index)
+{
+    if (!buffer || index >= buffer->count || !baa_token_is_error((BaaTokenType)buffer->kinds[index]))
+        return NULL;
+    const BaaTokenExtra *extra = baa_token_buffer_extra(buffer, index);
+    return extra ? &extra->error : NULL;
+}
+
+BaaErrorContext *baa_token_buffer_error_context(const BaaTokenBuffer *buffer, size_t index)
+{
+    const BaaLexerError *error = baa_token_buffer_error(buffer, index);
+    if (!error)
+        return NULL;
+    return baa_build_error_context((BaaTokenType)buffer->kinds[index], error, buffer->source);
+}
+
+const BaaLiteralValue *baa_token_buffer_literal(const BaaTokenBuffer *buffer, size_t index)
+{
+    if (!buffer || index >= buffer->count)
+        return NULL;
+    if (buffer->kinds[index] != BAA_TOKEN_INT_LIT && buffer->kinds[index] != BAA_TOKEN_FLOAT_LIT)
+        return NULL;
+    const BaaTokenExtra *extra = baa_token_buffer_extra(buffer, index);
+    return extra ? &extra->literal : NULL;
+}
+
+bool baa_lex_all(const wchar_t *source, BaaTokenBuffer *out_buffer)
+{
+    if (!source || !out_buffer)
+        return false;
+
+    baa_token_buffer_init(out_buffer, source);
+
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, NULL);
+    if (lexer.source_length > UINT32_MAX)
+    {
+        baa_cleanup_lexer(&lexer);
+        return false;
+    }
+
+    // Rough estimate of one token per four characters avoids most regrowth
+    bool ok = token_buffer_reserve(out_buffer, lexer.source_length / 4 + 1);
+    while (ok)
+    {
+        BaaToken *token = baa_lexer_next_token(&lexer);
+        if (!token)
+        {
+            ok = false;
+            break;
+        }
+
+        BaaTokenType type = token->type;
+        ok = baa_token_buffer_push(out_buffer, token);
+        baa_free_token(token);
+
+        if (type == BAA_TOKEN_EOF)
+            break;
+    }
+
+    baa_cleanup_lexer(&lexer);
+    if (!ok)
+        baa_token_buffer_free(out_buffer);
+    return ok;
+}
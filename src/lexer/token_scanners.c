@@ -16,6 +16,57 @@
 
 // NUM_KEYWORDS is now declared as extern const size_t in lexer_internal.h
 
+/**
+ * Creates a literal token whose processed lexeme is exactly the source slice
+ * [body_start, body_start + body_length), i.e. a literal without escapes.
+ * The lexeme is copied in one piece instead of character by character.
+ */
+static BaaToken *make_literal_slice_token(BaaLexer *lexer, BaaTokenType type, size_t body_start, size_t body_length)
+{
+    BaaToken *token = malloc(sizeof(BaaToken));
+    if (!token)
+        return NULL;
+
+    wchar_t *lexeme = malloc((body_length + 1) * sizeof(wchar_t));
+    if (!lexeme)
+    {
+        free(token);
+        return NULL;
+    }
+    wmemcpy(lexeme, lexer->source + body_start, body_length);
+    lexeme[body_length] = L'\0';
+
+    token->type = type;
+    token->lexeme = lexeme;
+    token->length = body_length;
+    token->start_offset = lexer->start;
+    token->end_offset = lexer->current;
+
+    // Non-error tokens carry no error information
+    token->error = (BaaLexerError){0};
+    token->literal = (BaaLiteralValue){0};
+
+    return token;
+}
+
+// Starts the buffered (escape-resolving) path with the escape-free prefix already scanned
+static wchar_t *seed_literal_buffer(BaaLexer *lexer, size_t body_start, size_t min_capacity,
+                                    size_t *buffer_len, size_t *buffer_cap)
+{
+    size_t prefix_length = lexer->current - body_start;
+    size_t capacity = min_capacity;
+    while (capacity <= prefix_length + 1)
+        capacity *= 2;
+
+    wchar_t *buffer = malloc(capacity * sizeof(wchar_t));
+    if (!buffer)
+        return NULL;
+    wmemcpy(buffer, lexer->source + body_start, prefix_length);
+    *buffer_len = prefix_length;
+    *buffer_cap = capacity;
+    return buffer;
+}
+
 BaaToken *scan_identifier(BaaLexer *lexer)
 {
     // lexer->start is already set before calling this function
@@ -79,8 +130,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                     BAA_TOKEN_ERROR_INVALID_NUMBER,
                     1005, "number",
                     L"أضف رقم سداسي عشري صالح بعد 0x",
-                    L"عدد سداسي عشر غير صالح: يجب أن يتبع البادئة 0x/0X رقم سداسي عشري أو فاصلة عشرية (السطر %zu، العمود %zu)",
-                    lexer->line, lexer->column);
+                    L"عدد سداسي عشر غير صالح: يجب أن يتبع البادئة 0x/0X رقم سداسي عشري أو فاصلة عشرية");
                 baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                 enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                 return error_token;
@@ -99,8 +149,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                     BAA_TOKEN_ERROR_INVALID_NUMBER,
                     1005, "number",
                     L"أضف رقم ثنائي صالح (0 أو 1) بعد 0b",
-                    L"عدد ثنائي غير صالح: يجب أن يتبع البادئة 0b/0B رقم ثنائي واحد على الأقل (السطر %zu، العمود %zu)",
-                    lexer->line, lexer->column);
+                    L"عدد ثنائي غير صالح: يجب أن يتبع البادئة 0b/0B رقم ثنائي واحد على الأقل");
                 baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                 enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                 return error_token;
@@ -136,8 +185,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                     BAA_TOKEN_ERROR_INVALID_NUMBER,
                     1005, "number",
                     L"استخدم الشرطة السفلية لفصل الأرقام فقط، وليس في البداية أو متتالية",
-                    L"شرطة سفلية غير صالحة في العدد: متتالية أو مباشرة بعد البادئة (السطر %zu، العمود %zu).",
-                    lexer->line, lexer->column);
+                    L"شرطة سفلية غير صالحة في العدد: متتالية أو مباشرة بعد البادئة.");
                 baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                 enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                 return error_token;
@@ -159,8 +207,7 @@ BaaToken *scan_number(BaaLexer *lexer)
             BAA_TOKEN_ERROR_INVALID_NUMBER,
             1005, "number",
             L"احذف الشرطة السفلية من نهاية الرقم",
-            L"شرطة سفلية غير صالحة في العدد (السطر %zu، العمود %zu): لا يمكن أن تكون في نهاية الرقم.",
-            lexer->line, lexer->column - 1);
+            L"شرطة سفلية غير صالحة في العدد: لا يمكن أن تكون في نهاية الرقم.");
         baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
         enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
         return error_token;
@@ -179,8 +226,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                 BAA_TOKEN_ERROR_INVALID_NUMBER,
                 1005, "number",
                 L"أضف رقم بعد الفاصلة العشرية قبل الشرطة السفلية",
-                L"شرطة سفلية غير صالحة في العدد (السطر %zu، العمود %zu): لا يمكن أن تتبع الفاصلة العشرية مباشرة.",
-                lexer->line, lexer->column + 1);
+                L"شرطة سفلية غير صالحة في العدد: لا يمكن أن تتبع الفاصلة العشرية مباشرة.");
             baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
             enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
             return error_token;
@@ -202,8 +248,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                             BAA_TOKEN_ERROR_INVALID_NUMBER,
                             1005, "number",
                             L"استخدم شرطة سفلية واحدة فقط لفصل الأرقام",
-                            L"شرطة سفلية غير صالحة في العدد (السطر %zu، العمود %zu): لا يمكن أن تكون متتالية.",
-                            lexer->line, lexer->column);
+                            L"شرطة سفلية غير صالحة في العدد: لا يمكن أن تكون متتالية.");
                         baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                         enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                         return error_token;
@@ -224,8 +269,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                     BAA_TOKEN_ERROR_INVALID_NUMBER,
                     1005, "number",
                     L"احذف الشرطة السفلية من نهاية الجزء الكسري",
-                    L"شرطة سفلية غير صالحة في العدد (السطر %zu، العمود %zu): لا يمكن أن تكون في نهاية الجزء الكسري.",
-                    lexer->line, lexer->column - 1);
+                    L"شرطة سفلية غير صالحة في العدد: لا يمكن أن تكون في نهاية الجزء الكسري.");
                 baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                 enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                 return error_token;
@@ -250,8 +294,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                 BAA_TOKEN_ERROR_INVALID_NUMBER,
                 1005, "number",
                 L"أضف رقم بعد علامة الأس 'أ' قبل الشرطة السفلية",
-                L"شرطة سفلية غير صالحة في العدد (السطر %zu، العمود %zu): لا يمكن أن تتبع علامة الأس 'أ' مباشرة.",
-                lexer->line, lexer->column + 1);
+                L"شرطة سفلية غير صالحة في العدد: لا يمكن أن تتبع علامة الأس 'أ' مباشرة.");
             baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
             enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
             return error_token;
@@ -271,8 +314,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                         BAA_TOKEN_ERROR_INVALID_NUMBER,
                         1005, "number",
                         L"أضف رقم بعد علامة الأس (+/-) قبل الشرطة السفلية",
-                        L"شرطة سفلية غير صالحة في العدد (السطر %zu، العمود %zu): لا يمكن أن تتبع علامة الأس (+/-) في الأس 'أ' مباشرة.",
-                        lexer->line, lexer->column + 2);
+                        L"شرطة سفلية غير صالحة في العدد: لا يمكن أن تتبع علامة الأس (+/-) في الأس 'أ' مباشرة.");
                     baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                     enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                     return error_token;
@@ -302,8 +344,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                     BAA_TOKEN_ERROR_INVALID_NUMBER,
                     1005, "number",
                     L"أضف رقم صالح بعد علامة الأس 'أ'",
-                    L"تنسيق أس غير صالح بعد 'أ' (السطر %zu، العمود %zu)",
-                    lexer->line, lexer->column);
+                    L"تنسيق أس غير صالح بعد 'أ'");
                 baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                 enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                 return error_token;
@@ -322,8 +363,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                             BAA_TOKEN_ERROR_INVALID_NUMBER,
                             1005, "number",
                             L"استخدم شرطة سفلية واحدة فقط لفصل الأرقام في الأس",
-                            L"شرطة سفلية غير صالحة في العدد (السطر %zu، العمود %zu): لا يمكن أن تكون متتالية في الأس.",
-                            lexer->line, lexer->column);
+                            L"شرطة سفلية غير صالحة في العدد: لا يمكن أن تكون متتالية في الأس.");
                         baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                         enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                         return error_token;
@@ -344,8 +384,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                     BAA_TOKEN_ERROR_INVALID_NUMBER,
                     1005, "number",
                     L"احذف الشرطة السفلية من نهاية الأس",
-                    L"شرطة سفلية غير صالحة في العدد (السطر %zu، العمود %zu): لا يمكن أن تكون في نهاية الأس.",
-                    lexer->line, lexer->column - 1);
+                    L"شرطة سفلية غير صالحة في العدد: لا يمكن أن تكون في نهاية الأس.");
                 baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                 enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_NUMBER);
                 return error_token;
@@ -377,8 +416,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                         BAA_TOKEN_ERROR_INVALID_SUFFIX,
                         1006, "number",
                         L"استخدم لاحقة غ واحدة فقط للأعداد غير المُوقعة",
-                        L"لاحقة رقم غير صالحة: لا يمكن استخدام 'غ' أكثر من مرة (السطر %zu، العمود %zu)",
-                        lexer->line, lexer->column);
+                        L"لاحقة رقم غير صالحة: لا يمكن استخدام 'غ' أكثر من مرة");
                     baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_SUFFIX);
                     enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_SUFFIX);
                     return error_token;
@@ -395,8 +433,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                         BAA_TOKEN_ERROR_INVALID_SUFFIX,
                         1006, "number",
                         L"استخدم لاحقات صالحة: ط (long) أو طط (long long)",
-                        L"لاحقة رقم غير صالحة: لا يمكن استخدام أكثر من 'طط' (السطر %zu، العمود %zu)",
-                        lexer->line, lexer->column);
+                        L"لاحقة رقم غير صالحة: لا يمكن استخدام أكثر من 'طط'");
                     baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_SUFFIX);
                     enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_SUFFIX);
                     return error_token;
@@ -424,8 +461,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                         BAA_TOKEN_ERROR_INVALID_SUFFIX,
                         1006, "number",
                         L"لاحقة 'ح' مخصصة للأعداد العشرية فقط",
-                        L"لاحقة رقم غير صالحة: لا يمكن استخدام 'ح' مع الأعداد الصحيحة (السطر %zu، العمود %zu)",
-                        lexer->line, lexer->column);
+                        L"لاحقة رقم غير صالحة: لا يمكن استخدام 'ح' مع الأعداد الصحيحة");
                     baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_SUFFIX);
                     enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_SUFFIX);
                     return error_token;
@@ -444,8 +480,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                 BAA_TOKEN_ERROR_INVALID_SUFFIX,
                 1006, "number",
                 L"استخدم لاحقات صالحة: غ (unsigned)، ط (long)، طط (long long)، ح (float)",
-                L"لاحقة رقم غير صالحة: تركيبة لاحقات غير مدعومة (السطر %zu، العمود %zu)",
-                lexer->line, lexer->column);
+                L"لاحقة رقم غير صالحة: تركيبة لاحقات غير مدعومة");
             baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_SUFFIX);
             enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_SUFFIX);
             return error_token;
@@ -476,8 +511,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                     BAA_TOKEN_ERROR_INVALID_SUFFIX,
                     1006, "number",
                     L"لاحقة 'ح' يجب أن تكون الأخيرة في الأعداد العشرية",
-                    L"لاحقة رقم غير صالحة: لا يمكن إضافة لاحقات بعد 'ح' (السطر %zu، العمود %zu)",
-                    lexer->line, lexer->column);
+                    L"لاحقة رقم غير صالحة: لا يمكن إضافة لاحقات بعد 'ح'");
                 baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_SUFFIX);
                 enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_SUFFIX);
                 return error_token;
@@ -493,8 +527,7 @@ BaaToken *scan_number(BaaLexer *lexer)
                     BAA_TOKEN_ERROR_INVALID_SUFFIX,
                     1006, "number",
                     L"استخدم لاحقة 'ح' للأعداد العشرية",
-                    L"لاحقة رقم غير صالحة: لاحقات الأعداد الصحيحة غير مدعومة للأعداد العشرية (السطر %zu، العمود %zu)",
-                    lexer->line, lexer->column);
+                    L"لاحقة رقم غير صالحة: لاحقات الأعداد الصحيحة غير مدعومة للأعداد العشرية");
                 baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_SUFFIX);
                 enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_SUFFIX);
                 return error_token;
@@ -502,28 +535,46 @@ BaaToken *scan_number(BaaLexer *lexer)
         }
     }
 
-    return make_token(lexer, is_float ? BAA_TOKEN_FLOAT_LIT : BAA_TOKEN_INT_LIT);
+    BaaToken *token = make_token(lexer, is_float ? BAA_TOKEN_FLOAT_LIT : BAA_TOKEN_INT_LIT);
+    if (token)
+    {
+        // The lexeme has been validated above, so parsing only computes the value.
+        // Doing it here once means the parser never re-parses the lexeme.
+        baa_parse_number_value(&lexer->source[lexer->start], lexer->current - lexer->start, &token->literal);
+    }
+    return token;
 }
 
 BaaToken *scan_string(BaaLexer *lexer)
 {
+    // lexer->start is at the opening quote. advance() consumes it.
+    advance(lexer); // Consume opening quote "
+
+    // Fast path: most strings contain no escapes. Find the closing quote in one
+    // scan and take the body straight from the source.
+    size_t body_start = lexer->current;
+    while (lexer->current < lexer->source_length &&
+           lexer->source[lexer->current] != L'"' && lexer->source[lexer->current] != L'\\')
+        lexer->current++;
+    if (lexer->current < lexer->source_length && lexer->source[lexer->current] == L'"')
+    {
+        size_t body_length = lexer->current - body_start;
+        advance(lexer); // Consume closing quote "
+        return make_literal_slice_token(lexer, BAA_TOKEN_STRING_LIT, body_start, body_length);
+    }
+
+    // A backslash (or the end of input) was found: resolve escapes from here on
     size_t buffer_cap = 64;
     size_t buffer_len = 0;
-    wchar_t *buffer = malloc(buffer_cap * sizeof(wchar_t));
+    wchar_t *buffer = seed_literal_buffer(lexer, body_start, buffer_cap, &buffer_len, &buffer_cap);
     if (!buffer)
     {
         return make_specific_error_token(lexer,
             BAA_TOKEN_ERROR,
             9001, "memory",
             L"تحقق من توفر ذاكرة كافية في النظام",
-            L"فشل في تخصيص ذاكرة لسلسلة نصية (السطر %zu)",
-            lexer->line);
+            L"فشل في تخصيص ذاكرة لسلسلة نصية");
     }
-    size_t start_line = lexer->line;
-    // lexer->start is at the opening quote. advance() consumes it.
-    // Column should be where the quote was.
-    size_t start_col = lexer->column;
-    advance(lexer); // Consume opening quote "
 
     while (peek(lexer) != L'"' && !is_at_end(lexer))
     {
@@ -567,8 +618,7 @@ BaaToken *scan_string(BaaLexer *lexer)
                         BAA_TOKEN_ERROR_INVALID_ESCAPE,
                         1002, "escape",
                         L"استخدم تسلسل هروب صالح مثل \\س أو \\م أو \\يXXXX",
-                        L"تسلسل هروب يونيكود غير صالح (\\يXXXX) في سلسلة نصية (بدأت في السطر %zu، العمود %zu)",
-                        start_line, start_col);
+                        L"تسلسل هروب يونيكود غير صالح (\\يXXXX) في سلسلة نصية");
                     baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                     enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                     return error_token;
@@ -589,8 +639,7 @@ BaaToken *scan_string(BaaLexer *lexer)
                             BAA_TOKEN_ERROR_INVALID_ESCAPE,
                             1002, "escape",
                             L"استخدم تسلسل هروب صالح مثل \\هـ01 إلى \\هـFF",
-                            L"تسلسل هروب سداسي عشري '\\هـHH' غير صالح في سلسلة نصية (بدأت في السطر %zu، العمود %zu)",
-                            start_line, start_col);
+                            L"تسلسل هروب سداسي عشري '\\هـHH' غير صالح في سلسلة نصية");
                     }
                     append_char_to_buffer(&buffer, &buffer_len, &buffer_cap, (wchar_t)byte_val);
                 }
@@ -601,8 +650,7 @@ BaaToken *scan_string(BaaLexer *lexer)
                         BAA_TOKEN_ERROR_INVALID_ESCAPE,
                         1002, "escape",
                         L"استخدم \\هـHH للهروب السداسي عشري",
-                        L"تسلسل هروب غير صالح: '\\ه' يجب أن يتبعها 'ـ' في سلسلة نصية (بدأت في السطر %zu، العمود %zu)",
-                        start_line, start_col);
+                        L"تسلسل هروب غير صالح: '\\ه' يجب أن يتبعها 'ـ' في سلسلة نصية");
                 }
                 break;
             }
@@ -612,8 +660,8 @@ BaaToken *scan_string(BaaLexer *lexer)
                     BAA_TOKEN_ERROR_INVALID_ESCAPE,
                     1002, "escape",
                     L"استخدم تسلسل هروب صالح مثل \\س أو \\م أو \\يXXXX",
-                    L"تسلسل هروب غير صالح '\\%lc' في سلسلة نصية (بدأت في السطر %zu، العمود %zu)",
-                    baa_escape_char_key, start_line, start_col);
+                    L"تسلسل هروب غير صالح '\\%lc' في سلسلة نصية",
+                    baa_escape_char_key);
                 baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                 enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                 return error_token;
@@ -623,24 +671,17 @@ BaaToken *scan_string(BaaLexer *lexer)
                     BAA_TOKEN_ERROR,
                     9001, "memory",
                     L"تحقق من توفر ذاكرة كافية في النظام",
-                    L"فشل في إعادة تخصيص ذاكرة لسلسلة نصية (السطر %zu)",
-                    start_line);
+                    L"فشل في إعادة تخصيص ذاكرة لسلسلة نصية");
         }
         else
         {
-            if (c == L'\n')
-            {
-                lexer->line++;
-                lexer->column = 0;
-            } // Track newlines inside string
             append_char_to_buffer(&buffer, &buffer_len, &buffer_cap, c);
             if (buffer == NULL)
                 return make_specific_error_token(lexer,
                     BAA_TOKEN_ERROR,
                     9001, "memory",
                     L"تحقق من توفر ذاكرة كافية في النظام",
-                    L"فشل في إعادة تخصيص ذاكرة لسلسلة نصية (السطر %zu)",
-                    start_line);
+                    L"فشل في إعادة تخصيص ذاكرة لسلسلة نصية");
             advance(lexer);
         }
     }
@@ -652,8 +693,7 @@ BaaToken *scan_string(BaaLexer *lexer)
             BAA_TOKEN_ERROR_UNTERMINATED_STRING,
             1001, "string",
             L"أضف علامة اقتباس مزدوجة \" في نهاية السلسلة",
-            L"سلسلة نصية غير منتهية (بدأت في السطر %zu، العمود %zu)",
-            start_line, start_col);
+            L"سلسلة نصية غير منتهية");
         baa_increment_error_count(lexer, BAA_TOKEN_ERROR_UNTERMINATED_STRING);
         if (!is_at_end(lexer))
             enhanced_synchronize(lexer, BAA_TOKEN_ERROR_UNTERMINATED_STRING); // Don't synchronize if already at EOF
@@ -666,8 +706,7 @@ BaaToken *scan_string(BaaLexer *lexer)
             BAA_TOKEN_ERROR,
             9001, "memory",
             L"تحقق من توفر ذاكرة كافية في النظام",
-            L"فشل في إعادة تخصيص الذاكرة عند إنهاء السلسلة النصية (بدأت في السطر %zu)",
-            start_line);
+            L"فشل في إعادة تخصيص الذاكرة عند إنهاء السلسلة النصية");
 
     // For make_token, lexer->start should be at the opening quote, lexer->current should be after closing quote.
     // The external dispatcher (baa_lexer_next_token) sets lexer->start.
@@ -682,26 +721,19 @@ BaaToken *scan_string(BaaLexer *lexer)
     token->type = BAA_TOKEN_STRING_LIT;
     token->lexeme = buffer;         // Transfer ownership of buffer
     token->length = buffer_len - 1; // Don't count our internal null terminator
-    token->line = start_line;
-    token->column = start_col;
+    token->start_offset = lexer->start;
+    token->end_offset = lexer->current;
 
-    // Initialize span (enhanced source location)
-    token->span.start_line = start_line;
-    token->span.start_column = start_col;
-    token->span.end_line = lexer->line;
-    token->span.end_column = lexer->column;
-    token->span.start_offset = lexer->start;
-    token->span.end_offset = lexer->current;
-
-    // Initialize error context to NULL for non-error tokens
-    token->error = NULL;
+    // Non-error tokens carry no error information
+    token->error = (BaaLexerError){0};
+    token->literal = (BaaLiteralValue){0};
 
     return token;
 }
 
 // Scans a documentation comment /** ... */
 // Assumes the initial /** has already been consumed.
-BaaToken *scan_doc_comment(BaaLexer *lexer, size_t token_start_line, size_t token_start_col)
+BaaToken *scan_doc_comment(BaaLexer *lexer)
 {
     size_t buffer_cap = 128;
     size_t buffer_len = 0;
@@ -712,12 +744,11 @@ BaaToken *scan_doc_comment(BaaLexer *lexer, size_t token_start_line, size_t toke
             BAA_TOKEN_ERROR,
             9001, "memory",
             L"تحقق من توفر ذاكرة كافية في النظام",
-            L"فشل في تخصيص ذاكرة لتعليق التوثيق (بدأ في السطر %zu، العمود %zu)",
-            token_start_line, token_start_col);
+            L"فشل في تخصيص ذاكرة لتعليق التوثيق");
     }
 
     // When called, lexer->current is positioned *after* the opening /**
-    // token_start_line/col refer to the position of the initial '/'.
+    // lexer->start refers to the position of the initial '/'.
 
     while (true)
     {
@@ -728,8 +759,7 @@ BaaToken *scan_doc_comment(BaaLexer *lexer, size_t token_start_line, size_t toke
                 BAA_TOKEN_ERROR_UNTERMINATED_COMMENT,
                 1007, "comment",
                 L"أضف */ لإنهاء تعليق التوثيق",
-                L"تعليق توثيق غير منتهٍ (بدأ في السطر %zu، العمود %zu)",
-                token_start_line, token_start_col);
+                L"تعليق توثيق غير منتهٍ");
             return err_token;
         }
 
@@ -752,8 +782,7 @@ BaaToken *scan_doc_comment(BaaLexer *lexer, size_t token_start_line, size_t toke
                 BAA_TOKEN_ERROR,
                 9001, "memory",
                 L"تحقق من توفر ذاكرة كافية في النظام",
-                L"فشل في إعادة تخصيص الذاكرة لتعليق التوثيق (السطر %zu)",
-                token_start_line);
+                L"فشل في إعادة تخصيص الذاكرة لتعليق التوثيق");
         }
     }
 
@@ -764,8 +793,7 @@ BaaToken *scan_doc_comment(BaaLexer *lexer, size_t token_start_line, size_t toke
             BAA_TOKEN_ERROR,
             9001, "memory",
             L"تحقق من توفر ذاكرة كافية في النظام",
-            L"فشل في إعادة تخصيص الذاكرة عند إنهاء تعليق التوثيق (بدأ في السطر %zu)",
-            token_start_line);
+            L"فشل في إعادة تخصيص الذاكرة عند إنهاء تعليق التوثيق");
     }
 
     BaaToken *token = malloc(sizeof(BaaToken));
@@ -778,19 +806,12 @@ BaaToken *scan_doc_comment(BaaLexer *lexer, size_t token_start_line, size_t toke
     token->type = BAA_TOKEN_DOC_COMMENT; // Use the new token type
     token->lexeme = buffer;              // Transfer ownership
     token->length = buffer_len - 1;      // Don't count our internal null terminator
-    token->line = token_start_line;
-    token->column = token_start_col;
-
-    // Initialize span (enhanced source location)
-    token->span.start_line = token_start_line;
-    token->span.start_column = token_start_col;
-    token->span.end_line = lexer->line;
-    token->span.end_column = lexer->column;
-    token->span.start_offset = lexer->start;
-    token->span.end_offset = lexer->current;
+    token->start_offset = lexer->start;
+    token->end_offset = lexer->current;
 
-    // Initialize error context to NULL for non-error tokens
-    token->error = NULL;
+    // Non-error tokens carry no error information
+    token->error = (BaaLexerError){0};
+    token->literal = (BaaLiteralValue){0};
 
     return token;
 }
@@ -800,11 +821,18 @@ BaaToken *scan_char_literal(BaaLexer *lexer)
     // lexer->start is at the opening quote, as set by baa_lexer_next_token
     // advance() in baa_lexer_next_token consumed the opening quote 'c'
     // So, lexer->current is currently at the character *inside* the literal, or the escape sequence.
-    size_t start_line = lexer->line;
-    // The main dispatcher (baa_lexer_next_token) calls advance() to get the opening quote,
-    // then calls this function. So lexer->column is already past the opening quote.
-    // We need the column of the opening quote itself.
-    size_t start_col = lexer->column - 1;
+
+    // Fast path: a plain character followed by the closing quote needs no escape
+    // handling; the token lexeme is the source slice either way
+    if (lexer->current + 1 < lexer->source_length)
+    {
+        wchar_t c = lexer->source[lexer->current];
+        if (c != L'\\' && c != L'\n' && c != L'\'' && lexer->source[lexer->current + 1] == L'\'')
+        {
+            lexer->current += 2; // Consume the character and the closing quote
+            return make_token(lexer, BAA_TOKEN_CHAR_LIT);
+        }
+    }
 
     wchar_t value_char;
 
@@ -826,8 +854,7 @@ BaaToken *scan_char_literal(BaaLexer *lexer)
                 BAA_TOKEN_ERROR_UNTERMINATED_CHAR,
                 1003, "character",
                 L"أضف علامة اقتباس مفردة ' في نهاية المحرف",
-                L"تسلسل هروب غير منته في قيمة حرفية (EOF بعد '\' في السطر %zu، العمود %zu)",
-                start_line, start_col);
+                L"تسلسل هروب غير منته في قيمة حرفية (EOF بعد '\')");
         }
         wchar_t baa_escape_char_key = advance(lexer); // Consume the Arabic escape key char
         switch (baa_escape_char_key)
@@ -862,8 +889,7 @@ BaaToken *scan_char_literal(BaaLexer *lexer)
                     BAA_TOKEN_ERROR_INVALID_ESCAPE,
                     1002, "escape",
                     L"استخدم تسلسل هروب صالح مثل \\س أو \\م أو \\يXXXX",
-                    L"تسلسل هروب يونيكود غير صالح (\\يXXXX) في قيمة حرفية (بدأت في السطر %zu، العمود %zu)",
-                    start_line, start_col);
+                    L"تسلسل هروب يونيكود غير صالح (\\يXXXX) في قيمة حرفية");
                 baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                 enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                 return error_token;
@@ -882,8 +908,7 @@ BaaToken *scan_char_literal(BaaLexer *lexer)
                         BAA_TOKEN_ERROR_INVALID_ESCAPE,
                         1002, "escape",
                         L"استخدم تسلسل هروب صالح مثل \\هـ01 إلى \\هـFF",
-                        L"تسلسل هروب سداسي عشري '\\هـHH' غير صالح في قيمة حرفية (بدأت في السطر %zu، العمود %zu)",
-                        start_line, start_col);
+                        L"تسلسل هروب سداسي عشري '\\هـHH' غير صالح في قيمة حرفية");
                 }
                 value_char = (wchar_t)byte_val;
             }
@@ -893,8 +918,7 @@ BaaToken *scan_char_literal(BaaLexer *lexer)
                     BAA_TOKEN_ERROR_INVALID_ESCAPE,
                     1002, "escape",
                     L"استخدم \\هـHH للهروب السداسي عشري",
-                    L"تسلسل هروب غير صالح: '\\ه' يجب أن يتبعها 'ـ' في قيمة حرفية (بدأت في السطر %zu، العمود %zu)",
-                    start_line, start_col);
+                    L"تسلسل هروب غير صالح: '\\ه' يجب أن يتبعها 'ـ' في قيمة حرفية");
             }
             break;
         default:
@@ -902,8 +926,8 @@ BaaToken *scan_char_literal(BaaLexer *lexer)
                 BAA_TOKEN_ERROR_INVALID_ESCAPE,
                 1002, "escape",
                 L"استخدم تسلسل هروب صالح مثل \\س أو \\م أو \\يXXXX",
-                L"تسلسل هروب غير صالح '\\%lc' في قيمة حرفية (بدأت في السطر %zu، العمود %zu)",
-                baa_escape_char_key, start_line, start_col);
+                L"تسلسل هروب غير صالح '\\%lc' في قيمة حرفية",
+                baa_escape_char_key);
             baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
             enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
             return error_token;
@@ -919,8 +943,7 @@ BaaToken *scan_char_literal(BaaLexer *lexer)
                 BAA_TOKEN_ERROR_INVALID_CHARACTER,
                 1004, "character",
                 L"استخدم تسلسل هروب \\س للسطر الجديد",
-                L"سطر جديد غير مسموح به في قيمة حرفية (بدأت في السطر %zu، العمود %zu)",
-                start_line, start_col);
+                L"سطر جديد غير مسموح به في قيمة حرفية");
             baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_CHARACTER);
             enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_CHARACTER); // Synchronize as this is a recoverable error.
             return error_token;
@@ -931,8 +954,7 @@ BaaToken *scan_char_literal(BaaLexer *lexer)
                 BAA_TOKEN_ERROR_INVALID_CHARACTER,
                 1004, "character",
                 L"أضف محرف بين علامتي الاقتباس المفردتين",
-                L"قيمة حرفية فارغة ('') (بدأت في السطر %zu، العمود %zu)",
-                start_line, start_col);
+                L"قيمة حرفية فارغة ('')");
             baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_CHARACTER);
             enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_CHARACTER);
             return error_token;
@@ -956,8 +978,7 @@ BaaToken *scan_char_literal(BaaLexer *lexer)
                 BAA_TOKEN_ERROR_UNTERMINATED_CHAR,
                 1003, "character",
                 L"أضف علامة اقتباس مفردة ' في نهاية المحرف",
-                L"قيمة حرفية غير منتهية (علامة اقتباس أحادية ' مفقودة، بدأت في السطر %zu، العمود %zu)",
-                start_line, start_col);
+                L"قيمة حرفية غير منتهية (علامة اقتباس أحادية ' مفقودة، بدأت)");
         }
         else
         {
@@ -966,8 +987,7 @@ BaaToken *scan_char_literal(BaaLexer *lexer)
                 BAA_TOKEN_ERROR_INVALID_CHARACTER,
                 1004, "character",
                 L"استخدم محرف واحد فقط بين علامتي الاقتباس المفردتين",
-                L"قيمة حرفية غير صالحة (متعددة الأحرف أو علامة اقتباس مفقودة؟ بدأت في السطر %zu، العمود %zu)",
-                start_line, start_col);
+                L"قيمة حرفية غير صالحة (متعددة الأحرف أو علامة اقتباس مفقودة؟ بدأت)");
             baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_CHARACTER);
             enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_CHARACTER); // Attempt to recover
             return error_token;
@@ -975,27 +995,44 @@ BaaToken *scan_char_literal(BaaLexer *lexer)
     }
 }
 
-BaaToken *scan_multiline_string_literal(BaaLexer *lexer, size_t token_start_line, size_t token_start_col)
+BaaToken *scan_multiline_string_literal(BaaLexer *lexer)
 {
+    // lexer->current is after the opening """ (see below). Fast path as in
+    // scan_string: without a backslash the body is the source slice up to the closing """.
+    size_t body_start = lexer->current;
+    while (lexer->current < lexer->source_length)
+    {
+        wchar_t c = lexer->source[lexer->current];
+        if (c == L'\\')
+            break;
+        if (c == L'"' &&
+            lexer->current + 2 < lexer->source_length &&
+            lexer->source[lexer->current + 1] == L'"' &&
+            lexer->source[lexer->current + 2] == L'"')
+        {
+            size_t body_length = lexer->current - body_start;
+            lexer->current += 3; // Consume closing """
+            return make_literal_slice_token(lexer, BAA_TOKEN_STRING_LIT, body_start, body_length);
+        }
+        lexer->current++;
+    }
+
     size_t buffer_cap = 128; // Start with a slightly larger buffer for multiline strings
     size_t buffer_len = 0;
-    wchar_t *buffer = malloc(buffer_cap * sizeof(wchar_t));
+    wchar_t *buffer = seed_literal_buffer(lexer, body_start, buffer_cap, &buffer_len, &buffer_cap);
     if (!buffer)
     {
-        // Use the passed start_line for error reporting if possible, though lexer->line is current
         return make_specific_error_token(lexer,
             BAA_TOKEN_ERROR,
             9001, "memory",
             L"تحقق من توفر ذاكرة كافية في النظام",
-            L"فشل في تخصيص ذاكرة لسلسلة نصية متعددة الأسطر (بدأت في السطر %zu، العمود %zu)",
-            token_start_line, token_start_col);
+            L"فشل في تخصيص ذاكرة لسلسلة نصية متعددة الأسطر");
     }
 
     // When this function is called from baa_lexer_next_token:
     // lexer->start points to the *first* quote of the opening """.
     // The three opening quotes have already been consumed by advance() calls in baa_lexer_next_token.
     // So, lexer->current is positioned *after* the opening """.
-    // token_start_line and token_start_col are the line/col of the *first* quote of """.
 
     while (true)
     {
@@ -1006,8 +1043,7 @@ BaaToken *scan_multiline_string_literal(BaaLexer *lexer, size_t token_start_line
                 BAA_TOKEN_ERROR_UNTERMINATED_STRING,
                 1001, "string",
                 L"أضف علامة اقتباس مزدوجة ثلاثية \"\"\" في نهاية السلسلة",
-                L"سلسلة نصية متعددة الأسطر غير منتهية (بدأت في السطر %zu، العمود %zu)",
-                token_start_line, token_start_col);
+                L"سلسلة نصية متعددة الأسطر غير منتهية");
             baa_increment_error_count(lexer, BAA_TOKEN_ERROR_UNTERMINATED_STRING);
             // No synchronize at EOF
             return err_token;
@@ -1064,8 +1100,7 @@ BaaToken *scan_multiline_string_literal(BaaLexer *lexer, size_t token_start_line
                         BAA_TOKEN_ERROR_INVALID_ESCAPE,
                         1002, "escape",
                         L"استخدم تسلسل هروب صالح مثل \\س أو \\م أو \\يXXXX",
-                        L"تسلسل هروب يونيكود غير صالح (\\يXXXX) في سلسلة متعددة الأسطر (بدأت في السطر %zu، العمود %zu)",
-                        token_start_line, token_start_col);
+                        L"تسلسل هروب يونيكود غير صالح (\\يXXXX) في سلسلة متعددة الأسطر");
                     baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                     enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                     return err_token;
@@ -1086,8 +1121,7 @@ BaaToken *scan_multiline_string_literal(BaaLexer *lexer, size_t token_start_line
                             BAA_TOKEN_ERROR_INVALID_ESCAPE,
                             1002, "escape",
                             L"استخدم تسلسل هروب صالح مثل \\هـ01 إلى \\هـFF",
-                            L"تسلسل هروب سداسي عشري '\\هـHH' غير صالح في سلسلة متعددة الأسطر (بدأت في السطر %zu، العمود %zu)",
-                            token_start_line, token_start_col);
+                            L"تسلسل هروب سداسي عشري '\\هـHH' غير صالح في سلسلة متعددة الأسطر");
                         baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                         enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                         return err_token;
@@ -1101,8 +1135,7 @@ BaaToken *scan_multiline_string_literal(BaaLexer *lexer, size_t token_start_line
                         BAA_TOKEN_ERROR_INVALID_ESCAPE,
                         1002, "escape",
                         L"استخدم \\هـHH للهروب السداسي عشري",
-                        L"تسلسل هروب غير صالح: '\\ه' يجب أن يتبعها 'ـ' في سلسلة متعددة الأسطر (بدأت في السطر %zu، العمود %zu)",
-                        token_start_line, token_start_col);
+                        L"تسلسل هروب غير صالح: '\\ه' يجب أن يتبعها 'ـ' في سلسلة متعددة الأسطر");
                     baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                     enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                     return err_token;
@@ -1115,8 +1148,8 @@ BaaToken *scan_multiline_string_literal(BaaLexer *lexer, size_t token_start_line
                     BAA_TOKEN_ERROR_INVALID_ESCAPE,
                     1002, "escape",
                     L"استخدم تسلسل هروب صالح مثل \\س أو \\م أو \\يXXXX",
-                    L"تسلسل هروب غير صالح '\\%lc' في سلسلة نصية متعددة الأسطر (بدأت في السطر %zu، العمود %zu)",
-                    baa_escape_char_key, token_start_line, token_start_col);
+                    L"تسلسل هروب غير صالح '\\%lc' في سلسلة نصية متعددة الأسطر",
+                    baa_escape_char_key);
                 baa_increment_error_count(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                 enhanced_synchronize(lexer, BAA_TOKEN_ERROR_INVALID_ESCAPE);
                 return err_token;
@@ -1126,8 +1159,7 @@ BaaToken *scan_multiline_string_literal(BaaLexer *lexer, size_t token_start_line
                     BAA_TOKEN_ERROR,
                     9001, "memory",
                     L"تحقق من توفر ذاكرة كافية في النظام",
-                    L"فشل في إعادة تخصيص ذاكرة لسلسلة متعددة الأسطر (السطر %zu)",
-                    token_start_line);
+                    L"فشل في إعادة تخصيص ذاكرة لسلسلة متعددة الأسطر");
         }
         else
         {
@@ -1139,8 +1171,7 @@ BaaToken *scan_multiline_string_literal(BaaLexer *lexer, size_t token_start_line
                     BAA_TOKEN_ERROR,
                     9001, "memory",
                     L"تحقق من توفر ذاكرة كافية في النظام",
-                    L"فشل في إعادة تخصيص ذاكرة لسلسلة متعددة الأسطر (السطر %zu)",
-                    token_start_line);
+                    L"فشل في إعادة تخصيص ذاكرة لسلسلة متعددة الأسطر");
         }
     }
 
@@ -1150,8 +1181,7 @@ BaaToken *scan_multiline_string_literal(BaaLexer *lexer, size_t token_start_line
             BAA_TOKEN_ERROR,
             9001, "memory",
             L"تحقق من توفر ذاكرة كافية في النظام",
-            L"فشل في إعادة تخصيص الذاكرة عند إنهاء السلسلة متعددة الأسطر (بدأت في السطر %zu)",
-            token_start_line);
+            L"فشل في إعادة تخصيص الذاكرة عند إنهاء السلسلة متعددة الأسطر");
 
     BaaToken *token = malloc(sizeof(BaaToken));
     if (!token)
@@ -1163,24 +1193,17 @@ BaaToken *scan_multiline_string_literal(BaaLexer *lexer, size_t token_start_line
     token->type = BAA_TOKEN_STRING_LIT;
     token->lexeme = buffer;         // Transfer ownership
     token->length = buffer_len - 1; // Don't count our internal null terminator
-    token->line = token_start_line;
-    token->column = token_start_col;
-
-    // Initialize span (enhanced source location)
-    token->span.start_line = token_start_line;
-    token->span.start_column = token_start_col;
-    token->span.end_line = lexer->line;
-    token->span.end_column = lexer->column;
-    token->span.start_offset = lexer->start;
-    token->span.end_offset = lexer->current;
+    token->start_offset = lexer->start;
+    token->end_offset = lexer->current;
 
-    // Initialize error context to NULL for non-error tokens
-    token->error = NULL;
+    // Non-error tokens carry no error information
+    token->error = (BaaLexerError){0};
+    token->literal = (BaaLiteralValue){0};
 
     return token;
 }
 
-BaaToken *scan_raw_string_literal(BaaLexer *lexer, bool is_multiline, size_t token_start_line, size_t token_start_col)
+BaaToken *scan_raw_string_literal(BaaLexer *lexer, bool is_multiline)
 {
     size_t buffer_cap = 128;
     size_t buffer_len = 0;
@@ -1191,15 +1214,13 @@ BaaToken *scan_raw_string_literal(BaaLexer *lexer, bool is_multiline, size_t tok
             BAA_TOKEN_ERROR,
             9001, "memory",
             L"تحقق من توفر ذاكرة كافية في النظام",
-            L"فشل في تخصيص ذاكرة لسلسلة نصية خام (بدأت في السطر %zu، العمود %zu)",
-            token_start_line, token_start_col);
+            L"فشل في تخصيص ذاكرة لسلسلة نصية خام");
     }
 
     // When this function is called:
     // lexer->start points to 'خ'.
     // The prefix ('خ' and opening quote(s)) have been consumed by the dispatcher.
     // lexer->current is positioned *after* the opening 'خ"' or 'خ"""'.
-    // token_start_line and token_start_col refer to the position of 'خ'.
 
     if (is_multiline)
     {
@@ -1213,8 +1234,7 @@ BaaToken *scan_raw_string_literal(BaaLexer *lexer, bool is_multiline, size_t tok
                     BAA_TOKEN_ERROR_UNTERMINATED_STRING,
                     1001, "string",
                     L"أضف علامة اقتباس مزدوجة ثلاثية \"\"\" في نهاية السلسلة الخام",
-                    L"سلسلة نصية خام متعددة الأسطر غير منتهية (بدأت في السطر %zu، العمود %zu)",
-                    token_start_line, token_start_col);
+                    L"سلسلة نصية خام متعددة الأسطر غير منتهية");
                 return err_token;
             }
 
@@ -1235,8 +1255,7 @@ BaaToken *scan_raw_string_literal(BaaLexer *lexer, bool is_multiline, size_t tok
                     BAA_TOKEN_ERROR,
                     9001, "memory",
                     L"تحقق من توفر ذاكرة كافية في النظام",
-                    L"فشل في إعادة تخصيص ذاكرة لسلسلة خام متعددة الأسطر (السطر %zu)",
-                    token_start_line);
+                    L"فشل في إعادة تخصيص ذاكرة لسلسلة خام متعددة الأسطر");
         }
     }
     else
@@ -1253,8 +1272,7 @@ BaaToken *scan_raw_string_literal(BaaLexer *lexer, bool is_multiline, size_t tok
                     BAA_TOKEN_ERROR_UNTERMINATED_STRING,
                     1001, "string",
                     L"استخدم خ\"\"\" للسلاسل الخام متعددة الأسطر أو أضف \" لإنهاء السلسلة",
-                    L"سلسلة نصية خام أحادية السطر غير منتهية قبل السطر الجديد (بدأت في السطر %zu، العمود %zu)",
-                    token_start_line, token_start_col);
+                    L"سلسلة نصية خام أحادية السطر غير منتهية قبل السطر الجديد");
                 baa_increment_error_count(lexer, BAA_TOKEN_ERROR_UNTERMINATED_STRING);
                 // Do not consume the newline, let synchronize handle it or next token be on new line.
                 enhanced_synchronize(lexer, BAA_TOKEN_ERROR_UNTERMINATED_STRING); // Try to recover
@@ -1267,8 +1285,7 @@ BaaToken *scan_raw_string_literal(BaaLexer *lexer, bool is_multiline, size_t tok
                     BAA_TOKEN_ERROR,
                     9001, "memory",
                     L"تحقق من توفر ذاكرة كافية في النظام",
-                    L"فشل في إعادة تخصيص ذاكرة لسلسلة خام (السطر %zu)",
-                    token_start_line);
+                    L"فشل في إعادة تخصيص ذاكرة لسلسلة خام");
         }
 
         if (is_at_end(lexer) || peek(lexer) != L'"')
@@ -1278,8 +1295,7 @@ BaaToken *scan_raw_string_literal(BaaLexer *lexer, bool is_multiline, size_t tok
                 BAA_TOKEN_ERROR_UNTERMINATED_STRING,
                 1001, "string",
                 L"أضف علامة اقتباس مزدوجة \" في نهاية السلسلة الخام",
-                L"سلسلة نصية خام أحادية السطر غير منتهية (بدأت في السطر %zu، العمود %zu)",
-                token_start_line, token_start_col);
+                L"سلسلة نصية خام أحادية السطر غير منتهية");
             baa_increment_error_count(lexer, BAA_TOKEN_ERROR_UNTERMINATED_STRING);
             // No synchronize if at EOF, otherwise synchronize might have been called if newline was hit
             if (!is_at_end(lexer) && peek(lexer) != L'\n')
@@ -1295,8 +1311,7 @@ BaaToken *scan_raw_string_literal(BaaLexer *lexer, bool is_multiline, size_t tok
             BAA_TOKEN_ERROR,
             9001, "memory",
             L"تحقق من توفر ذاكرة كافية في النظام",
-            L"فشل في إعادة تخصيص الذاكرة عند إنهاء السلسلة الخام (بدأت في السطر %zu)",
-            token_start_line);
+            L"فشل في إعادة تخصيص الذاكرة عند إنهاء السلسلة الخام");
 
     BaaToken *token = malloc(sizeof(BaaToken));
     if (!token)
@@ -1308,19 +1323,12 @@ BaaToken *scan_raw_string_literal(BaaLexer *lexer, bool is_multiline, size_t tok
     token->type = BAA_TOKEN_STRING_LIT; // Reusing BAA_TOKEN_STRING_LIT
     token->lexeme = buffer;
     token->length = buffer_len - 1;
-    token->line = token_start_line;
-    token->column = token_start_col;
+    token->start_offset = lexer->start;
+    token->end_offset = lexer->current;
 
-    // Initialize span (enhanced source location)
-    token->span.start_line = token_start_line;
-    token->span.start_column = token_start_col;
-    token->span.end_line = lexer->line;
-    token->span.end_column = lexer->column;
-    token->span.start_offset = lexer->start;
-    token->span.end_offset = lexer->current;
-
-    // Initialize error context to NULL for non-error tokens
-    token->error = NULL;
+    // Non-error tokens carry no error information
+    token->error = (BaaLexerError){0};
+    token->literal = (BaaLiteralValue){0};
 
     return token;
 }
@@ -1350,15 +1358,14 @@ BaaToken *scan_whitespace_sequence(BaaLexer *lexer)
  * This function consumes the comment content until newline or EOF.
  *
  * @param lexer Pointer to the BaaLexer instance.
- * @param comment_delimiter_start_line Line where the opening "//" started.
- * @param comment_delimiter_start_col Column where the opening "//" started.
  * @return A BaaToken of type BAA_TOKEN_SINGLE_LINE_COMMENT. Lexeme is the content.
  */
-BaaToken *scan_single_line_comment(BaaLexer *lexer, size_t comment_delimiter_start_line, size_t comment_delimiter_start_col)
+BaaToken *scan_single_line_comment(BaaLexer *lexer)
 {
     // Called after '//' is consumed by baa_lexer_next_token.
     // lexer->current is at the first character of the comment content.
-    lexer->start = lexer->current; // Lexeme STARTS AFTER //
+    size_t delimiter_start = lexer->start; // Offset of the opening "//"
+    lexer->start = lexer->current;         // Lexeme STARTS AFTER //
 
     while (peek(lexer) != L'\n' && !is_at_end(lexer))
     {
@@ -1368,9 +1375,8 @@ BaaToken *scan_single_line_comment(BaaLexer *lexer, size_t comment_delimiter_sta
     // make_token uses lexer->start (start of content) and lexer->current (end of content).
     BaaToken *token = make_token(lexer, BAA_TOKEN_SINGLE_LINE_COMMENT);
     if (token)
-    {                                                // Ensure make_token succeeded
-        token->line = comment_delimiter_start_line;  // Report token at the line of "//"
-        token->column = comment_delimiter_start_col; // Report token at the column of "//"
+    {                                          // Ensure make_token succeeded
+        token->start_offset = delimiter_start; // Report token at the position of "//"
     }
     // Do NOT consume the newline here; let baa_lexer_next_token handle it as a separate token.
     return token;
@@ -1383,15 +1389,14 @@ BaaToken *scan_single_line_comment(BaaLexer *lexer, size_t comment_delimiter_sta
  * This function consumes the comment content and the closing delimiter.
  *
  * @param lexer Pointer to the BaaLexer instance.
- * @param comment_delimiter_start_line Line where the opening delimiter started.
- * @param comment_delimiter_start_col Column where the opening delimiter started.
  * @return A BaaToken of type BAA_TOKEN_MULTI_LINE_COMMENT or BAA_TOKEN_ERROR if unterminated.
  */
-BaaToken *scan_multi_line_comment(BaaLexer *lexer, size_t comment_delimiter_start_line, size_t comment_delimiter_start_col)
+BaaToken *scan_multi_line_comment(BaaLexer *lexer)
 {
     // Called AFTER "/*" has been consumed by baa_lexer_next_token.
     // lexer->current is at the first character of the comment content.
-    lexer->start = lexer->current; // Lexeme STARTS AFTER /*
+    size_t delimiter_start = lexer->start; // Offset of the opening "/*"
+    lexer->start = lexer->current;         // Lexeme STARTS AFTER /*
 
     bool terminated = false;
     while (!is_at_end(lexer))
@@ -1411,19 +1416,18 @@ BaaToken *scan_multi_line_comment(BaaLexer *lexer, size_t comment_delimiter_star
             BAA_TOKEN_ERROR_UNTERMINATED_COMMENT,
             1007, "comment",
             L"أضف */ لإنهاء التعليق",
-            L"تعليق متعدد الأسطر غير منتهٍ (بدأ في السطر %zu، العمود %zu)",
-            comment_delimiter_start_line, comment_delimiter_start_col);
+            L"تعليق متعدد الأسطر غير منتهٍ");
     }
 
     // lexer->current is at the '*' of "*/". make_token will create lexeme up to this point.
     BaaToken *token = make_token(lexer, BAA_TOKEN_MULTI_LINE_COMMENT);
-    if (token)
-    {
-        token->line = comment_delimiter_start_line;  // Report token at the line of "/*"
-        token->column = comment_delimiter_start_col; // Report token at the column of "/*"
-    }
 
     advance(lexer); // Consume '*' of "*/"
     advance(lexer); // Consume '/' of "*/"
+    if (token)
+    {
+        token->start_offset = delimiter_start; // Report token at the position of "/*"
+        token->end_offset = lexer->current;    // Span includes the closing "*/"
+    }
     return token;
 }
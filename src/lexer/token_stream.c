@@ -0,0 +1,199 @@
+// src/lexer/token_stream.c
+#include "baa/lexer/token_stream.h"
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#define BAA_TOKEN_STREAM_INITIAL_CAPACITY 16
+
+bool baa_token_stream_init(BaaTokenStream *stream, BaaLexer *lexer)
+{
+    memset(stream, 0, sizeof(*stream));
+    stream->lexer = lexer;
+    stream->ring = calloc(BAA_TOKEN_STREAM_INITIAL_CAPACITY, sizeof(BaaToken));
+    if (!stream->ring)
+        return false;
+    stream->capacity = BAA_TOKEN_STREAM_INITIAL_CAPACITY;
+    return true;
+}
+
+bool baa_token_stream_init_buffer(BaaTokenStream *stream, const BaaTokenBuffer *buffer, size_t first)
+{
+    if (!buffer || first >= buffer->count || !baa_token_stream_init(stream, NULL))
+        return false;
+    stream->buffer = buffer;
+    stream->buffer_next = first;
+    return true;
+}
+
+void baa_token_stream_free(BaaTokenStream *stream)
+{
+    if (!stream || !stream->ring)
+        return;
+    for (size_t i = 0; i < stream->capacity; i++)
+        free(stream->ring[i].lexeme);
+    free(stream->ring);
+    stream->ring = NULL;
+    stream->capacity = 0;
+}
+
+// Oldest token index that must not be recycled
+static size_t stream_retain_from(const BaaTokenStream *stream)
+{
+    size_t from = stream->discarded < stream->position ? stream->discarded : stream->position;
+    if (stream->mark_depth > 0 && stream->mark_floor < from)
+        from = stream->mark_floor;
+    return from;
+}
+
+// Doubles the ring, keeping retained tokens and freeing the lexemes of the rest
+static bool stream_grow(BaaTokenStream *stream)
+{
+    size_t capacity = stream->capacity * 2;
+    BaaToken *ring = calloc(capacity, sizeof(BaaToken));
+    if (!ring)
+        return false;
+
+    size_t from = stream_retain_from(stream);
+    size_t oldest = stream->lexed > stream->capacity ? stream->lexed - stream->capacity : 0;
+    for (size_t i = oldest; i < stream->lexed; i++)
+    {
+        BaaToken *slot = &stream->ring[i & (stream->capacity - 1)];
+        if (i >= from)
+            ring[i & (capacity - 1)] = *slot;
+        else
+            free(slot->lexeme);
+    }
+
+    free(stream->ring);
+    stream->ring = ring;
+    stream->capacity = capacity;
+    return true;
+}
+
+// Rebuilds the next buffer token in `slot`, as baa_lexer_next_token returned it
+static bool stream_replay(BaaTokenStream *stream, BaaToken *slot)
+{
+    const BaaTokenBuffer *buffer = stream->buffer;
+    size_t index = stream->buffer_next;
+    if (index >= buffer->count)
+        return false;
+
+    // Lexer tokens own a null-terminated copy of their lexeme
+    size_t length = 0;
+    const wchar_t *text = baa_token_buffer_lexeme(buffer, index, &length);
+    wchar_t *lexeme = malloc((length + 1) * sizeof(wchar_t));
+    if (!lexeme)
+        return false;
+    wmemcpy(lexeme, text, length);
+    lexeme[length] = L'\0';
+
+    const BaaTokenExtra *extra = baa_token_buffer_extra(buffer, index);
+    free(slot->lexeme);
+    slot->type = (BaaTokenType)buffer->kinds[index];
+    slot->lexeme = lexeme;
+    slot->length = length;
+    slot->start_offset = buffer->offsets[index];
+    slot->end_offset = (size_t)buffer->offsets[index] + buffer->lengths[index];
+    slot->error = extra ? extra->error : (BaaLexerError){0};
+    slot->literal = extra ? extra->literal : (BaaLiteralValue){0};
+    stream->buffer_next++;
+    return true;
+}
+
+// Lexes tokens until `index` is available or the lexer reached EOF
+static bool stream_fill(BaaTokenStream *stream, size_t index)
+{
+    while (stream->lexed <= index && !stream->at_eof)
+    {
+        if (stream->failed)
+            return false;
+        if (stream->lexed - stream_retain_from(stream) >= stream->capacity && !stream_grow(stream))
+        {
+            stream->failed = true;
+            return false;
+        }
+
+        // The slot holds a token older than the retained window, if anything
+        BaaToken *slot = &stream->ring[stream->lexed & (stream->capacity - 1)];
+        if (stream->buffer)
+        {
+            if (!stream_replay(stream, slot))
+            {
+                stream->failed = true;
+                return false;
+            }
+        }
+        else
+        {
+            BaaToken *token = baa_lexer_next_token(stream->lexer);
+            if (!token)
+            {
+                stream->failed = true;
+                return false;
+            }
+            free(slot->lexeme);
+            *slot = *token; // The slot now owns the lexeme
+            token->lexeme = NULL;
+            baa_free_token(token);
+        }
+
+        if (slot->type == BAA_TOKEN_EOF)
+        {
+            stream->at_eof = true;
+            stream->eof_index = stream->lexed;
+        }
+        stream->lexed++;
+    }
+    return !stream->failed || stream->lexed > index;
+}
+
+static const BaaToken *stream_token_at(BaaTokenStream *stream, size_t index)
+{
+    if (!stream_fill(stream, index))
+        return NULL;
+    if (stream->at_eof && index > stream->eof_index)
+        index = stream->eof_index;
+    return &stream->ring[index & (stream->capacity - 1)];
+}
+
+const BaaToken *baa_token_stream_peek(BaaTokenStream *stream, size_t n)
+{
+    return stream_token_at(stream, stream->position + n);
+}
+
+const BaaToken *baa_token_stream_next(BaaTokenStream *stream)
+{
+    const BaaToken *token = stream_token_at(stream, stream->position);
+    if (token && !(stream->at_eof && stream->position > stream->eof_index))
+        stream->position++;
+    return token;
+}
+
+void baa_token_stream_discard(BaaTokenStream *stream, size_t index)
+{
+    if (index > stream->discarded)
+        stream->discarded = index;
+}
+
+BaaTokenMark baa_token_stream_mark(BaaTokenStream *stream)
+{
+    // Everything the consumer still referenced when marking must survive a rewind
+    if (stream->mark_depth++ == 0)
+        stream->mark_floor = stream_retain_from(stream);
+    return (BaaTokenMark){stream->position, stream->discarded};
+}
+
+void baa_token_stream_rewind(BaaTokenStream *stream, BaaTokenMark mark)
+{
+    stream->position = mark.position;
+    stream->discarded = mark.discarded;
+    baa_token_stream_release(stream, mark);
+}
+
+void baa_token_stream_release(BaaTokenStream *stream, BaaTokenMark mark)
+{
+    (void)mark; // Marks nest, so only the depth needs tracking
+    if (stream->mark_depth > 0)
+        stream->mark_depth--;
+}
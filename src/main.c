@@ -2,6 +2,7 @@
 // #include "baa/parser/parser.h" // Removed as parser is being removed
 #include "baa/codegen/codegen.h"
 #include "baa/utils/utils.h"
+#include "baa/utils/trace.h"
 #include "baa/preprocessor/preprocessor.h"
 #include "baa/compiler.h"
 #include <stdio.h>
@@ -33,6 +34,7 @@ static void print_usage(const char *program_name) {
  */
 int main(int argc, char **argv) {
     setlocale(LC_ALL, "");  // Set locale for proper wide char handling
+    baa_trace_init_from_env(); // BAA_TRACE=parser,... (only if built with BAA_ENABLE_TRACE)
 
     if (argc < 2) {
         print_usage(argv[0]);
@@ -3,50 +3,91 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <wchar.h>
 
-// Operator table with precedence and associativity information
-static const BaaOperatorInfo operator_table[] = {
+// Operator table indexed by operator, with precedence and associativity information.
+// + and - are listed with their binary precedence; their prefix forms are in
+// unary_operator_names below.
+static const BaaOperatorInfo operator_table[BAA_OP_NONE] = {
     // Unary operators (highest precedence)
-    {BAA_OP_NOT,        L"!",  L"نفي",          true,  false, BAA_PREC_UNARY, true},
-    {BAA_OP_SUB,        L"-",  L"سالب",         true,  true,  BAA_PREC_UNARY, true},
-    {BAA_OP_ADD,        L"+",  L"موجب",         true,  true,  BAA_PREC_UNARY, true},
+    [BAA_OP_NOT]        = {BAA_OP_NOT,        L"!",  L"نفي",          true,  false, BAA_PREC_UNARY, true},
 
     // Multiplicative operators
-    {BAA_OP_MUL,        L"*",  L"ضرب",          false, true,  BAA_PREC_FACTOR, false},
-    {BAA_OP_DIV,        L"/",  L"قسمة",         false, true,  BAA_PREC_FACTOR, false},
-    {BAA_OP_MOD,        L"%",  L"باقي",         false, true,  BAA_PREC_FACTOR, false},
+    [BAA_OP_MUL]        = {BAA_OP_MUL,        L"*",  L"ضرب",          false, true,  BAA_PREC_FACTOR, false},
+    [BAA_OP_DIV]        = {BAA_OP_DIV,        L"/",  L"قسمة",         false, true,  BAA_PREC_FACTOR, false},
+    [BAA_OP_MOD]        = {BAA_OP_MOD,        L"%",  L"باقي",         false, true,  BAA_PREC_FACTOR, false},
 
-    // Additive operators
-    {BAA_OP_ADD,        L"+",  L"جمع",          false, true,  BAA_PREC_TERM, false},
-    {BAA_OP_SUB,        L"-",  L"طرح",          false, true,  BAA_PREC_TERM, false},
+    // Additive operators (also prefix operators)
+    [BAA_OP_ADD]        = {BAA_OP_ADD,        L"+",  L"جمع",          true,  true,  BAA_PREC_TERM, false},
+    [BAA_OP_SUB]        = {BAA_OP_SUB,        L"-",  L"طرح",          true,  true,  BAA_PREC_TERM, false},
 
     // Relational operators
-    {BAA_OP_LT,         L"<",  L"أصغر_من",      false, true,  BAA_PREC_COMPARISON, false},
-    {BAA_OP_GT,         L">",  L"أكبر_من",      false, true,  BAA_PREC_COMPARISON, false},
-    {BAA_OP_LE,         L"<=", L"أصغر_أو_يساوي", false, true,  BAA_PREC_COMPARISON, false},
-    {BAA_OP_GE,         L">=", L"أكبر_أو_يساوي", false, true,  BAA_PREC_COMPARISON, false},
+    [BAA_OP_LT]         = {BAA_OP_LT,         L"<",  L"أصغر_من",      false, true,  BAA_PREC_COMPARISON, false},
+    [BAA_OP_GT]         = {BAA_OP_GT,         L">",  L"أكبر_من",      false, true,  BAA_PREC_COMPARISON, false},
+    [BAA_OP_LE]         = {BAA_OP_LE,         L"<=", L"أصغر_أو_يساوي", false, true,  BAA_PREC_COMPARISON, false},
+    [BAA_OP_GE]         = {BAA_OP_GE,         L">=", L"أكبر_أو_يساوي", false, true,  BAA_PREC_COMPARISON, false},
 
     // Equality operators
-    {BAA_OP_EQ,         L"==", L"يساوي",        false, true,  BAA_PREC_EQUALITY, false},
-    {BAA_OP_NE,         L"!=", L"لا_يساوي",     false, true,  BAA_PREC_EQUALITY, false},
+    [BAA_OP_EQ]         = {BAA_OP_EQ,         L"==", L"يساوي",        false, true,  BAA_PREC_EQUALITY, false},
+    [BAA_OP_NE]         = {BAA_OP_NE,         L"!=", L"لا_يساوي",     false, true,  BAA_PREC_EQUALITY, false},
 
     // Logical AND
-    {BAA_OP_AND,        L"&&", L"و",            false, true,  BAA_PREC_LOGICAL_AND, false},
+    [BAA_OP_AND]        = {BAA_OP_AND,        L"&&", L"و",            false, true,  BAA_PREC_LOGICAL_AND, false},
 
     // Logical OR
-    {BAA_OP_OR,         L"||", L"أو",           false, true,  BAA_PREC_LOGICAL_OR, false},
+    [BAA_OP_OR]         = {BAA_OP_OR,         L"||", L"أو",           false, true,  BAA_PREC_LOGICAL_OR, false},
 
     // Assignment operators (lowest precedence)
-    {BAA_OP_ASSIGN,     L"=",  L"تعيين",        false, true,  BAA_PREC_ASSIGNMENT, true},
-    {BAA_OP_ADD_ASSIGN, L"+=", L"جمع_تعيين",    false, true,  BAA_PREC_ASSIGNMENT, true},
-    {BAA_OP_SUB_ASSIGN, L"-=", L"طرح_تعيين",    false, true,  BAA_PREC_ASSIGNMENT, true},
-    {BAA_OP_MUL_ASSIGN, L"*=", L"ضرب_تعيين",    false, true,  BAA_PREC_ASSIGNMENT, true},
-    {BAA_OP_DIV_ASSIGN, L"/=", L"قسمة_تعيين",   false, true,  BAA_PREC_ASSIGNMENT, true},
-    {BAA_OP_MOD_ASSIGN, L"%=", L"باقي_تعيين",   false, true,  BAA_PREC_ASSIGNMENT, true}
+    [BAA_OP_ASSIGN]     = {BAA_OP_ASSIGN,     L"=",  L"تعيين",        false, true,  BAA_PREC_ASSIGNMENT, true},
+    [BAA_OP_ADD_ASSIGN] = {BAA_OP_ADD_ASSIGN, L"+=", L"جمع_تعيين",    false, true,  BAA_PREC_ASSIGNMENT, true},
+    [BAA_OP_SUB_ASSIGN] = {BAA_OP_SUB_ASSIGN, L"-=", L"طرح_تعيين",    false, true,  BAA_PREC_ASSIGNMENT, true},
+    [BAA_OP_MUL_ASSIGN] = {BAA_OP_MUL_ASSIGN, L"*=", L"ضرب_تعيين",    false, true,  BAA_PREC_ASSIGNMENT, true},
+    [BAA_OP_DIV_ASSIGN] = {BAA_OP_DIV_ASSIGN, L"/=", L"قسمة_تعيين",   false, true,  BAA_PREC_ASSIGNMENT, true},
+    [BAA_OP_MOD_ASSIGN] = {BAA_OP_MOD_ASSIGN, L"%=", L"باقي_تعيين",   false, true,  BAA_PREC_ASSIGNMENT, true},
 };
 
-static const size_t operator_count = sizeof(operator_table) / sizeof(operator_table[0]);
+// Arabic names of the prefix forms of + and -
+static const struct {
+    const wchar_t* arabic_name;
+    BaaOperatorType type;
+} unary_operator_names[] = {
+    {L"سالب", BAA_OP_SUB},
+    {L"موجب", BAA_OP_ADD},
+};
+
+// Symbol lookup: operator symbols are one or two ASCII characters. The second
+// character selects one of a few columns, so a symbol maps to its operator with
+// two array reads. Entries hold the operator + 1 (0 = no operator).
+enum {
+    SYMBOL_END,       // Single-character symbol
+    SYMBOL_EQUAL,     // x=
+    SYMBOL_AMPERSAND, // &&
+    SYMBOL_BAR,       // ||
+    SYMBOL_COLUMN_COUNT
+};
+
+static const uint8_t symbol_second_column[128] = {
+    [L'='] = SYMBOL_EQUAL,
+    [L'&'] = SYMBOL_AMPERSAND,
+    [L'|'] = SYMBOL_BAR,
+};
+
+#define SYMBOL(op) ((uint8_t)((op) + 1))
+
+static const uint8_t symbol_operators[128][SYMBOL_COLUMN_COUNT] = {
+    [L'+'] = {[SYMBOL_END] = SYMBOL(BAA_OP_ADD), [SYMBOL_EQUAL] = SYMBOL(BAA_OP_ADD_ASSIGN)},
+    [L'-'] = {[SYMBOL_END] = SYMBOL(BAA_OP_SUB), [SYMBOL_EQUAL] = SYMBOL(BAA_OP_SUB_ASSIGN)},
+    [L'*'] = {[SYMBOL_END] = SYMBOL(BAA_OP_MUL), [SYMBOL_EQUAL] = SYMBOL(BAA_OP_MUL_ASSIGN)},
+    [L'/'] = {[SYMBOL_END] = SYMBOL(BAA_OP_DIV), [SYMBOL_EQUAL] = SYMBOL(BAA_OP_DIV_ASSIGN)},
+    [L'%'] = {[SYMBOL_END] = SYMBOL(BAA_OP_MOD), [SYMBOL_EQUAL] = SYMBOL(BAA_OP_MOD_ASSIGN)},
+    [L'<'] = {[SYMBOL_END] = SYMBOL(BAA_OP_LT), [SYMBOL_EQUAL] = SYMBOL(BAA_OP_LE)},
+    [L'>'] = {[SYMBOL_END] = SYMBOL(BAA_OP_GT), [SYMBOL_EQUAL] = SYMBOL(BAA_OP_GE)},
+    [L'='] = {[SYMBOL_END] = SYMBOL(BAA_OP_ASSIGN), [SYMBOL_EQUAL] = SYMBOL(BAA_OP_EQ)},
+    [L'!'] = {[SYMBOL_END] = SYMBOL(BAA_OP_NOT), [SYMBOL_EQUAL] = SYMBOL(BAA_OP_NE)},
+    [L'&'] = {[SYMBOL_AMPERSAND] = SYMBOL(BAA_OP_AND)},
+    [L'|'] = {[SYMBOL_BAR] = SYMBOL(BAA_OP_OR)},
+};
 
 void baa_init_operators(void) {
     // Nothing to initialize for now
@@ -58,30 +99,47 @@ void baa_init_operator_system(void) {
 }
 
 const BaaOperatorInfo* baa_get_operator_info(BaaOperatorType type) {
-    for (size_t i = 0; i < operator_count; i++) {
-        if (operator_table[i].type == type) {
-            return &operator_table[i];
-        }
+    if ((unsigned)type >= BAA_OP_NONE || !operator_table[type].symbol) {
+        return NULL;
     }
-    return NULL;
+    return &operator_table[type];
 }
 
 BaaOperatorType baa_get_operator_from_symbol(const wchar_t* symbol) {
-    for (size_t i = 0; i < operator_count; i++) {
-        if (wcscmp(operator_table[i].symbol, symbol) == 0) {
-            return operator_table[i].type;
+    if (!symbol || symbol[0] == L'\0' || (unsigned long)symbol[0] >= 128) {
+        return BAA_OP_NONE;
+    }
+
+    size_t column = SYMBOL_END;
+    if (symbol[1] != L'\0') {
+        // A second character outside the columns, or a third character, is no operator
+        if ((unsigned long)symbol[1] >= 128 || symbol[2] != L'\0') {
+            return BAA_OP_NONE;
+        }
+        column = symbol_second_column[symbol[1]];
+        if (column == SYMBOL_END) {
+            return BAA_OP_NONE;
         }
     }
-    return -1; // Invalid operator
+    uint8_t entry = symbol_operators[symbol[0]][column];
+    return entry ? (BaaOperatorType)(entry - 1) : BAA_OP_NONE;
 }
 
 BaaOperatorType baa_get_operator_from_name(const wchar_t* arabic_name) {
-    for (size_t i = 0; i < operator_count; i++) {
-        if (wcscmp(operator_table[i].arabic_name, arabic_name) == 0) {
+    if (!arabic_name) {
+        return BAA_OP_NONE;
+    }
+    for (size_t i = 0; i < BAA_OP_NONE; i++) {
+        if (operator_table[i].arabic_name && wcscmp(operator_table[i].arabic_name, arabic_name) == 0) {
             return operator_table[i].type;
         }
     }
-    return -1; // Invalid operator
+    for (size_t i = 0; i < sizeof(unary_operator_names) / sizeof(unary_operator_names[0]); i++) {
+        if (wcscmp(unary_operator_names[i].arabic_name, arabic_name) == 0) {
+            return unary_operator_names[i].type;
+        }
+    }
+    return BAA_OP_NONE;
 }
 
 BaaOperatorPrecedence baa_get_operator_precedence(BaaOperatorType type) {
@@ -126,75 +184,137 @@ const char* baa_operator_to_string(BaaOperatorType type) {
     return str;
 }
 
-bool baa_validate_binary_op(BaaOperatorType op, BaaType* left_type, BaaType* right_type, BaaType** result_type) {
-    if (!left_type || !right_type) {
-        *result_type = baa_type_error;
-        return false;
+// --- Operand type rules ---
+//
+// binary_rules[op][left kind][right kind] and unary_rules[op][operand kind] give
+// the result and the implicit conversions of each operand; entries not listed
+// are zero, i.e. invalid.
+
+// Valid with a primitive result kind; operands converted to the given kinds
+#define RULE(result_kind, left_kind, right_kind) \
+    {.valid = true, .result = (result_kind), .left_convert = (left_kind), .right_convert = (right_kind)}
+
+// Valid; the result is the (left) operand's own type, the right operand is converted
+#define RULE_LEFT(left_kind, right_kind) \
+    {.valid = true, .result_is_left = true, .result = (left_kind), .left_convert = (left_kind), \
+     .right_convert = (right_kind)}
+
+// int op int -> int; any float operand converts the other one to float
+#define ARITHMETIC_RULES                                                          \
+    {                                                                             \
+        [BAA_TYPE_INT] = {[BAA_TYPE_INT] = RULE(BAA_TYPE_INT, BAA_TYPE_INT, BAA_TYPE_INT),       \
+                          [BAA_TYPE_FLOAT] = RULE(BAA_TYPE_FLOAT, BAA_TYPE_FLOAT, BAA_TYPE_FLOAT)}, \
+        [BAA_TYPE_FLOAT] = {[BAA_TYPE_INT] = RULE(BAA_TYPE_FLOAT, BAA_TYPE_FLOAT, BAA_TYPE_FLOAT),   \
+                            [BAA_TYPE_FLOAT] = RULE(BAA_TYPE_FLOAT, BAA_TYPE_FLOAT, BAA_TYPE_FLOAT)}, \
     }
 
-    // Handle arithmetic operators
-    if (op == BAA_OP_ADD || op == BAA_OP_SUB || op == BAA_OP_MUL || op == BAA_OP_DIV) {
-        if (left_type->kind == BAA_TYPE_INT && right_type->kind == BAA_TYPE_INT) {
-            *result_type = baa_type_int;
-            return true;
-        }
-        if (left_type->kind == BAA_TYPE_FLOAT || right_type->kind == BAA_TYPE_FLOAT) {
-            *result_type = baa_type_float;
-            return true;
-        }
+// Numeric operands compared after the usual conversion; the result is int (boolean)
+#define COMPARISON_RULES                                                          \
+    {                                                                             \
+        [BAA_TYPE_INT] = {[BAA_TYPE_INT] = RULE(BAA_TYPE_INT, BAA_TYPE_INT, BAA_TYPE_INT),       \
+                          [BAA_TYPE_FLOAT] = RULE(BAA_TYPE_INT, BAA_TYPE_FLOAT, BAA_TYPE_FLOAT)}, \
+        [BAA_TYPE_FLOAT] = {[BAA_TYPE_INT] = RULE(BAA_TYPE_INT, BAA_TYPE_FLOAT, BAA_TYPE_FLOAT),   \
+                            [BAA_TYPE_FLOAT] = RULE(BAA_TYPE_INT, BAA_TYPE_FLOAT, BAA_TYPE_FLOAT)}, \
     }
 
-    // Handle comparison operators
-    if (op == BAA_OP_EQ || op == BAA_OP_NE ||
-        op == BAA_OP_LT || op == BAA_OP_GT ||
-        op == BAA_OP_LE || op == BAA_OP_GE) {
-        if ((left_type->kind == BAA_TYPE_INT || left_type->kind == BAA_TYPE_FLOAT) &&
-            (right_type->kind == BAA_TYPE_INT || right_type->kind == BAA_TYPE_FLOAT)) {
-            *result_type = baa_type_int; // Comparison operators return int (boolean)
-            return true;
-        }
+// int or bool operands, compared against zero; the result is int (boolean)
+#define LOGICAL_RULES                                                             \
+    {                                                                             \
+        [BAA_TYPE_INT] = {[BAA_TYPE_INT] = RULE(BAA_TYPE_INT, BAA_TYPE_INT, BAA_TYPE_INT),       \
+                          [BAA_TYPE_BOOL] = RULE(BAA_TYPE_INT, BAA_TYPE_INT, BAA_TYPE_BOOL)},    \
+        [BAA_TYPE_BOOL] = {[BAA_TYPE_INT] = RULE(BAA_TYPE_INT, BAA_TYPE_BOOL, BAA_TYPE_INT),     \
+                           [BAA_TYPE_BOOL] = RULE(BAA_TYPE_INT, BAA_TYPE_BOOL, BAA_TYPE_BOOL)},  \
     }
 
-    // Handle assignment
-    if (op == BAA_OP_ASSIGN) {
-        if (left_type->kind == right_type->kind) {
-            *result_type = left_type;
-            return true;
-        }
-        if (left_type->kind == BAA_TYPE_FLOAT && right_type->kind == BAA_TYPE_INT) {
-            *result_type = left_type;
-            return true;
-        }
+#define SAME_KIND(kind) [kind] = {[kind] = RULE_LEFT(kind, kind)}
+
+static const BaaOperatorTypeRule binary_rules[BAA_OP_NONE][BAA_TYPE_KIND_COUNT][BAA_TYPE_KIND_COUNT] = {
+    [BAA_OP_ADD] = ARITHMETIC_RULES,
+    [BAA_OP_SUB] = ARITHMETIC_RULES,
+    [BAA_OP_MUL] = ARITHMETIC_RULES,
+    [BAA_OP_DIV] = ARITHMETIC_RULES,
+    [BAA_OP_MOD] = {[BAA_TYPE_INT] = {[BAA_TYPE_INT] = RULE(BAA_TYPE_INT, BAA_TYPE_INT, BAA_TYPE_INT)}},
+
+    [BAA_OP_EQ] = COMPARISON_RULES,
+    [BAA_OP_NE] = COMPARISON_RULES,
+    [BAA_OP_LT] = COMPARISON_RULES,
+    [BAA_OP_GT] = COMPARISON_RULES,
+    [BAA_OP_LE] = COMPARISON_RULES,
+    [BAA_OP_GE] = COMPARISON_RULES,
+
+    [BAA_OP_AND] = LOGICAL_RULES,
+    [BAA_OP_OR] = LOGICAL_RULES,
+
+    // Any kind can be assigned to itself; an int converts to a float target
+    [BAA_OP_ASSIGN] = {
+        SAME_KIND(BAA_TYPE_VOID),
+        SAME_KIND(BAA_TYPE_INT),
+        [BAA_TYPE_FLOAT] = {[BAA_TYPE_FLOAT] = RULE_LEFT(BAA_TYPE_FLOAT, BAA_TYPE_FLOAT),
+                            [BAA_TYPE_INT] = RULE_LEFT(BAA_TYPE_FLOAT, BAA_TYPE_FLOAT)},
+        SAME_KIND(BAA_TYPE_CHAR),
+        SAME_KIND(BAA_TYPE_STRING),
+        SAME_KIND(BAA_TYPE_BOOL),
+        SAME_KIND(BAA_TYPE_NULL),
+        SAME_KIND(BAA_TYPE_ERROR),
+        SAME_KIND(BAA_TYPE_ARRAY),
+    },
+};
+
+static const BaaOperatorTypeRule unary_rules[BAA_OP_NONE][BAA_TYPE_KIND_COUNT] = {
+    // Numeric prefix operators keep the operand's type
+    [BAA_OP_ADD] = {[BAA_TYPE_INT] = RULE_LEFT(BAA_TYPE_INT, BAA_TYPE_INT),
+                    [BAA_TYPE_FLOAT] = RULE_LEFT(BAA_TYPE_FLOAT, BAA_TYPE_FLOAT)},
+    [BAA_OP_SUB] = {[BAA_TYPE_INT] = RULE_LEFT(BAA_TYPE_INT, BAA_TYPE_INT),
+                    [BAA_TYPE_FLOAT] = RULE_LEFT(BAA_TYPE_FLOAT, BAA_TYPE_FLOAT)},
+    [BAA_OP_NOT] = {[BAA_TYPE_INT] = RULE(BAA_TYPE_INT, BAA_TYPE_INT, BAA_TYPE_INT),
+                    [BAA_TYPE_BOOL] = RULE(BAA_TYPE_INT, BAA_TYPE_BOOL, BAA_TYPE_BOOL)},
+};
+
+static const BaaOperatorTypeRule invalid_rule = {0};
+
+const BaaOperatorTypeRule* baa_get_binary_op_rule(BaaOperatorType op, BaaTypeKind left_kind, BaaTypeKind right_kind) {
+    if ((unsigned)op >= BAA_OP_NONE || (unsigned)left_kind >= BAA_TYPE_KIND_COUNT ||
+        (unsigned)right_kind >= BAA_TYPE_KIND_COUNT) {
+        return &invalid_rule;
     }
+    return &binary_rules[op][left_kind][right_kind];
+}
 
-    *result_type = baa_type_error;
-    return false;
+const BaaOperatorTypeRule* baa_get_unary_op_rule(BaaOperatorType op, BaaTypeKind operand_kind) {
+    if ((unsigned)op >= BAA_OP_NONE || (unsigned)operand_kind >= BAA_TYPE_KIND_COUNT) {
+        return &invalid_rule;
+    }
+    return &unary_rules[op][operand_kind];
 }
 
-bool baa_validate_unary_op(BaaOperatorType op, BaaType* operand_type, BaaType** result_type) {
-    if (!operand_type) {
+bool baa_validate_binary_op(BaaOperatorType op, BaaType* left_type, BaaType* right_type, BaaType** result_type) {
+    if (!left_type || !right_type) {
         *result_type = baa_type_error;
         return false;
     }
 
-    // Handle numeric unary operators
-    if (op == BAA_OP_ADD || op == BAA_OP_SUB) {
-        if (operand_type->kind == BAA_TYPE_INT || operand_type->kind == BAA_TYPE_FLOAT) {
-            *result_type = operand_type;
-            return true;
-        }
+    const BaaOperatorTypeRule* rule = baa_get_binary_op_rule(op, left_type->kind, right_type->kind);
+    if (!rule->valid) {
+        *result_type = baa_type_error;
+        return false;
     }
+    *result_type = rule->result_is_left ? left_type : baa_create_primitive_type((BaaTypeKind)rule->result);
+    return true;
+}
 
-    // Handle logical not
-    if (op == BAA_OP_NOT) {
-        if (operand_type->kind == BAA_TYPE_INT) {
-            *result_type = baa_type_int;
-            return true;
-        }
+bool baa_validate_unary_op(BaaOperatorType op, BaaType* operand_type, BaaType** result_type) {
+    if (!operand_type) {
+        *result_type = baa_type_error;
+        return false;
     }
 
-    *result_type = baa_type_error;
-    return false;
+    const BaaOperatorTypeRule* rule = baa_get_unary_op_rule(op, operand_type->kind);
+    if (!rule->valid) {
+        *result_type = baa_type_error;
+        return false;
+    }
+    *result_type = rule->result_is_left ? operand_type : baa_create_primitive_type((BaaTypeKind)rule->result);
+    return true;
 }
 
 // Error handling
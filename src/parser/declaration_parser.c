@@ -60,16 +60,18 @@ BaaNode *parse_variable_declaration_statement(BaaParser *parser, BaaAstNodeModif
         return NULL;
     }
     
-    // Get the variable name
-    const wchar_t *var_name = parser->current_token.lexeme ? parser->current_token.lexeme : L"";
+    // Copy the variable name: the initializer may consume enough tokens to recycle its lexeme
+    wchar_t *var_name = baa_strdup(parser->current_token.lexeme ? parser->current_token.lexeme : L"");
+    if (!var_name)
+    {
+        baa_ast_free_node(type_node);
+        return NULL;
+    }
     
     // Create source span starting from the type specifier
     BaaAstSourceSpan span = {
         .start = type_node->span.start,
-        .end = {
-            .filename = parser->source_filename,
-            .line = parser->current_token.line,
-            .column = parser->current_token.column + parser->current_token.length}};
+        .end = baa_parser_token_end_location(parser, &parser->current_token)};
     
     baa_parser_advance(parser); // Consume the identifier
     
@@ -83,6 +85,7 @@ BaaNode *parse_variable_declaration_statement(BaaParser *parser, BaaAstNodeModif
         initializer_expr = parse_expression(parser);
         if (!initializer_expr)
         {
+            baa_free(var_name);
             baa_ast_free_node(type_node);
             return NULL;
         }
@@ -95,12 +98,11 @@ BaaNode *parse_variable_declaration_statement(BaaParser *parser, BaaAstNodeModif
     baa_parser_consume_token(parser, BAA_TOKEN_DOT, L"توقع '.' في نهاية إعلان المتغير");
     
     // Update span to include the dot
-    span.end.filename = parser->source_filename;
-    span.end.line = parser->current_token.line;
-    span.end.column = parser->current_token.column;
+    span.end = baa_parser_token_start_location(parser, &parser->current_token);
     
     // Create the variable declaration node
     BaaNode *var_decl_node = baa_ast_new_var_decl_node(span, var_name, modifiers, type_node, initializer_expr);
+    baa_free(var_name);
     if (!var_decl_node)
     {
         baa_ast_free_node(type_node);
@@ -118,10 +120,10 @@ BaaNode *parse_variable_declaration_statement(BaaParser *parser, BaaAstNodeModif
 
 BaaNode *parse_parameter(BaaParser *parser)
 {
-    // Convert lexer span to AST span for start position
+    // Compute AST span from token offsets for start position
     BaaAstSourceSpan start_span = {
-        {NULL, parser->current_token.span.start_line, parser->current_token.span.start_column},
-        {NULL, parser->current_token.span.end_line, parser->current_token.span.end_column}
+        baa_parser_token_start_location(parser, &parser->current_token),
+        baa_parser_token_end_location(parser, &parser->current_token)
     };
 
     // Parse the parameter type
@@ -148,10 +150,10 @@ BaaNode *parse_parameter(BaaParser *parser)
         return NULL;
     }
 
-    // Convert lexer span to AST span for end position
+    // Compute AST span from token offsets for end position
     BaaAstSourceSpan end_span = {
-        {NULL, parser->current_token.span.start_line, parser->current_token.span.start_column},
-        {NULL, parser->current_token.span.end_line, parser->current_token.span.end_column}
+        baa_parser_token_start_location(parser, &parser->current_token),
+        baa_parser_token_end_location(parser, &parser->current_token)
     };
     baa_parser_advance(parser); // Consume the parameter name
 
@@ -292,14 +294,49 @@ bool parse_parameter_list(BaaParser *parser, BaaNode ***parameters, size_t *para
 
 // --- Function Definition Parsing ---
 
+/**
+ * @brief Skips a function body by brace matching, for lazy parsing.
+ * Consumes everything from the opening brace through the matching closing brace.
+ *
+ * @param parser Pointer to the parser state.
+ * @return true if the closing brace was consumed, false on a missing brace or EOF (error reported).
+ */
+static bool skip_function_body(BaaParser *parser)
+{
+    if (!baa_parser_check_token(parser, BAA_TOKEN_LBRACE))
+    {
+        baa_parser_error(parser, L"توقع '{' لبداية الكتلة");
+        return false;
+    }
+    baa_parser_advance(parser);
+
+    size_t depth = 1;
+    while (!baa_parser_check_token(parser, BAA_TOKEN_EOF))
+    {
+        if (parser->current_token.type == BAA_TOKEN_LBRACE)
+        {
+            depth++;
+        }
+        else if (parser->current_token.type == BAA_TOKEN_RBRACE && --depth == 0)
+        {
+            baa_parser_advance(parser);
+            return true;
+        }
+        baa_parser_advance(parser);
+    }
+
+    baa_parser_error(parser, L"توقع '}' لنهاية الكتلة");
+    return false;
+}
+
 BaaNode *parse_function_definition(BaaParser *parser, BaaAstNodeModifiers initial_modifiers)
 {
     BaaAstNodeModifiers modifiers = initial_modifiers;
 
-    // Convert lexer span to AST span for start position
+    // Compute AST span from token offsets for start position
     BaaAstSourceSpan start_span = {
-        {NULL, parser->current_token.span.start_line, parser->current_token.span.start_column},
-        {NULL, parser->current_token.span.end_line, parser->current_token.span.end_column}
+        baa_parser_token_start_location(parser, &parser->current_token),
+        baa_parser_token_end_location(parser, &parser->current_token)
     };
 
     // Parse additional modifiers if present (e.g., inline)
@@ -350,9 +387,22 @@ BaaNode *parse_function_definition(BaaParser *parser, BaaAstNodeModifiers initia
         return NULL;
     }
 
-    // Parse function body (block statement)
-    BaaNode *body = parse_block_statement(parser);
-    if (!body)
+    // Parse function body (block statement), or only record where it is in lazy mode
+    BaaNode *body = NULL;
+    size_t body_start_offset = parser->current_token.start_offset;
+    size_t body_end_offset = 0;
+    if (parser->lazy_bodies)
+    {
+        if (skip_function_body(parser))
+        {
+            body_end_offset = parser->previous_token.end_offset;
+        }
+    }
+    else
+    {
+        body = parse_block_statement(parser);
+    }
+    if (!body && body_end_offset == 0)
     {
         baa_parser_error(parser, L"Expected function body (block statement)");
         baa_free(function_name);
@@ -369,10 +419,10 @@ BaaNode *parse_function_definition(BaaParser *parser, BaaAstNodeModifiers initia
         return NULL;
     }
 
-    // Convert lexer span to AST span for end position
+    // Compute AST span from token offsets for end position
     BaaAstSourceSpan end_span = {
-        {NULL, parser->current_token.span.start_line, parser->current_token.span.start_column},
-        {NULL, parser->current_token.span.end_line, parser->current_token.span.end_column}
+        baa_parser_token_start_location(parser, &parser->current_token),
+        baa_parser_token_end_location(parser, &parser->current_token)
     };
 
     // Create the function definition node with combined span
@@ -381,9 +431,11 @@ BaaNode *parse_function_definition(BaaParser *parser, BaaAstNodeModifiers initia
         end_span.end
     };
 
-    BaaNode *function_def_node = baa_ast_new_function_def_node(function_span, function_name,
-                                                               modifiers, return_type_node,
-                                                               body, false); // is_variadic = false for now
+    BaaNode *function_def_node =
+        body ? baa_ast_new_function_def_node(function_span, function_name, modifiers, return_type_node,
+                                             body, false) // is_variadic = false for now
+             : baa_ast_new_deferred_function_def_node(function_span, function_name, modifiers, return_type_node,
+                                                      body_start_offset, body_end_offset, false);
 
     baa_free(function_name); // Free the duplicated name (baa_ast_new_function_def_node duplicates it again)
 
@@ -430,64 +482,84 @@ BaaNode *parse_function_definition(BaaParser *parser, BaaAstNodeModifiers initia
 
 // --- Declaration/Statement Dispatcher ---
 
+/**
+ * @brief Returns the number of tokens a type specifier starting `n` tokens ahead spans.
+ * Handles primitive types and array suffixes (`type[...]`), skipping balanced brackets.
+ *
+ * @param parser Pointer to the parser state.
+ * @param n Lookahead distance of the first type token.
+ * @return The length in tokens, or 0 if no complete type fits in the lookahead window.
+ */
+static size_t peek_type_specifier_length(BaaParser *parser, size_t n)
+{
+    const BaaToken *token = baa_parser_peek_token(parser, n);
+    if (!token || !baa_token_is_type(token->type))
+    {
+        return 0;
+    }
+
+    size_t length = 1;
+    token = baa_parser_peek_token(parser, n + length);
+    if (token && token->type == BAA_TOKEN_LBRACKET)
+    {
+        size_t depth = 0;
+        do
+        {
+            if (!token || token->type == BAA_TOKEN_EOF)
+            {
+                return 0;
+            }
+            if (token->type == BAA_TOKEN_LBRACKET)
+            {
+                depth++;
+            }
+            else if (token->type == BAA_TOKEN_RBRACKET)
+            {
+                depth--;
+            }
+            length++;
+            token = baa_parser_peek_token(parser, n + length);
+        } while (depth > 0);
+    }
+    return length;
+}
+
 /**
  * @brief Helper function to check if the current token sequence looks like a function definition.
- * This function performs lookahead to distinguish between function definitions and variable declarations.
+ * Uses the parser's lookahead ring to check for `[modifiers] type identifier '('`
+ * without consuming, re-lexing or freeing any token.
  *
  * @param parser Pointer to the parser state.
  * @return true if the sequence looks like a function definition, false otherwise.
  */
 static bool looks_like_function_definition(BaaParser *parser)
 {
-    // We need to look ahead to see if after [modifiers] type_specifier identifier we have '('
-    // This is a simplified heuristic - a more robust implementation would use proper lookahead
-
-    // Save current parser state
-    BaaToken saved_current = parser->current_token;
-    BaaToken saved_previous = parser->previous_token;
-
     // Skip modifiers
-    while (parser->current_token.type == BAA_TOKEN_CONST ||
-           parser->current_token.type == BAA_TOKEN_KEYWORD_INLINE ||
-           parser->current_token.type == BAA_TOKEN_KEYWORD_RESTRICT)
+    size_t n = 0;
+    const BaaToken *token = baa_parser_peek_token(parser, n);
+    while (token && (token->type == BAA_TOKEN_CONST ||
+                     token->type == BAA_TOKEN_KEYWORD_INLINE ||
+                     token->type == BAA_TOKEN_KEYWORD_RESTRICT))
     {
-        baa_parser_advance(parser);
+        token = baa_parser_peek_token(parser, ++n);
     }
 
-    // Skip type specifier (simplified - assumes single token type)
-    if (baa_token_is_type(parser->current_token.type))
-    {
-        baa_parser_advance(parser);
-    }
-    else
+    // Skip the type specifier (which may span several tokens)
+    size_t type_length = peek_type_specifier_length(parser, n);
+    if (type_length == 0)
     {
-        // Restore parser state and return false
-        parser->current_token = saved_current;
-        parser->previous_token = saved_previous;
         return false;
     }
+    n += type_length;
 
-    // Skip identifier (function/variable name)
-    if (parser->current_token.type == BAA_TOKEN_IDENTIFIER)
-    {
-        baa_parser_advance(parser);
-    }
-    else
+    // The function/variable name must follow, then '(' for a function definition
+    token = baa_parser_peek_token(parser, n);
+    if (!token || token->type != BAA_TOKEN_IDENTIFIER)
     {
-        // Restore parser state and return false
-        parser->current_token = saved_current;
-        parser->previous_token = saved_previous;
         return false;
     }
-
-    // Check if next token is '(' (function definition) or something else (variable declaration)
-    bool is_function = (parser->current_token.type == BAA_TOKEN_LPAREN);
-
-    // Restore parser state
-    parser->current_token = saved_current;
-    parser->previous_token = saved_previous;
-
-    return is_function;
+    token = baa_parser_peek_token(parser, n + 1);
+    return token && token->type == BAA_TOKEN_LPAREN;
 }
 
 BaaNode *parse_declaration_or_statement(BaaParser *parser)
@@ -6,28 +6,25 @@
 #include "baa/lexer/lexer.h"
 #include "baa/utils/utils.h"
 #include <stdio.h>
+#include <string.h>
 
 BaaNode *parse_primary_expression(BaaParser *parser)
 {
     // Handle literals
     if (parser->current_token.type == BAA_TOKEN_INT_LIT)
     {
-        // Extract the integer value from the token
-        // For now, we'll use a simple conversion - this should be improved later
-        long long value = 0;
-        if (parser->current_token.lexeme)
+        // The lexer already parsed the value (all bases, digit sets, underscores and suffixes)
+        const BaaLiteralValue *literal = &parser->current_token.literal;
+        if (literal->flags & BAA_LITERAL_FLAG_OVERFLOW)
         {
-            // Simple conversion - this should use proper number parsing later
-            value = wcstoll(parser->current_token.lexeme, NULL, 10);
+            baa_parser_error_at_token(parser, &parser->current_token, L"العدد الصحيح كبير جداً");
         }
+        long long value = (long long)literal->int_value;
 
         // Create source span from current token
         BaaAstSourceSpan span = {
-            .start = {
-                .filename = parser->source_filename,
-                .line = parser->current_token.line,
-                .column = parser->current_token.column},
-            .end = {.filename = parser->source_filename, .line = parser->current_token.line, .column = parser->current_token.column + parser->current_token.length}};
+            .start = baa_parser_token_start_location(parser, &parser->current_token),
+            .end = baa_parser_token_end_location(parser, &parser->current_token)};
 
         // Use NULL type for now - this should be determined properly later
         BaaNode *node = baa_ast_new_literal_int_node(span, value, NULL);
@@ -39,11 +36,8 @@ BaaNode *parse_primary_expression(BaaParser *parser)
     {
         // Create source span from current token
         BaaAstSourceSpan span = {
-            .start = {
-                .filename = parser->source_filename,
-                .line = parser->current_token.line,
-                .column = parser->current_token.column},
-            .end = {.filename = parser->source_filename, .line = parser->current_token.line, .column = parser->current_token.column + parser->current_token.length}};
+            .start = baa_parser_token_start_location(parser, &parser->current_token),
+            .end = baa_parser_token_end_location(parser, &parser->current_token)};
 
         // Use the token's lexeme as the string value
         const wchar_t *string_value = parser->current_token.lexeme ? parser->current_token.lexeme : L"";
@@ -58,11 +52,8 @@ BaaNode *parse_primary_expression(BaaParser *parser)
     {
         // Create source span from current token
         BaaAstSourceSpan span = {
-            .start = {
-                .filename = parser->source_filename,
-                .line = parser->current_token.line,
-                .column = parser->current_token.column},
-            .end = {.filename = parser->source_filename, .line = parser->current_token.line, .column = parser->current_token.column + parser->current_token.length}};
+            .start = baa_parser_token_start_location(parser, &parser->current_token),
+            .end = baa_parser_token_end_location(parser, &parser->current_token)};
 
         // Use the token's lexeme as the identifier name
         const wchar_t *identifier_name = parser->current_token.lexeme ? parser->current_token.lexeme : L"";
@@ -72,19 +63,6 @@ BaaNode *parse_primary_expression(BaaParser *parser)
         return node;
     }
 
-    if (parser->current_token.type == BAA_TOKEN_LPAREN)
-    {
-        baa_parser_advance(parser);               // Consume '('
-        BaaNode *expr = parse_expression(parser); // Recursively parse the expression inside
-        if (!expr)
-        {
-            return NULL; // Error in parsing the inner expression
-        }
-
-        baa_parser_consume_token(parser, BAA_TOKEN_RPAREN, L"توقع ')' بعد التعبير");
-        return expr; // Return the inner expression (grouping doesn't create a new node)
-    }
-
     // If we reach here, we have an unexpected token
     baa_parser_error_at_token(parser, &parser->current_token,
                               L"توقع تعبير أساسي (رقم، نص، معرف، أو '(')");
@@ -169,315 +147,315 @@ static BaaBinaryOperatorKind token_to_binary_op(BaaTokenType token_type)
     }
 }
 
-BaaNode *parse_expression(BaaParser *parser)
-{
-    // Start with unary expression parsing
-    BaaNode *left_expr = parse_unary_expression(parser);
-    if (!left_expr)
-    {
-        return NULL;
-    }
+// --- Expression Engine ---
+//
+// Expressions are parsed by an operator-precedence engine with an explicit
+// stack instead of one recursive call per nesting level, so deeply nested
+// parentheses, prefix chains and calls only grow a heap array. The stack holds
+// the constructs still waiting for an operand: prefix operators, binary
+// operators with their left operand, open parentheses and open argument lists.
+// Binary operators are reduced while the operator on the stack has the same or
+// a higher precedence (all binary operators are left-associative), which builds
+// the same trees as precedence climbing.
 
-    // Then handle binary operators with precedence climbing
-    return parse_binary_expression_rhs(parser, 0, left_expr);
-}
+#define EXPR_INLINE_FRAMES 32 // Frames kept on the C stack before the engine moves to the heap
 
-BaaNode *parse_unary_expression(BaaParser *parser)
+typedef enum
 {
-    // Check for unary operators
-    if (parser->current_token.type == BAA_TOKEN_MINUS)
-    {
-        // Create source span for the unary operator
-        BaaAstSourceSpan span = {
-            .start = {
-                .filename = parser->source_filename,
-                .line = parser->current_token.line,
-                .column = parser->current_token.column},
-            .end = {.filename = parser->source_filename, .line = parser->current_token.line, .column = parser->current_token.column + parser->current_token.length}};
-
-        baa_parser_advance(parser); // Consume the '-' token
-
-        // Parse the operand (recursively handle unary expressions)
-        BaaNode *operand = parse_unary_expression(parser);
-        if (!operand)
-        {
-            return NULL;
-        }
+    EXPR_FRAME_UNARY,  // Prefix operator waiting for its operand
+    EXPR_FRAME_BINARY, // Binary operator waiting for its right operand
+    EXPR_FRAME_GROUP,  // '(' of a parenthesized expression
+    EXPR_FRAME_CALL,   // Argument list of a call
+} BaaExprFrameKind;
 
-        // Update span to include the operand
-        span.end = operand->span.end;
+typedef struct
+{
+    BaaExprFrameKind kind;
+    BaaTokenType operator_token;    // EXPR_FRAME_BINARY
+    int precedence;                 // EXPR_FRAME_BINARY
+    BaaUnaryOperatorKind unary_op;  // EXPR_FRAME_UNARY
+    BaaSourceLocation start;        // EXPR_FRAME_UNARY: start of the operator token
+    BaaNode *node;                  // EXPR_FRAME_BINARY: left operand; EXPR_FRAME_CALL: the call
+} BaaExprFrame;
+
+typedef struct
+{
+    BaaExprFrame *frames;
+    size_t count;
+    size_t capacity;
+    BaaExprFrame inline_frames[EXPR_INLINE_FRAMES];
+} BaaExprStack;
 
-        // Create unary expression node
-        return baa_ast_new_unary_expr_node(span, operand, BAA_UNARY_OP_MINUS);
-    }
-    else if (parser->current_token.type == BAA_TOKEN_PLUS)
+static bool expr_stack_push(BaaExprStack *stack, BaaExprFrame frame)
+{
+    if (stack->count == stack->capacity)
     {
-        // Create source span for the unary operator
-        BaaAstSourceSpan span = {
-            .start = {
-                .filename = parser->source_filename,
-                .line = parser->current_token.line,
-                .column = parser->current_token.column},
-            .end = {.filename = parser->source_filename, .line = parser->current_token.line, .column = parser->current_token.column + parser->current_token.length}};
-
-        baa_parser_advance(parser); // Consume the '+' token
-
-        // Parse the operand (recursively handle unary expressions)
-        BaaNode *operand = parse_unary_expression(parser);
-        if (!operand)
+        size_t capacity = stack->capacity * 2;
+        BaaExprFrame *frames;
+        if (stack->frames == stack->inline_frames)
         {
-            return NULL;
+            frames = (BaaExprFrame *)baa_malloc(capacity * sizeof(BaaExprFrame));
+            if (frames)
+                memcpy(frames, stack->inline_frames, stack->count * sizeof(BaaExprFrame));
         }
-
-        // Update span to include the operand
-        span.end = operand->span.end;
-
-        // Create unary expression node
-        return baa_ast_new_unary_expr_node(span, operand, BAA_UNARY_OP_PLUS);
-    }
-    else if (parser->current_token.type == BAA_TOKEN_BANG)
-    {
-        // Create source span for the unary operator
-        BaaAstSourceSpan span = {
-            .start = {
-                .filename = parser->source_filename,
-                .line = parser->current_token.line,
-                .column = parser->current_token.column},
-            .end = {.filename = parser->source_filename, .line = parser->current_token.line, .column = parser->current_token.column + parser->current_token.length}};
-
-        baa_parser_advance(parser); // Consume the '!' token
-
-        // Parse the operand (recursively handle unary expressions)
-        BaaNode *operand = parse_unary_expression(parser);
-        if (!operand)
+        else
         {
-            return NULL;
+            frames = (BaaExprFrame *)baa_realloc(stack->frames, capacity * sizeof(BaaExprFrame));
         }
-
-        // Update span to include the operand
-        span.end = operand->span.end;
-
-        // Create unary expression node
-        return baa_ast_new_unary_expr_node(span, operand, BAA_UNARY_OP_LOGICAL_NOT);
-    }
-
-    // No unary operator, parse primary expression and then handle postfix operations
-    BaaNode *primary_expr = parse_primary_expression(parser);
-    if (!primary_expr)
-    {
-        return NULL;
+        if (!frames)
+            return false;
+        stack->frames = frames;
+        stack->capacity = capacity;
     }
-
-    // Handle postfix operations (function calls, array access, etc.)
-    return parse_postfix_expression(parser, primary_expr);
+    stack->frames[stack->count++] = frame;
+    return true;
 }
 
-BaaNode *parse_binary_expression_rhs(BaaParser *parser, int min_precedence, BaaNode *left_expr)
+static BaaExprFrame *expr_stack_top(BaaExprStack *stack)
 {
-    if (!left_expr)
-    {
-        return NULL;
-    }
+    return stack->count ? &stack->frames[stack->count - 1] : NULL;
+}
 
-    while (true)
+// Folds the binary operators on top of the stack whose precedence is at least
+// `min_precedence` into `operand`. Returns NULL (with everything freed) on failure.
+static BaaNode *expr_reduce_binary(BaaExprStack *stack, BaaNode *operand, int min_precedence)
+{
+    BaaExprFrame *top;
+    while ((top = expr_stack_top(stack)) && top->kind == EXPR_FRAME_BINARY && top->precedence >= min_precedence)
     {
-        // Check if current token is a binary operator
-        int token_precedence = get_token_precedence(parser->current_token.type);
-
-        // If it's not a binary operator or precedence is too low, we're done
-        if (token_precedence < min_precedence)
-        {
-            return left_expr;
-        }
+        BaaNode *left_expr = top->node;
+        stack->count--;
 
-        // Remember the operator token and advance
-        BaaTokenType operator_token = parser->current_token.type;
-        BaaAstSourceSpan operator_span = {
-            .start = {
-                .filename = parser->source_filename,
-                .line = parser->current_token.line,
-                .column = parser->current_token.column},
-            .end = {.filename = parser->source_filename, .line = parser->current_token.line, .column = parser->current_token.column + parser->current_token.length}};
-
-        baa_parser_advance(parser); // Consume the operator
-
-        // Parse the right operand
-        BaaNode *right_expr = parse_unary_expression(parser);
-        if (!right_expr)
-        {
-            baa_ast_free_node(left_expr);
-            return NULL;
-        }
-
-        // Check if the next operator has higher precedence
-        int next_precedence = get_token_precedence(parser->current_token.type);
-        if (next_precedence > token_precedence)
-        {
-            // Parse the right side with higher precedence first
-            right_expr = parse_binary_expression_rhs(parser, token_precedence + 1, right_expr);
-            if (!right_expr)
-            {
-                baa_ast_free_node(left_expr);
-                return NULL;
-            }
-        }
-
-        // Create the binary expression node
         BaaAstSourceSpan expr_span = {
             .start = left_expr->span.start,
-            .end = right_expr->span.end};
-
-        BaaBinaryOperatorKind op_kind = token_to_binary_op(operator_token);
-        BaaNode *binary_expr = baa_ast_new_binary_expr_node(expr_span, left_expr, right_expr, op_kind);
+            .end = operand->span.end};
+        BaaNode *binary_expr = baa_ast_new_binary_expr_node(expr_span, left_expr, operand,
+                                                            token_to_binary_op(top->operator_token));
         if (!binary_expr)
         {
             baa_ast_free_node(left_expr);
-            baa_ast_free_node(right_expr);
+            baa_ast_free_node(operand);
             return NULL;
         }
-
-        // The binary expression becomes the new left operand for the next iteration
-        left_expr = binary_expr;
+        operand = binary_expr;
     }
+    return operand;
 }
 
-// --- Postfix Expression Parsing ---
-
-BaaNode *parse_postfix_expression(BaaParser *parser, BaaNode *base_expr)
+// Releases what is left on the stack after an error. Every open argument list
+// reports the failed argument, innermost first, as nested call parsing did.
+static void expr_stack_unwind(BaaParser *parser, BaaExprStack *stack, BaaNode *operand)
 {
-    if (!base_expr)
+    baa_ast_free_node(operand);
+    while (stack->count > 0)
     {
-        return NULL;
-    }
-
-    BaaNode *current_expr = base_expr;
-
-    // Handle postfix operations in a loop
-    while (true)
-    {
-        if (parser->current_token.type == BAA_TOKEN_LPAREN)
+        BaaExprFrame *frame = &stack->frames[--stack->count];
+        if (frame->kind == EXPR_FRAME_CALL)
         {
-            // Function call
-            current_expr = parse_call_expression(parser, current_expr);
-            if (!current_expr)
-            {
-                return NULL;
-            }
+            baa_parser_error(parser, L"Failed to parse function call argument");
         }
-        // Future: Add array access [index], member access .member, etc.
-        else
+        if (frame->kind == EXPR_FRAME_BINARY || frame->kind == EXPR_FRAME_CALL)
         {
-            // No more postfix operations
-            break;
+            baa_ast_free_node(frame->node);
         }
     }
-
-    return current_expr;
 }
 
-BaaNode *parse_call_expression(BaaParser *parser, BaaNode *callee_expr)
+static bool token_to_unary_op(BaaTokenType token_type, BaaUnaryOperatorKind *op)
 {
-    if (!callee_expr)
+    switch (token_type)
     {
-        return NULL;
+    case BAA_TOKEN_MINUS:
+        *op = BAA_UNARY_OP_MINUS;
+        return true;
+    case BAA_TOKEN_PLUS:
+        *op = BAA_UNARY_OP_PLUS;
+        return true;
+    case BAA_TOKEN_BANG:
+        *op = BAA_UNARY_OP_LOGICAL_NOT;
+        return true;
+    default:
+        return false;
     }
+}
+
+BaaNode *parse_expression(BaaParser *parser)
+{
+    BaaExprStack stack;
+    stack.frames = stack.inline_frames;
+    stack.count = 0;
+    stack.capacity = EXPR_INLINE_FRAMES;
 
-    // Convert lexer span to AST span for start position
-    BaaAstSourceSpan start_span = {
-        {NULL, parser->current_token.span.start_line, parser->current_token.span.start_column},
-        {NULL, parser->current_token.span.end_line, parser->current_token.span.end_column}
-    };
+    BaaNode *operand = NULL;
+    BaaNode *result = NULL;
 
-    // Expect opening parenthesis
-    if (parser->current_token.type != BAA_TOKEN_LPAREN)
+    for (;;)
     {
-        baa_parser_error(parser, L"Expected '(' to start function call");
-        baa_ast_free_node(callee_expr);
-        return NULL;
-    }
+        // Operand position: prefix operators and '(' open frames until a primary expression is reached
+        BaaUnaryOperatorKind unary_op;
+        while (!operand)
+        {
+            BaaExprFrame frame;
+            memset(&frame, 0, sizeof(frame));
+            if (token_to_unary_op(parser->current_token.type, &unary_op))
+            {
+                frame.kind = EXPR_FRAME_UNARY;
+                frame.unary_op = unary_op;
+                frame.start = baa_parser_token_start_location(parser, &parser->current_token);
+            }
+            else if (parser->current_token.type == BAA_TOKEN_LPAREN)
+            {
+                frame.kind = EXPR_FRAME_GROUP;
+            }
+            else
+            {
+                operand = parse_primary_expression(parser);
+                if (!operand)
+                    goto fail;
+                break;
+            }
 
-    baa_parser_advance(parser); // Consume '('
+            baa_parser_advance(parser); // Consume the prefix operator or '('
+            if (!expr_stack_push(&stack, frame))
+                goto fail;
+        }
 
-    // Create the call expression node
-    BaaNode *call_expr = baa_ast_new_call_expr_node(start_span, callee_expr);
-    if (!call_expr)
-    {
-        baa_parser_error(parser, L"Failed to create call expression node");
-        baa_ast_free_node(callee_expr);
-        return NULL;
-    }
+        // Postfix operations: calls. An argument list opens a frame and parses its first argument.
+        while (parser->current_token.type == BAA_TOKEN_LPAREN)
+        {
+            // The call's span starts at '('
+            BaaAstSourceSpan start_span = {
+                baa_parser_token_start_location(parser, &parser->current_token),
+                baa_parser_token_end_location(parser, &parser->current_token)};
+            baa_parser_advance(parser); // Consume '('
+
+            BaaNode *call_expr = baa_ast_new_call_expr_node(start_span, operand);
+            if (!call_expr)
+            {
+                baa_parser_error(parser, L"Failed to create call expression node");
+                goto fail;
+            }
+            operand = call_expr;
 
-    // Handle empty argument list
-    if (parser->current_token.type == BAA_TOKEN_RPAREN)
-    {
-        baa_parser_advance(parser); // Consume ')'
+            if (parser->current_token.type == BAA_TOKEN_RPAREN)
+            {
+                baa_parser_advance(parser); // Consume ')'
+                // Empty argument list: the span ends with the token after ')'
+                call_expr->span.end = baa_parser_token_end_location(parser, &parser->current_token);
+                continue;
+            }
 
-        // Update span to include closing parenthesis
-        BaaAstSourceSpan end_span = {
-            {NULL, parser->current_token.span.start_line, parser->current_token.span.start_column},
-            {NULL, parser->current_token.span.end_line, parser->current_token.span.end_column}
-        };
-        call_expr->span.end = end_span.end;
+            BaaExprFrame frame;
+            memset(&frame, 0, sizeof(frame));
+            frame.kind = EXPR_FRAME_CALL;
+            frame.node = call_expr;
+            if (!expr_stack_push(&stack, frame))
+                goto fail;
+            operand = NULL;
+            break;
+        }
+        if (!operand)
+            continue; // Parse the first argument
 
-        return call_expr; // Empty argument list is valid
-    }
+        // Prefix operators bind tighter than binary operators but looser than calls
+        BaaExprFrame *top;
+        while ((top = expr_stack_top(&stack)) && top->kind == EXPR_FRAME_UNARY)
+        {
+            BaaAstSourceSpan span = {.start = top->start, .end = operand->span.end};
+            BaaNode *unary_expr = baa_ast_new_unary_expr_node(span, operand, top->unary_op);
+            stack.count--;
+            if (!unary_expr)
+                goto fail;
+            operand = unary_expr;
+        }
 
-    // Parse arguments
-    do {
-        // Parse a single argument expression
-        BaaNode *arg_expr = parse_expression(parser);
-        if (!arg_expr)
+        // Operator position: a binary operator reduces the operators it binds looser than
+        int precedence = get_token_precedence(parser->current_token.type);
+        if (precedence >= 0)
         {
-            baa_parser_error(parser, L"Failed to parse function call argument");
-            baa_ast_free_node(call_expr);
-            return NULL;
+            operand = expr_reduce_binary(&stack, operand, precedence);
+            if (!operand)
+                goto fail;
+
+            BaaExprFrame frame;
+            memset(&frame, 0, sizeof(frame));
+            frame.kind = EXPR_FRAME_BINARY;
+            frame.operator_token = parser->current_token.type;
+            frame.precedence = precedence;
+            frame.node = operand;
+            if (!expr_stack_push(&stack, frame))
+                goto fail;
+            operand = NULL;
+            baa_parser_advance(parser); // Consume the operator
+            continue;
+        }
+
+        // Any other token ends the innermost expression
+        operand = expr_reduce_binary(&stack, operand, 0);
+        if (!operand)
+            goto fail;
+
+        top = expr_stack_top(&stack);
+        if (!top)
+        {
+            result = operand;
+            break;
         }
 
-        // Add the argument to the call expression
-        if (!baa_ast_add_call_argument(call_expr, arg_expr))
+        if (top->kind == EXPR_FRAME_GROUP)
+        {
+            // Grouping doesn't create a new node; the inner expression may still be called or negated
+            stack.count--;
+            baa_parser_consume_token(parser, BAA_TOKEN_RPAREN, L"توقع ')' بعد التعبير");
+            continue;
+        }
+
+        // EXPR_FRAME_CALL: the operand is the next argument
+        BaaNode *call_expr = top->node;
+        if (!baa_ast_add_call_argument(call_expr, operand))
         {
             baa_parser_error(parser, L"Failed to add argument to function call");
-            baa_ast_free_node(arg_expr);
-            baa_ast_free_node(call_expr);
-            return NULL;
+            goto fail_call;
         }
+        operand = NULL;
 
-        // Check for comma (more arguments) or closing parenthesis
         if (parser->current_token.type == BAA_TOKEN_COMMA)
         {
             baa_parser_advance(parser); // Consume ','
-            // Continue to parse next argument
+            // A trailing comma is accepted before ')'
+            if (parser->current_token.type != BAA_TOKEN_RPAREN && parser->current_token.type != BAA_TOKEN_EOF)
+                continue; // Parse the next argument
         }
-        else if (parser->current_token.type == BAA_TOKEN_RPAREN)
-        {
-            break; // End of argument list
-        }
-        else
+        else if (parser->current_token.type != BAA_TOKEN_RPAREN)
         {
             baa_parser_error(parser, L"Expected ',' or ')' in function call argument list");
-            baa_ast_free_node(call_expr);
-            return NULL;
+            goto fail_call;
         }
 
-    } while (parser->current_token.type != BAA_TOKEN_RPAREN &&
-             parser->current_token.type != BAA_TOKEN_EOF);
+        if (parser->current_token.type != BAA_TOKEN_RPAREN)
+        {
+            baa_parser_error(parser, L"Expected ')' to close function call argument list");
+            goto fail_call;
+        }
 
-    // Expect closing parenthesis
-    if (parser->current_token.type != BAA_TOKEN_RPAREN)
-    {
-        baa_parser_error(parser, L"Expected ')' to close function call argument list");
-        baa_ast_free_node(call_expr);
-        return NULL;
+        // Update span to include closing parenthesis
+        call_expr->span.end = baa_parser_token_end_location(parser, &parser->current_token);
+        baa_parser_advance(parser); // Consume ')'
+        stack.count--;
+        operand = call_expr;
     }
 
-    // Update span to include closing parenthesis
-    BaaAstSourceSpan end_span = {
-        {NULL, parser->current_token.span.start_line, parser->current_token.span.start_column},
-        {NULL, parser->current_token.span.end_line, parser->current_token.span.end_column}
-    };
-    call_expr->span.end = end_span.end;
-
-    baa_parser_advance(parser); // Consume ')'
-
-    return call_expr;
+    if (stack.frames != stack.inline_frames)
+        baa_free(stack.frames);
+    return result;
+
+fail_call:
+    // The innermost call reported its own error; the calls around it report the failed argument
+    stack.count--;
+    baa_ast_free_node(stack.frames[stack.count].node);
+fail:
+    expr_stack_unwind(parser, &stack, operand);
+    if (stack.frames != stack.inline_frames)
+        baa_free(stack.frames);
+    return NULL;
 }
@@ -4,10 +4,12 @@
 #include "parser_utils.h"    // For parser utility function declarations
 #include "statement_parser.h" // For parse_statement
 #include "declaration_parser.h" // For parse_declaration_or_statement
+#include "parser_parallel.h"  // For baa_parser_parse_program_parallel
 #include "baa/utils/utils.h"  // For baa_malloc, baa_free
+#include "baa/utils/trace.h"  // For BAA_TRACE
 #include "baa/lexer/lexer.h"  // For baa_lexer_next_token, baa_free_token
 #include "baa/ast/ast.h"     // For AST node creation functions
-#include <stdio.h>            // For error printing (temporary), fwprintf, vfwprintf
+#include <stdio.h>            // For fprintf (creation failures)
 #include <stdarg.h>           // For va_list, va_start, va_end
 #include <stdlib.h>           // For NULL
 
@@ -80,10 +82,32 @@ void baa_parser_synchronize(BaaParser *parser)
     parser->panic_mode = false; // Cleared at EOF
 }
 
+/**
+ * @brief Records a parser error at a token unless the parser is already panicking.
+ * Sets had_error and enters panic mode. A literal message is kept by pointer,
+ * one with arguments is formatted now; line/column are resolved only when the
+ * diagnostic is retrieved (see baa_parser_get_diagnostics).
+ */
+static void report_error_at_token(BaaParser *parser, const BaaToken *token, const wchar_t *message_format,
+                                  va_list args)
+{
+    if (parser->panic_mode)
+    { // Don't report if already panicking
+        return;
+    }
+    parser->panic_mode = true; // Enter panic mode
+    parser->had_error = true;
+    if (parser->silent)
+    {
+        return; // Worker parsers only record that an error occurred
+    }
+    baa_parser_record_diagnostic(parser, token, BAA_DIAG_ERROR, message_format, args);
+}
+
 /**
  * @brief Reports a parser error at the location of a specific token.
  * Sets the parser's had_error flag and enters panic mode if not already in it.
- * Avoids printing duplicate errors if already in panic mode.
+ * Avoids recording duplicate errors if already in panic mode.
  *
  * @param parser Pointer to the BaaParser instance.
  * @param token Pointer to the BaaToken at which the error occurred.
@@ -92,26 +116,15 @@ void baa_parser_synchronize(BaaParser *parser)
  */
 void baa_parser_error_at_token(BaaParser *parser, const BaaToken *token, const wchar_t *message_format, ...)
 {
-    if (!parser || parser->panic_mode)
-    { // Don't report if already panicking
+    if (!parser)
+    {
         return;
     }
-    parser->panic_mode = true; // Enter panic mode
-    parser->had_error = true;
-
-    // Construct the error message prefix with location
-    // Using source_filename stored in parser struct
-    fwprintf(stderr, L"%ls:%zu:%zu: خطأ: ",
-             parser->source_filename ? parser->source_filename : L"<unknown_source>",
-             token->line,
-             token->column);
 
     va_list args;
     va_start(args, message_format);
-    vfwprintf(stderr, message_format, args);
+    report_error_at_token(parser, token, message_format, args);
     va_end(args);
-
-    fwprintf(stderr, L"\n");
 }
 
 /**
@@ -129,16 +142,46 @@ void baa_parser_error(BaaParser *parser, const wchar_t *message_format, ...)
         return;
     }
 
+    // Report at the current token
     va_list args;
     va_start(args, message_format);
-
-    // Create a temporary buffer for the formatted message
-    wchar_t message_buffer[512];
-    vswprintf(message_buffer, sizeof(message_buffer) / sizeof(wchar_t), message_format, args);
+    report_error_at_token(parser, &parser->current_token, message_format, args);
     va_end(args);
+}
 
-    // Call the main error function with the current token
-    baa_parser_error_at_token(parser, &parser->current_token, L"%ls", message_buffer);
+/**
+ * @brief Computes the source location of a token's first character.
+ * Line and column are looked up on demand from the token's start offset.
+ *
+ * @param parser Pointer to the BaaParser instance.
+ * @param token The token to locate.
+ * @return The location, with line/column 0 if they cannot be computed.
+ */
+BaaSourceLocation baa_parser_token_start_location(BaaParser *parser, const BaaToken *token)
+{
+    BaaSourceLocation location = {parser ? parser->source_filename : NULL, 0, 0};
+    if (parser && token)
+    {
+        baa_lexer_get_position(parser->lexer, token->start_offset, &location.line, &location.column);
+    }
+    return location;
+}
+
+/**
+ * @brief Computes the source location just past a token's last character.
+ *
+ * @param parser Pointer to the BaaParser instance.
+ * @param token The token to locate.
+ * @return The location, with line/column 0 if they cannot be computed.
+ */
+BaaSourceLocation baa_parser_token_end_location(BaaParser *parser, const BaaToken *token)
+{
+    BaaSourceLocation location = {parser ? parser->source_filename : NULL, 0, 0};
+    if (parser && token)
+    {
+        baa_lexer_get_position(parser->lexer, token->end_offset, &location.line, &location.column);
+    }
+    return location;
 }
 
 /**
@@ -200,18 +243,15 @@ void baa_parser_consume_token(BaaParser *parser, BaaTokenType expected_type, con
     // Token doesn't match, report error using varargs for the message
     va_list args;
     va_start(args, error_message_format);
-    // Create a temporary buffer for the formatted message body
-    wchar_t message_body[256]; // Adjust size as needed or use dynamic allocation
-    vswprintf(message_body, sizeof(message_body) / sizeof(wchar_t), error_message_format, args);
+    report_error_at_token(parser, &parser->current_token, error_message_format, args);
     va_end(args);
-
-    // Report the error using the already formatted message_body
-    baa_parser_error_at_token(parser, &parser->current_token, L"%ls", message_body);
     // Note: synchronize() is typically called by the parsing rule that detects an unrecoverable state,
     // not directly by consume_token itself, to allow the rule to decide if it can recover differently.
 }
 
-BaaParser *baa_parser_create(BaaLexer *lexer, const wchar_t *source_filename)
+// Creates a parser whose token ring lexes from `lexer`, or replays `tokens` from token `first` if given
+static BaaParser *parser_create(BaaLexer *lexer, const BaaTokenBuffer *tokens, size_t first,
+                                const wchar_t *source_filename)
 {
     if (!lexer)
     {
@@ -231,20 +271,35 @@ BaaParser *baa_parser_create(BaaLexer *lexer, const wchar_t *source_filename)
     parser->source_filename = source_filename; // Store filename
     parser->had_error = false;
     parser->panic_mode = false;
+    parser->previous_index = 0;
+    parser->lookahead_head = 0;
+    parser->lookahead_count = 0;
+    parser->use_ast_arena = true;
+    parser->parse_threads = 1;
+    parser->lazy_bodies = false;
+    parser->silent = false;
+    parser->diagnostics = (BaaParserDiagnostics){0};
+
+    bool stream_ready = tokens ? baa_token_stream_init_buffer(&parser->tokens, tokens, first)
+                               : baa_token_stream_init(&parser->tokens, lexer);
+    if (!stream_ready)
+    {
+        fprintf(stderr, "Parser Error: Failed to allocate memory for the token ring.\n");
+        baa_free(parser);
+        return NULL;
+    }
 
     // Initialize tokens to a known state (e.g., EOF or an UNKNOWN type)
-    // The lexemes should be NULL initially so 'advance' doesn't try to free garbage.
+    // Lexemes are owned by the token ring, so these never need freeing.
     parser->current_token.type = BAA_TOKEN_UNKNOWN; // Or some initial sentinel
     parser->current_token.lexeme = NULL;
     parser->current_token.length = 0;
-    parser->current_token.line = 0;
-    parser->current_token.column = 0;
+    parser->current_token.start_offset = 0;
+    parser->current_token.end_offset = 0;
+    parser->current_token.error = (BaaLexerError){0};
+    parser->current_token.literal = (BaaLiteralValue){0};
 
-    parser->previous_token.type = BAA_TOKEN_UNKNOWN;
-    parser->previous_token.lexeme = NULL;
-    parser->previous_token.length = 0;
-    parser->previous_token.line = 0;
-    parser->previous_token.column = 0;
+    parser->previous_token = parser->current_token;
 
     // Prime the pump: Fetch the first token to be current_token.
     // previous_token will remain in its initial state after this first advance.
@@ -257,30 +312,48 @@ BaaParser *baa_parser_create(BaaLexer *lexer, const wchar_t *source_filename)
     return parser;
 }
 
+BaaParser *baa_parser_create(BaaLexer *lexer, const wchar_t *source_filename)
+{
+    return parser_create(lexer, NULL, 0, source_filename);
+}
+
+BaaParser *baa_parser_create_from_tokens(BaaLexer *lexer, const BaaTokenBuffer *tokens, size_t first,
+                                         const wchar_t *source_filename)
+{
+    if (!tokens)
+        return NULL;
+    return parser_create(lexer, tokens, first, source_filename);
+}
+
+// Tokens the grammar never sees: advance and peek step over them silently
+bool baa_parser_token_is_trivia(BaaTokenType type)
+{
+    return type == BAA_TOKEN_WHITESPACE || type == BAA_TOKEN_NEWLINE ||
+           type == BAA_TOKEN_SINGLE_LINE_COMMENT || type == BAA_TOKEN_MULTI_LINE_COMMENT ||
+           type == BAA_TOKEN_DOC_COMMENT;
+}
+
 /**
- * @brief Consumes the current token and fetches the next one from the lexer.
+ * @brief Consumes the current token and fetches the next one from the token ring.
  *
- * Skips over lexical error tokens, reporting them and continuing to the next
- * valid token or EOF. Manages lexeme ownership for current_token and previous_token.
+ * Skips whitespace and comments, and skips over lexical error tokens, reporting
+ * them and continuing to the next valid token or EOF. Error tokens replayed after
+ * a rewind are reported again, since the rewind dropped their diagnostics.
+ * current_token and previous_token borrow their lexemes from the ring, which
+ * keeps them alive until the parser moves past them.
  */
 void baa_parser_advance(BaaParser *parser)
 {
-    // 1. Free the lexeme of the *old* previous_token (the one about to be overwritten)
-    if (parser->previous_token.lexeme != NULL)
-    {
-        baa_free((void *)parser->previous_token.lexeme); // Cast to void* for baa_free
-        parser->previous_token.lexeme = NULL;
-    }
-
-    // 2. Shift current_token to previous_token
-    parser->previous_token = parser->current_token; // Struct copy. previous_token now "owns" the lexeme
-                                                    // that current_token previously owned.
+    // 1. Shift current_token to previous_token; tokens before it may now be recycled
+    parser->previous_token = parser->current_token; // Struct copy, the lexeme stays in the ring
+    parser->previous_index = parser->tokens.position > 0 ? parser->tokens.position - 1 : 0;
+    baa_token_stream_discard(&parser->tokens, parser->previous_index);
 
-    // 3. Fetch the next token from the lexer until it's not a BAA_TOKEN_ERROR or we hit EOF.
+    // 2. Fetch the next token until it's not a BAA_TOKEN_ERROR or we hit EOF.
     for (;;)
     {
-        BaaToken *lexer_next_token_ptr = baa_lexer_next_token(parser->lexer);
-        if (!lexer_next_token_ptr)
+        const BaaToken *next_token = baa_token_stream_next(&parser->tokens);
+        if (!next_token)
         {
             // This indicates a critical failure in the lexer (e.g., malloc failed for token)
             // Report a parser-level error and set current_token to EOF to stop.
@@ -289,57 +362,18 @@ void baa_parser_advance(BaaParser *parser)
             parser->current_token.type = BAA_TOKEN_EOF;
             parser->current_token.lexeme = NULL; // No lexeme for this synthetic EOF
             parser->current_token.length = 0;
-            parser->current_token.line = parser->previous_token.line; // Approximate location
-            parser->current_token.column = parser->previous_token.column;
-            // No need to free lexer_next_token_ptr as it's NULL
+            parser->current_token.start_offset = parser->previous_token.end_offset; // Approximate location
+            parser->current_token.end_offset = parser->previous_token.end_offset;
             return;
         }
-        // --- DEBUG PRINT: Token received from lexer IN THIS ITERATION ---
-        if (lexer_next_token_ptr)
-        {
-            fwprintf(stderr, L"DEBUG PARSER advance - Lexer Returned: Type=%d (%ls), Lexeme='", lexer_next_token_ptr->type, baa_token_type_to_string(lexer_next_token_ptr->type));
-            for (size_t i = 0; i < lexer_next_token_ptr->length; ++i)
-            {
-                putwc(lexer_next_token_ptr->lexeme[i], stderr);
-            }
-            fwprintf(stderr, L"', Line=%zu, Col=%zu\n", lexer_next_token_ptr->line, lexer_next_token_ptr->column);
-            fflush(stderr);
-        }
-        // --- END DEBUG PRINT ---
+        // 3. Copy the new token's data to parser->current_token; the ring keeps owning the lexeme
+        parser->current_token = *next_token;
 
-        // --- DEBUG PRINT before assignment ---
-        if (lexer_next_token_ptr)
+        if (baa_parser_token_is_trivia(parser->current_token.type))
         {
-            fwprintf(stderr, L"DEBUG PARSER advance - Lexer Token Before Assign: Type=%d, Lexeme='", lexer_next_token_ptr->type);
-            for (size_t i = 0; i < lexer_next_token_ptr->length; ++i)
-            {
-                putwc(lexer_next_token_ptr->lexeme[i], stderr);
-            }
-            fwprintf(stderr, L"', Len=%zu, Line=%zu, Col=%zu\n",
-                     lexer_next_token_ptr->length, lexer_next_token_ptr->line, lexer_next_token_ptr->column);
+            continue; // Whitespace and comments carry no syntax
         }
-        // --- END DEBUG PRINT ---
-
-        // 4. Copy the new token's data to parser->current_token
-        parser->current_token = *lexer_next_token_ptr; // Struct copy. current_token now "owns" the lexeme.
-
-        // 5. Sever ownership from the temporary token struct returned by the lexer
-        lexer_next_token_ptr->lexeme = NULL;
-
-        // 6. Free the shell of the token returned by the lexer
-        baa_free_token(lexer_next_token_ptr);
-
-        // -- -DEBUG PRINT after assignment-- -
-        fwprintf(stderr, L"DEBUG PARSER advance - Parser Current Token After Assign: Type=%d, Lexeme='", parser->current_token.type);
-        for (size_t i = 0; i < parser->current_token.length; ++i)
-        {
-            putwc(parser->current_token.lexeme[i], stderr);
-        }
-        fwprintf(stderr, L"', Len=%zu, Line=%zu, Col=%zu\n",
-                 parser->current_token.length, parser->current_token.line, parser->current_token.column);
-        // --- END DEBUG PRINT ---
-
-        if (parser->current_token.type != BAA_TOKEN_ERROR)
+        if (!baa_token_is_error(parser->current_token.type))
         {
             break; // Got a valid token or EOF
         }
@@ -350,8 +384,85 @@ void baa_parser_advance(BaaParser *parser)
                                   parser->current_token.lexeme ? parser->current_token.lexeme : L"Unknown lexical error");
         // parser->had_error is already set by parser_error_at_token
         // The loop continues to fetch the next token after a lexical error.
-        // The erroneous token's lexeme in current_token will be freed on the next advance.
     }
+
+    BAA_TRACE(BAA_TRACE_PARSER, "advance", parser->current_token.type, parser->current_token.start_offset,
+              parser->current_token.end_offset, parser->current_token.lexeme, parser->current_token.length);
+
+    // The new current token was the head of the lookahead ring if peek had filled it
+    if (parser->lookahead_count > 0)
+    {
+        parser->lookahead_head = (parser->lookahead_head + 1) & (BAA_PARSER_MAX_LOOKAHEAD - 1);
+        parser->lookahead_count--;
+    }
+}
+
+const BaaToken *baa_parser_peek_token(BaaParser *parser, size_t n)
+{
+    if (!parser || n > BAA_PARSER_MAX_LOOKAHEAD)
+        return NULL;
+    if (n == 0)
+        return &parser->current_token;
+
+    // Extend the ring one significant token at a time; each stream token is examined once
+    while (parser->lookahead_count < n)
+    {
+        size_t index = parser->tokens.position;
+        if (parser->lookahead_count > 0)
+        {
+            size_t last = (parser->lookahead_head + parser->lookahead_count - 1) & (BAA_PARSER_MAX_LOOKAHEAD - 1);
+            index = parser->lookahead[last] + 1;
+        }
+        for (;;)
+        {
+            const BaaToken *token = baa_token_stream_peek(&parser->tokens, index - parser->tokens.position);
+            if (!token)
+                return NULL;
+            if (!baa_parser_token_is_trivia(token->type) && !baa_token_is_error(token->type))
+                break;
+            index++;
+        }
+        size_t slot = (parser->lookahead_head + parser->lookahead_count) & (BAA_PARSER_MAX_LOOKAHEAD - 1);
+        parser->lookahead[slot] = index;
+        parser->lookahead_count++;
+    }
+
+    size_t slot = (parser->lookahead_head + n - 1) & (BAA_PARSER_MAX_LOOKAHEAD - 1);
+    return baa_token_stream_peek(&parser->tokens, parser->lookahead[slot] - parser->tokens.position);
+}
+
+BaaParserMark baa_parser_mark(BaaParser *parser)
+{
+    BaaParserMark mark;
+    mark.tokens = baa_token_stream_mark(&parser->tokens);
+    mark.current_token = parser->current_token;
+    mark.previous_token = parser->previous_token;
+    mark.previous_index = parser->previous_index;
+    mark.had_error = parser->had_error;
+    mark.panic_mode = parser->panic_mode;
+    mark.diagnostic_count = parser->diagnostics.count;
+    return mark;
+}
+
+void baa_parser_rewind(BaaParser *parser, const BaaParserMark *mark)
+{
+    BAA_TRACE(BAA_TRACE_PARSER, "rewind", (long)(parser->tokens.position - mark->tokens.position),
+              mark->current_token.start_offset, parser->current_token.start_offset, NULL, 0);
+
+    // The mark kept previous_token and everything after it in the ring
+    baa_token_stream_rewind(&parser->tokens, mark->tokens);
+    parser->current_token = mark->current_token;
+    parser->previous_token = mark->previous_token;
+    parser->previous_index = mark->previous_index;
+    parser->had_error = mark->had_error;
+    parser->panic_mode = mark->panic_mode;
+    baa_parser_truncate_diagnostics(parser, mark->diagnostic_count);
+    parser->lookahead_count = 0; // Refilled from the ring on the next peek
+}
+
+void baa_parser_release_mark(BaaParser *parser, const BaaParserMark *mark)
+{
+    baa_token_stream_release(&parser->tokens, mark->tokens);
 }
 
 BaaNode *baa_parse_program(BaaParser *parser)
@@ -363,22 +474,37 @@ BaaNode *baa_parse_program(BaaParser *parser)
 
     // Create source span for the entire program
     BaaAstSourceSpan span = {
-        .start = {
-            .filename = parser->source_filename,
-            .line = parser->current_token.line,
-            .column = parser->current_token.column},
-        .end = {.filename = parser->source_filename, .line = parser->current_token.line, .column = parser->current_token.column}};
+        .start = baa_parser_token_start_location(parser, &parser->current_token),
+        .end = baa_parser_token_start_location(parser, &parser->current_token)};
+
+    // The declarations go into an arena owned by the (heap-allocated) program node
+    BaaAstArena *arena = NULL;
+    if (parser->use_ast_arena && !(arena = baa_ast_arena_create()))
+    {
+        baa_parser_error_at_token(parser, &parser->current_token,
+                                  L"فشل في إنشاء عقدة البرنامج");
+        return NULL;
+    }
 
     // Create the program node
+    BaaAstArena *previous_arena = baa_ast_arena_activate(NULL);
     BaaNode *program_node = baa_ast_new_program_node(span);
     if (!program_node)
     {
+        baa_ast_arena_activate(previous_arena);
+        baa_ast_arena_destroy(arena);
         baa_parser_error_at_token(parser, &parser->current_token,
                                   L"فشل في إنشاء عقدة البرنامج");
         return NULL;
     }
+    if (arena)
+    {
+        baa_ast_program_adopt_arena(program_node, arena); // Cannot fail for a new heap program node
+    }
+    baa_ast_arena_activate(arena);
 
-    // Parse top-level constructs until EOF
+    // Parse top-level constructs until EOF, on worker threads if enabled and safe
+    baa_parser_parse_program_parallel(parser, program_node);
     while (!baa_parser_check_token(parser, BAA_TOKEN_EOF))
     {
         // Parse declarations (functions, variables) and statements
@@ -391,6 +517,7 @@ BaaNode *baa_parse_program(BaaParser *parser)
                 // Failed to add declaration to program
                 baa_ast_free_node(declaration);
                 baa_ast_free_node(program_node);
+                baa_ast_arena_activate(previous_arena);
                 baa_parser_error_at_token(parser, &parser->current_token,
                                           L"فشل في إضافة الإعلان إلى البرنامج");
                 return NULL;
@@ -411,20 +538,87 @@ BaaNode *baa_parse_program(BaaParser *parser)
             }
         }
     }
+    baa_ast_arena_activate(previous_arena);
 
     // Update the end position of the program span
-    span.end.line = parser->current_token.line;
-    span.end.column = parser->current_token.column;
+    span.end = baa_parser_token_start_location(parser, &parser->current_token);
     program_node->span = span;
 
     return program_node;
 }
 
+void baa_parser_set_ast_arena(BaaParser *parser, bool enabled)
+{
+    if (parser)
+    {
+        parser->use_ast_arena = enabled;
+    }
+}
+
+void baa_parser_set_parallel(BaaParser *parser, size_t thread_count)
+{
+    if (parser)
+    {
+        parser->parse_threads = thread_count;
+    }
+}
+
+void baa_parser_set_lazy_bodies(BaaParser *parser, bool enabled)
+{
+    if (parser)
+    {
+        parser->lazy_bodies = enabled;
+    }
+}
+
+BaaNode *baa_parser_function_body(BaaParser *parser, BaaNode *function_node)
+{
+    if (!parser || !function_node || function_node->kind != BAA_NODE_KIND_FUNCTION_DEF)
+    {
+        return NULL;
+    }
+    BaaFunctionDefData *data = (BaaFunctionDefData *)function_node->data;
+    if (!data->body_deferred)
+    {
+        return data->body;
+    }
+
+    // A sub-parser lexes only the recorded range and resolves locations through this parser's lexer
+    BaaLexer lexer;
+    baa_lexer_init_range(&lexer, parser->lexer->source, data->body_start_offset, data->body_end_offset);
+    BaaParser *body_parser = baa_parser_create(&lexer, parser->source_filename);
+    if (!body_parser)
+    {
+        baa_cleanup_lexer(&lexer);
+        return NULL;
+    }
+    body_parser->lexer = parser->lexer; // The token ring keeps lexing from `lexer`
+    body_parser->silent = parser->silent;
+
+    // The body joins the function's allocation domain
+    BaaAstArena *previous_arena = baa_ast_arena_activate(function_node->arena);
+    BaaNode *body = parse_block_statement(body_parser);
+    baa_ast_arena_activate(previous_arena);
+
+    parser->had_error = parser->had_error || body_parser->had_error;
+    baa_parser_append_diagnostics(parser, body_parser);
+    baa_parser_free(body_parser);
+    baa_cleanup_lexer(&lexer);
+
+    if (body && !baa_ast_function_set_body(function_node, body))
+    {
+        baa_ast_free_node(body);
+        return NULL;
+    }
+    return body;
+}
+
 /**
  * @brief Frees the resources associated with the parser.
  *
- * This includes freeing the lexemes of any currently held tokens (`current_token`
- * and `previous_token`) and then freeing the BaaParser structure itself.
+ * This includes freeing the token ring (and with it the lexemes of
+ * `current_token` and `previous_token`), the recorded diagnostics and then the
+ * BaaParser structure itself.
  * It does NOT free the lexer instance that was passed during parser creation.
  *
  * @param parser A pointer to the BaaParser instance to be freed. If NULL,
@@ -437,16 +631,9 @@ void baa_parser_free(BaaParser *parser)
         return;
     }
 
-    // Free the lexeme of the current_token if it exists
-    if (parser->current_token.lexeme != NULL)
-    {
-        baa_free((void *)parser->current_token.lexeme);
-    }
-    // Free the lexeme of the previous_token if it exists
-    if (parser->previous_token.lexeme != NULL)
-    {
-        baa_free((void *)parser->previous_token.lexeme);
-    }
+    // The token ring owns the lexemes of current_token and previous_token
+    baa_token_stream_free(&parser->tokens);
+    baa_parser_free_diagnostics(parser);
     baa_free(parser);
 }
 
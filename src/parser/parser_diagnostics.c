@@ -0,0 +1,256 @@
+// src/parser/parser_diagnostics.c
+#include "parser_utils.h"
+#include "baa/parser/parser.h"
+#include "baa/lexer/lexer.h" // For baa_lexer_get_position
+#include "baa/utils/utils.h" // For baa_malloc, baa_realloc, baa_free
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+
+// Messages with arguments are formatted into a stack buffer of this size first
+#define BAA_PARSER_DIAGNOSTIC_INLINE_CHARS 256
+
+// Longest message captured from arguments
+#define BAA_PARSER_DIAGNOSTIC_MAX_CHARS 65536
+
+// --- Recording ---
+
+static BaaParserDiagnosticRecord *push_record(BaaParserDiagnostics *diagnostics)
+{
+    if (diagnostics->count == diagnostics->capacity)
+    {
+        size_t capacity = diagnostics->capacity ? diagnostics->capacity * 2 : 16;
+        BaaParserDiagnosticRecord *records = (BaaParserDiagnosticRecord *)baa_realloc(
+            diagnostics->records, capacity * sizeof(BaaParserDiagnosticRecord));
+        if (!records)
+        {
+            return NULL;
+        }
+        diagnostics->records = records;
+        diagnostics->capacity = capacity;
+    }
+    return &diagnostics->records[diagnostics->count++];
+}
+
+// Copies `length` characters into the diagnostic arena, creating it on first use
+static const wchar_t *capture_text(BaaParserDiagnostics *diagnostics, const wchar_t *text, size_t length)
+{
+    if (!diagnostics->arena)
+    {
+        diagnostics->arena = baa_ast_arena_create();
+        if (!diagnostics->arena)
+        {
+            return NULL;
+        }
+    }
+    wchar_t *copy = (wchar_t *)baa_ast_arena_alloc(diagnostics->arena, (length + 1) * sizeof(wchar_t));
+    if (copy)
+    {
+        memcpy(copy, text, length * sizeof(wchar_t));
+        copy[length] = L'\0';
+    }
+    return copy;
+}
+
+// Formats a message into the diagnostic arena
+static const wchar_t *capture_formatted(BaaParserDiagnostics *diagnostics, const wchar_t *format, va_list args)
+{
+    wchar_t inline_buffer[BAA_PARSER_DIAGNOSTIC_INLINE_CHARS];
+    wchar_t *buffer = inline_buffer;
+    size_t capacity = BAA_PARSER_DIAGNOSTIC_INLINE_CHARS;
+    int written;
+    for (;;)
+    {
+        // vswprintf fails without reporting the needed size, so grow until it fits
+        va_list attempt;
+        va_copy(attempt, args);
+        written = vswprintf(buffer, capacity, format, attempt);
+        va_end(attempt);
+        if (written >= 0 || capacity >= BAA_PARSER_DIAGNOSTIC_MAX_CHARS)
+        {
+            break;
+        }
+        capacity *= 2;
+        wchar_t *larger = (wchar_t *)baa_realloc(buffer == inline_buffer ? NULL : buffer, capacity * sizeof(wchar_t));
+        if (!larger)
+        {
+            break;
+        }
+        buffer = larger;
+    }
+
+    // A message that still does not format is kept unformatted
+    const wchar_t *text = written >= 0 ? capture_text(diagnostics, buffer, (size_t)written)
+                                       : capture_text(diagnostics, format, wcslen(format));
+    if (buffer != inline_buffer)
+    {
+        baa_free(buffer);
+    }
+    return text;
+}
+
+bool baa_parser_record_diagnostic(BaaParser *parser, const BaaToken *token, BaaDiagnosticSeverity severity,
+                                  const wchar_t *message_format, va_list args)
+{
+    BaaParserDiagnostics *diagnostics = &parser->diagnostics;
+
+    // Most messages are literals: keep the pointer and format nothing
+    const wchar_t *message = message_format;
+    bool captured = wcschr(message_format, L'%') != NULL;
+    if (captured)
+    {
+        message = capture_formatted(diagnostics, message_format, args);
+        if (!message)
+        {
+            return false;
+        }
+    }
+
+    BaaParserDiagnosticRecord *record = push_record(diagnostics);
+    if (!record)
+    {
+        return false;
+    }
+    size_t length = token && token->end_offset > token->start_offset ? token->end_offset - token->start_offset : 0;
+    record->start_offset = token ? token->start_offset : 0;
+    record->message = message;
+    record->length = length > UINT32_MAX ? UINT32_MAX : (uint32_t)length;
+    record->severity = (uint8_t)severity;
+    record->category = (uint8_t)BAA_DIAG_SYNTAX;
+    record->captured = captured;
+    return true;
+}
+
+void baa_parser_truncate_diagnostics(BaaParser *parser, size_t count)
+{
+    BaaParserDiagnostics *diagnostics = &parser->diagnostics;
+    if (count < diagnostics->count)
+    {
+        // Captured text stays in the arena until the parser is freed
+        diagnostics->count = count;
+    }
+    if (diagnostics->view_count > diagnostics->count)
+    {
+        diagnostics->view_count = diagnostics->count;
+    }
+}
+
+bool baa_parser_append_diagnostics(BaaParser *parser, const BaaParser *source)
+{
+    BaaParserDiagnostics *diagnostics = &parser->diagnostics;
+    for (size_t i = 0; i < source->diagnostics.count; i++)
+    {
+        BaaParserDiagnosticRecord record = source->diagnostics.records[i];
+        if (record.captured)
+        {
+            record.message = capture_text(diagnostics, record.message, wcslen(record.message));
+            if (!record.message)
+            {
+                return false;
+            }
+        }
+        BaaParserDiagnosticRecord *slot = push_record(diagnostics);
+        if (!slot)
+        {
+            return false;
+        }
+        *slot = record;
+    }
+    return true;
+}
+
+void baa_parser_free_diagnostics(BaaParser *parser)
+{
+    BaaParserDiagnostics *diagnostics = &parser->diagnostics;
+    baa_free(diagnostics->records);
+    baa_free(diagnostics->views);
+    baa_ast_arena_destroy(diagnostics->arena);
+    memset(diagnostics, 0, sizeof(*diagnostics));
+}
+
+// --- Retrieval ---
+
+size_t baa_parser_diagnostic_count(const BaaParser *parser)
+{
+    return parser ? parser->diagnostics.count : 0;
+}
+
+const BaaDiagnostic *baa_parser_get_diagnostics(BaaParser *parser, size_t *out_count)
+{
+    if (out_count)
+    {
+        *out_count = 0;
+    }
+    if (!parser || parser->diagnostics.count == 0)
+    {
+        return NULL;
+    }
+
+    BaaParserDiagnostics *diagnostics = &parser->diagnostics;
+    if (diagnostics->view_capacity < diagnostics->count)
+    {
+        BaaDiagnostic *views = (BaaDiagnostic *)baa_realloc(diagnostics->views,
+                                                            diagnostics->capacity * sizeof(BaaDiagnostic));
+        if (!views)
+        {
+            return NULL;
+        }
+        diagnostics->views = views;
+        diagnostics->view_capacity = diagnostics->capacity;
+    }
+
+    // Only records added since the last call are expanded
+    for (size_t i = diagnostics->view_count; i < diagnostics->count; i++)
+    {
+        const BaaParserDiagnosticRecord *record = &diagnostics->records[i];
+        BaaDiagnostic *view = &diagnostics->views[i];
+        view->severity = (BaaDiagnosticSeverity)record->severity;
+        view->category = (BaaDiagnosticCategory)record->category;
+        view->location.filename = parser->source_filename;
+        view->location.line = 0;
+        view->location.column = 0;
+        baa_lexer_get_position(parser->lexer, record->start_offset, &view->location.line, &view->location.column);
+        view->message = record->message;
+        view->source_line = NULL;
+        view->column_start = view->location.column;
+        view->column_end = view->location.column + record->length;
+        view->fix_hint = NULL;
+    }
+    diagnostics->view_count = diagnostics->count;
+
+    if (out_count)
+    {
+        *out_count = diagnostics->count;
+    }
+    return diagnostics->views;
+}
+
+static const wchar_t *severity_label(BaaDiagnosticSeverity severity)
+{
+    switch (severity)
+    {
+    case BAA_DIAG_WARNING:
+        return L"تحذير";
+    case BAA_DIAG_NOTE:
+        return L"ملاحظة";
+    case BAA_DIAG_HINT:
+        return L"تلميح";
+    case BAA_DIAG_ERROR:
+    default:
+        return L"خطأ";
+    }
+}
+
+void baa_parser_print_diagnostics(BaaParser *parser, FILE *stream)
+{
+    size_t count = 0;
+    const BaaDiagnostic *diagnostics = baa_parser_get_diagnostics(parser, &count);
+    for (size_t i = 0; i < count; i++)
+    {
+        const BaaDiagnostic *diagnostic = &diagnostics[i];
+        fwprintf(stream, L"%ls:%zu:%zu: %ls: %ls\n",
+                 diagnostic->location.filename ? diagnostic->location.filename : L"<unknown_source>",
+                 diagnostic->location.line, diagnostic->location.column, severity_label(diagnostic->severity),
+                 diagnostic->message);
+    }
+}
@@ -2,8 +2,45 @@
 #define BAA_PARSER_INTERNAL_H
 
 #include "baa/lexer/lexer.h" // For BaaLexer, BaaToken
+#include "baa/lexer/token_stream.h" // For BaaTokenStream, BaaTokenMark
 #include "baa/ast/ast.h"     // For BaaNode (forward declaration is fine, but full include helps for ast.h API)
+#include "baa/ast/ast_arena.h" // For BaaAstArena (captured diagnostic text)
+#include "baa/diagnostics/diagnostics.h" // For BaaDiagnostic
 #include <stdbool.h>         // For bool
+#include <stdint.h>          // For uint8_t, uint32_t
+
+// Maximum number of tokens baa_parser_peek_token can see past current_token (power of two)
+#define BAA_PARSER_MAX_LOOKAHEAD 16
+
+/**
+ * @brief A diagnostic as recorded while parsing (24 bytes on 64-bit targets).
+ *
+ * Only the token's offset and length are kept; line and column are looked up
+ * when the diagnostic is expanded into a BaaDiagnostic.
+ */
+typedef struct
+{
+    size_t start_offset;    // Source offset of the token the diagnostic points at
+    const wchar_t *message; // The message literal, or text captured in the diagnostic arena
+    uint32_t length;        // Length of that token in characters
+    uint8_t severity;       // BaaDiagnosticSeverity
+    uint8_t category;       // BaaDiagnosticCategory
+    bool captured;          // `message` was formatted from arguments into the arena
+} BaaParserDiagnosticRecord;
+
+/**
+ * @brief Diagnostics collected by one parser (see parser_diagnostics.c).
+ */
+typedef struct
+{
+    BaaParserDiagnosticRecord *records; // Recorded diagnostics in report order
+    size_t count;
+    size_t capacity;
+    BaaAstArena *arena;    // Captured message text, created on first use
+    BaaDiagnostic *views;  // Records expanded by baa_parser_get_diagnostics
+    size_t view_count;     // Number of records already expanded into `views`
+    size_t view_capacity;
+} BaaParserDiagnostics;
 
 // Forward declaration for BaaParser for use in helper function signatures if needed early
 typedef struct BaaParser BaaParser;
@@ -14,17 +51,41 @@ typedef struct BaaParser BaaParser;
 struct BaaParser
 {
     BaaLexer *lexer;         // Pointer to the lexer instance providing tokens
-    BaaToken current_token;  // The current token being processed
-    BaaToken previous_token; // The most recently consumed token
+    BaaTokenStream tokens;   // Ring of lexed tokens; owns the lexemes of current/previous_token
+    BaaToken current_token;  // The current token being processed (lexeme borrowed from `tokens`)
+    BaaToken previous_token; // The most recently consumed token (lexeme borrowed from `tokens`)
+    size_t previous_index;   // Stream index of previous_token
+
+    size_t lookahead[BAA_PARSER_MAX_LOOKAHEAD]; // Ring of stream indices of the next significant tokens
+    size_t lookahead_head;                      // Ring slot of the token right after current_token
+    size_t lookahead_count;                     // Number of filled ring slots
 
     bool had_error;  // Flag: true if any syntax error has been encountered
     bool panic_mode; // Flag: true if the parser is currently recovering from an error
 
     const wchar_t *source_filename; // Name of the source file being parsed (for error messages)
+    bool use_ast_arena;             // Build the program's AST in an arena (see baa_parser_set_ast_arena)
+    size_t parse_threads;           // Threads for baa_parse_program (1 = sequential, see baa_parser_set_parallel)
+    bool lazy_bodies;               // Record function body ranges instead of parsing them (see baa_parser_set_lazy_bodies)
+    bool silent;                    // Record only the error flag, no diagnostics (worker parsers of a parallel parse)
 
-    // DiagnosticContext* diagnostics; // Future: For collecting multiple parse errors
+    BaaParserDiagnostics diagnostics; // Diagnostics reported so far (see baa_parser_get_diagnostics)
 };
 
+/**
+ * @brief Parser checkpoint for speculative parsing (see baa_parser_mark).
+ */
+typedef struct
+{
+    BaaTokenMark tokens;     // Token stream position
+    BaaToken current_token;  // Saved current token
+    BaaToken previous_token; // Saved previous token
+    size_t previous_index;   // Saved stream index of previous_token
+    bool had_error;          // Saved error flag
+    bool panic_mode;         // Saved panic mode flag
+    size_t diagnostic_count; // Diagnostics recorded before the mark
+} BaaParserMark;
+
 // Internal helper function prototypes will go here later, e.g.:
 // void parser_error_at_current(BaaParser* parser, const wchar_t* message_format, ...);
 // void advance(BaaParser* parser);
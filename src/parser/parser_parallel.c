@@ -0,0 +1,326 @@
+// src/parser/parser_parallel.c
+#include "parser_parallel.h"
+#include "parser_utils.h"       // For baa_parser_token_is_trivia
+#include "declaration_parser.h" // For parse_declaration_or_statement
+#include "baa/parser/parser.h"
+#include "baa/lexer/lexer_parallel.h" // For baa_lex_parallel
+#include "baa/utils/threads.h"
+#include "baa/utils/trace.h" // For BAA_TRACE_ENABLED
+#include "baa/utils/utils.h" // For baa_malloc, baa_realloc, baa_free
+#include <stdint.h>
+#include <string.h>
+
+// Slices smaller than this are not worth a thread of their own
+#define BAA_PARSE_PARALLEL_MIN_SLICE_CHARS 16384
+
+// Upper bound on worker threads, regardless of what the caller asks for
+#define BAA_PARSE_PARALLEL_MAX_THREADS 64
+
+// End offset of the last slice, which runs to EOF
+#define BAA_PARSE_SLICE_TO_EOF SIZE_MAX
+
+// --- Top-level boundary pre-pass ---
+
+/**
+ * Finds up to `max_boundaries` tokens starting a top-level construct, the i-th
+ * one at or after target token `first + (i + 1) * span / (max_boundaries + 1)`.
+ *
+ * A construct ends with a `.` or a `}` at bracket depth 0; the next significant
+ * token starts a new one unless it is وإلا (which continues an if statement).
+ * The grammar may still disagree (e.g. after a syntax error); the slice parsers
+ * detect that by checking where they stop.
+ *
+ * @return Number of boundaries written, or 0 if the buffer holds lexical errors.
+ */
+static size_t find_top_level_boundaries(const BaaTokenBuffer *tokens, size_t first, size_t max_boundaries,
+                                        size_t *out_boundaries)
+{
+    size_t span = tokens->count - first;
+    size_t found = 0;
+    size_t depth = 0;
+    bool construct_ended = false;
+
+    for (size_t i = first; i < tokens->count; i++)
+    {
+        BaaTokenType type = (BaaTokenType)tokens->kinds[i];
+        if (baa_token_is_error(type))
+            return 0; // Error recovery is left to the sequential parser
+        if (baa_parser_token_is_trivia(type))
+            continue;
+
+        if (construct_ended)
+        {
+            construct_ended = false;
+            size_t target = first + (found + 1) * (span / (max_boundaries + 1));
+            if (found < max_boundaries && i >= target && type != BAA_TOKEN_ELSE && type != BAA_TOKEN_EOF)
+                out_boundaries[found++] = i;
+        }
+
+        switch (type)
+        {
+        case BAA_TOKEN_LPAREN:
+        case BAA_TOKEN_LBRACE:
+        case BAA_TOKEN_LBRACKET:
+            depth++;
+            break;
+        case BAA_TOKEN_RPAREN:
+        case BAA_TOKEN_RBRACKET:
+            if (depth > 0)
+                depth--;
+            break;
+        case BAA_TOKEN_RBRACE:
+            if (depth > 0)
+                depth--;
+            construct_ended = depth == 0;
+            break;
+        case BAA_TOKEN_DOT:
+            construct_ended = depth == 0;
+            break;
+        default:
+            break;
+        }
+    }
+    return found;
+}
+
+// --- Slice parsing ---
+
+typedef struct
+{
+    const BaaTokenBuffer *tokens;   // Tokens of the whole source (shared, read-only)
+    size_t first;                   // Index of the slice's first token
+    size_t end;                     // Offset of the next slice's first token (BAA_PARSE_SLICE_TO_EOF for the last)
+    BaaLexer *positions;            // Lexer whose prebuilt line index resolves node locations (shared, read-only)
+    const wchar_t *source_filename; // Filename recorded in node spans
+    bool use_arena;                 // Allocate the slice's nodes in `arena`
+    bool lazy_bodies;               // Defer function bodies (see baa_parser_set_lazy_bodies)
+    BaaAstArena *arena;             // Arena of the slice's nodes (NULL for heap nodes)
+    BaaNode **declarations;         // Parsed declarations in source order
+    size_t count;                   // Number of declarations
+    size_t capacity;                // Allocated capacity of `declarations`
+    bool ok;                        // The slice parsed without errors and ended exactly at `end`
+} BaaParseSlice;
+
+static bool slice_push(BaaParseSlice *slice, BaaNode *declaration)
+{
+    if (slice->count == slice->capacity)
+    {
+        size_t capacity = slice->capacity ? slice->capacity * 2 : 64;
+        BaaNode **grown = (BaaNode **)baa_realloc(slice->declarations, capacity * sizeof(BaaNode *));
+        if (!grown)
+            return false;
+        slice->declarations = grown;
+        slice->capacity = capacity;
+    }
+    slice->declarations[slice->count++] = declaration;
+    return true;
+}
+
+// Releases the slice's declarations (heap nodes individually, arena nodes with their arena)
+static void slice_discard(BaaParseSlice *slice)
+{
+    for (size_t i = 0; i < slice->count; i++)
+        baa_ast_free_node(slice->declarations[i]);
+    baa_ast_arena_destroy(slice->arena);
+    slice->arena = NULL;
+    slice->count = 0;
+}
+
+/**
+ * Parses the top-level constructs of one slice with a silent parser that replays
+ * the shared token buffer from the slice's first token. The parser may peek past
+ * the slice end, exactly like the sequential parser does.
+ */
+static int parse_slice(void *arg)
+{
+    BaaParseSlice *slice = (BaaParseSlice *)arg;
+    slice->ok = false;
+
+    if (slice->use_arena && !(slice->arena = baa_ast_arena_create()))
+        return 1;
+
+    BaaParser *parser = baa_parser_create_from_tokens(slice->positions, slice->tokens, slice->first,
+                                                      slice->source_filename);
+    if (!parser)
+        return 1;
+    parser->silent = true;
+    parser->lazy_bodies = slice->lazy_bodies;
+
+    BaaAstArena *previous_arena = baa_ast_arena_activate(slice->arena);
+    bool ok = !parser->had_error;
+    while (ok && parser->current_token.type != BAA_TOKEN_EOF && parser->current_token.start_offset < slice->end)
+    {
+        BaaNode *declaration = parse_declaration_or_statement(parser);
+        ok = declaration && !parser->had_error && slice_push(slice, declaration);
+        if (!ok && declaration)
+            baa_ast_free_node(declaration);
+    }
+    baa_ast_arena_activate(previous_arena);
+
+    // The slice must stop exactly where the next one starts
+    if (slice->end == BAA_PARSE_SLICE_TO_EOF)
+        ok = ok && parser->current_token.type == BAA_TOKEN_EOF;
+    else
+        ok = ok && parser->current_token.type != BAA_TOKEN_EOF && parser->current_token.start_offset == slice->end;
+    slice->ok = ok;
+
+    baa_parser_free(parser);
+    return ok ? 0 : 1;
+}
+
+// Returns the index of the token starting at `offset`, or tokens->count if there is none
+static size_t find_token_at(const BaaTokenBuffer *tokens, size_t offset)
+{
+    size_t low = 0;
+    size_t high = tokens->count;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (tokens->offsets[mid] < offset)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low < tokens->count && tokens->offsets[low] == offset ? low : tokens->count;
+}
+
+// Appends every slice's declarations in source order; on failure the program is restored
+static bool merge_slices(BaaNode *program_node, BaaParseSlice *slices, size_t slice_count)
+{
+    BaaProgramData *data = (BaaProgramData *)program_node->data;
+    size_t original_count = data->count;
+    for (size_t i = 0; i < slice_count; i++)
+    {
+        for (size_t j = 0; j < slices[i].count; j++)
+        {
+            if (!baa_ast_add_declaration_to_program(program_node, slices[i].declarations[j]))
+            {
+                data->count = original_count;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool baa_parser_parse_program_parallel(BaaParser *parser, BaaNode *program_node)
+{
+    if (!parser || !program_node || parser->parse_threads == 1 || parser->had_error ||
+        parser->current_token.type == BAA_TOKEN_EOF)
+        return false;
+
+    // The trace sink is not thread-safe: traced runs parse sequentially
+    if (BAA_TRACE_ENABLED(BAA_TRACE_PARSER))
+        return false;
+
+    BaaLexer *lexer = parser->lexer;
+    size_t thread_count = parser->parse_threads;
+    if (thread_count == 0)
+        thread_count = baa_thread_hardware_concurrency();
+    if (thread_count > BAA_PARSE_PARALLEL_MAX_THREADS)
+        thread_count = BAA_PARSE_PARALLEL_MAX_THREADS;
+    if (thread_count > lexer->source_length / BAA_PARSE_PARALLEL_MIN_SLICE_CHARS)
+        thread_count = lexer->source_length / BAA_PARSE_PARALLEL_MIN_SLICE_CHARS;
+    if (thread_count < 2)
+        return false;
+
+    BaaTokenBuffer tokens;
+    if (!baa_lex_parallel(lexer->source, thread_count, &tokens))
+        return false;
+
+    // Split the rest of the input, starting at the parser's current token
+    size_t boundaries[BAA_PARSE_PARALLEL_MAX_THREADS];
+    size_t boundary_count = 0;
+    size_t first = find_token_at(&tokens, parser->current_token.start_offset);
+    if (first < tokens.count)
+        boundary_count = find_top_level_boundaries(&tokens, first, thread_count - 1, boundaries);
+
+    // Build the line index once; the slice parsers then only read it
+    size_t line;
+    if (boundary_count == 0 || !baa_lexer_get_position(lexer, 0, &line, NULL))
+    {
+        baa_token_buffer_free(&tokens);
+        return false;
+    }
+
+    size_t slice_count = boundary_count + 1;
+    BaaParseSlice *slices = (BaaParseSlice *)baa_malloc(slice_count * sizeof(BaaParseSlice));
+    BaaThread *threads = (BaaThread *)baa_malloc(slice_count * sizeof(BaaThread));
+    bool *started = (bool *)baa_malloc(slice_count * sizeof(bool));
+    if (!slices || !threads || !started)
+    {
+        baa_free(slices);
+        baa_free(threads);
+        baa_free(started);
+        baa_token_buffer_free(&tokens);
+        return false;
+    }
+
+    BaaAstArena *program_arena = baa_ast_arena_current();
+    memset(slices, 0, slice_count * sizeof(BaaParseSlice));
+    for (size_t i = 0; i < slice_count; i++)
+    {
+        slices[i].tokens = &tokens;
+        slices[i].first = i == 0 ? first : boundaries[i - 1];
+        slices[i].end = i == boundary_count ? BAA_PARSE_SLICE_TO_EOF : tokens.offsets[boundaries[i]];
+        slices[i].positions = lexer;
+        slices[i].source_filename = parser->source_filename;
+        slices[i].use_arena = program_arena != NULL;
+        slices[i].lazy_bodies = parser->lazy_bodies;
+        started[i] = false;
+    }
+    size_t eof_offset = tokens.offsets[tokens.count - 1];
+
+    // The calling thread parses the first slice itself
+    for (size_t i = 1; i < slice_count; i++)
+    {
+        started[i] = baa_thread_create(&threads[i], parse_slice, &slices[i]);
+        if (!started[i])
+            parse_slice(&slices[i]); // Could not start a thread; do the work inline
+    }
+    parse_slice(&slices[0]);
+
+    bool ok = true;
+    for (size_t i = 0; i < slice_count; i++)
+    {
+        if (started[i] && !baa_thread_join(&threads[i], NULL))
+            slices[i].ok = false;
+        ok = ok && slices[i].ok;
+    }
+    baa_token_buffer_free(&tokens);
+
+    if (ok)
+    {
+        // The program's arena takes over the slice arenas, then the declarations join in source order
+        for (size_t i = 0; i < slice_count; i++)
+        {
+            if (slices[i].arena)
+            {
+                baa_ast_arena_adopt(program_arena, slices[i].arena); // Fresh arenas: cannot fail
+                slices[i].arena = NULL;
+            }
+        }
+        ok = merge_slices(program_node, slices, slice_count);
+    }
+
+    for (size_t i = 0; i < slice_count; i++)
+    {
+        if (!ok)
+            slice_discard(&slices[i]); // Adopted arena nodes stay with the program until it is freed
+        baa_free(slices[i].declarations);
+    }
+    baa_free(slices);
+    baa_free(threads);
+    baa_free(started);
+
+    if (ok)
+    {
+        // Leave the parser where the sequential loop would have stopped
+        parser->previous_token = parser->current_token;
+        memset(&parser->current_token, 0, sizeof(parser->current_token));
+        parser->current_token.type = BAA_TOKEN_EOF;
+        parser->current_token.start_offset = eof_offset;
+        parser->current_token.end_offset = eof_offset;
+    }
+    return ok;
+}
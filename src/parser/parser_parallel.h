@@ -0,0 +1,30 @@
+#ifndef BAA_PARSER_PARALLEL_INTERNAL_H
+#define BAA_PARSER_PARALLEL_INTERNAL_H
+
+#include "parser_internal.h" // For BaaParser
+#include "baa/ast/ast.h"     // For BaaNode
+#include <stdbool.h>
+
+/**
+ * @brief Parses the rest of the input on worker threads and appends the declarations to `program_node`.
+ *
+ * The source is lexed into a token buffer, and a pre-pass over the buffer
+ * matches brackets to find top-level declaration boundaries near evenly spaced
+ * targets. Each slice between two boundaries is parsed by its own silent
+ * parser on a worker thread, replaying the shared buffer rather than lexing
+ * again, into its own AST arena (adopted by the arena active on the calling
+ * thread). The declarations are then appended in source order.
+ *
+ * Nothing is appended and `parser` is left untouched when the parallel parse
+ * cannot guarantee the sequential result: on lexical or syntax errors, when a
+ * slice does not end exactly at the next boundary, on allocation failure, for
+ * inputs too small to split, and while parser tracing is enabled. The caller
+ * then parses sequentially.
+ *
+ * @param parser The parser, positioned at the first top-level construct to parse.
+ * @param program_node The program node receiving the declarations.
+ * @return true if the whole input was parsed (the parser is then at EOF).
+ */
+bool baa_parser_parse_program_parallel(BaaParser *parser, BaaNode *program_node);
+
+#endif // BAA_PARSER_PARALLEL_INTERNAL_H
@@ -3,17 +3,105 @@
 
 #include "parser_internal.h"
 #include "baa/lexer/lexer.h"
+#include "baa/lexer/token_buffer.h" // For BaaTokenBuffer
+#include "baa/ast/ast_types.h"
 #include <stdarg.h>
 
+/**
+ * @brief Creates a parser that replays `tokens` from token `first` on instead of lexing.
+ *
+ * `lexer` only resolves token positions (its source must be the buffer's).
+ * The token buffer must outlive the parser and is only read, so parsers on
+ * different threads may share it.
+ *
+ * @return The parser, or NULL on allocation failure or an out-of-range `first`.
+ */
+BaaParser *baa_parser_create_from_tokens(BaaLexer *lexer, const BaaTokenBuffer *tokens, size_t first,
+                                         const wchar_t *source_filename);
+
 /**
  * @brief Consumes the current token and fetches the next one from the lexer.
- * Skips over lexical error tokens, reporting them and continuing to the next
- * valid token or EOF. Manages lexeme ownership for current_token and previous_token.
+ * Skips whitespace and comments, and skips over lexical error tokens, reporting
+ * them and continuing to the next valid token or EOF. Lexemes stay owned by the
+ * parser's token ring.
  *
  * @param parser Pointer to the parser state.
  */
 void baa_parser_advance(BaaParser *parser);
 
+/**
+ * @brief Returns true for tokens the grammar never sees (whitespace, newlines and comments).
+ * baa_parser_advance and baa_parser_peek_token step over them silently.
+ */
+bool baa_parser_token_is_trivia(BaaTokenType type);
+
+/**
+ * @brief Returns the n-th significant token after the current one without consuming anything.
+ *
+ * peek(0) is current_token, peek(1) the token baa_parser_advance would make
+ * current next, and so on. Whitespace, comments and lexical error tokens are
+ * skipped exactly as baa_parser_advance skips them, but errors are not reported.
+ * Tokens come from the token ring, so peeking never re-lexes; once filled,
+ * each peek is O(1).
+ *
+ * @param parser Pointer to the parser state.
+ * @param n Distance from the current token (at most BAA_PARSER_MAX_LOOKAHEAD).
+ * @return The token (valid until the parser advances or peeks again), or NULL
+ *         if n is out of range or the lexer failed. Past the end it is the EOF token.
+ */
+const BaaToken *baa_parser_peek_token(BaaParser *parser, size_t n);
+
+/**
+ * @brief Checkpoints the parser's token position and error state in O(1).
+ *
+ * Every mark must be ended by exactly one baa_parser_rewind or
+ * baa_parser_release_mark, innermost first. Tokens consumed after the mark
+ * stay in the token ring, so rewinding never re-lexes.
+ *
+ * @param parser Pointer to the parser state.
+ * @return The checkpoint.
+ */
+BaaParserMark baa_parser_mark(BaaParser *parser);
+
+/**
+ * @brief Restores the parser to a checkpoint and ends it.
+ *
+ * current_token, previous_token, had_error and panic_mode are restored, and
+ * diagnostics recorded while speculating are dropped (lexical errors among the
+ * replayed tokens are reported again when they are consumed again).
+ *
+ * @param parser Pointer to the parser state.
+ * @param mark Checkpoint returned by baa_parser_mark.
+ */
+void baa_parser_rewind(BaaParser *parser, const BaaParserMark *mark);
+
+/**
+ * @brief Ends a checkpoint, keeping everything parsed since it was taken.
+ *
+ * @param parser Pointer to the parser state.
+ * @param mark Checkpoint returned by baa_parser_mark.
+ */
+void baa_parser_release_mark(BaaParser *parser, const BaaParserMark *mark);
+
+/**
+ * @brief Computes the AST source location of a token's first character.
+ * Line/column are derived on demand from the token's offsets.
+ *
+ * @param parser Pointer to the parser state.
+ * @param token The token to locate.
+ * @return The source location (filename is the parser's source filename).
+ */
+BaaSourceLocation baa_parser_token_start_location(BaaParser *parser, const BaaToken *token);
+
+/**
+ * @brief Computes the AST source location just past a token's last character.
+ *
+ * @param parser Pointer to the parser state.
+ * @param token The token to locate.
+ * @return The source location (filename is the parser's source filename).
+ */
+BaaSourceLocation baa_parser_token_end_location(BaaParser *parser, const BaaToken *token);
+
 /**
  * @brief Checks if the current token's type matches the given type.
  *
@@ -35,6 +123,8 @@ bool baa_parser_match_token(BaaParser *parser, BaaTokenType type);
 /**
  * @brief Consumes a token of the expected type or reports an error.
  *
+ * The message has the lifetime rules of baa_parser_error_at_token.
+ *
  * @param parser Pointer to the parser state.
  * @param expected_type The expected token type.
  * @param error_message_format Format string for the error message.
@@ -45,6 +135,10 @@ void baa_parser_consume_token(BaaParser *parser, BaaTokenType expected_type, con
 /**
  * @brief Reports a parser error at the given token location.
  *
+ * A format without conversions is kept by pointer until the diagnostics are
+ * read, so it must outlive the parser (string literals do). Pass variable
+ * text as an argument, e.g. `L"%ls", buffer`, so that it is copied.
+ *
  * @param parser Pointer to the parser state.
  * @param token Pointer to the token where the error occurred.
  * @param message_format Format string for the error message.
@@ -56,12 +150,45 @@ void baa_parser_error_at_token(BaaParser *parser, const BaaToken *token, const w
  * @brief Reports a parser error at the current token location.
  * Convenience function that wraps baa_parser_error_at_token with the current token.
  *
+ * The message has the lifetime rules of baa_parser_error_at_token.
+ *
  * @param parser Pointer to the parser state.
  * @param message_format Format string for the error message.
  * @param ... Additional arguments for the format string.
  */
 void baa_parser_error(BaaParser *parser, const wchar_t *message_format, ...);
 
+/**
+ * @brief Records a diagnostic at a token (parser_diagnostics.c).
+ *
+ * A format without conversions is stored as is and must outlive the parser
+ * (all parser messages are literals); otherwise the message is formatted
+ * right away into the parser's diagnostic arena, since its arguments (usually
+ * lexemes) do not live that long. Nothing is printed.
+ *
+ * @return false on allocation failure (the diagnostic is dropped).
+ */
+bool baa_parser_record_diagnostic(BaaParser *parser, const BaaToken *token, BaaDiagnosticSeverity severity,
+                                  const wchar_t *message_format, va_list args);
+
+/**
+ * @brief Drops the diagnostics recorded after the first `count` (used by baa_parser_rewind).
+ */
+void baa_parser_truncate_diagnostics(BaaParser *parser, size_t count);
+
+/**
+ * @brief Appends the diagnostics of `source` to `parser`, copying captured text.
+ *
+ * Both parsers must report locations through the same lexer (e.g. a sub-parser
+ * of a deferred function body and its parent).
+ */
+bool baa_parser_append_diagnostics(BaaParser *parser, const BaaParser *source);
+
+/**
+ * @brief Releases the diagnostic records, views and arena of a parser.
+ */
+void baa_parser_free_diagnostics(BaaParser *parser);
+
 /**
  * @brief Attempts to recover from a syntax error by discarding tokens.
  * Advances tokens until a synchronization point is found or EOF is reached.
@@ -20,10 +20,7 @@ BaaNode *parse_expression_statement(BaaParser *parser)
     // Create source span from the start of the expression to the current position
     BaaAstSourceSpan span = {
         .start = expr->span.start,
-        .end = {
-            .filename = parser->source_filename,
-            .line = parser->current_token.line,
-            .column = parser->current_token.column + parser->current_token.length}};
+        .end = baa_parser_token_end_location(parser, &parser->current_token)};
 
     // Expect and consume the dot terminator
     baa_parser_consume_token(parser, BAA_TOKEN_DOT, L"توقع '.' بعد التعبير في الجملة");
@@ -44,11 +41,8 @@ BaaNode *parse_block_statement(BaaParser *parser)
 {
     // Create source span starting from the opening brace
     BaaAstSourceSpan span = {
-        .start = {
-            .filename = parser->source_filename,
-            .line = parser->current_token.line,
-            .column = parser->current_token.column},
-        .end = {.filename = parser->source_filename, .line = parser->current_token.line, .column = parser->current_token.column + 1}};
+        .start = baa_parser_token_start_location(parser, &parser->current_token),
+        .end = baa_parser_token_end_location(parser, &parser->current_token)};
 
     // Consume the opening brace
     baa_parser_consume_token(parser, BAA_TOKEN_LBRACE, L"توقع '{' لبداية الكتلة");
@@ -85,8 +79,7 @@ BaaNode *parse_block_statement(BaaParser *parser)
     }
 
     // Update the end position of the span
-    span.end.line = parser->current_token.line;
-    span.end.column = parser->current_token.column + parser->current_token.length;
+    span.end = baa_parser_token_end_location(parser, &parser->current_token);
     block_node->span = span;
 
     // Consume the closing brace
@@ -151,11 +144,7 @@ BaaNode *parse_if_statement(BaaParser *parser)
 {
     // Create source span starting from the 'إذا' keyword
     BaaAstSourceSpan span = {
-        .start = {
-            .filename = parser->source_filename,
-            .line = parser->current_token.line,
-            .column = parser->current_token.column
-        }
+        .start = baa_parser_token_start_location(parser, &parser->current_token)
     };
 
     // Consume the 'إذا' keyword
@@ -196,9 +185,7 @@ BaaNode *parse_if_statement(BaaParser *parser)
     }
 
     // Update the span end location
-    span.end.filename = parser->source_filename;
-    span.end.line = parser->previous_token.line;
-    span.end.column = parser->previous_token.column + parser->previous_token.length;
+    span.end = baa_parser_token_end_location(parser, &parser->previous_token);
 
     // Create the if statement node
     return baa_ast_new_if_stmt_node(span, condition_expr, then_stmt, else_stmt);
@@ -210,11 +197,7 @@ BaaNode *parse_while_statement(BaaParser *parser)
 {
     // Create source span starting from the 'طالما' keyword
     BaaAstSourceSpan span = {
-        .start = {
-            .filename = parser->source_filename,
-            .line = parser->current_token.line,
-            .column = parser->current_token.column
-        }
+        .start = baa_parser_token_start_location(parser, &parser->current_token)
     };
 
     // Consume the 'طالما' keyword
@@ -242,9 +225,7 @@ BaaNode *parse_while_statement(BaaParser *parser)
     }
 
     // Update the span end location
-    span.end.filename = parser->source_filename;
-    span.end.line = parser->previous_token.line;
-    span.end.column = parser->previous_token.column + parser->previous_token.length;
+    span.end = baa_parser_token_end_location(parser, &parser->previous_token);
 
     // Create the while statement node
     return baa_ast_new_while_stmt_node(span, condition_expr, body_stmt);
@@ -256,11 +237,7 @@ BaaNode *parse_for_statement(BaaParser *parser)
 {
     // Create source span starting from the 'لكل' keyword
     BaaAstSourceSpan span = {
-        .start = {
-            .filename = parser->source_filename,
-            .line = parser->current_token.line,
-            .column = parser->current_token.column
-        }
+        .start = baa_parser_token_start_location(parser, &parser->current_token)
     };
 
     // Consume the 'لكل' keyword
@@ -289,11 +266,7 @@ BaaNode *parse_for_statement(BaaParser *parser)
                         .line = expr->span.start.line,
                         .column = expr->span.start.column
                     },
-                    .end = {
-                        .filename = parser->source_filename,
-                        .line = parser->previous_token.line,
-                        .column = parser->previous_token.column + parser->previous_token.length
-                    }
+                    .end = baa_parser_token_end_location(parser, &parser->previous_token)
                 };
                 initializer_stmt = baa_ast_new_expr_stmt_node(expr_span, expr);
             }
@@ -345,9 +318,7 @@ BaaNode *parse_for_statement(BaaParser *parser)
     }
 
     // Update the span end location
-    span.end.filename = parser->source_filename;
-    span.end.line = parser->previous_token.line;
-    span.end.column = parser->previous_token.column + parser->previous_token.length;
+    span.end = baa_parser_token_end_location(parser, &parser->previous_token);
 
     // Create the for statement node
     return baa_ast_new_for_stmt_node(span, initializer_stmt, condition_expr, increment_expr, body_stmt);
@@ -359,11 +330,7 @@ BaaNode *parse_return_statement(BaaParser *parser)
 {
     // Create source span starting from the 'إرجع' keyword
     BaaAstSourceSpan span = {
-        .start = {
-            .filename = parser->source_filename,
-            .line = parser->current_token.line,
-            .column = parser->current_token.column
-        }
+        .start = baa_parser_token_start_location(parser, &parser->current_token)
     };
 
     // Consume the 'إرجع' keyword
@@ -384,9 +351,7 @@ BaaNode *parse_return_statement(BaaParser *parser)
     baa_parser_consume_token(parser, BAA_TOKEN_DOT, L"Expected '.' after return statement");
 
     // Update the span end location
-    span.end.filename = parser->source_filename;
-    span.end.line = parser->previous_token.line;
-    span.end.column = parser->previous_token.column + parser->previous_token.length;
+    span.end = baa_parser_token_end_location(parser, &parser->previous_token);
 
     // Create the return statement node
     return baa_ast_new_return_stmt_node(span, value_expr);
@@ -398,11 +363,7 @@ BaaNode *parse_break_statement(BaaParser *parser)
 {
     // Create source span starting from the 'توقف' keyword
     BaaAstSourceSpan span = {
-        .start = {
-            .filename = parser->source_filename,
-            .line = parser->current_token.line,
-            .column = parser->current_token.column
-        }
+        .start = baa_parser_token_start_location(parser, &parser->current_token)
     };
 
     // Consume the 'توقف' keyword
@@ -412,9 +373,7 @@ BaaNode *parse_break_statement(BaaParser *parser)
     baa_parser_consume_token(parser, BAA_TOKEN_DOT, L"Expected '.' after break statement");
 
     // Update the span end location
-    span.end.filename = parser->source_filename;
-    span.end.line = parser->previous_token.line;
-    span.end.column = parser->previous_token.column + parser->previous_token.length;
+    span.end = baa_parser_token_end_location(parser, &parser->previous_token);
 
     // Create the break statement node
     return baa_ast_new_break_stmt_node(span);
@@ -426,11 +385,7 @@ BaaNode *parse_continue_statement(BaaParser *parser)
 {
     // Create source span starting from the 'استمر' keyword
     BaaAstSourceSpan span = {
-        .start = {
-            .filename = parser->source_filename,
-            .line = parser->current_token.line,
-            .column = parser->current_token.column
-        }
+        .start = baa_parser_token_start_location(parser, &parser->current_token)
     };
 
     // Consume the 'استمر' keyword
@@ -440,9 +395,7 @@ BaaNode *parse_continue_statement(BaaParser *parser)
     baa_parser_consume_token(parser, BAA_TOKEN_DOT, L"Expected '.' after continue statement");
 
     // Update the span end location
-    span.end.filename = parser->source_filename;
-    span.end.line = parser->previous_token.line;
-    span.end.column = parser->previous_token.column + parser->previous_token.length;
+    span.end = baa_parser_token_end_location(parser, &parser->previous_token);
 
     // Create the continue statement node
     return baa_ast_new_continue_stmt_node(span);
@@ -41,11 +41,8 @@ BaaNode *parse_type_specifier(BaaParser *parser)
     {
         // Create source span for the type token
         BaaAstSourceSpan span = {
-            .start = {
-                .filename = parser->source_filename,
-                .line = parser->current_token.line,
-                .column = parser->current_token.column},
-            .end = {.filename = parser->source_filename, .line = parser->current_token.line, .column = parser->current_token.column + parser->current_token.length}};
+            .start = baa_parser_token_start_location(parser, &parser->current_token),
+            .end = baa_parser_token_end_location(parser, &parser->current_token)};
 
         // Get the type name
         const wchar_t *type_name = token_to_type_name(parser->current_token.type);
@@ -85,10 +82,7 @@ BaaNode *parse_type_specifier(BaaParser *parser)
             // Update span to include the array brackets
             BaaAstSourceSpan array_span = {
                 .start = span.start,
-                .end = {
-                    .filename = parser->source_filename,
-                    .line = parser->current_token.line,
-                    .column = parser->current_token.column}};
+                .end = baa_parser_token_start_location(parser, &parser->current_token)};
 
             // Create array type node
             BaaNode *array_type_node = baa_ast_new_array_type_node(array_span, type_node, size_expr);
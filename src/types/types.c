@@ -1,32 +1,125 @@
 #include "baa/types/types.h"
 #include "baa/utils/utils.h"
+#include "baa/utils/threads.h" // For BaaMutex
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <wchar.h>
 
+// Primitive types are statically allocated, so they exist before any lookup and
+// compare by pointer like every type in the canonical table
+#define BAA_PRIMITIVE_TYPE(var, type_kind, type_name, type_size, signed_flag) \
+    static BaaType var = {.kind = type_kind, .name = type_name, .size = type_size, \
+                          .is_signed = signed_flag, .is_canonical = true}
+
+BAA_PRIMITIVE_TYPE(type_void, BAA_TYPE_VOID, L"فراغ", sizeof(void), false);
+BAA_PRIMITIVE_TYPE(type_int, BAA_TYPE_INT, L"عدد_صحيح", sizeof(int), true);
+BAA_PRIMITIVE_TYPE(type_float, BAA_TYPE_FLOAT, L"عدد_حقيقي", sizeof(double), true);
+BAA_PRIMITIVE_TYPE(type_char, BAA_TYPE_CHAR, L"حرف", sizeof(wchar_t), true);
+BAA_PRIMITIVE_TYPE(type_string, BAA_TYPE_STRING, L"نص", sizeof(wchar_t*), false);
+BAA_PRIMITIVE_TYPE(type_bool, BAA_TYPE_BOOL, L"منطقي", sizeof(bool), false);
+BAA_PRIMITIVE_TYPE(type_null, BAA_TYPE_NULL, L"فارغ", 0, false);
+BAA_PRIMITIVE_TYPE(type_error, BAA_TYPE_ERROR, L"خطأ", 0, false);
+
 // Global type instances
-BaaType* baa_type_void = NULL;
-BaaType* baa_type_int = NULL;
-BaaType* baa_type_float = NULL;
-BaaType* baa_type_char = NULL;
-BaaType* baa_type_string = NULL;
-BaaType* baa_type_bool = NULL;
-BaaType* baa_type_null = NULL;
-BaaType* baa_type_error = NULL;
+BaaType* baa_type_void = &type_void;
+BaaType* baa_type_int = &type_int;
+BaaType* baa_type_float = &type_float;
+BaaType* baa_type_char = &type_char;
+BaaType* baa_type_string = &type_string;
+BaaType* baa_type_bool = &type_bool;
+BaaType* baa_type_null = &type_null;
+BaaType* baa_type_error = &type_error;
 
-void baa_init_type_system(void) {
-    if (baa_type_void == NULL) {
-        baa_type_void = baa_create_type(BAA_TYPE_VOID, L"فراغ", sizeof(void), false);
-        baa_type_int = baa_create_type(BAA_TYPE_INT, L"عدد_صحيح", sizeof(int), true);
-        baa_type_float = baa_create_type(BAA_TYPE_FLOAT, L"عدد_حقيقي", sizeof(double), true);
-        baa_type_char = baa_create_type(BAA_TYPE_CHAR, L"حرف", sizeof(wchar_t), true);
-        baa_type_string = baa_create_type(BAA_TYPE_STRING, L"نص", sizeof(wchar_t*), false);
-        baa_type_bool = baa_create_type(BAA_TYPE_BOOL, L"منطقي", sizeof(bool), false);
-        baa_type_null = baa_create_type(BAA_TYPE_NULL, L"فارغ", 0, false);
-        baa_type_error = baa_create_type(BAA_TYPE_ERROR, L"خطأ", 0, false);
+// Canonical table of constructed types: buckets chained through BaaType.next.
+// A constructed type is keyed by its kind, its operand type and a count
+// (T[N] is {ARRAY, T, N}); since operands are canonical themselves, comparing
+// them by pointer compares them structurally.
+#define BAA_TYPE_TABLE_INITIAL_BUCKETS 64
+
+static BaaType** type_buckets = NULL;
+static size_t type_bucket_count = 0;
+static size_t type_count = 0;
+static BaaMutex type_table_mutex = BAA_MUTEX_INIT;
+
+static size_t type_key_hash(BaaTypeKind kind, const BaaType* operand, size_t count) {
+    uint64_t hash = (uint64_t)(uintptr_t)operand;
+    hash ^= ((uint64_t)count + 0x9e3779b97f4a7c15ULL) + (hash << 6) + (hash >> 2);
+    hash ^= (uint64_t)kind * 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return (size_t)hash;
+}
+
+static bool type_table_grow(void) {
+    size_t bucket_count = type_bucket_count ? type_bucket_count * 2 : BAA_TYPE_TABLE_INITIAL_BUCKETS;
+    BaaType** buckets = baa_malloc(bucket_count * sizeof(BaaType*));
+    if (!buckets) {
+        return false;
     }
+    memset(buckets, 0, bucket_count * sizeof(BaaType*));
+    for (size_t i = 0; i < type_bucket_count; i++) {
+        BaaType* type = type_buckets[i];
+        while (type) {
+            BaaType* next = type->next;
+            size_t slot = type_key_hash(type->kind, type->element_type, type->array_size) & (bucket_count - 1);
+            type->next = buckets[slot];
+            buckets[slot] = type;
+            type = next;
+        }
+    }
+    baa_free(type_buckets);
+    type_buckets = buckets;
+    type_bucket_count = bucket_count;
+    return true;
+}
+
+// Returns the canonical {kind, operand, count} type, creating it on first use
+static BaaType* type_table_intern(BaaTypeKind kind, BaaType* operand, size_t count,
+                                  const wchar_t* name, uint32_t size) {
+    size_t hash = type_key_hash(kind, operand, count);
+    BaaType* result = NULL;
+
+    baa_mutex_lock(&type_table_mutex);
+    if (type_bucket_count > 0) {
+        for (BaaType* type = type_buckets[hash & (type_bucket_count - 1)]; type; type = type->next) {
+            if (type->kind == kind && type->element_type == operand && type->array_size == count) {
+                result = type;
+                break;
+            }
+        }
+    }
+    // Keep chains short: at most one type per bucket on average
+    if (!result && (type_count < type_bucket_count || type_table_grow())) {
+        result = baa_malloc(sizeof(BaaType));
+        if (result) {
+            result->kind = kind;
+            result->name = name;
+            result->size = size;
+            result->is_signed = false;
+            result->is_canonical = true;
+            result->element_type = operand;
+            result->array_size = count;
+            size_t slot = hash & (type_bucket_count - 1);
+            result->next = type_buckets[slot];
+            type_buckets[slot] = result;
+            type_count++;
+        }
+    }
+    baa_mutex_unlock(&type_table_mutex);
+    return result;
+}
+
+size_t baa_type_table_size(void) {
+    baa_mutex_lock(&type_table_mutex);
+    size_t count = type_count;
+    baa_mutex_unlock(&type_table_mutex);
+    return count;
+}
+
+void baa_init_type_system(void) {
+    // Primitive types are static and constructed types are created on demand;
+    // kept for callers that initialize the type system explicitly.
 }
 
 BaaType* baa_create_type(BaaTypeKind kind, const wchar_t* name, uint32_t size, bool is_signed) {
@@ -36,33 +129,46 @@ BaaType* baa_create_type(BaaTypeKind kind, const wchar_t* name, uint32_t size, b
         type->name = baa_strdup(name);
         type->size = size;
         type->is_signed = is_signed;
+        type->is_canonical = false;
         type->next = NULL;
+        type->element_type = NULL;
+        type->array_size = 0;
     }
     return type;
 }
 
 void baa_free_type(BaaType* type) {
-    if (type) {
+    // Canonical types live as long as the program
+    if (type && !type->is_canonical) {
         if (type->name) {
             baa_free((void*)type->name);
         }
-        
+
         // If it's an array type, we don't free the element_type
         // since it might be a shared type that's used elsewhere
         // The element_type is expected to be freed separately
-        
+
         baa_free(type);
     }
 }
 
 bool baa_types_equal(BaaType* a, BaaType* b) {
-    if (a == NULL || b == NULL) {
+    if (a == b) {
+        return a != NULL;
+    }
+    // Distinct canonical types always differ
+    if (a == NULL || b == NULL || (a->is_canonical && b->is_canonical)) {
         return false;
     }
 
-    return a->kind == b->kind &&
-           a->size == b->size &&
-           a->is_signed == b->is_signed;
+    // Types from baa_create_type are compared structurally
+    if (a->kind != b->kind || a->size != b->size || a->is_signed != b->is_signed) {
+        return false;
+    }
+    if (a->kind == BAA_TYPE_ARRAY) {
+        return a->array_size == b->array_size && baa_types_equal(a->element_type, b->element_type);
+    }
+    return true;
 }
 
 bool baa_can_convert(BaaType* from, BaaType* to) {
@@ -108,58 +214,34 @@ const wchar_t* baa_type_to_string(BaaType* type) {
 
 // Type getter functions
 BaaType* baa_get_void_type(void) {
-    if (baa_type_void == NULL) {
-        baa_init_type_system();
-    }
     return baa_type_void;
 }
 
 BaaType* baa_get_int_type(void) {
-    if (baa_type_int == NULL) {
-        baa_init_type_system();
-    }
     return baa_type_int;
 }
 
 BaaType* baa_get_float_type(void) {
-    if (baa_type_float == NULL) {
-        baa_init_type_system();
-    }
     return baa_type_float;
 }
 
 BaaType* baa_get_char_type(void) {
-    if (baa_type_char == NULL) {
-        baa_init_type_system();
-    }
     return baa_type_char;
 }
 
 BaaType* baa_get_string_type(void) {
-    if (baa_type_string == NULL) {
-        baa_init_type_system();
-    }
     return baa_type_string;
 }
 
 BaaType* baa_get_bool_type(void) {
-    if (baa_type_bool == NULL) {
-        baa_init_type_system();
-    }
     return baa_type_bool;
 }
 
 BaaType* baa_get_null_type(void) {
-    if (baa_type_null == NULL) {
-        baa_init_type_system();
-    }
     return baa_type_null;
 }
 
 BaaType* baa_get_error_type(void) {
-    if (baa_type_error == NULL) {
-        baa_init_type_system();
-    }
     return baa_type_error;
 }
 
@@ -190,23 +272,10 @@ BaaType* baa_create_primitive_type(BaaTypeKind kind) {
 // Array type operations
 BaaType* baa_create_array_type(BaaType* element_type, size_t size) {
     if (!element_type) return NULL;
-    
-    // Create a new array type
-    BaaType* array_type = baa_malloc(sizeof(BaaType));
-    if (!array_type) return NULL;
-    
-    // Initialize the array type
-    array_type->kind = BAA_TYPE_ARRAY;
-    array_type->name = baa_strdup(L"مصفوفة");
-    array_type->size = element_type->size * (size > 0 ? size : 1);
-    array_type->is_signed = false;
-    array_type->next = NULL;
-    
-    // Set array-specific fields
-    array_type->element_type = element_type;
-    array_type->array_size = size;
-    
-    return array_type;
+
+    // T[N] is created once; later calls return the same type
+    uint32_t byte_size = element_type->size * (uint32_t)(size > 0 ? size : 1);
+    return type_table_intern(BAA_TYPE_ARRAY, element_type, size, L"مصفوفة", byte_size);
 }
 
 BaaType* baa_get_array_element_type(BaaType* array_type) {
@@ -0,0 +1,93 @@
+#include "baa/utils/threads.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+static DWORD WINAPI baa_thread_trampoline(LPVOID param)
+{
+    BaaThread *thread = (BaaThread *)param;
+    thread->result = thread->func(thread->arg);
+    return 0;
+}
+#else
+static void *baa_thread_trampoline(void *param)
+{
+    BaaThread *thread = (BaaThread *)param;
+    thread->result = thread->func(thread->arg);
+    return NULL;
+}
+#endif
+
+bool baa_thread_create(BaaThread *thread, BaaThreadFunc func, void *arg)
+{
+    if (!thread || !func)
+        return false;
+
+    thread->func = func;
+    thread->arg = arg;
+    thread->result = 0;
+
+#ifdef _WIN32
+    HANDLE handle = CreateThread(NULL, 0, baa_thread_trampoline, thread, 0, NULL);
+    if (!handle)
+        return false;
+    thread->handle = handle;
+    return true;
+#else
+    return pthread_create(&thread->handle, NULL, baa_thread_trampoline, thread) == 0;
+#endif
+}
+
+bool baa_thread_join(BaaThread *thread, int *out_result)
+{
+    if (!thread)
+        return false;
+
+#ifdef _WIN32
+    if (WaitForSingleObject((HANDLE)thread->handle, INFINITE) != WAIT_OBJECT_0)
+        return false;
+    CloseHandle((HANDLE)thread->handle);
+    thread->handle = NULL;
+#else
+    if (pthread_join(thread->handle, NULL) != 0)
+        return false;
+#endif
+
+    if (out_result)
+        *out_result = thread->result;
+    return true;
+}
+
+size_t baa_thread_hardware_concurrency(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t)count : 1;
+#endif
+}
+
+void baa_mutex_lock(BaaMutex *mutex)
+{
+#ifdef _WIN32
+    AcquireSRWLockExclusive((PSRWLOCK)&mutex->native);
+#else
+    pthread_mutex_lock(&mutex->native);
+#endif
+}
+
+void baa_mutex_unlock(BaaMutex *mutex)
+{
+#ifdef _WIN32
+    ReleaseSRWLockExclusive((PSRWLOCK)&mutex->native);
+#else
+    pthread_mutex_unlock(&mutex->native);
+#endif
+}
@@ -0,0 +1,171 @@
+// src/utils/trace.c
+#include "baa/utils/trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define BAA_TRACE_BUFFER_SIZE 65536
+#define BAA_TRACE_MAX_EVENT 512 // Longest line written in one piece (longer text is truncated)
+
+unsigned baa_trace_mask = 0;
+
+static char trace_buffer[BAA_TRACE_BUFFER_SIZE];
+static size_t trace_length = 0;
+static FILE *trace_sink = NULL; // NULL means stderr
+static FILE *trace_owned_file = NULL;
+static int trace_atexit_registered = 0;
+
+void baa_trace_flush(void)
+{
+    if (trace_length > 0)
+    {
+        FILE *sink = trace_sink ? trace_sink : stderr;
+        fwrite(trace_buffer, 1, trace_length, sink);
+        fflush(sink);
+        trace_length = 0;
+    }
+}
+
+static void trace_at_exit(void)
+{
+    baa_trace_flush();
+    if (trace_owned_file)
+    {
+        fclose(trace_owned_file);
+        trace_owned_file = NULL;
+        trace_sink = NULL;
+    }
+}
+
+static void trace_register_atexit(void)
+{
+    if (!trace_atexit_registered)
+    {
+        atexit(trace_at_exit);
+        trace_atexit_registered = 1;
+    }
+}
+
+void baa_trace_enable(unsigned subsystems)
+{
+    baa_trace_mask = subsystems & BAA_TRACE_ALL;
+    if (baa_trace_mask)
+        trace_register_atexit();
+}
+
+void baa_trace_set_sink(FILE *sink)
+{
+    baa_trace_flush();
+    trace_sink = sink;
+}
+
+unsigned baa_trace_init_from_env(void)
+{
+#ifdef BAA_ENABLE_TRACE
+    static const struct
+    {
+        const char *name;
+        unsigned mask;
+    } names[] = {
+        {"lexer", BAA_TRACE_LEXER},
+        {"preprocessor", BAA_TRACE_PREPROCESSOR},
+        {"parser", BAA_TRACE_PARSER},
+        {"semantic", BAA_TRACE_SEMANTIC},
+        {"all", BAA_TRACE_ALL},
+    };
+
+    const char *spec = getenv("BAA_TRACE");
+    unsigned mask = 0;
+    while (spec && *spec)
+    {
+        size_t length = strcspn(spec, ",");
+        for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+        {
+            if (strlen(names[i].name) == length && strncmp(spec, names[i].name, length) == 0)
+                mask |= names[i].mask;
+        }
+        spec += length;
+        if (*spec == ',')
+            spec++;
+    }
+
+    const char *path = getenv("BAA_TRACE_FILE");
+    if (mask && path && *path && !trace_owned_file)
+    {
+        trace_owned_file = fopen(path, "w");
+        if (trace_owned_file)
+            baa_trace_set_sink(trace_owned_file);
+    }
+
+    baa_trace_enable(mask);
+    return baa_trace_mask;
+#else
+    return 0; // Trace points are compiled out; leave the mask and sink alone
+#endif
+}
+
+// Appends the UTF-8 encoding of c (control characters escaped), returning the new position
+static size_t trace_put_char(char *out, size_t pos, wchar_t wc)
+{
+    unsigned long c = (unsigned long)wc;
+    if (c == L'\n' || c == L'\r' || c == L'\t' || c == L'\\')
+    {
+        out[pos++] = '\\';
+        out[pos++] = c == L'\n' ? 'n' : c == L'\r' ? 'r' : c == L'\t' ? 't' : '\\';
+    }
+    else if (c < 0x20)
+    {
+        out[pos++] = '?';
+    }
+    else if (c < 0x80)
+    {
+        out[pos++] = (char)c;
+    }
+    else if (c < 0x800)
+    {
+        out[pos++] = (char)(0xC0 | (c >> 6));
+        out[pos++] = (char)(0x80 | (c & 0x3F));
+    }
+    else if (c < 0x10000)
+    {
+        out[pos++] = (char)(0xE0 | (c >> 12));
+        out[pos++] = (char)(0x80 | ((c >> 6) & 0x3F));
+        out[pos++] = (char)(0x80 | (c & 0x3F));
+    }
+    else
+    {
+        out[pos++] = (char)(0xF0 | ((c >> 18) & 0x07));
+        out[pos++] = (char)(0x80 | ((c >> 12) & 0x3F));
+        out[pos++] = (char)(0x80 | ((c >> 6) & 0x3F));
+        out[pos++] = (char)(0x80 | (c & 0x3F));
+    }
+    return pos;
+}
+
+void baa_trace_emit(BaaTraceSubsystem subsystem, const char *event, long value,
+                    size_t start, size_t end, const wchar_t *text, size_t text_length)
+{
+    static const char letters[] = {'L', 'C', 'P', 'S'};
+    char line[BAA_TRACE_MAX_EVENT];
+
+    char letter = '?';
+    for (size_t i = 0; i < sizeof(letters); i++)
+    {
+        if ((unsigned)subsystem == (1u << i))
+            letter = letters[i];
+    }
+
+    int header = snprintf(line, sizeof(line), "%c %s %ld %zu..%zu ", letter, event ? event : "-", value, start, end);
+    if (header < 0)
+        return;
+    size_t pos = (size_t)header < sizeof(line) ? (size_t)header : sizeof(line) - 1;
+
+    // Each character takes at most 4 bytes; keep room for the newline
+    for (size_t i = 0; text && i < text_length && pos + 5 < sizeof(line); i++)
+        pos = trace_put_char(line, pos, text[i]);
+    line[pos++] = '\n';
+
+    if (trace_length + pos > sizeof(trace_buffer))
+        baa_trace_flush();
+    memcpy(trace_buffer + trace_length, line, pos);
+    trace_length += pos;
+}
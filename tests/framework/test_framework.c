@@ -189,6 +189,16 @@ BaaNode *create_test_ast_node(int kind, const char *test_data)
     }
 }
 
+static BaaAstVisitResult print_ast_node(BaaNode *node, BaaNode *parent, size_t depth, void *user_data)
+{
+    (void)parent;
+    int indent_level = *(const int *)user_data + (int)depth;
+    for (int i = 0; i < indent_level; i++)
+        wprintf(L"  ");
+    wprintf(L"Node: kind=%d\n", node->kind);
+    return BAA_AST_VISIT_CONTINUE;
+}
+
 void print_ast_debug(BaaNode *root, int indent_level)
 {
     if (!root)
@@ -199,11 +209,8 @@ void print_ast_debug(BaaNode *root, int indent_level)
         return;
     }
 
-    for (int i = 0; i < indent_level; i++)
-        wprintf(L"  ");
-    wprintf(L"Node: kind=%d\n", root->kind);
-
-    // TODO: Add more detailed AST printing based on node type
+    BaaAstVisitor visitor = {print_ast_node, NULL, &indent_level};
+    baa_ast_walk(root, &visitor);
 }
 
 void free_test_ast(BaaNode *root)
@@ -246,6 +253,7 @@ BaaNode *parse_test_string(const wchar_t *source)
     BaaParser *parser = baa_parser_create(&lexer, L"test.baa");
     if (!parser)
     {
+        baa_cleanup_lexer(&lexer);
         return NULL;
     }
 
@@ -254,6 +262,7 @@ BaaNode *parse_test_string(const wchar_t *source)
 
     // Clean up parser (but not the AST)
     baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
 
     return ast;
 }
@@ -302,7 +311,9 @@ BaaToken *tokenize_test_string(const wchar_t *source)
     baa_init_lexer(&lexer, source, L"test.baa");
 
     // For now, just return the first token
-    return baa_lexer_next_token(&lexer);
+    BaaToken *token = baa_lexer_next_token(&lexer);
+    baa_cleanup_lexer(&lexer);
+    return token;
 }
 
 void assert_token_sequence(const wchar_t *source, int *expected_types, size_t count, const char *test_name)
@@ -324,6 +335,7 @@ void assert_token_sequence(const wchar_t *source, int *expected_types, size_t co
         {
             wprintf(L"[ASSERT FAILED] %hs: Expected token %zu but got NULL\n", test_name, i);
             failed_tests++;
+            baa_cleanup_lexer(&lexer);
             return;
         }
 
@@ -333,11 +345,13 @@ void assert_token_sequence(const wchar_t *source, int *expected_types, size_t co
                     test_name, i, expected_types[i], token->type);
             baa_free_token(token);
             failed_tests++;
+            baa_cleanup_lexer(&lexer);
             return;
         }
 
         baa_free_token(token);
     }
+    baa_cleanup_lexer(&lexer);
 }
 
 void free_test_tokens(BaaToken *tokens, size_t count)
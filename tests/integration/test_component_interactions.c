@@ -39,6 +39,7 @@ void test_preprocessor_to_lexer_interaction(void)
     ASSERT_WSTR_EQ(L"123", token->lexeme);
     
     baa_free_token(token);
+    baa_cleanup_lexer(&lexer);
     free(preprocessed);
     if (error_message) free(error_message);
     
@@ -81,6 +82,7 @@ void test_lexer_to_parser_interaction(void)
     
     baa_ast_free_node(ast);
     baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
     
     wprintf(L"  ✓ Lexer → Parser interaction successful\n");
     
@@ -134,6 +136,7 @@ void test_parser_to_ast_interaction(void)
     
     baa_ast_free_node(ast);
     baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
     
     wprintf(L"  ✓ Parser → AST interaction successful\n");
     
@@ -200,6 +203,7 @@ void test_arabic_content_through_pipeline(void)
     
     baa_ast_free_node(ast);
     baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
     free(preprocessed);
     if (error_message) free(error_message);
     
@@ -251,6 +255,7 @@ void test_error_handling_across_components(void)
         }
         baa_free_token(token);
     }
+    baa_cleanup_lexer(&lexer);
     
     // Test 3: Parser error
     const wchar_t* parser_error_source = L"42 43."; // Invalid syntax
@@ -271,6 +276,7 @@ void test_error_handling_across_components(void)
         if (ast) baa_ast_free_node(ast);
         baa_parser_free(parser);
     }
+    baa_cleanup_lexer(&parser_lexer);
     
     TEST_TEARDOWN();
     wprintf(L"✓ Error handling across components test passed\n");
@@ -306,6 +312,7 @@ void test_memory_management_across_pipeline(void)
                 if (ast) baa_ast_free_node(ast);
                 baa_parser_free(parser);
             }
+            baa_cleanup_lexer(&lexer);
             
             free(preprocessed);
         }
@@ -73,6 +73,7 @@ void free_pipeline_result(PipelineResult* result)
     if (result->parser) {
         baa_parser_free(result->parser);
     }
+    baa_cleanup_lexer(&result->lexer);
     if (result->ast) {
         baa_ast_free_node(result->ast);
     }
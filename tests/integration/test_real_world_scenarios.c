@@ -40,6 +40,7 @@ BaaNode* parse_baa_code(const wchar_t* source_code, const char* filename)
     
     // Cleanup
     baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
     free(preprocessed);
     
     return ast;
@@ -0,0 +1,211 @@
+#include "test_framework.h"
+#include "baa/analysis/symbol_table.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_types.h"
+#include <stdio.h>
+#include <string.h>
+
+static BaaAstSourceSpan test_span(void)
+{
+    BaaAstSourceSpan span = {
+        .start = {.filename = L"symbols.baa", .line = 1, .column = 1},
+        .end = {.filename = L"symbols.baa", .line = 1, .column = 10}};
+    return span;
+}
+
+void test_scopes_and_shadowing(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing scope push/pop and shadowing...\n");
+
+    BaaSymbolTable *table = baa_symbol_table_create(NULL);
+    ASSERT_NOT_NULL(table, L"Table should be created");
+    BaaScope *global = baa_symbol_table_current_scope(table);
+    ASSERT_EQ(0, (int)global->depth);
+    ASSERT_NULL(global->parent, L"The global scope has no parent");
+    ASSERT_TRUE(!baa_symbol_table_pop_scope(table), L"The outermost scope cannot be left");
+
+    BaaSymbol *outer = baa_symbol_table_declare(table, L"س", BAA_SYMBOL_VARIABLE, NULL);
+    ASSERT_NOT_NULL(outer, L"Declaration should succeed");
+    ASSERT_NULL(baa_symbol_table_declare(table, L"س", BAA_SYMBOL_VARIABLE, NULL),
+                L"Redeclaring in the same scope should fail");
+    ASSERT_PTR_EQ(outer, baa_symbol_table_lookup_current(table, L"س"));
+
+    // Names are interned: every copy of the name yields the same pointer
+    wchar_t copy[] = L"س";
+    ASSERT_PTR_EQ(outer->name, baa_symbol_table_intern(table, copy));
+
+    BaaNode *block = baa_ast_new_block_stmt_node(test_span());
+    BaaScope *inner_scope = baa_symbol_table_push_scope(table, block);
+    ASSERT_NOT_NULL(inner_scope, L"Scope should be pushed");
+    ASSERT_PTR_EQ(inner_scope, ((BaaBlockStmtData *)block->data)->scope);
+    ASSERT_PTR_EQ(global, inner_scope->parent);
+    ASSERT_EQ(1, (int)inner_scope->depth);
+
+    ASSERT_PTR_EQ(outer, baa_symbol_table_lookup(table, L"س"));
+    ASSERT_NULL(baa_symbol_table_lookup_current(table, L"س"), L"The outer symbol is not in the inner scope");
+
+    BaaSymbol *inner = baa_symbol_table_declare(table, L"س", BAA_SYMBOL_VARIABLE, NULL);
+    ASSERT_NOT_NULL(inner, L"Shadowing should succeed");
+    ASSERT_PTR_EQ(outer, inner->shadowed);
+    ASSERT_PTR_EQ(inner, baa_symbol_table_lookup(table, L"س"));
+    ASSERT_PTR_EQ(outer->name, inner->name);
+    BaaSymbol *local = baa_symbol_table_declare(table, L"ص", BAA_SYMBOL_VARIABLE, NULL);
+    ASSERT_EQ(2, (int)inner_scope->symbol_count);
+    ASSERT_PTR_EQ(local, inner_scope->symbols);
+    ASSERT_PTR_EQ(inner, local->next_in_scope);
+
+    ASSERT_TRUE(baa_symbol_table_pop_scope(table), L"Scope should be popped");
+    ASSERT_PTR_EQ(global, baa_symbol_table_current_scope(table));
+    ASSERT_PTR_EQ(outer, baa_symbol_table_lookup(table, L"س"));
+    ASSERT_NULL(baa_symbol_table_lookup(table, L"ص"), L"Inner names should be gone");
+
+    // Popped scopes and their symbols persist for later passes
+    ASSERT_PTR_EQ(inner_scope, inner->scope);
+    ASSERT_EQ(2, (int)inner_scope->symbol_count);
+    ASSERT_EQ(2, (int)baa_symbol_table_name_count(table));
+
+    baa_ast_free_node(block);
+    baa_symbol_table_free(table);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Scope and shadowing test passed\n");
+}
+
+void test_ast_back_pointers(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing symbol back-pointers in AST nodes...\n");
+
+    BaaSymbolTable *table = baa_symbol_table_create(NULL);
+    BaaNode *function = baa_ast_new_function_def_node(test_span(), L"د", BAA_MOD_NONE,
+                                                      baa_ast_new_primitive_type_node(test_span(), L"فراغ"),
+                                                      baa_ast_new_block_stmt_node(test_span()), false);
+    BaaNode *parameter = baa_ast_new_parameter_node(test_span(), L"م",
+                                                    baa_ast_new_primitive_type_node(test_span(), L"عدد_صحيح"));
+    baa_ast_add_function_parameter(function, parameter);
+    BaaNode *variable = baa_ast_new_var_decl_node(test_span(), L"س", BAA_MOD_NONE,
+                                                  baa_ast_new_primitive_type_node(test_span(), L"عدد_صحيح"), NULL);
+    BaaNode *use = baa_ast_new_identifier_expr_node(test_span(), L"م");
+    BaaNode *unknown = baa_ast_new_identifier_expr_node(test_span(), L"مجهول");
+
+    BaaSymbol *function_symbol = baa_symbol_table_declare(table, L"د", BAA_SYMBOL_FUNCTION, function);
+    ASSERT_PTR_EQ(function_symbol, ((BaaFunctionDefData *)function->data)->symbol_entry);
+    ASSERT_PTR_EQ(function, function_symbol->declaration);
+
+    BaaNode *body = ((BaaFunctionDefData *)function->data)->body;
+    baa_symbol_table_push_scope(table, body);
+    BaaSymbol *parameter_symbol = baa_symbol_table_declare(table, L"م", BAA_SYMBOL_PARAMETER, parameter);
+    BaaSymbol *variable_symbol = baa_symbol_table_declare(table, L"س", BAA_SYMBOL_VARIABLE, variable);
+    ASSERT_PTR_EQ(parameter_symbol, ((BaaParameterData *)parameter->data)->symbol_entry);
+    ASSERT_PTR_EQ(variable_symbol, ((BaaVarDeclData *)variable->data)->symbol_entry);
+    ASSERT_EQ(BAA_SYMBOL_PARAMETER, parameter_symbol->kind);
+
+    ASSERT_PTR_EQ(parameter_symbol, baa_symbol_table_resolve(table, use));
+    ASSERT_PTR_EQ(parameter_symbol, ((BaaIdentifierExprData *)use->data)->resolved_symbol);
+    ASSERT_NULL(baa_symbol_table_resolve(table, unknown), L"Unknown names should not resolve");
+    ASSERT_NULL(((BaaIdentifierExprData *)unknown->data)->resolved_symbol, L"Unresolved names keep a NULL symbol");
+    ASSERT_PTR_EQ(((BaaBlockStmtData *)body->data)->scope, parameter_symbol->scope);
+    baa_symbol_table_pop_scope(table);
+
+    baa_ast_free_node(unknown);
+    baa_ast_free_node(use);
+    baa_ast_free_node(variable);
+    baa_ast_free_node(function);
+    baa_symbol_table_free(table);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ AST back-pointer test passed\n");
+}
+
+void test_layered_globals(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing tables layered over frozen globals...\n");
+
+    BaaSymbolTable *globals = baa_symbol_table_create(NULL);
+    BaaSymbol *global_x = baa_symbol_table_declare(globals, L"س", BAA_SYMBOL_VARIABLE, NULL);
+    BaaSymbol *global_f = baa_symbol_table_declare(globals, L"د", BAA_SYMBOL_FUNCTION, NULL);
+
+    BaaSymbolTable *local = baa_symbol_table_create(globals);
+    ASSERT_NOT_NULL(local, L"Layered table should be created");
+    BaaScope *function_scope = baa_symbol_table_current_scope(local);
+    ASSERT_PTR_EQ(baa_symbol_table_current_scope(globals), function_scope->parent);
+    ASSERT_EQ(1, (int)function_scope->depth);
+
+    ASSERT_PTR_EQ(global_f, baa_symbol_table_lookup(local, L"د"));
+    ASSERT_PTR_EQ(global_x, baa_symbol_table_lookup(local, L"س"));
+
+    baa_symbol_table_push_scope(local, NULL);
+    BaaSymbol *local_x = baa_symbol_table_declare(local, L"س", BAA_SYMBOL_VARIABLE, NULL);
+    ASSERT_NOT_NULL(local_x, L"Globals can be shadowed");
+    ASSERT_PTR_EQ(global_x, local_x->shadowed);
+    ASSERT_PTR_EQ(local_x, baa_symbol_table_lookup(local, L"س"));
+    ASSERT_PTR_EQ(global_x, baa_symbol_table_lookup(globals, L"س"));
+    baa_symbol_table_pop_scope(local);
+    ASSERT_PTR_EQ(global_x, baa_symbol_table_lookup(local, L"س"));
+
+    // The globals table is only read
+    ASSERT_EQ(2, (int)baa_symbol_table_name_count(globals));
+
+    baa_symbol_table_free(local);
+    baa_symbol_table_free(globals);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Layered globals test passed\n");
+}
+
+void test_deep_nesting(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing deep nesting and table growth...\n");
+
+    enum
+    {
+        DEPTH = 2000
+    };
+    BaaSymbolTable *table = baa_symbol_table_create(NULL);
+    BaaSymbol *outer = baa_symbol_table_declare(table, L"س", BAA_SYMBOL_VARIABLE, NULL);
+
+    // Every scope shadows the same name and adds a name of its own
+    wchar_t name[32];
+    for (int i = 1; i <= DEPTH; i++)
+    {
+        baa_symbol_table_push_scope(table, NULL);
+        baa_symbol_table_declare(table, L"س", BAA_SYMBOL_VARIABLE, NULL);
+        swprintf(name, 32, L"متغير_%d", i);
+        ASSERT_NOT_NULL(baa_symbol_table_declare(table, name, BAA_SYMBOL_VARIABLE, NULL), L"Declaration failed");
+    }
+    ASSERT_EQ(DEPTH + 1, (int)baa_symbol_table_name_count(table));
+    BaaSymbol *innermost = baa_symbol_table_lookup(table, L"س");
+    ASSERT_EQ(DEPTH, (int)innermost->scope->depth);
+    ASSERT_NOT_NULL(baa_symbol_table_lookup(table, L"متغير_1"), L"Outer names stay visible");
+
+    for (int i = DEPTH; i >= 1; i--)
+    {
+        ASSERT_EQ(i, (int)baa_symbol_table_lookup(table, L"س")->scope->depth);
+        swprintf(name, 32, L"متغير_%d", i);
+        ASSERT_NOT_NULL(baa_symbol_table_lookup_current(table, name), L"The scope's own name should be current");
+        ASSERT_TRUE(baa_symbol_table_pop_scope(table), L"Scope should be popped");
+        ASSERT_NULL(baa_symbol_table_lookup(table, name), L"The scope's name should be gone");
+    }
+    ASSERT_PTR_EQ(outer, baa_symbol_table_lookup(table, L"س"));
+
+    baa_symbol_table_free(table);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Deep nesting test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running symbol table tests...\n\n");
+
+TEST_CASE(test_scopes_and_shadowing);
+TEST_CASE(test_ast_back_pointers);
+TEST_CASE(test_layered_globals);
+TEST_CASE(test_deep_nesting);
+
+wprintf(L"\n✓ All symbol table tests completed!\n");
+
+TEST_SUITE_END()
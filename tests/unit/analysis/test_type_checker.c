@@ -0,0 +1,193 @@
+#include "test_framework.h"
+#include "baa/analysis/type_checker.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_types.h"
+#include "baa/ast/ast_visitor.h"
+#include "baa/lexer/lexer.h"
+#include "baa/parser/parser.h"
+#include "baa/types/types.h"
+#include <stdio.h>
+#include <string.h>
+
+// The function calls one declared after it and shadows a variable in a nested block
+static const wchar_t *valid_source =
+    L"عدد_صحيح حد = 10.\n"
+    L"حرف[4] تحية = \"سلام\".\n"
+    L"عدد_حقيقي نسبة(عدد_صحيح س, عدد_حقيقي ص) {\n"
+    L"    عدد_صحيح م = س * 2.\n"
+    L"    إذا (م > حد) {\n"
+    L"        عدد_حقيقي م = ص + م.\n"
+    L"        إرجع م.\n"
+    L"    }\n"
+    L"    إرجع مربع(س) + ص.\n"
+    L"}\n"
+    L"عدد_صحيح مربع(عدد_صحيح س) {\n"
+    L"    إرجع س * س.\n"
+    L"}\n";
+
+// One error per line 1, 3, 4, 5, 6 and 8
+static const wchar_t *invalid_source =
+    L"عدد_صحيح أ = \"نص\".\n"
+    L"فراغ د(عدد_صحيح س) {\n"
+    L"    عدد_صحيح ص = س + مجهول.\n"
+    L"    منطقي ن = \"أ\" * 2.\n"
+    L"    د(1, 2).\n"
+    L"    إرجع 1.\n"
+    L"}\n"
+    L"عدد_صحيح أ = 2.\n";
+
+static BaaNode *parse(const wchar_t *source, BaaLexer *lexer)
+{
+    baa_init_lexer(lexer, source, L"types.baa");
+    BaaParser *parser = baa_parser_create(lexer, L"types.baa");
+    BaaNode *program = baa_parse_program(parser);
+    bool had_error = baa_parser_had_error(parser);
+    baa_parser_free(parser);
+    if (had_error)
+    {
+        baa_ast_free_node(program);
+        return NULL;
+    }
+    return program;
+}
+
+static BaaAstVisitResult count_node(BaaNode *node, BaaNode *parent, size_t depth, void *user_data)
+{
+    (void)node;
+    (void)parent;
+    (void)depth;
+    (*(size_t *)user_data)++;
+    return BAA_AST_VISIT_CONTINUE;
+}
+
+void test_annotates_valid_program(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing that a valid program is annotated with types and symbols...\n");
+
+    BaaLexer lexer;
+    BaaNode *program = parse(valid_source, &lexer);
+    ASSERT_NOT_NULL(program, L"Program should parse");
+
+    BaaTypeChecker *checker = baa_type_checker_create();
+    ASSERT_NOT_NULL(checker, L"Checker should be created");
+    ASSERT_TRUE(baa_type_check_program(checker, program), L"The program should check");
+    ASSERT_EQ(0, (int)baa_type_checker_error_count(checker));
+    ASSERT_TRUE(!baa_type_check_program(checker, program), L"A checker checks one program");
+
+    // Every node is visited once
+    size_t node_total = 0;
+    BaaAstVisitor counter = {.pre = count_node, .user_data = &node_total};
+    baa_ast_walk(program, &counter);
+    ASSERT_EQ((int)node_total, (int)baa_type_checker_node_count(checker));
+
+    BaaProgramData *program_data = (BaaProgramData *)program->data;
+    BaaNode *limit = program_data->top_level_declarations[0];
+    BaaNode *greeting = program_data->top_level_declarations[1];
+    BaaNode *ratio = program_data->top_level_declarations[2];
+    BaaNode *square = program_data->top_level_declarations[3];
+    ASSERT_PTR_EQ(baa_get_int_type(), limit->resolved_type);
+    ASSERT_PTR_EQ(baa_create_array_type(baa_get_char_type(), 4), greeting->resolved_type);
+    ASSERT_PTR_EQ(baa_get_float_type(), ratio->resolved_type);
+    ASSERT_PTR_EQ(baa_symbol_table_lookup(baa_type_checker_globals(checker), L"مربع"),
+                  ((BaaFunctionDefData *)square->data)->symbol_entry);
+
+    BaaFunctionDefData *ratio_data = (BaaFunctionDefData *)ratio->data;
+    BaaSymbol *x = ((BaaParameterData *)ratio_data->parameters[0]->data)->symbol_entry;
+    ASSERT_NOT_NULL(x, L"Parameters should be declared");
+    ASSERT_PTR_EQ(baa_get_int_type(), x->type);
+
+    // م = س * 2
+    BaaBlockStmtData *body = (BaaBlockStmtData *)ratio_data->body->data;
+    ASSERT_NOT_NULL(body->scope, L"The body should have a scope");
+    BaaNode *m_decl = body->statements[0];
+    BaaSymbol *m = ((BaaVarDeclData *)m_decl->data)->symbol_entry;
+    BaaNode *product = ((BaaVarDeclData *)m_decl->data)->initializer_expr;
+    ASSERT_PTR_EQ(baa_get_int_type(), product->resolved_type);
+    BaaNode *x_use = ((BaaBinaryExprData *)product->data)->left_operand;
+    ASSERT_PTR_EQ(x, ((BaaIdentifierExprData *)x_use->data)->resolved_symbol);
+
+    // The inner م is a float initialized from the outer one
+    BaaNode *branch = ((BaaIfStmtData *)body->statements[1]->data)->then_stmt;
+    BaaNode *inner_decl = ((BaaBlockStmtData *)branch->data)->statements[0];
+    BaaSymbol *inner_m = ((BaaVarDeclData *)inner_decl->data)->symbol_entry;
+    ASSERT_PTR_EQ(m, inner_m->shadowed);
+    ASSERT_PTR_EQ(baa_get_float_type(), inner_m->type);
+    BaaNode *sum = ((BaaVarDeclData *)inner_decl->data)->initializer_expr;
+    BaaNode *outer_use = ((BaaBinaryExprData *)sum->data)->right_operand;
+    ASSERT_PTR_EQ(m, ((BaaIdentifierExprData *)outer_use->data)->resolved_symbol);
+    ASSERT_PTR_EQ(baa_get_float_type(), sum->resolved_type);
+
+    // مربع(س) + ص: a call to a later function, then int + float
+    BaaNode *result = ((BaaReturnStmtData *)body->statements[2]->data)->value_expr;
+    BaaNode *call = ((BaaBinaryExprData *)result->data)->left_operand;
+    ASSERT_PTR_EQ(baa_get_int_type(), call->resolved_type);
+    ASSERT_PTR_EQ(baa_get_float_type(), result->resolved_type);
+
+    baa_type_checker_free(checker);
+    baa_ast_free_node(program);
+    baa_cleanup_lexer(&lexer);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Valid program test passed\n");
+}
+
+void test_reports_errors_in_source_order(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing semantic diagnostics...\n");
+
+    BaaLexer lexer;
+    BaaNode *program = parse(invalid_source, &lexer);
+    ASSERT_NOT_NULL(program, L"Program should parse");
+
+    BaaTypeChecker *checker = baa_type_checker_create();
+    ASSERT_TRUE(!baa_type_check_program(checker, program), L"The program should not check");
+
+    size_t count = 0;
+    const BaaDiagnostic *diagnostics = baa_type_checker_get_diagnostics(checker, &count);
+    ASSERT_EQ(6, (int)count);
+    const size_t lines[] = {1, 3, 4, 5, 6, 8};
+    const BaaDiagnosticCategory categories[] = {BAA_DIAG_TYPE,     BAA_DIAG_SEMANTIC, BAA_DIAG_TYPE,
+                                                BAA_DIAG_SEMANTIC, BAA_DIAG_TYPE,     BAA_DIAG_SEMANTIC};
+    for (size_t i = 0; i < count && i < 6; i++)
+    {
+        ASSERT_EQ((int)lines[i], (int)diagnostics[i].location.line);
+        ASSERT_EQ(categories[i], diagnostics[i].category);
+        ASSERT_EQ(BAA_DIAG_ERROR, diagnostics[i].severity);
+    }
+    ASSERT_TRUE(wcsstr(diagnostics[1].message, L"مجهول") != NULL, L"The undeclared name should be named");
+
+    // The failed operand gets the error type; its statement reports nothing else
+    BaaNode *function = ((BaaProgramData *)program->data)->top_level_declarations[1];
+    BaaBlockStmtData *body = (BaaBlockStmtData *)((BaaFunctionDefData *)function->data)->body->data;
+    BaaNode *sum = ((BaaVarDeclData *)body->statements[0]->data)->initializer_expr;
+    ASSERT_PTR_EQ(baa_get_error_type(), sum->resolved_type);
+
+    FILE *stream = tmpfile();
+    ASSERT_NOT_NULL(stream, L"Temporary file should open");
+    baa_type_checker_print_diagnostics(checker, stream);
+    rewind(stream);
+    wchar_t line[256];
+    ASSERT_NOT_NULL(fgetws(line, 256, stream), L"A diagnostic should be printed");
+    ASSERT_TRUE(wcsncmp(line, L"types.baa:1:", 12) == 0, L"Printed diagnostics start with the location");
+    fclose(stream);
+
+    baa_type_checker_free(checker);
+    baa_ast_free_node(program);
+    baa_cleanup_lexer(&lexer);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Diagnostics test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running type checker tests...\n\n");
+
+TEST_CASE(test_annotates_valid_program);
+TEST_CASE(test_reports_errors_in_source_order);
+
+wprintf(L"\n✓ All type checker tests completed!\n");
+
+TEST_SUITE_END()
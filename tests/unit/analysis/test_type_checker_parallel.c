@@ -0,0 +1,227 @@
+#include "test_framework.h"
+#include "baa/analysis/type_checker.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_types.h"
+#include "baa/ast/ast_visitor.h"
+#include "baa/lexer/lexer.h"
+#include "baa/parser/parser.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PARALLEL_TEST_UNITS 600
+
+// Appends formatted text to a growing buffer
+static void append(wchar_t **buffer, size_t *length, size_t *capacity, const wchar_t *format, ...)
+{
+    if (*capacity - *length < 512)
+    {
+        *capacity = *capacity ? *capacity * 2 : 4096;
+        *buffer = realloc(*buffer, *capacity * sizeof(wchar_t));
+    }
+    va_list args;
+    va_start(args, format);
+    int written = vswprintf(*buffer + *length, *capacity - *length, format, args);
+    va_end(args);
+    if (written > 0)
+        *length += (size_t)written;
+}
+
+// Globals and functions calling each other; every seventh function has a name
+// error and a type error in its body
+static wchar_t *generate_source(void)
+{
+    wchar_t *source = NULL;
+    size_t length = 0;
+    size_t capacity = 0;
+    for (size_t i = 0; i < PARALLEL_TEST_UNITS; i++)
+    {
+        if (i % 4 == 0)
+        {
+            append(&source, &length, &capacity, L"عدد_صحيح عام_%zu = %zu.\n", i, i);
+            continue;
+        }
+        append(&source, &length, &capacity,
+               L"عدد_حقيقي دالة_%zu(عدد_صحيح أ) {\n"
+               L"    عدد_حقيقي ب = أ * 2 + عام_%zu.\n"
+               L"    إذا (ب > أ) {\n"
+               L"        عدد_صحيح ب = أ %% 3.\n"
+               L"        إرجع دالة_%zu(ب).\n"
+               L"    }\n",
+               i, i - i % 4, i % 4 == 3 ? i - 2 : i + 1);
+        if (i % 7 == 0)
+            append(&source, &length, &capacity, L"    منطقي علم = مجهول_%zu + \"نص\" * %zu.\n", i, i);
+        append(&source, &length, &capacity, L"    إرجع ب.\n}\n");
+    }
+    return source;
+}
+
+static BaaNode *parse_source(const wchar_t *source)
+{
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"parallel.baa");
+    BaaParser *parser = baa_parser_create(&lexer, L"parallel.baa");
+    if (!parser)
+    {
+        baa_cleanup_lexer(&lexer);
+        return NULL;
+    }
+    BaaNode *program = baa_parse_program(parser);
+    bool had_error = baa_parser_had_error(parser);
+    baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
+    if (had_error)
+    {
+        baa_ast_free_node(program);
+        return NULL;
+    }
+    return program;
+}
+
+typedef struct
+{
+    BaaType **types;
+    size_t count;
+    size_t capacity;
+} TypeList;
+
+static BaaAstVisitResult collect_type(BaaNode *node, BaaNode *parent, size_t depth, void *user_data)
+{
+    (void)parent;
+    (void)depth;
+    TypeList *list = (TypeList *)user_data;
+    if (list->count == list->capacity)
+    {
+        list->capacity = list->capacity ? list->capacity * 2 : 1024;
+        list->types = realloc(list->types, list->capacity * sizeof(BaaType *));
+    }
+    list->types[list->count++] = node->resolved_type;
+    return BAA_AST_VISIT_CONTINUE;
+}
+
+// Resolved types of every node, in pre-order
+static TypeList collect_types(BaaNode *program)
+{
+    TypeList list = {0};
+    BaaAstVisitor visitor = {.pre = collect_type, .user_data = &list};
+    baa_ast_walk(program, &visitor);
+    return list;
+}
+
+static bool diagnostics_equal(const BaaTypeChecker *a, const BaaTypeChecker *b)
+{
+    size_t count_a = 0;
+    size_t count_b = 0;
+    const BaaDiagnostic *list_a = baa_type_checker_get_diagnostics(a, &count_a);
+    const BaaDiagnostic *list_b = baa_type_checker_get_diagnostics(b, &count_b);
+    if (count_a != count_b)
+        return false;
+    for (size_t i = 0; i < count_a; i++)
+    {
+        if (list_a[i].location.line != list_b[i].location.line ||
+            list_a[i].location.column != list_b[i].location.column || list_a[i].category != list_b[i].category ||
+            wcscmp(list_a[i].message, list_b[i].message) != 0)
+            return false;
+    }
+    return true;
+}
+
+void test_parallel_matches_sequential(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing that parallel checking gives the sequential results...\n");
+
+    wchar_t *source = generate_source();
+    ASSERT_NOT_NULL(source, L"Source generation failed");
+
+    BaaNode *sequential_program = parse_source(source);
+    ASSERT_NOT_NULL(sequential_program, L"The source should parse");
+    BaaTypeChecker *sequential = baa_type_checker_create();
+    ASSERT_TRUE(!baa_type_check_program(sequential, sequential_program), L"The program has errors");
+    TypeList expected = collect_types(sequential_program);
+
+    // Two errors in each function whose index is a multiple of 7 (and not of 4)
+    size_t erroneous = 0;
+    for (size_t i = 0; i < PARALLEL_TEST_UNITS; i++)
+        erroneous += i % 7 == 0 && i % 4 != 0;
+    ASSERT_EQ((int)(2 * erroneous), (int)baa_type_checker_error_count(sequential));
+
+    // Diagnostics are in source order
+    size_t count = 0;
+    const BaaDiagnostic *diagnostics = baa_type_checker_get_diagnostics(sequential, &count);
+    for (size_t i = 1; i < count; i++)
+        ASSERT_TRUE(diagnostics[i - 1].location.line <= diagnostics[i].location.line,
+                    L"Diagnostics should be in source order");
+
+    const size_t thread_counts[] = {2, 3, 8, 0};
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++)
+    {
+        BaaNode *program = parse_source(source);
+        ASSERT_NOT_NULL(program, L"The source should parse");
+        BaaTypeChecker *checker = baa_type_checker_create();
+        baa_type_checker_set_parallel(checker, thread_counts[t]);
+        ASSERT_TRUE(!baa_type_check_program(checker, program), L"The program has errors");
+
+        ASSERT_TRUE(diagnostics_equal(sequential, checker), L"Diagnostics should not depend on the thread count");
+        ASSERT_EQ((int)baa_type_checker_node_count(sequential), (int)baa_type_checker_node_count(checker));
+        TypeList actual = collect_types(program);
+        ASSERT_EQ((int)expected.count, (int)actual.count);
+        ASSERT_TRUE(memcmp(expected.types, actual.types, expected.count * sizeof(BaaType *)) == 0,
+                    L"Annotations should not depend on the thread count");
+
+        // Calls resolve to the shared global symbols
+        BaaNode *function = ((BaaProgramData *)program->data)->top_level_declarations[1];
+        BaaBlockStmtData *body = (BaaBlockStmtData *)((BaaFunctionDefData *)function->data)->body->data;
+        BaaNode *branch = ((BaaIfStmtData *)body->statements[1]->data)->then_stmt;
+        BaaNode *call = ((BaaReturnStmtData *)((BaaBlockStmtData *)branch->data)->statements[1]->data)->value_expr;
+        BaaNode *callee = ((BaaCallExprData *)call->data)->callee_expr;
+        ASSERT_PTR_EQ(baa_symbol_table_lookup(baa_type_checker_globals(checker), L"دالة_2"),
+                      ((BaaIdentifierExprData *)callee->data)->resolved_symbol);
+
+        free(actual.types);
+        baa_type_checker_free(checker);
+        baa_ast_free_node(program);
+    }
+
+    free(expected.types);
+    baa_type_checker_free(sequential);
+    baa_ast_free_node(sequential_program);
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Parallel check test passed\n");
+}
+
+void test_parallel_small_program(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing parallel checking of programs with few or no bodies...\n");
+
+    const wchar_t *sources[] = {L"عدد_صحيح س = 1.\n",
+                                L"عدد_صحيح د(عدد_صحيح أ) {\n    إرجع أ + ص.\n}\nعدد_صحيح ص = 2.\n"};
+    for (size_t i = 0; i < 2; i++)
+    {
+        BaaNode *program = parse_source(sources[i]);
+        ASSERT_NOT_NULL(program, L"The source should parse");
+        BaaTypeChecker *checker = baa_type_checker_create();
+        baa_type_checker_set_parallel(checker, 4);
+        ASSERT_TRUE(baa_type_check_program(checker, program), L"The program should check");
+        ASSERT_EQ(0, (int)baa_type_checker_error_count(checker));
+        baa_type_checker_free(checker);
+        baa_ast_free_node(program);
+    }
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Small program test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running parallel type checker tests...\n\n");
+
+TEST_CASE(test_parallel_matches_sequential);
+TEST_CASE(test_parallel_small_program);
+
+wprintf(L"\n✓ All parallel type checker tests completed!\n");
+
+TEST_SUITE_END()
@@ -0,0 +1,165 @@
+#include "test_framework.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_types.h"
+#include "baa/ast/ast_arena.h"
+
+static BaaAstSourceSpan test_span(void)
+{
+    BaaAstSourceSpan span = {
+        .start = {.filename = L"test.baa", .line = 1, .column = 1},
+        .end = {.filename = L"test.baa", .line = 1, .column = 10}};
+    return span;
+}
+
+void test_arena_node_allocation(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing node allocation from an active arena...\n");
+
+    BaaAstArena *arena = baa_ast_arena_create();
+    ASSERT_NOT_NULL(arena, L"Arena should be created");
+    ASSERT_NULL(baa_ast_arena_activate(arena), L"No arena should be active initially");
+    ASSERT_TRUE(baa_ast_arena_current() == arena, L"Arena should be active");
+
+    BaaNode *left = baa_ast_new_identifier_expr_node(test_span(), L"س");
+    BaaNode *right = baa_ast_new_literal_int_node(test_span(), 42, NULL);
+    BaaNode *sum = baa_ast_new_binary_expr_node(test_span(), left, right, BAA_BINARY_OP_ADD);
+    ASSERT_NOT_NULL(sum, L"Binary node should be created");
+    ASSERT_TRUE(sum->arena == arena, L"Node should belong to the arena");
+
+    // Node and data share one block
+    ASSERT_TRUE((char *)sum->data > (char *)sum, L"Data should follow the node");
+    ASSERT_TRUE((char *)sum->data - (char *)sum < 2 * (long)sizeof(BaaNode), L"Data should be in the node's block");
+
+    // Freeing an arena node individually is a no-op
+    baa_ast_free_node(sum);
+
+    BaaAstArenaStats stats;
+    baa_ast_arena_get_stats(arena, &stats);
+    ASSERT_EQ(3, (int)stats.node_count);
+    ASSERT_TRUE(stats.bytes_used <= stats.bytes_reserved, L"Usage should fit in the reserved chunks");
+
+    ASSERT_TRUE(baa_ast_arena_activate(NULL) == arena, L"Deactivating should return the arena");
+    BaaNode *heap_node = baa_ast_new_break_stmt_node(test_span());
+    ASSERT_NULL(heap_node->arena, L"Without an arena nodes come from the heap");
+    baa_ast_free_node(heap_node);
+
+    baa_ast_arena_destroy(arena);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Arena node allocation test passed\n");
+}
+
+void test_arena_interning(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing the arena intern pool...\n");
+
+    BaaAstArena *arena = baa_ast_arena_create();
+    baa_ast_arena_activate(arena);
+
+    BaaNode *first = baa_ast_new_identifier_expr_node(test_span(), L"عداد");
+    BaaNode *second = baa_ast_new_identifier_expr_node(test_span(), L"عداد");
+    BaaNode *other = baa_ast_new_identifier_expr_node(test_span(), L"مجموع");
+    const wchar_t *first_name = ((BaaIdentifierExprData *)first->data)->name;
+    ASSERT_TRUE(first_name == ((BaaIdentifierExprData *)second->data)->name, L"Equal names should be shared");
+    ASSERT_TRUE(first_name != ((BaaIdentifierExprData *)other->data)->name, L"Different names should differ");
+    ASSERT_WSTR_EQ(L"عداد", first_name);
+
+    // Prefixes are interned by length
+    const wchar_t *prefix = baa_ast_arena_intern(arena, L"عداد", 2);
+    ASSERT_WSTR_EQ(L"عد", prefix);
+    ASSERT_TRUE(prefix != first_name, L"A prefix is a different string");
+
+    // Enough strings to grow the table
+    wchar_t name[32];
+    for (int i = 0; i < 5000; i++)
+    {
+        swprintf(name, 32, L"م_%d", i);
+        ASSERT_NOT_NULL(baa_ast_arena_intern(arena, name, wcslen(name)), L"Interning should succeed");
+    }
+    ASSERT_TRUE(baa_ast_arena_intern(arena, L"عداد", 4) == first_name, L"Growth should keep canonical pointers");
+
+    BaaAstArenaStats stats;
+    baa_ast_arena_get_stats(arena, &stats);
+    ASSERT_EQ(5003, (int)stats.interned_strings);
+
+    baa_ast_arena_activate(NULL);
+    baa_ast_arena_destroy(arena);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Arena interning test passed\n");
+}
+
+void test_arena_child_arrays(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing child arrays grown in the arena...\n");
+
+    BaaAstArena *arena = baa_ast_arena_create();
+    baa_ast_arena_activate(arena);
+
+    BaaNode *block = baa_ast_new_block_stmt_node(test_span());
+    for (int i = 0; i < 1000; i++)
+    {
+        BaaNode *stmt = baa_ast_new_expr_stmt_node(test_span(), baa_ast_new_literal_int_node(test_span(), i, NULL));
+        ASSERT_TRUE(baa_ast_add_stmt_to_block(block, stmt), L"Statement should be added");
+    }
+
+    BaaBlockStmtData *data = (BaaBlockStmtData *)block->data;
+    ASSERT_EQ(1000, (int)data->count);
+    for (int i = 0; i < 1000; i++)
+    {
+        BaaNode *expr = ((BaaExprStmtData *)data->statements[i]->data)->expression;
+        ASSERT_EQ(i, (int)((BaaLiteralExprData *)expr->data)->value.int_value);
+    }
+
+    baa_ast_arena_activate(NULL);
+    baa_ast_arena_destroy(arena);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Arena child array test passed\n");
+}
+
+void test_program_owns_arena(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing program teardown through its arena...\n");
+
+    BaaNode *program = baa_ast_new_program_node(test_span());
+    BaaAstArena *arena = baa_ast_arena_create();
+    ASSERT_TRUE(baa_ast_program_adopt_arena(program, arena), L"Program should adopt the arena");
+    ASSERT_TRUE(!baa_ast_program_adopt_arena(program, arena), L"Program should own at most one arena");
+
+    baa_ast_arena_activate(arena);
+    for (int i = 0; i < 100; i++)
+    {
+        BaaNode *type = baa_ast_new_primitive_type_node(test_span(), L"عدد_صحيح");
+        BaaNode *init = baa_ast_new_literal_string_node(test_span(), L"نص", NULL);
+        BaaNode *decl = baa_ast_new_var_decl_node(test_span(), L"س", BAA_MOD_NONE, type, init);
+        ASSERT_TRUE(baa_ast_add_declaration_to_program(program, decl), L"Declaration should be added");
+    }
+    baa_ast_arena_activate(NULL);
+
+    ASSERT_NULL(program->arena, L"The program itself is a heap node");
+    ASSERT_EQ(100, (int)((BaaProgramData *)program->data)->count);
+
+    // Releases the arena; the leak checker verifies nothing is left behind
+    baa_ast_free_node(program);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Program arena ownership test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running AST arena tests...\n\n");
+
+TEST_CASE(test_arena_node_allocation);
+TEST_CASE(test_arena_interning);
+TEST_CASE(test_arena_child_arrays);
+TEST_CASE(test_program_owns_arena);
+
+wprintf(L"\n✓ All AST arena tests completed!\n");
+
+TEST_SUITE_END()
@@ -0,0 +1,204 @@
+#include "test_framework.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_types.h"
+#include "baa/ast/ast_flat.h"
+
+static BaaAstSourceSpan test_span(size_t line)
+{
+    BaaAstSourceSpan span = {
+        .start = {.filename = L"test.baa", .line = line, .column = 1},
+        .end = {.filename = L"test.baa", .line = line, .column = 10}};
+    return span;
+}
+
+// عدد_صحيح م[3] = -س.
+// عدد_صحيح جمع(عدد_صحيح س، عدد_صحيح ص) { ... }
+static BaaNode *build_sample_program(void)
+{
+    BaaNode *program = baa_ast_new_program_node(test_span(1));
+
+    BaaNode *element = baa_ast_new_primitive_type_node(test_span(1), L"عدد_صحيح");
+    BaaNode *array = baa_ast_new_array_type_node(test_span(1), element,
+                                                 baa_ast_new_literal_int_node(test_span(1), 3, NULL));
+    BaaNode *negated = baa_ast_new_unary_expr_node(test_span(1), baa_ast_new_identifier_expr_node(test_span(1), L"س"),
+                                                   BAA_UNARY_OP_MINUS);
+    baa_ast_add_declaration_to_program(program,
+                                       baa_ast_new_var_decl_node(test_span(1), L"م", BAA_MOD_CONST, array, negated));
+
+    BaaNode *body = baa_ast_new_block_stmt_node(test_span(3));
+    BaaNode *sum = baa_ast_new_binary_expr_node(test_span(4), baa_ast_new_identifier_expr_node(test_span(4), L"س"),
+                                                baa_ast_new_identifier_expr_node(test_span(4), L"ص"), BAA_BINARY_OP_ADD);
+    BaaNode *call = baa_ast_new_call_expr_node(test_span(5), baa_ast_new_identifier_expr_node(test_span(5), L"اطبع"));
+    baa_ast_add_call_argument(call, baa_ast_new_literal_string_node(test_span(5), L"مرحبا", NULL));
+    baa_ast_add_call_argument(call, baa_ast_new_literal_int_node(test_span(5), -5000000000LL, NULL));
+    baa_ast_add_stmt_to_block(body, baa_ast_new_if_stmt_node(test_span(4), sum,
+                                                             baa_ast_new_expr_stmt_node(test_span(5), call), NULL));
+    BaaNode *loop_body = baa_ast_new_block_stmt_node(test_span(6));
+    baa_ast_add_stmt_to_block(loop_body, baa_ast_new_break_stmt_node(test_span(6)));
+    baa_ast_add_stmt_to_block(loop_body, baa_ast_new_continue_stmt_node(test_span(6)));
+    baa_ast_add_stmt_to_block(body, baa_ast_new_while_stmt_node(
+                                        test_span(6), baa_ast_new_identifier_expr_node(test_span(6), L"س"), loop_body));
+    baa_ast_add_stmt_to_block(body, baa_ast_new_for_stmt_node(test_span(7), NULL, NULL, NULL,
+                                                              baa_ast_new_block_stmt_node(test_span(7))));
+    baa_ast_add_stmt_to_block(body, baa_ast_new_return_stmt_node(test_span(8),
+                                                                 baa_ast_new_literal_int_node(test_span(8), 0, NULL)));
+
+    BaaNode *function = baa_ast_new_function_def_node(test_span(2), L"جمع", BAA_MOD_NONE,
+                                                      baa_ast_new_primitive_type_node(test_span(2), L"عدد_صحيح"),
+                                                      body, false);
+    baa_ast_add_function_parameter(function, baa_ast_new_parameter_node(
+                                                 test_span(2), L"س", baa_ast_new_primitive_type_node(test_span(2), L"عدد_صحيح")));
+    baa_ast_add_function_parameter(function, baa_ast_new_parameter_node(
+                                                 test_span(2), L"ص", baa_ast_new_primitive_type_node(test_span(2), L"عدد_صحيح")));
+    baa_ast_add_declaration_to_program(program, function);
+    return program;
+}
+
+void test_flat_encoding(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing the flat encoding of a program...\n");
+
+    BaaNode *program = build_sample_program();
+    BaaFlatAst *flat = baa_flat_ast_from_tree(program);
+    ASSERT_NOT_NULL(flat, L"Flat AST should be created");
+
+    ASSERT_EQ(32, (int)flat->node_count);
+    ASSERT_EQ((int)flat->node_count - 1, (int)flat->root);
+    ASSERT_EQ(BAA_NODE_KIND_PROGRAM, flat->nodes[flat->root].kind);
+    ASSERT_EQ(2, (int)flat->nodes[flat->root].rhs);
+    ASSERT_EQ(1, (int)flat->file_count);
+    ASSERT_EQ(12, (int)sizeof(BaaFlatNode));
+
+    // Children come before their parents
+    for (size_t i = 0; i < flat->node_count; i++)
+    {
+        const BaaFlatNode *node = &flat->nodes[i];
+        if (node->kind == BAA_NODE_KIND_BINARY_EXPR)
+        {
+            ASSERT_TRUE(node->lhs < i && node->rhs < i, L"Operands should precede the operator");
+            ASSERT_EQ(BAA_BINARY_OP_ADD, node->tag);
+        }
+    }
+
+    // The first declaration is the variable; its name and type are in extra data
+    BaaFlatIndex decl = flat->extra_data[flat->nodes[flat->root].lhs];
+    ASSERT_EQ(BAA_NODE_KIND_VAR_DECL_STMT, flat->nodes[decl].kind);
+    const uint32_t *extra = flat->extra_data + flat->nodes[decl].lhs;
+    ASSERT_WSTR_EQ(L"م", baa_flat_ast_string(flat, extra[0]));
+    ASSERT_EQ(BAA_MOD_CONST, (int)extra[1]);
+    ASSERT_EQ(BAA_TYPE_AST_KIND_ARRAY, flat->nodes[extra[2]].tag);
+    ASSERT_EQ(3, (int)baa_flat_ast_int_value(flat, flat->nodes[extra[2]].rhs));
+
+    // Strings are stored once
+    int identifier_s = 0;
+    uint32_t s_offset = BAA_FLAT_NONE;
+    for (size_t i = 0; i < flat->node_count; i++)
+    {
+        const BaaFlatNode *node = &flat->nodes[i];
+        if (node->kind == BAA_NODE_KIND_IDENTIFIER_EXPR && wcscmp(baa_flat_ast_string(flat, node->lhs), L"س") == 0)
+        {
+            ASSERT_TRUE(s_offset == BAA_FLAT_NONE || s_offset == node->lhs, L"Equal names should share an offset");
+            s_offset = node->lhs;
+            identifier_s++;
+        }
+        if (node->kind == BAA_NODE_KIND_LITERAL_EXPR && node->tag == BAA_LITERAL_KIND_INT &&
+            baa_flat_ast_int_value(flat, (BaaFlatIndex)i) < 0)
+        {
+            ASSERT_TRUE(baa_flat_ast_int_value(flat, (BaaFlatIndex)i) == -5000000000LL, L"64-bit values should survive");
+        }
+    }
+    ASSERT_EQ(3, identifier_s);
+
+    BaaAstSourceSpan span = baa_flat_ast_span(flat, decl);
+    ASSERT_WSTR_EQ(L"test.baa", span.start.filename);
+    ASSERT_EQ(1, (int)span.start.line);
+    ASSERT_EQ(10, (int)span.end.column);
+
+    baa_flat_ast_free(flat);
+    baa_ast_free_node(program);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Flat encoding test passed\n");
+}
+
+void test_flat_round_trip(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing tree -> flat -> tree round trips...\n");
+
+    BaaNode *program = build_sample_program();
+    BaaFlatAst *flat = baa_flat_ast_from_tree(program);
+    BaaNode *rebuilt = baa_flat_ast_to_tree(flat);
+    ASSERT_NOT_NULL(rebuilt, L"Tree should be rebuilt");
+    ASSERT_EQ(BAA_NODE_KIND_PROGRAM, rebuilt->kind);
+
+    BaaFunctionDefData *function = (BaaFunctionDefData *)((BaaProgramData *)rebuilt->data)->top_level_declarations[1]->data;
+    ASSERT_WSTR_EQ(L"جمع", function->name);
+    ASSERT_EQ(2, (int)function->parameter_count);
+    ASSERT_WSTR_EQ(L"ص", ((BaaParameterData *)function->parameters[1]->data)->name);
+    ASSERT_EQ(4, (int)((BaaBlockStmtData *)function->body->data)->count);
+
+    BaaFlatAst *again = baa_flat_ast_from_tree(rebuilt);
+    ASSERT_TRUE(baa_flat_ast_equal(flat, again), L"Re-encoding should give the same flat AST");
+
+    // A changed tree encodes differently
+    ((BaaFunctionDefData *)((BaaProgramData *)program->data)->top_level_declarations[1]->data)->is_variadic = true;
+    BaaFlatAst *changed = baa_flat_ast_from_tree(program);
+    ASSERT_TRUE(!baa_flat_ast_equal(flat, changed), L"Different trees should not compare equal");
+
+    baa_flat_ast_free(changed);
+    baa_flat_ast_free(again);
+    baa_flat_ast_free(flat);
+    baa_ast_free_node(rebuilt);
+    baa_ast_free_node(program);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Flat round trip test passed\n");
+}
+
+void test_flat_deep_tree(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing a deeply nested expression...\n");
+
+    // Arena nodes, so the deep tree is released without a recursive walk
+    BaaAstArena *arena = baa_ast_arena_create();
+    baa_ast_arena_activate(arena);
+
+    const int depth = 100000;
+    BaaNode *expr = baa_ast_new_literal_int_node(test_span(1), 1, NULL);
+    for (int i = 0; i < depth; i++)
+    {
+        expr = baa_ast_new_unary_expr_node(test_span(1), expr, BAA_UNARY_OP_MINUS);
+    }
+
+    BaaFlatAst *flat = baa_flat_ast_from_tree(expr);
+    ASSERT_NOT_NULL(flat, L"Deep trees should be encoded");
+    ASSERT_EQ(depth + 1, (int)flat->node_count);
+    ASSERT_EQ(BAA_NODE_KIND_UNARY_EXPR, flat->nodes[flat->root].kind);
+    ASSERT_EQ((int)flat->root - 1, (int)flat->nodes[flat->root].lhs);
+
+    BaaNode *rebuilt = baa_flat_ast_to_tree(flat);
+    ASSERT_NOT_NULL(rebuilt, L"Deep trees should be rebuilt");
+    ASSERT_TRUE(rebuilt->arena == arena, L"Rebuilt nodes should come from the active arena");
+
+    baa_flat_ast_free(flat);
+    baa_ast_arena_activate(NULL);
+    baa_ast_arena_destroy(arena);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Flat deep tree test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running flat AST tests...\n\n");
+
+TEST_CASE(test_flat_encoding);
+TEST_CASE(test_flat_round_trip);
+TEST_CASE(test_flat_deep_tree);
+
+wprintf(L"\n✓ All flat AST tests completed!\n");
+
+TEST_SUITE_END()
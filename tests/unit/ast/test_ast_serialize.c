@@ -0,0 +1,210 @@
+#include "test_framework.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_types.h"
+#include "baa/ast/ast_flat.h"
+#include "baa/ast/ast_serialize.h"
+#include "baa/types/types.h"
+#include "baa/utils/utils.h"
+#include <stdio.h>
+#include <string.h>
+
+static BaaAstSourceSpan test_span(size_t line)
+{
+    BaaAstSourceSpan span = {
+        .start = {.filename = L"cache.baa", .line = line, .column = 1},
+        .end = {.filename = L"cache.baa", .line = line, .column = 12}};
+    return span;
+}
+
+// ثابت عدد_صحيح م[2] = "نص".
+// عدد_صحيح مربع(عدد_صحيح س) { إرجع س * 3. }  (and a deferred function)
+static BaaNode *build_sample_program(void)
+{
+    BaaNode *program = baa_ast_new_program_node(test_span(1));
+
+    BaaNode *array = baa_ast_new_array_type_node(
+        test_span(1), baa_ast_new_primitive_type_node(test_span(1), L"عدد_صحيح"),
+        baa_ast_new_literal_int_node(test_span(1), 2, baa_get_int_type()));
+    baa_ast_add_declaration_to_program(
+        program, baa_ast_new_var_decl_node(test_span(1), L"م", BAA_MOD_CONST, array,
+                                           baa_ast_new_literal_string_node(test_span(1), L"نص", baa_get_string_type())));
+
+    BaaNode *body = baa_ast_new_block_stmt_node(test_span(3));
+    BaaNode *product = baa_ast_new_binary_expr_node(test_span(3), baa_ast_new_identifier_expr_node(test_span(3), L"س"),
+                                                    baa_ast_new_literal_int_node(test_span(3), 3, baa_get_int_type()),
+                                                    BAA_BINARY_OP_MULTIPLY);
+    baa_ast_add_stmt_to_block(body, baa_ast_new_return_stmt_node(test_span(3), product));
+    BaaNode *function = baa_ast_new_function_def_node(test_span(2), L"مربع", BAA_MOD_NONE,
+                                                      baa_ast_new_primitive_type_node(test_span(2), L"عدد_صحيح"),
+                                                      body, false);
+    baa_ast_add_function_parameter(function, baa_ast_new_parameter_node(
+                                                 test_span(2), L"س", baa_ast_new_primitive_type_node(test_span(2), L"عدد_صحيح")));
+    baa_ast_add_declaration_to_program(program, function);
+
+    baa_ast_add_declaration_to_program(
+        program, baa_ast_new_deferred_function_def_node(test_span(4), L"مؤجلة", BAA_MOD_NONE,
+                                                        baa_ast_new_primitive_type_node(test_span(4), L"فراغ"), 120, 140,
+                                                        true));
+    return program;
+}
+
+static bool trees_equal(const BaaNode *a, const BaaNode *b)
+{
+    BaaFlatAst *flat_a = baa_flat_ast_from_tree(a);
+    BaaFlatAst *flat_b = baa_flat_ast_from_tree(b);
+    bool equal = flat_a && flat_b && baa_flat_ast_equal(flat_a, flat_b);
+    baa_flat_ast_free(flat_a);
+    baa_flat_ast_free(flat_b);
+    return equal;
+}
+
+void test_image_round_trip(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing an in-memory image round trip...\n");
+
+    BaaNode *program = build_sample_program();
+    BaaFlatAst *flat = baa_flat_ast_from_tree(program);
+    ASSERT_NOT_NULL(flat, L"Flat encoding failed");
+    ASSERT_EQ(2, (int)flat->type_count);
+
+    const wchar_t *source = L"مصدر مثال";
+    BaaAstCacheKey key = baa_ast_cache_key(source, wcslen(source), L"cache.baa");
+    size_t size = 0;
+    void *data = baa_ast_serialize(flat, key, &size);
+    ASSERT_NOT_NULL(data, L"Serialization failed");
+    ASSERT_EQ(0, (int)(size % 8));
+
+    BaaAstImage *image = baa_ast_image_from_memory(data, size, &key);
+    ASSERT_NOT_NULL(image, L"A fresh image should load");
+    const BaaFlatAst *loaded = baa_ast_image_flat(image);
+    ASSERT_TRUE((const unsigned char *)loaded->nodes > (const unsigned char *)data &&
+                    (const unsigned char *)loaded->nodes < (const unsigned char *)data + size,
+                L"Nodes should point into the image");
+    ASSERT_TRUE(loaded->types[0] == baa_get_int_type() || loaded->types[0] == baa_get_string_type(),
+                L"Literal types should resolve to the global types");
+    ASSERT_TRUE(baa_flat_ast_equal(flat, loaded), L"The loaded flat AST should match the original");
+
+    BaaNode *rebuilt = baa_flat_ast_to_tree(loaded);
+    ASSERT_NOT_NULL(rebuilt, L"Rebuilding from the image failed");
+    ASSERT_TRUE(trees_equal(program, rebuilt), L"The rebuilt tree should match the original");
+    baa_ast_free_node(rebuilt);
+
+    // Another key is a miss
+    BaaAstCacheKey other = baa_ast_cache_key(source, wcslen(source), L"other.baa");
+    ASSERT_TRUE(other.hash != key.hash, L"The filename should be part of the key");
+    ASSERT_NULL(baa_ast_image_from_memory(data, size, &other), L"A stale image should be rejected");
+
+    baa_ast_image_free(image);
+    baa_free(data);
+    baa_flat_ast_free(flat);
+    baa_ast_free_node(program);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Image round trip test passed\n");
+}
+
+void test_image_rejects_invalid_data(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing that damaged or foreign images are rejected...\n");
+
+    BaaNode *program = build_sample_program();
+    BaaFlatAst *flat = baa_flat_ast_from_tree(program);
+    BaaAstCacheKey key = baa_ast_cache_key(L"س", 1, NULL);
+    size_t size = 0;
+    unsigned char *data = (unsigned char *)baa_ast_serialize(flat, key, &size);
+    ASSERT_NOT_NULL(data, L"Serialization failed");
+
+    // Truncated
+    ASSERT_NULL(baa_ast_image_from_memory(data, size - 8, NULL), L"A truncated image should be rejected");
+
+    // Payload corruption is caught by the checksum
+    data[size - 1] ^= 0x40;
+    ASSERT_NULL(baa_ast_image_from_memory(data, size, NULL), L"A corrupted image should be rejected");
+    data[size - 1] ^= 0x40;
+
+    // Another format version (the version follows the 8-byte magic)
+    uint32_t version;
+    memcpy(&version, data + 8, sizeof(version));
+    ASSERT_EQ(BAA_AST_IMAGE_VERSION, version);
+    version++;
+    memcpy(data + 8, &version, sizeof(version));
+    ASSERT_NULL(baa_ast_image_from_memory(data, size, NULL), L"Another version should be rejected");
+    version--;
+    memcpy(data + 8, &version, sizeof(version));
+
+    data[0] = 'X';
+    ASSERT_NULL(baa_ast_image_from_memory(data, size, NULL), L"A bad magic should be rejected");
+    data[0] = 'B';
+    BaaAstImage *image = baa_ast_image_from_memory(data, size, NULL);
+    ASSERT_NOT_NULL(image, L"The restored image should load again");
+    ASSERT_EQ(1, (int)baa_ast_image_key(image).length);
+    baa_ast_image_free(image);
+    baa_free(data);
+
+    // Array literal types are not stored
+    BaaType *array_type = baa_create_array_type(baa_get_int_type(), 2);
+    BaaNode *literal = baa_ast_new_literal_int_node(test_span(1), 1, array_type);
+    BaaFlatAst *array_flat = baa_flat_ast_from_tree(literal);
+    ASSERT_NULL(baa_ast_serialize(array_flat, key, &size), L"Array literal types should not be serialized");
+    baa_flat_ast_free(array_flat);
+    baa_ast_free_node(literal);
+    baa_free_type(array_type);
+
+    baa_flat_ast_free(flat);
+    baa_ast_free_node(program);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Invalid image test passed\n");
+}
+
+void test_cache_directory(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing the on-disk AST cache...\n");
+
+    const wchar_t *source = L"عدد_صحيح م = 1.";
+    BaaAstCacheKey key = baa_ast_cache_key(source, wcslen(source), L"cache.baa");
+    char path[512];
+    ASSERT_TRUE(baa_ast_cache_path(".", key, path, sizeof(path)) < sizeof(path), L"Cache path should fit");
+    remove(path);
+
+    BaaAstImage *image = NULL;
+    ASSERT_NULL(baa_ast_cache_load(".", key, &image), L"An empty cache should miss");
+    ASSERT_NULL(image, L"A miss should not return an image");
+
+    BaaNode *program = build_sample_program();
+    ASSERT_TRUE(baa_ast_cache_store(".", key, program), L"Storing the tree failed");
+
+    BaaNode *cached = baa_ast_cache_load(".", key, &image);
+    ASSERT_NOT_NULL(cached, L"The stored unit should hit");
+    ASSERT_NOT_NULL(image, L"A hit should return its image");
+    ASSERT_EQ(BAA_NODE_KIND_PROGRAM, cached->kind);
+    ASSERT_TRUE(trees_equal(program, cached), L"The cached tree should match the original");
+    ASSERT_TRUE(wcscmp(cached->span.start.filename, L"cache.baa") == 0, L"Spans should keep their filename");
+    baa_ast_free_node(cached);
+    baa_ast_image_free(image);
+
+    // A changed source has another key
+    BaaAstCacheKey changed = baa_ast_cache_key(L"عدد_صحيح م = 2.", wcslen(source), L"cache.baa");
+    ASSERT_NULL(baa_ast_cache_load(".", changed, &image), L"A changed unit should miss");
+
+    remove(path);
+    baa_ast_free_node(program);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ AST cache test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running AST image tests...\n\n");
+
+TEST_CASE(test_image_round_trip);
+TEST_CASE(test_image_rejects_invalid_data);
+TEST_CASE(test_cache_directory);
+
+wprintf(L"\n✓ All AST image tests completed!\n");
+
+TEST_SUITE_END()
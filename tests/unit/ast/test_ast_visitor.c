@@ -0,0 +1,167 @@
+#include "test_framework.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_types.h"
+#include "baa/ast/ast_visitor.h"
+
+#define MAX_EVENTS 64
+
+typedef struct
+{
+    BaaNodeKind pre[MAX_EVENTS];
+    BaaNodeKind post[MAX_EVENTS];
+    size_t pre_count;
+    size_t post_count;
+    size_t max_depth;
+    BaaNodeKind skip_kind;   // Children of this kind are skipped (BAA_NODE_KIND_UNKNOWN for none)
+    size_t abort_after;      // Abort when this many nodes were entered (0 for never)
+} VisitLog;
+
+static BaaAstSourceSpan test_span(void)
+{
+    BaaAstSourceSpan span = {
+        .start = {.filename = L"test.baa", .line = 1, .column = 1},
+        .end = {.filename = L"test.baa", .line = 1, .column = 10}};
+    return span;
+}
+
+static BaaAstVisitResult log_pre(BaaNode *node, BaaNode *parent, size_t depth, void *user_data)
+{
+    (void)parent;
+    VisitLog *log = (VisitLog *)user_data;
+    if (log->pre_count < MAX_EVENTS)
+        log->pre[log->pre_count] = node->kind;
+    log->pre_count++;
+    if (depth > log->max_depth)
+        log->max_depth = depth;
+    if (log->abort_after && log->pre_count == log->abort_after)
+        return BAA_AST_VISIT_ABORT;
+    return node->kind == log->skip_kind ? BAA_AST_VISIT_SKIP_CHILDREN : BAA_AST_VISIT_CONTINUE;
+}
+
+static BaaAstVisitResult log_post(BaaNode *node, BaaNode *parent, size_t depth, void *user_data)
+{
+    (void)parent;
+    (void)depth;
+    VisitLog *log = (VisitLog *)user_data;
+    if (log->post_count < MAX_EVENTS)
+        log->post[log->post_count] = node->kind;
+    log->post_count++;
+    return BAA_AST_VISIT_CONTINUE;
+}
+
+// إذا (س + 1) { إرجع. }  -- with an absent else branch
+static BaaNode *build_if_statement(void)
+{
+    BaaNode *sum = baa_ast_new_binary_expr_node(test_span(), baa_ast_new_identifier_expr_node(test_span(), L"س"),
+                                                baa_ast_new_literal_int_node(test_span(), 1, NULL), BAA_BINARY_OP_ADD);
+    BaaNode *block = baa_ast_new_block_stmt_node(test_span());
+    baa_ast_add_stmt_to_block(block, baa_ast_new_return_stmt_node(test_span(), NULL));
+    return baa_ast_new_if_stmt_node(test_span(), sum, block, NULL);
+}
+
+void test_visit_order(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing pre- and post-order visits...\n");
+
+    BaaNode *stmt = build_if_statement();
+    VisitLog log = {0};
+    BaaAstVisitor visitor = {log_pre, log_post, &log};
+    ASSERT_TRUE(baa_ast_walk(stmt, &visitor), L"Walk should complete");
+
+    BaaNodeKind expected_pre[] = {BAA_NODE_KIND_IF_STMT, BAA_NODE_KIND_BINARY_EXPR, BAA_NODE_KIND_IDENTIFIER_EXPR,
+                                  BAA_NODE_KIND_LITERAL_EXPR, BAA_NODE_KIND_BLOCK_STMT, BAA_NODE_KIND_RETURN_STMT};
+    BaaNodeKind expected_post[] = {BAA_NODE_KIND_IDENTIFIER_EXPR, BAA_NODE_KIND_LITERAL_EXPR, BAA_NODE_KIND_BINARY_EXPR,
+                                   BAA_NODE_KIND_RETURN_STMT, BAA_NODE_KIND_BLOCK_STMT, BAA_NODE_KIND_IF_STMT};
+    ASSERT_EQ(6, (int)log.pre_count);
+    ASSERT_EQ(6, (int)log.post_count);
+    for (int i = 0; i < 6; i++)
+    {
+        ASSERT_EQ(expected_pre[i], log.pre[i]);
+        ASSERT_EQ(expected_post[i], log.post[i]);
+    }
+    ASSERT_EQ(2, (int)log.max_depth);
+
+    // Child slots include the absent else branch
+    ASSERT_EQ(3, (int)baa_ast_child_count(stmt));
+    ASSERT_NULL(baa_ast_child(stmt, 2), L"Absent else branch should be NULL");
+    ASSERT_NULL(baa_ast_child(stmt, 3), L"Out-of-range slot should be NULL");
+
+    baa_ast_free_node(stmt);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Visit order test passed\n");
+}
+
+void test_visit_skip_and_abort(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing skip-children and abort...\n");
+
+    BaaNode *stmt = build_if_statement();
+
+    VisitLog skip = {0};
+    skip.skip_kind = BAA_NODE_KIND_BINARY_EXPR;
+    BaaAstVisitor skipper = {log_pre, log_post, &skip};
+    ASSERT_TRUE(baa_ast_walk(stmt, &skipper), L"Skipping should not stop the walk");
+    ASSERT_EQ(4, (int)skip.pre_count);
+    ASSERT_EQ(4, (int)skip.post_count);
+    ASSERT_EQ(BAA_NODE_KIND_BINARY_EXPR, skip.post[0]);
+
+    VisitLog stop = {0};
+    stop.abort_after = 3;
+    BaaAstVisitor aborter = {log_pre, log_post, &stop};
+    ASSERT_TRUE(!baa_ast_walk(stmt, &aborter), L"Abort should be reported");
+    ASSERT_EQ(3, (int)stop.pre_count);
+    ASSERT_EQ(0, (int)stop.post_count);
+
+    // Post-only visitors work too
+    VisitLog post_only = {0};
+    BaaAstVisitor post_visitor = {NULL, log_post, &post_only};
+    ASSERT_TRUE(baa_ast_walk(stmt, &post_visitor), L"Post-only walk should complete");
+    ASSERT_EQ(6, (int)post_only.post_count);
+
+    baa_ast_free_node(stmt);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Skip and abort test passed\n");
+}
+
+void test_visit_deep_tree(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing walks over a deeply nested heap tree...\n");
+
+    // Deep enough to overflow a recursive walk; also exercises baa_ast_free_node
+    const int depth = 200000;
+    BaaNode *expr = baa_ast_new_identifier_expr_node(test_span(), L"س");
+    for (int i = 0; i < depth; i++)
+    {
+        BaaNode *rhs = baa_ast_new_literal_int_node(test_span(), i, NULL);
+        expr = baa_ast_new_binary_expr_node(test_span(), expr, rhs, BAA_BINARY_OP_ADD);
+    }
+
+    VisitLog log = {0};
+    BaaAstVisitor visitor = {log_pre, log_post, &log};
+    ASSERT_TRUE(baa_ast_walk(expr, &visitor), L"Deep walk should complete");
+    ASSERT_EQ(2 * depth + 1, (int)log.pre_count);
+    ASSERT_EQ(2 * depth + 1, (int)log.post_count);
+    ASSERT_EQ(depth, (int)log.max_depth);
+
+    baa_ast_free_node(expr);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Deep tree walk test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running AST visitor tests...\n\n");
+
+TEST_CASE(test_visit_order);
+TEST_CASE(test_visit_skip_and_abort);
+TEST_CASE(test_visit_deep_tree);
+
+wprintf(L"\n✓ All AST visitor tests completed!\n");
+
+TEST_SUITE_END()
@@ -37,6 +37,75 @@ void test_operator_init(void) {
     printf("Operator initialization tests passed.\n");
 }
 
+// Test symbol lookup for one- and two-character operators
+void test_operator_symbols(void) {
+    printf("Testing operator symbol lookup...\n");
+
+    assert(baa_get_operator_from_symbol(L"<") == BAA_OP_LT);
+    assert(baa_get_operator_from_symbol(L"<=") == BAA_OP_LE);
+    assert(baa_get_operator_from_symbol(L"=") == BAA_OP_ASSIGN);
+    assert(baa_get_operator_from_symbol(L"!=") == BAA_OP_NE);
+    assert(baa_get_operator_from_symbol(L"%=") == BAA_OP_MOD_ASSIGN);
+    assert(baa_get_operator_from_symbol(L"&&") == BAA_OP_AND);
+    assert(baa_get_operator_from_symbol(L"&") == BAA_OP_NONE);
+    assert(baa_get_operator_from_symbol(L"<<=") == BAA_OP_NONE);
+    assert(baa_get_operator_from_symbol(L"ج") == BAA_OP_NONE);
+    assert(baa_get_operator_from_symbol(L"") == BAA_OP_NONE);
+
+    // Every operator with info is found from its own symbol
+    for (int op = 0; op < BAA_OP_NONE; op++) {
+        const BaaOperatorInfo* info = baa_get_operator_info((BaaOperatorType)op);
+        if (info) {
+            assert(info->type == (BaaOperatorType)op);
+            assert(baa_get_operator_from_symbol(info->symbol) == (BaaOperatorType)op);
+        }
+    }
+
+    assert(baa_get_operator_from_name(L"سالب") == BAA_OP_SUB);
+    assert(baa_get_operator_from_name(L"طرح") == BAA_OP_SUB);
+
+    printf("Operator symbol lookup tests passed.\n");
+}
+
+// Test the operand type rules
+void test_operator_type_rules(void) {
+    printf("Testing operator type rules...\n");
+
+    BaaType* result = NULL;
+    assert(baa_validate_binary_op(BAA_OP_ADD, baa_type_int, baa_type_int, &result) && result == baa_type_int);
+    assert(baa_validate_binary_op(BAA_OP_MUL, baa_type_int, baa_type_float, &result) && result == baa_type_float);
+    assert(baa_validate_binary_op(BAA_OP_LT, baa_type_float, baa_type_int, &result) && result == baa_type_int);
+    assert(!baa_validate_binary_op(BAA_OP_ADD, baa_type_void, baa_type_int, &result) && result == baa_type_error);
+    assert(!baa_validate_binary_op(BAA_OP_ADD, baa_type_float, baa_type_string, &result));
+
+    // Modulo takes ints only; logical operators take ints and booleans
+    assert(baa_validate_binary_op(BAA_OP_MOD, baa_type_int, baa_type_int, &result) && result == baa_type_int);
+    assert(!baa_validate_binary_op(BAA_OP_MOD, baa_type_float, baa_type_int, &result));
+    assert(baa_validate_binary_op(BAA_OP_AND, baa_type_bool, baa_type_int, &result) && result == baa_type_int);
+    assert(!baa_validate_binary_op(BAA_OP_OR, baa_type_float, baa_type_int, &result));
+
+    // Mixed arithmetic converts the int operand
+    const BaaOperatorTypeRule* rule = baa_get_binary_op_rule(BAA_OP_SUB, BAA_TYPE_INT, BAA_TYPE_FLOAT);
+    assert(rule->valid && rule->left_convert == BAA_TYPE_FLOAT && rule->right_convert == BAA_TYPE_FLOAT);
+
+    // Assignment keeps the target's own type
+    BaaType* array = baa_create_array_type(baa_type_int, 3);
+    assert(baa_validate_binary_op(BAA_OP_ASSIGN, array, array, &result) && result == array);
+    assert(baa_validate_binary_op(BAA_OP_ASSIGN, baa_type_float, baa_type_int, &result) && result == baa_type_float);
+    assert(!baa_validate_binary_op(BAA_OP_ASSIGN, baa_type_int, baa_type_float, &result));
+
+    assert(baa_validate_unary_op(BAA_OP_SUB, baa_type_float, &result) && result == baa_type_float);
+    assert(baa_validate_unary_op(BAA_OP_NOT, baa_type_int, &result) && result == baa_type_int);
+    assert(baa_validate_unary_op(BAA_OP_NOT, baa_type_bool, &result) && result == baa_type_int);
+    assert(!baa_validate_unary_op(BAA_OP_NOT, baa_type_string, &result) && result == baa_type_error);
+
+    // Out-of-range arguments give an invalid rule
+    assert(!baa_get_binary_op_rule(BAA_OP_NONE, BAA_TYPE_INT, BAA_TYPE_INT)->valid);
+    assert(!baa_get_unary_op_rule(BAA_OP_ADD, BAA_TYPE_KIND_COUNT)->valid);
+
+    printf("Operator type rule tests passed.\n");
+}
+
 /* // Temporarily comment out tests using undeclared functions
 // Test arithmetic operator type checking
 void test_arithmetic_operators(void) {
@@ -169,6 +238,8 @@ TEST_SUITE_BEGIN()
     baa_init_type_system(); // Initialize types first
 
     TEST_CASE(test_operator_init);
+    TEST_CASE(test_operator_symbols);
+    TEST_CASE(test_operator_type_rules);
     // TEST_CASE(test_arithmetic_operators); // Commented out
     // TEST_CASE(test_comparison_operators); // Commented out
     // TEST_CASE(test_assignment_operator); // Commented out
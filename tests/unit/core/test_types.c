@@ -66,6 +66,47 @@ void test_type_comparison(void)
     printf("Type comparison tests passed.\n");
 }
 
+// Test canonical (hash-consed) array types
+void test_array_type_interning(void)
+{
+    printf("Testing canonical array types...\n");
+
+    size_t table_size = baa_type_table_size();
+    BaaType *ints = baa_create_array_type(baa_type_int, 4);
+    assert(ints != NULL);
+    assert(ints->is_canonical);
+    assert(baa_get_array_element_type(ints) == baa_type_int);
+    assert(baa_get_array_size(ints) == 4);
+
+    // Structurally equal types are the same pointer and are only created once
+    assert(baa_create_array_type(baa_type_int, 4) == ints);
+    assert(baa_type_table_size() == table_size + 1);
+    assert(baa_types_equal(ints, baa_create_array_type(baa_get_int_type(), 4)));
+
+    // Element type and size both tell array types apart
+    BaaType *floats = baa_create_array_type(baa_type_float, 4);
+    BaaType *longer = baa_create_array_type(baa_type_int, 5);
+    assert(floats != ints && longer != ints);
+    assert(!baa_types_equal(ints, floats));
+    assert(!baa_types_equal(ints, longer));
+
+    // Nested arrays are keyed by their canonical element type
+    BaaType *matrix = baa_create_array_type(ints, 2);
+    assert(baa_create_array_type(baa_create_array_type(baa_type_int, 4), 2) == matrix);
+    assert(baa_type_table_size() == table_size + 4);
+
+    // Canonical types are never freed
+    baa_free_type(ints);
+    assert(baa_create_array_type(baa_type_int, 4) == ints);
+
+    // Standalone types still compare structurally
+    BaaType *standalone = baa_create_type(BAA_TYPE_INT, L"عدد_صحيح", baa_type_int->size, true);
+    assert(baa_types_equal(standalone, baa_type_int));
+    baa_free_type(standalone);
+
+    printf("Canonical array type tests passed.\n");
+}
+
 // Test type conversion rules
 void test_type_conversion(void)
 {
@@ -108,6 +149,7 @@ int main(void)
     test_type_creation();
     test_type_system_init();
     test_type_comparison();
+    test_array_type_interning();
     test_type_conversion();
     test_type_to_string();
 
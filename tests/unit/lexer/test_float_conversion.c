@@ -0,0 +1,212 @@
+#include "test_framework.h"
+#include "baa/lexer/lexer.h"
+#include <wchar.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+
+// Default number of random literals; set BAA_FLOAT_TEST_ITERATIONS for longer runs
+#define DEFAULT_RANDOM_ITERATIONS 200000
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+// xorshift64*: deterministic so failures are reproducible
+static uint64_t next_random(void)
+{
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+static bool same_bits(double a, double b)
+{
+    return memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+static double baa_value_of(const wchar_t *text)
+{
+    BaaLiteralValue value;
+    BaaNumberError error = baa_parse_number_value(text, wcslen(text), &value);
+    if (error != BAA_NUM_SUCCESS || !(value.flags & BAA_LITERAL_FLAG_FLOAT))
+        return -1.0;
+    return value.float_value;
+}
+
+void test_known_hard_cases(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing hard float conversion cases...\n");
+
+    struct
+    {
+        const wchar_t *baa;
+        const char *c;
+    } cases[] = {
+        {L"0.1", "0.1"},
+        {L"٠٫١", "0.1"},
+        {L"9007199254740993.0", "9007199254740993"},  // Halfway, rounds to even
+        {L"9007199254740995.0", "9007199254740995"},  // Halfway, rounds up to even
+        {L"2.2250738585072014أ-308", "2.2250738585072014e-308"}, // Smallest normal
+        {L"2.2250738585072011أ-308", "2.2250738585072011e-308"}, // Largest subnormal region
+        {L"4.9406564584124654أ-324", "4.9406564584124654e-324"}, // Smallest subnormal
+        {L"2.4703282292062327أ-324", "2.4703282292062327e-324"}, // Just below half of it
+        {L"2.4703282292062328أ-324", "2.4703282292062328e-324"}, // Just above half of it
+        {L"1.7976931348623157أ308", "1.7976931348623157e308"},   // Largest double
+        {L"1.7976931348623159أ308", "1.7976931348623159e308"},   // Overflows to infinity
+        {L"1أ-400", "1e-400"},
+        {L"1أ400", "1e400"},
+        {L"0.1000000000000000055511151231257827021181583404541015625",
+         "0.1000000000000000055511151231257827021181583404541015625"},
+        {L"7.2057594037927933أ16", "7.2057594037927933e16"},
+        {L"123456789012345678901234567890.0", "123456789012345678901234567890"},
+        {L"1_234.567_8أ1_0", "1234.5678e10"},
+        {L"٣٫١٤١٥٩٢٦٥٣٥٨٩٧٩٣٢٣٨٤٦٢٦٤٣٣٨٣٢٧٩٥", "3.14159265358979323846264338327950"},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        double expected = strtod(cases[i].c, NULL);
+        double actual = baa_value_of(cases[i].baa);
+        if (!same_bits(expected, actual))
+            wprintf(L"  Mismatch for %ls: expected %.17g, got %.17g\n", cases[i].baa, expected, actual);
+        ASSERT_TRUE(same_bits(expected, actual), L"Conversion must match strtod exactly");
+    }
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Hard float conversion cases test passed\n");
+}
+
+void test_long_literals(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing literals with more digits than the slow path keeps...\n");
+
+    // Halfway between two doubles plus a trailing 1: only the dropped digits decide
+    // the rounding. 700 zeros fit in the slow path buffer; the others set its sticky digit.
+    const size_t zero_counts[] = {700, 790, 1000, 2000};
+    size_t capacity = 2100;
+    wchar_t *baa = malloc(capacity * sizeof(wchar_t));
+    char *c = malloc(capacity);
+    ASSERT_NOT_NULL(baa, L"Allocation should succeed");
+    ASSERT_NOT_NULL(c, L"Allocation should succeed");
+
+    for (size_t i = 0; i < sizeof(zero_counts) / sizeof(zero_counts[0]); i++)
+    {
+        for (int fraction = 0; fraction < 2; fraction++)
+        {
+            size_t zeros = zero_counts[i];
+            size_t n = (size_t)swprintf(baa, capacity, fraction ? L"0٫9007199254740993" : L"9007199254740993");
+            size_t m = (size_t)snprintf(c, capacity, fraction ? "0.9007199254740993" : "9007199254740993");
+            for (size_t z = 0; z < zeros; z++)
+            {
+                baa[n++] = L'0';
+                c[m++] = '0';
+            }
+            if (fraction)
+            {
+                swprintf(baa + n, capacity - n, L"1أ16");
+                snprintf(c + m, capacity - m, "1e16");
+            }
+            else
+            {
+                swprintf(baa + n, capacity - n, L"1أ-%zu", zeros + 1);
+                snprintf(c + m, capacity - m, "1e-%zu", zeros + 1);
+            }
+
+            double expected = strtod(c, NULL);
+            double actual = baa_value_of(baa);
+            if (!same_bits(expected, actual))
+                wprintf(L"  Mismatch with %zu zeros: expected %.17g, got %.17g\n", zeros, expected, actual);
+            ASSERT_TRUE(same_bits(expected, actual), L"Conversion must match strtod exactly");
+        }
+    }
+
+    free(baa);
+    free(c);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Long float literal test passed\n");
+}
+
+// Builds a random literal in Baa syntax and the equivalent C literal for strtod
+static void random_literal(wchar_t *baa, size_t baa_size, char *c, size_t c_size)
+{
+    int digit_count = 1 + (int)(next_random() % 25);
+    int point = (int)(next_random() % (digit_count + 1)); // Digits before the decimal point
+    int exponent = (int)(next_random() % 700) - 350;
+    bool arabic = next_random() % 2 == 0;
+    bool arabic_separator = next_random() % 2 == 0;
+
+    char digits[32];
+    for (int i = 0; i < digit_count; i++)
+        digits[i] = (char)('0' + next_random() % 10);
+    digits[digit_count] = '\0';
+
+    // strtod gets an integer significand so no decimal point (and no locale) is involved
+    snprintf(c, c_size, "%se%d", digits, exponent - (digit_count - point));
+
+    size_t n = 0;
+    if (point == 0)
+        baa[n++] = L'0';
+    for (int i = 0; i < digit_count; i++)
+    {
+        if (i == point)
+            baa[n++] = arabic_separator ? L'٫' : L'.';
+        else if (i > 0 && next_random() % 8 == 0)
+            baa[n++] = L'_';
+        int d = digits[i] - '0';
+        baa[n++] = arabic ? (wchar_t)(0x0660 + d) : (wchar_t)(L'0' + d);
+    }
+    if (point == digit_count)
+    {
+        baa[n++] = arabic_separator ? L'٫' : L'.';
+        baa[n++] = arabic ? (wchar_t)0x0660 : L'0';
+    }
+    swprintf(baa + n, baa_size - n, L"أ%d", exponent);
+}
+
+void test_random_against_strtod(void)
+{
+    TEST_SETUP();
+
+    size_t iterations = DEFAULT_RANDOM_ITERATIONS;
+    const char *env = getenv("BAA_FLOAT_TEST_ITERATIONS");
+    if (env && atol(env) > 0)
+        iterations = (size_t)atol(env);
+    wprintf(L"Testing %zu random literals against strtod...\n", iterations);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < iterations; i++)
+    {
+        wchar_t baa[96];
+        char c[64];
+        random_literal(baa, sizeof(baa) / sizeof(baa[0]), c, sizeof(c));
+
+        double expected = strtod(c, NULL);
+        double actual = baa_value_of(baa);
+        if (!same_bits(expected, actual))
+        {
+            if (mismatches < 10)
+                wprintf(L"  Mismatch for %ls (%hs): expected %.17g, got %.17g\n", baa, c, expected, actual);
+            mismatches++;
+        }
+    }
+    ASSERT_EQ(0, (int)mismatches);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Random float conversion test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running float literal conversion tests...\n\n");
+
+TEST_CASE(test_known_hard_cases);
+TEST_CASE(test_long_literals);
+TEST_CASE(test_random_against_strtod);
+
+wprintf(L"\n✓ All float literal conversion tests completed!\n");
+
+TEST_SUITE_END()
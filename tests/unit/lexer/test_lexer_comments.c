@@ -32,6 +32,8 @@ BaaToken** get_all_tokens(const wchar_t* source, size_t* token_count)
         }
     }
     
+    baa_cleanup_lexer(&lexer);
+    
     return tokens;
 }
 
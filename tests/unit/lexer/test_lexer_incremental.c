@@ -0,0 +1,274 @@
+#include "test_framework.h"
+#include "baa/lexer/lexer_incremental.h"
+#include <wchar.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+static uint64_t rng_state = 0x2545F4914F6CDD1DULL;
+
+// xorshift64*: deterministic so failures are reproducible
+static uint64_t next_random(void)
+{
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+static const wchar_t *BASE_SOURCE =
+    L"// برنامج تجريبي\n"
+    L"عدد_صحيح س = 10.\n"
+    L"عشري ص = ٣٫١٤أ2.\n"
+    L"/* تعليق\n متعدد الأسطر */\n"
+    L"حرف ح = 'أ'.\n"
+    L"عدد_صحيح رئيسية() {\n"
+    L"    إذا (س >= 0x1F) {\n"
+    L"        اطبع(\"مرحبا\\س\").\n"
+    L"    }\n"
+    L"    نص ن = \"\"\"سطر\nآخر\"\"\".\n"
+    L"    إرجع س + 1_000 * 2.5ح.\n"
+    L"}\n";
+
+// Compares two token buffers token by token, including lexemes and literal values
+static bool buffers_equal(const BaaTokenBuffer *a, const BaaTokenBuffer *b)
+{
+    if (a->count != b->count || a->extra_count != b->extra_count || a->error_count != b->error_count)
+        return false;
+
+    for (size_t i = 0; i < a->count; i++)
+    {
+        if (a->kinds[i] != b->kinds[i] || a->offsets[i] != b->offsets[i] || a->lengths[i] != b->lengths[i])
+            return false;
+
+        size_t length_a, length_b;
+        const wchar_t *lexeme_a = baa_token_buffer_lexeme(a, i, &length_a);
+        const wchar_t *lexeme_b = baa_token_buffer_lexeme(b, i, &length_b);
+        if (length_a != length_b || wmemcmp(lexeme_a, lexeme_b, length_a) != 0)
+            return false;
+
+        const BaaLiteralValue *literal_a = baa_token_buffer_literal(a, i);
+        const BaaLiteralValue *literal_b = baa_token_buffer_literal(b, i);
+        if ((literal_a == NULL) != (literal_b == NULL))
+            return false;
+        if (literal_a && (literal_a->int_value != literal_b->int_value || literal_a->flags != literal_b->flags))
+            return false;
+
+        const BaaLexerError *error_a = baa_token_buffer_error(a, i);
+        const BaaLexerError *error_b = baa_token_buffer_error(b, i);
+        if ((error_a == NULL) != (error_b == NULL))
+            return false;
+        if (error_a && (error_a->error_code != error_b->error_code || error_a->position != error_b->position))
+            return false;
+    }
+    return true;
+}
+
+void test_apply_edit(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing baa_source_apply_edit...\n");
+
+    BaaSourceEdit edit = {2, 3, L"XY", 2};
+    wchar_t *result = baa_source_apply_edit(L"abcdefg", 7, &edit);
+    ASSERT_NOT_NULL(result, L"Edit should apply");
+    ASSERT_WSTR_EQ(L"abXYfg", result);
+    free(result);
+
+    BaaSourceEdit bad = {5, 4, NULL, 0};
+    ASSERT_NULL(baa_source_apply_edit(L"abcdefg", 7, &bad), L"Out-of-range edit should fail");
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ baa_source_apply_edit test passed\n");
+}
+
+void test_small_edit_small_range(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing that a small edit re-lexes a small range...\n");
+
+    // Many copies of the base program, then change one identifier in the middle
+    size_t base_length = wcslen(BASE_SOURCE);
+    size_t copies = 200;
+    wchar_t *source = malloc((base_length * copies + 1) * sizeof(wchar_t));
+    ASSERT_NOT_NULL(source, L"Allocation should succeed");
+    for (size_t i = 0; i < copies; i++)
+        wmemcpy(source + i * base_length, BASE_SOURCE, base_length);
+    source[base_length * copies] = L'\0';
+
+    BaaTokenBuffer buffer;
+    ASSERT_TRUE(baa_lex_all(source, &buffer), L"Initial lex should succeed");
+    size_t total = buffer.count;
+
+    const wchar_t *needle = wcsstr(source + base_length * (copies / 2), L"س = 10");
+    ASSERT_NOT_NULL(needle, L"Edit target should exist");
+    BaaSourceEdit edit = {(size_t)(needle - source), 1, L"متغير", 5};
+    wchar_t *edited = baa_source_apply_edit(source, base_length * copies, &edit);
+    ASSERT_NOT_NULL(edited, L"Edit should apply");
+
+    BaaTokenRange range;
+    ASSERT_TRUE(baa_relex_incremental(&buffer, edited, &edit, &range), L"Incremental relex should succeed");
+    ASSERT_TRUE(range.old_count <= 4 && range.new_count <= 4, L"Changed range should stay local");
+    ASSERT_TRUE(range.first > total / 4, L"Tokens before the edit should be reused");
+    ASSERT_EQ((int)total, (int)buffer.count);
+
+    BaaTokenBuffer expected;
+    ASSERT_TRUE(baa_lex_all(edited, &expected), L"Full lex should succeed");
+    ASSERT_TRUE(buffers_equal(&expected, &buffer), L"Incremental result should match a full lex");
+
+    baa_token_buffer_free(&expected);
+    baa_token_buffer_free(&buffer);
+    free(edited);
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Small edit range test passed\n");
+}
+
+void test_error_tokens_reused(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing that error tokens are reused after an edit...\n");
+
+    // An invalid character near the top, then many copies of the base program
+    size_t base_length = wcslen(BASE_SOURCE);
+    size_t copies = 50;
+    const wchar_t *prefix = L"عدد_صحيح خطأ = 1 @ 2.\n";
+    size_t prefix_length = wcslen(prefix);
+    size_t length = prefix_length + base_length * copies;
+    wchar_t *source = malloc((length + 1) * sizeof(wchar_t));
+    ASSERT_NOT_NULL(source, L"Allocation should succeed");
+    wmemcpy(source, prefix, prefix_length);
+    for (size_t i = 0; i < copies; i++)
+        wmemcpy(source + prefix_length + i * base_length, BASE_SOURCE, base_length);
+    source[length] = L'\0';
+
+    BaaTokenBuffer buffer;
+    ASSERT_TRUE(baa_lex_all(source, &buffer), L"Initial lex should succeed");
+    ASSERT_EQ(1, (int)buffer.error_count);
+    size_t total = buffer.count;
+
+    // Adding lines after the error keeps it and lexes only around the edit
+    const wchar_t *needle = wcsstr(source + prefix_length + base_length * (copies / 2), L"س = 10");
+    ASSERT_NOT_NULL(needle, L"Edit target should exist");
+    BaaSourceEdit edit = {(size_t)(needle - source), 1, L"م\n\n", 3};
+    wchar_t *edited = baa_source_apply_edit(source, length, &edit);
+    ASSERT_NOT_NULL(edited, L"Edit should apply");
+
+    BaaTokenRange range;
+    ASSERT_TRUE(baa_relex_incremental(&buffer, edited, &edit, &range), L"Incremental relex should succeed");
+    ASSERT_TRUE(range.first > total / 4 && range.old_count <= 4 && range.new_count <= 8,
+                L"An error before the edit should not force a full re-lex");
+
+    BaaTokenBuffer expected;
+    ASSERT_TRUE(baa_lex_all(edited, &expected), L"Full lex should succeed");
+    ASSERT_TRUE(buffers_equal(&expected, &buffer), L"Incremental result should match a full lex");
+    baa_token_buffer_free(&expected);
+    free(source);
+    source = edited;
+    length = length - edit.removed_length + edit.inserted_length;
+
+    // Adding lines before the error reuses it with a shifted position
+    BaaSourceEdit before = {0, 0, L"\n\n", 2};
+    edited = baa_source_apply_edit(source, length, &before);
+    ASSERT_NOT_NULL(edited, L"Edit should apply");
+    ASSERT_TRUE(baa_relex_incremental(&buffer, edited, &before, &range), L"Incremental relex should succeed");
+    ASSERT_TRUE(range.old_count <= 4 && range.new_count <= 4, L"Tokens after the edit should be reused");
+    ASSERT_TRUE(baa_lex_all(edited, &expected), L"Full lex should succeed");
+    ASSERT_TRUE(buffers_equal(&expected, &buffer), L"Reused error tokens should match a full lex");
+
+    baa_token_buffer_free(&expected);
+    baa_token_buffer_free(&buffer);
+    free(edited);
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Error token reuse test passed\n");
+}
+
+void test_random_edits(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing random edits against full re-lexing...\n");
+
+    // Fragments that change token boundaries: quotes, comment markers, newlines, digits
+    static const wchar_t *fragments[] = {
+        L"\"", L"\"\"\"", L"'", L"//", L"/*", L"*/", L"\n", L"\r", L" ", L"1", L"٫",
+        L".", L"أ", L"+", L"_", L"x", L"س", L"خ\"", L"\\", L"=", L"0x", L"ح", L"",
+    };
+    size_t fragment_count = sizeof(fragments) / sizeof(fragments[0]);
+
+    size_t length = wcslen(BASE_SOURCE);
+    wchar_t *source = malloc((length + 1) * sizeof(wchar_t));
+    ASSERT_NOT_NULL(source, L"Allocation should succeed");
+    wmemcpy(source, BASE_SOURCE, length + 1);
+
+    BaaTokenBuffer buffer;
+    ASSERT_TRUE(baa_lex_all(source, &buffer), L"Initial lex should succeed");
+
+    size_t mismatches = 0;
+    for (int iteration = 0; iteration < 3000; iteration++)
+    {
+        BaaSourceEdit edit;
+        edit.offset = (size_t)(next_random() % (length + 1));
+        size_t max_removed = length - edit.offset < 4 ? length - edit.offset : 4;
+        edit.removed_length = (size_t)(next_random() % (max_removed + 1));
+        edit.inserted = fragments[next_random() % fragment_count];
+        edit.inserted_length = wcslen(edit.inserted);
+
+        // Keep the source from drifting too far from something that lexes
+        if (length > 2 * wcslen(BASE_SOURCE) || (iteration % 10) == 9)
+        {
+            edit.offset = 0;
+            edit.removed_length = length;
+            edit.inserted = BASE_SOURCE;
+            edit.inserted_length = wcslen(BASE_SOURCE);
+        }
+
+        wchar_t *edited = baa_source_apply_edit(source, length, &edit);
+        ASSERT_NOT_NULL(edited, L"Edit should apply");
+
+        BaaTokenRange range;
+        ASSERT_TRUE(baa_relex_incremental(&buffer, edited, &edit, &range), L"Incremental relex should succeed");
+
+        BaaTokenBuffer expected;
+        ASSERT_TRUE(baa_lex_all(edited, &expected), L"Full lex should succeed");
+        if (!buffers_equal(&expected, &buffer))
+        {
+            if (mismatches < 5)
+                wprintf(L"  Mismatch after edit at %zu (-%zu +\"%ls\")\n", edit.offset, edit.removed_length, edit.inserted);
+            mismatches++;
+            // Continue from a correct buffer so one failure is not reported repeatedly
+            baa_token_buffer_free(&buffer);
+            buffer = expected;
+        }
+        else
+        {
+            baa_token_buffer_free(&expected);
+        }
+
+        free(source);
+        source = edited;
+        length = length - edit.removed_length + edit.inserted_length;
+    }
+    ASSERT_EQ(0, (int)mismatches);
+
+    baa_token_buffer_free(&buffer);
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Random edits test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running incremental lexing tests...\n\n");
+
+TEST_CASE(test_apply_edit);
+TEST_CASE(test_small_edit_small_range);
+TEST_CASE(test_error_tokens_reused);
+TEST_CASE(test_random_edits);
+
+wprintf(L"\n✓ All incremental lexing tests completed!\n");
+
+TEST_SUITE_END()
@@ -9,7 +9,9 @@ BaaToken *get_first_token(const wchar_t *source)
 {
     BaaLexer lexer;
     baa_init_lexer(&lexer, source, L"test.baa");
-    return baa_lexer_next_token(&lexer);
+    BaaToken *token = baa_lexer_next_token(&lexer);
+    baa_cleanup_lexer(&lexer);
+    return token;
 }
 
 // Helper function to tokenize a string and return all tokens
@@ -45,6 +47,8 @@ BaaToken **get_all_tokens(const wchar_t *source, size_t *token_count)
         }
     }
 
+    baa_cleanup_lexer(&lexer);
+
     return tokens;
 }
 
@@ -0,0 +1,168 @@
+#include "test_framework.h"
+#include "baa/lexer/lexer.h"
+#include "baa/lexer/lexer_parallel.h"
+#include <wchar.h>
+#include <string.h>
+#include <stdlib.h>
+
+// A snippet exercising every construct the split pre-scan must understand:
+// strings with escaped quotes, multiline and raw strings containing newlines,
+// comments, character literals and CRLF line endings.
+static const wchar_t *snippet =
+    L"// تعليق سطر واحد \"ليس نصاً\n"
+    L"عدد_صحيح س = ١٢٣ + 0x1F.\r\n"
+    L"نص = \"سلسلة \\\" مع\\سهروب\".\n"
+    L"/* تعليق\n متعدد\n الأسطر */ ص = 'ح'.\n"
+    L"/** توثيق\n */\n"
+    L"م = \"\"\"سطر أول\n\"سطر\" ثانٍ\n\"\"\".\n"
+    L"خام = خ\"C:\\مسار\\ملف\".\n"
+    L"خام_متعدد = خ\"\"\"أ\nب \\ ج\n\"\"\".\n"
+    L"أخ\"نص بعد معرف\".\n"
+    L"إذا (س >= ٣.١٤ && ص != '\\م') { إرجع س * 2. }\n";
+
+static wchar_t *build_source(size_t repetitions, const wchar_t *tail)
+{
+    size_t snippet_length = wcslen(snippet);
+    size_t tail_length = tail ? wcslen(tail) : 0;
+    size_t total = snippet_length * repetitions + tail_length;
+    wchar_t *source = malloc((total + 1) * sizeof(wchar_t));
+    if (!source)
+        return NULL;
+
+    for (size_t i = 0; i < repetitions; i++)
+        wmemcpy(source + i * snippet_length, snippet, snippet_length);
+    if (tail)
+        wmemcpy(source + snippet_length * repetitions, tail, tail_length);
+    source[total] = L'\0';
+    return source;
+}
+
+// Compares a token buffer against a fresh sequential run of baa_lexer_next_token
+static void assert_matches_sequential(const wchar_t *source, const BaaTokenBuffer *tokens)
+{
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"test.baa");
+
+    size_t index = 0;
+    for (;;)
+    {
+        BaaToken *expected = baa_lexer_next_token(&lexer);
+        ASSERT_NOT_NULL(expected, L"Sequential token should not be NULL");
+        ASSERT_TRUE(index < tokens->count, L"Parallel stream ended early");
+
+        size_t length = 0;
+        const wchar_t *lexeme = baa_token_buffer_lexeme(tokens, index, &length);
+        ASSERT_EQ(expected->type, (BaaTokenType)tokens->kinds[index]);
+        ASSERT_EQ((int)expected->start_offset, (int)tokens->offsets[index]);
+        ASSERT_EQ((int)(expected->end_offset - expected->start_offset), (int)tokens->lengths[index]);
+        ASSERT_EQ((int)expected->length, (int)length);
+        ASSERT_TRUE(wmemcmp(expected->lexeme, lexeme, length) == 0, L"Lexemes should match");
+        index++;
+
+        BaaTokenType type = expected->type;
+        baa_free_token(expected);
+        if (type == BAA_TOKEN_EOF)
+            break;
+    }
+    ASSERT_EQ((int)tokens->count, (int)index);
+
+    baa_cleanup_lexer(&lexer);
+}
+
+void test_split_points_are_safe(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing split point pre-scan...\n");
+
+    wchar_t *source = build_source(200, NULL);
+    ASSERT_NOT_NULL(source, L"Source allocation should succeed");
+    size_t length = wcslen(source);
+
+    size_t splits[8];
+    size_t count = baa_lexer_find_split_points(source, length, 8, splits);
+    ASSERT_EQ(7, (int)count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        ASSERT_TRUE(source[splits[i]] == L'\n', L"Split must be at a newline");
+        ASSERT_TRUE(splits[i] == 0 || source[splits[i] - 1] != L'\r', L"Split must not break CRLF");
+        if (i > 0)
+            ASSERT_TRUE(splits[i] > splits[i - 1], L"Splits must be increasing");
+    }
+
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Split point pre-scan test passed\n");
+}
+
+void test_parallel_matches_sequential(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing parallel lexing against the sequential lexer...\n");
+
+    wchar_t *source = build_source(600, NULL);
+    ASSERT_NOT_NULL(source, L"Source allocation should succeed");
+
+    // The snippet must be error-free, otherwise the parallel path would just fall back
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"test.baa");
+    for (;;)
+    {
+        BaaToken *token = baa_lexer_next_token(&lexer);
+        ASSERT_NOT_NULL(token, L"Token should not be NULL");
+        ASSERT_TRUE(!baa_token_is_error(token->type), L"Snippet should lex without errors");
+        BaaTokenType type = token->type;
+        baa_free_token(token);
+        if (type == BAA_TOKEN_EOF)
+            break;
+    }
+    baa_cleanup_lexer(&lexer);
+
+    size_t thread_counts[] = {1, 2, 3, 4, 8};
+    for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++)
+    {
+        BaaTokenBuffer tokens;
+        ASSERT_TRUE(baa_lex_parallel(source, thread_counts[i], &tokens), L"Parallel lexing should succeed");
+        assert_matches_sequential(source, &tokens);
+        baa_token_buffer_free(&tokens);
+    }
+
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Parallel lexing identity test passed\n");
+}
+
+void test_parallel_error_fallback(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing parallel lexing with lexical errors...\n");
+
+    // An unterminated string near the end makes a chunk fail; the result must
+    // still match the sequential lexer, including the error token.
+    wchar_t *source = build_source(600, L"س = \"غير منتهية\n؟ # @\n");
+    ASSERT_NOT_NULL(source, L"Source allocation should succeed");
+
+    BaaTokenBuffer tokens;
+    ASSERT_TRUE(baa_lex_parallel(source, 4, &tokens), L"Parallel lexing should succeed");
+    assert_matches_sequential(source, &tokens);
+    baa_token_buffer_free(&tokens);
+
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Parallel lexing error fallback test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running Lexer parallel lexing tests...\n\n");
+
+TEST_CASE(test_split_points_are_safe);
+TEST_CASE(test_parallel_matches_sequential);
+TEST_CASE(test_parallel_error_fallback);
+
+wprintf(L"\n✓ All Lexer parallel lexing tests completed!\n");
+
+TEST_SUITE_END()
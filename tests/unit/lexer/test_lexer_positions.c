@@ -0,0 +1,123 @@
+#include "test_framework.h"
+#include "baa/lexer/lexer.h"
+#include <wchar.h>
+#include <string.h>
+#include <stdlib.h>
+
+void test_offset_to_line_column(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing offset to line/column conversion...\n");
+
+    const wchar_t *source = L"أ ب\nجـ\n\nد";
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"test.baa");
+
+    size_t line = 0, column = 0;
+    ASSERT_TRUE(baa_lexer_get_position(&lexer, 0, &line, &column), L"Position lookup should succeed");
+    ASSERT_EQ(1, (int)line);
+    ASSERT_EQ(1, (int)column);
+
+    // The newline character itself belongs to the line it terminates
+    baa_lexer_get_position(&lexer, 3, &line, &column);
+    ASSERT_EQ(1, (int)line);
+    ASSERT_EQ(4, (int)column);
+
+    baa_lexer_get_position(&lexer, 4, &line, &column);
+    ASSERT_EQ(2, (int)line);
+    ASSERT_EQ(1, (int)column);
+
+    // Empty line
+    baa_lexer_get_position(&lexer, 7, &line, &column);
+    ASSERT_EQ(3, (int)line);
+    ASSERT_EQ(1, (int)column);
+
+    baa_lexer_get_position(&lexer, 8, &line, &column);
+    ASSERT_EQ(4, (int)line);
+    ASSERT_EQ(1, (int)column);
+
+    // Offsets past the end clamp to the end of the source
+    baa_lexer_get_position(&lexer, 1000, &line, &column);
+    ASSERT_EQ(4, (int)line);
+    ASSERT_EQ(2, (int)column);
+
+    baa_cleanup_lexer(&lexer);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Offset to line/column conversion test passed\n");
+}
+
+void test_token_spans(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing token spans computed from offsets...\n");
+
+    const wchar_t *source = L"س\n  // تعليق\n\"نص\" ص";
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"test.baa");
+
+    BaaTokenType expected_types[] = {
+        BAA_TOKEN_IDENTIFIER, BAA_TOKEN_NEWLINE, BAA_TOKEN_WHITESPACE,
+        BAA_TOKEN_SINGLE_LINE_COMMENT, BAA_TOKEN_NEWLINE, BAA_TOKEN_STRING_LIT,
+        BAA_TOKEN_WHITESPACE, BAA_TOKEN_IDENTIFIER, BAA_TOKEN_EOF};
+    size_t expected_lines[] = {1, 1, 2, 2, 2, 3, 3, 3, 3};
+    size_t expected_columns[] = {1, 2, 1, 3, 11, 1, 5, 6, 7};
+
+    for (size_t i = 0; i < sizeof(expected_types) / sizeof(expected_types[0]); i++)
+    {
+        BaaToken *token = baa_lexer_next_token(&lexer);
+        ASSERT_NOT_NULL(token, L"Token should not be NULL");
+        ASSERT_EQ(expected_types[i], token->type);
+
+        BaaLexerSourceSpan span = baa_lexer_get_token_span(&lexer, token);
+        ASSERT_EQ((int)expected_lines[i], (int)span.start_line);
+        ASSERT_EQ((int)expected_columns[i], (int)span.start_column);
+        ASSERT_EQ((int)token->start_offset, (int)span.start_offset);
+        ASSERT_EQ((int)token->end_offset, (int)span.end_offset);
+
+        baa_free_token(token);
+    }
+
+    baa_cleanup_lexer(&lexer);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Token spans test passed\n");
+}
+
+void test_line_index_standalone(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing standalone line index...\n");
+
+    const wchar_t *source = L"\n\nأ\n";
+    BaaLineIndex index = {0};
+    ASSERT_TRUE(baa_line_index_build(&index, source, wcslen(source)), L"Index build should succeed");
+    ASSERT_EQ(4, (int)index.line_count);
+
+    size_t line = 0, column = 0;
+    baa_line_index_lookup(&index, 2, &line, &column);
+    ASSERT_EQ(3, (int)line);
+    ASSERT_EQ(1, (int)column);
+
+    baa_line_index_lookup(&index, 4, &line, &column);
+    ASSERT_EQ(4, (int)line);
+    ASSERT_EQ(1, (int)column);
+
+    baa_line_index_free(&index);
+    ASSERT_NULL(index.line_starts, L"Index should be released");
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Standalone line index test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running Lexer source position tests...\n\n");
+
+TEST_CASE(test_offset_to_line_column);
+TEST_CASE(test_token_spans);
+TEST_CASE(test_line_index_standalone);
+
+wprintf(L"\n✓ All Lexer source position tests completed!\n");
+
+TEST_SUITE_END()
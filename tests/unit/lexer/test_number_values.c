@@ -0,0 +1,161 @@
+#include "test_framework.h"
+#include "baa/lexer/lexer.h"
+#include <wchar.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+// Lexes source and returns its first token (caller frees)
+static BaaToken *lex_first_token(const wchar_t *source)
+{
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"test.baa");
+    BaaToken *token = baa_lexer_next_token(&lexer);
+    baa_cleanup_lexer(&lexer);
+    return token;
+}
+
+void test_integer_values(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing integer literal values...\n");
+
+    struct
+    {
+        const wchar_t *source;
+        uint64_t value;
+    } cases[] = {
+        {L"0", 0},
+        {L"42", 42},
+        {L"١٢٣", 123},
+        {L"1٢3", 123},
+        {L"1_000_000", 1000000},
+        {L"٩٨٧_٦٥٤", 987654},
+        {L"0x1F", 31},
+        {L"0xFF_FF", 65535},
+        {L"0b1010", 10},
+        {L"0b1_0000", 16},
+        {L"9223372036854775807", 9223372036854775807ULL},
+        {L"18446744073709551615", 18446744073709551615ULL},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        BaaToken *token = lex_first_token(cases[i].source);
+        ASSERT_NOT_NULL(token, L"Token should not be NULL");
+        ASSERT_EQ(BAA_TOKEN_INT_LIT, token->type);
+        ASSERT_TRUE(token->literal.int_value == cases[i].value, L"Integer value mismatch");
+        ASSERT_EQ(0, (int)token->literal.flags);
+        baa_free_token(token);
+    }
+
+    BaaToken *token = lex_first_token(L"18446744073709551616");
+    ASSERT_NOT_NULL(token, L"Token should not be NULL");
+    ASSERT_TRUE(token->literal.flags & BAA_LITERAL_FLAG_OVERFLOW, L"Value above 2^64-1 should overflow");
+    baa_free_token(token);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Integer literal values test passed\n");
+}
+
+void test_integer_suffix_flags(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing integer suffix flags...\n");
+
+    struct
+    {
+        const wchar_t *source;
+        uint8_t flags;
+    } cases[] = {
+        {L"10غ", BAA_LITERAL_FLAG_UNSIGNED},
+        {L"10ط", BAA_LITERAL_FLAG_LONG},
+        {L"10طط", BAA_LITERAL_FLAG_LONG_LONG},
+        {L"10غطط", BAA_LITERAL_FLAG_UNSIGNED | BAA_LITERAL_FLAG_LONG_LONG},
+        {L"١٠ططغ", BAA_LITERAL_FLAG_UNSIGNED | BAA_LITERAL_FLAG_LONG_LONG},
+        {L"0x10غ", BAA_LITERAL_FLAG_UNSIGNED},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        BaaToken *token = lex_first_token(cases[i].source);
+        ASSERT_NOT_NULL(token, L"Token should not be NULL");
+        ASSERT_EQ(BAA_TOKEN_INT_LIT, token->type);
+        ASSERT_TRUE(token->literal.int_value == (i == 5 ? 16u : 10u), L"Suffix must not change the value");
+        ASSERT_EQ((int)cases[i].flags, (int)token->literal.flags);
+        baa_free_token(token);
+    }
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Integer suffix flags test passed\n");
+}
+
+void test_float_values(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing float literal values...\n");
+
+    struct
+    {
+        const wchar_t *source;
+        double value;
+    } cases[] = {
+        {L"3.14", 3.14},
+        {L"٣٫١٤", 3.14},
+        {L"٣.١٤", 3.14},
+        {L".5", 0.5},
+        {L"1_000.000_5", 1000.0005},
+        {L"1.5أ3", 1500.0},
+        {L"2أ-2", 0.02},
+        {L"١٫٢٥أ+٢", 125.0},
+        {L"0x1.8", 1.5},
+        {L"0x1.8أ3", 12.0},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        BaaToken *token = lex_first_token(cases[i].source);
+        ASSERT_NOT_NULL(token, L"Token should not be NULL");
+        ASSERT_EQ(BAA_TOKEN_FLOAT_LIT, token->type);
+        ASSERT_TRUE(token->literal.flags & BAA_LITERAL_FLAG_FLOAT, L"Float flag should be set");
+        ASSERT_TRUE(token->literal.float_value == cases[i].value, L"Float value mismatch");
+        baa_free_token(token);
+    }
+
+    BaaToken *token = lex_first_token(L"2.5ح");
+    ASSERT_NOT_NULL(token, L"Token should not be NULL");
+    ASSERT_TRUE(token->literal.flags & BAA_LITERAL_FLAG_FLOAT_SUFFIX, L"'ح' suffix flag should be set");
+    ASSERT_TRUE(token->literal.float_value == 2.5, L"Float value mismatch");
+    baa_free_token(token);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Float literal values test passed\n");
+}
+
+void test_parse_number_value_errors(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing baa_parse_number_value errors...\n");
+
+    BaaLiteralValue value;
+    ASSERT_EQ(BAA_NUM_INVALID_FORMAT, baa_parse_number_value(L"", 0, &value));
+    ASSERT_EQ(BAA_NUM_MULTIPLE_DOTS, baa_parse_number_value(L"1.2.3", 5, &value));
+    ASSERT_EQ(BAA_NUM_INVALID_FORMAT, baa_parse_number_value(L"12س", 3, &value));
+    ASSERT_EQ(BAA_NUM_INVALID_FORMAT, baa_parse_number_value(L"0x", 2, &value));
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ baa_parse_number_value error test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running Lexer number value tests...\n\n");
+
+TEST_CASE(test_integer_values);
+TEST_CASE(test_integer_suffix_flags);
+TEST_CASE(test_float_values);
+TEST_CASE(test_parse_number_value_errors);
+
+wprintf(L"\n✓ All Lexer number value tests completed!\n");
+
+TEST_SUITE_END()
@@ -0,0 +1,195 @@
+#include "test_framework.h"
+#include "baa/lexer/lexer.h"
+#include "baa/lexer/token_buffer.h"
+#include <wchar.h>
+#include <string.h>
+#include <stdlib.h>
+
+void test_lex_all_matches_sequential(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing baa_lex_all against the sequential lexer...\n");
+
+    const wchar_t *source =
+        L"// تعليق\n"
+        L"عدد_صحيح س = ١٢٣ + 0x1F.\r\n"
+        L"نص = \"سلسلة \\\" مع\\سهروب\".\n"
+        L"/* متعدد\n الأسطر */ ص = 'ح'.\n"
+        L"إذا (س >= ٣.١٤) { إرجع س * 2. }\n";
+
+    BaaTokenBuffer tokens;
+    ASSERT_TRUE(baa_lex_all(source, &tokens), L"baa_lex_all should succeed");
+    ASSERT_TRUE(tokens.source == source, L"Buffer should reference the source");
+
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"test.baa");
+    size_t index = 0;
+    for (;;)
+    {
+        BaaToken *expected = baa_lexer_next_token(&lexer);
+        ASSERT_NOT_NULL(expected, L"Sequential token should not be NULL");
+        ASSERT_TRUE(index < tokens.count, L"Buffer ended early");
+
+        size_t length = 0;
+        const wchar_t *lexeme = baa_token_buffer_lexeme(&tokens, index, &length);
+        ASSERT_EQ(expected->type, (BaaTokenType)tokens.kinds[index]);
+        ASSERT_EQ((int)expected->start_offset, (int)tokens.offsets[index]);
+        ASSERT_EQ((int)(expected->end_offset - expected->start_offset), (int)tokens.lengths[index]);
+        ASSERT_EQ((int)expected->length, (int)length);
+        ASSERT_TRUE(wmemcmp(expected->lexeme, lexeme, length) == 0, L"Lexemes should match");
+        index++;
+
+        BaaTokenType type = expected->type;
+        baa_free_token(expected);
+        if (type == BAA_TOKEN_EOF)
+            break;
+    }
+    ASSERT_EQ((int)tokens.count, (int)index);
+    baa_cleanup_lexer(&lexer);
+
+    baa_token_buffer_free(&tokens);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ baa_lex_all identity test passed\n");
+}
+
+void test_side_table_only_for_processed_tokens(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing token buffer side table...\n");
+
+    // Tokens: IDENT WS = WS STRING . WS IDENT WS = WS INT . EOF
+    const wchar_t *source = L"س = \"أ\\سب\". ص = ٤٢.";
+
+    BaaTokenBuffer tokens;
+    ASSERT_TRUE(baa_lex_all(source, &tokens), L"baa_lex_all should succeed");
+    ASSERT_EQ(14, (int)tokens.count);
+    ASSERT_EQ(BAA_TOKEN_EOF, (BaaTokenType)tokens.kinds[tokens.count - 1]);
+
+    // Only the string literal (processed text) and the number (parsed value) need entries
+    ASSERT_EQ(2, (int)tokens.extra_count);
+    ASSERT_EQ(BAA_TOKEN_STRING_LIT, (BaaTokenType)tokens.kinds[4]);
+    const BaaTokenExtra *extra = baa_token_buffer_extra(&tokens, 4);
+    ASSERT_NOT_NULL(extra, L"String literal should have a side table entry");
+    ASSERT_WSTR_EQ(L"أ\nب", extra->text);
+
+    size_t length = 0;
+    const wchar_t *lexeme = baa_token_buffer_lexeme(&tokens, 11, &length);
+    ASSERT_EQ(BAA_TOKEN_INT_LIT, (BaaTokenType)tokens.kinds[11]);
+    ASSERT_EQ(2, (int)length);
+    ASSERT_TRUE(lexeme == source + tokens.offsets[11], L"Number lexemes should point into the source");
+    const BaaLiteralValue *literal = baa_token_buffer_literal(&tokens, 11);
+    ASSERT_NOT_NULL(literal, L"Number should have a parsed value");
+    ASSERT_EQ(42, (int)literal->int_value);
+    ASSERT_TRUE(baa_token_buffer_extra(&tokens, 7) == NULL, L"Plain tokens should have no side table entry");
+    ASSERT_TRUE(baa_token_buffer_literal(&tokens, 7) == NULL, L"Identifiers have no literal value");
+
+    baa_token_buffer_free(&tokens);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Token buffer side table test passed\n");
+}
+
+void test_error_contexts_in_side_table(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing error contexts in the token buffer...\n");
+
+    const wchar_t *source = L"س = \"غير منتهية\n";
+
+    BaaTokenBuffer tokens;
+    ASSERT_TRUE(baa_lex_all(source, &tokens), L"baa_lex_all should succeed");
+
+    bool found_error = false;
+    for (size_t i = 0; i < tokens.count; i++)
+    {
+        if (baa_token_is_error((BaaTokenType)tokens.kinds[i]))
+        {
+            found_error = true;
+            const BaaLexerError *error = baa_token_buffer_error(&tokens, i);
+            ASSERT_NOT_NULL(error, L"Error token should keep its error information");
+            ASSERT_EQ(1001, (int)error->error_code);
+
+            // The full context is only built on request
+            BaaErrorContext *context = baa_token_buffer_error_context(&tokens, i);
+            ASSERT_NOT_NULL(context, L"Error context should be built on demand");
+            ASSERT_EQ(1001, (int)context->error_code);
+            ASSERT_TRUE(strcmp(context->category, "string") == 0, L"Category should be kept");
+            ASSERT_NOT_NULL(context->suggestion, L"Suggestion should be kept");
+            ASSERT_NOT_NULL(context->context_before, L"Source context should be extracted");
+            ASSERT_TRUE(wcsstr(context->context_before, L"غير منتهية") != NULL, L"Context should show the source");
+            baa_free_error_context(context);
+        }
+        else
+        {
+            ASSERT_TRUE(baa_token_buffer_error(&tokens, i) == NULL, L"Non-error tokens have no error information");
+            ASSERT_TRUE(baa_token_buffer_error_context(&tokens, i) == NULL, L"Non-error tokens have no context");
+        }
+    }
+    ASSERT_TRUE(found_error, L"Unterminated string should produce an error token");
+
+    baa_token_buffer_free(&tokens);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Token buffer error context test passed\n");
+}
+
+void test_escape_free_literals_reference_source(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing escape-free string literals...\n");
+
+    const wchar_t *source = L"س = \"مرحبا\". ص = \"سطر\\سجديد\". ن = \"\"\"أ\nب\"\"\". ح = 'ب'. ف = \"\".";
+
+    // Expected processed lexemes of the string literals, in order
+    const wchar_t *expected[] = {L"مرحبا", L"سطر\nجديد", L"أ\nب", L""};
+    const bool escape_free[] = {true, false, true, true};
+
+    BaaTokenBuffer tokens;
+    ASSERT_TRUE(baa_lex_all(source, &tokens), L"baa_lex_all should succeed");
+
+    size_t string_index = 0;
+    for (size_t i = 0; i < tokens.count; i++)
+    {
+        if (tokens.kinds[i] == BAA_TOKEN_CHAR_LIT)
+        {
+            ASSERT_TRUE(baa_token_buffer_extra(&tokens, i) == NULL, L"Plain char literals are source slices");
+            continue;
+        }
+        if (tokens.kinds[i] != BAA_TOKEN_STRING_LIT)
+            continue;
+        ASSERT_TRUE(string_index < 4, L"Unexpected string literal");
+
+        size_t length = 0;
+        const wchar_t *lexeme = baa_token_buffer_lexeme(&tokens, i, &length);
+        ASSERT_EQ((int)wcslen(expected[string_index]), (int)length);
+        ASSERT_TRUE(wmemcmp(lexeme, expected[string_index], length) == 0, L"String body mismatch");
+
+        // Escape-free bodies point into the source; only escaped ones own a copy
+        const BaaTokenExtra *extra = baa_token_buffer_extra(&tokens, i);
+        ASSERT_NOT_NULL(extra, L"String literals have a side table entry");
+        ASSERT_TRUE((extra->text == NULL) == escape_free[string_index], L"Only escaped strings own their text");
+        if (escape_free[string_index])
+            ASSERT_TRUE(lexeme >= source && lexeme < source + wcslen(source), L"Lexeme should be a source slice");
+        string_index++;
+    }
+    ASSERT_EQ(4, (int)string_index);
+
+    baa_token_buffer_free(&tokens);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Escape-free string literals test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running Lexer token buffer tests...\n\n");
+
+TEST_CASE(test_lex_all_matches_sequential);
+TEST_CASE(test_side_table_only_for_processed_tokens);
+TEST_CASE(test_error_contexts_in_side_table);
+TEST_CASE(test_escape_free_literals_reference_source);
+
+wprintf(L"\n✓ All Lexer token buffer tests completed!\n");
+
+TEST_SUITE_END()
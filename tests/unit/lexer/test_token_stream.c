@@ -0,0 +1,219 @@
+#include "test_framework.h"
+#include "baa/lexer/token_stream.h"
+#include "baa/lexer/token_buffer.h"
+#include <wchar.h>
+#include <stdlib.h>
+
+static const wchar_t *STREAM_SOURCE =
+    L"عدد_صحيح س = 10.\n"
+    L"عدد_صحيح رئيسية() {\n"
+    L"    إذا (س >= 0x1F) {\n"
+    L"        اطبع(\"مرحبا\\س\").\n"
+    L"    }\n"
+    L"    إرجع س + 1_000 * 2.5ح.\n"
+    L"}\n";
+
+// Builds `copies` concatenated copies of STREAM_SOURCE
+static wchar_t *repeat_source(size_t copies)
+{
+    size_t length = wcslen(STREAM_SOURCE);
+    wchar_t *source = malloc((length * copies + 1) * sizeof(wchar_t));
+    if (!source)
+        return NULL;
+    for (size_t i = 0; i < copies; i++)
+        wmemcpy(source + i * length, STREAM_SOURCE, length);
+    source[length * copies] = L'\0';
+    return source;
+}
+
+void test_stream_matches_lexer(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing that the token stream yields the lexer's tokens...\n");
+
+    wchar_t *source = repeat_source(20);
+    ASSERT_NOT_NULL(source, L"Allocation should succeed");
+
+    BaaTokenBuffer expected;
+    ASSERT_TRUE(baa_lex_all(source, &expected), L"Reference lex should succeed");
+
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"test.baa");
+    BaaTokenStream stream;
+    ASSERT_TRUE(baa_token_stream_init(&stream, &lexer), L"Stream init should succeed");
+
+    for (size_t i = 0; i < expected.count; i++)
+    {
+        const BaaToken *token = baa_token_stream_next(&stream);
+        ASSERT_NOT_NULL(token, L"Token should be available");
+        ASSERT_EQ((int)expected.kinds[i], (int)token->type);
+        ASSERT_EQ((int)expected.offsets[i], (int)token->start_offset);
+        baa_token_stream_discard(&stream, stream.position);
+    }
+
+    // The EOF token repeats, and discarding as we go keeps the ring small
+    ASSERT_EQ(BAA_TOKEN_EOF, baa_token_stream_next(&stream)->type);
+    ASSERT_EQ(BAA_TOKEN_EOF, baa_token_stream_peek(&stream, 5)->type);
+    ASSERT_TRUE(stream.capacity <= 16, L"Ring should not grow without marks");
+
+    baa_token_stream_free(&stream);
+    baa_cleanup_lexer(&lexer);
+    baa_token_buffer_free(&expected);
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Token stream sequence test passed\n");
+}
+
+void test_stream_replays_buffer(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing that a buffer-backed stream replays the lexer's tokens...\n");
+
+    // An invalid character makes sure error tokens replay too
+    wchar_t *source = repeat_source(5);
+    ASSERT_NOT_NULL(source, L"Allocation should succeed");
+    source[wcslen(STREAM_SOURCE) * 2] = L'@';
+
+    BaaTokenBuffer tokens;
+    ASSERT_TRUE(baa_lex_all(source, &tokens), L"Reference lex should succeed");
+    ASSERT_EQ(1, (int)tokens.error_count);
+
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"test.baa");
+    BaaTokenStream lexed, replayed;
+    ASSERT_TRUE(baa_token_stream_init(&lexed, &lexer), L"Stream init should succeed");
+    ASSERT_TRUE(baa_token_stream_init_buffer(&replayed, &tokens, 0), L"Buffer stream init should succeed");
+
+    for (size_t i = 0; i < tokens.count; i++)
+    {
+        const BaaToken *expected = baa_token_stream_next(&lexed);
+        const BaaToken *token = baa_token_stream_next(&replayed);
+        ASSERT_NOT_NULL(token, L"Token should be available");
+        ASSERT_EQ((int)expected->type, (int)token->type);
+        ASSERT_EQ((int)expected->start_offset, (int)token->start_offset);
+        ASSERT_EQ((int)expected->end_offset, (int)token->end_offset);
+        ASSERT_EQ((int)expected->length, (int)token->length);
+        ASSERT_WSTR_EQ(expected->lexeme, token->lexeme);
+        ASSERT_EQ((int)expected->error.error_code, (int)token->error.error_code);
+        ASSERT_TRUE(expected->literal.int_value == token->literal.int_value, L"Literal values should match");
+        baa_token_stream_discard(&lexed, lexed.position);
+        baa_token_stream_discard(&replayed, replayed.position);
+    }
+    ASSERT_EQ(BAA_TOKEN_EOF, baa_token_stream_next(&replayed)->type);
+    baa_token_stream_free(&replayed);
+
+    // Replay can start at any token
+    size_t middle = tokens.count / 2;
+    ASSERT_TRUE(baa_token_stream_init_buffer(&replayed, &tokens, middle), L"Buffer stream init should succeed");
+    ASSERT_EQ((int)tokens.offsets[middle], (int)baa_token_stream_peek(&replayed, 0)->start_offset);
+    baa_token_stream_free(&replayed);
+    ASSERT_TRUE(!baa_token_stream_init_buffer(&replayed, &tokens, tokens.count), L"Out-of-range start should fail");
+
+    baa_token_stream_free(&lexed);
+    baa_cleanup_lexer(&lexer);
+    baa_token_buffer_free(&tokens);
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Token stream buffer replay test passed\n");
+}
+
+void test_stream_peek(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing token stream lookahead...\n");
+
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, STREAM_SOURCE, L"test.baa");
+    BaaTokenStream stream;
+    ASSERT_TRUE(baa_token_stream_init(&stream, &lexer), L"Stream init should succeed");
+
+    // Whitespace tokens are part of the stream: "عدد_صحيح", " ", "س", " ", "="
+    ASSERT_EQ(BAA_TOKEN_TYPE_INT, baa_token_stream_peek(&stream, 0)->type);
+    ASSERT_EQ(BAA_TOKEN_IDENTIFIER, baa_token_stream_peek(&stream, 2)->type);
+    ASSERT_EQ(BAA_TOKEN_EQUAL, baa_token_stream_peek(&stream, 4)->type);
+    ASSERT_EQ(0, (int)stream.position);
+    ASSERT_EQ(5, (int)stream.lexed);
+
+    // Peeking again does not lex again
+    ASSERT_EQ(BAA_TOKEN_IDENTIFIER, baa_token_stream_peek(&stream, 2)->type);
+    ASSERT_EQ(5, (int)stream.lexed);
+
+    ASSERT_EQ(BAA_TOKEN_TYPE_INT, baa_token_stream_next(&stream)->type);
+    ASSERT_EQ(BAA_TOKEN_EQUAL, baa_token_stream_peek(&stream, 3)->type);
+    ASSERT_EQ(BAA_TOKEN_EOF, baa_token_stream_peek(&stream, 100000)->type);
+
+    baa_token_stream_free(&stream);
+    baa_cleanup_lexer(&lexer);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Token stream lookahead test passed\n");
+}
+
+void test_stream_mark_rewind(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing token stream mark/rewind...\n");
+
+    wchar_t *source = repeat_source(10);
+    ASSERT_NOT_NULL(source, L"Allocation should succeed");
+
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"test.baa");
+    BaaTokenStream stream;
+    ASSERT_TRUE(baa_token_stream_init(&stream, &lexer), L"Stream init should succeed");
+
+    for (int i = 0; i < 5; i++)
+        baa_token_stream_next(&stream);
+    baa_token_stream_discard(&stream, stream.position);
+
+    // Speculate far enough that the ring has to grow, remembering what we saw
+    BaaTokenMark mark = baa_token_stream_mark(&stream);
+    size_t offsets[200];
+    const wchar_t *lexemes[200];
+    for (int i = 0; i < 200; i++)
+    {
+        const BaaToken *token = baa_token_stream_next(&stream);
+        offsets[i] = token->start_offset;
+        lexemes[i] = token->lexeme;
+        baa_token_stream_discard(&stream, stream.position);
+    }
+    size_t lexed = stream.lexed;
+
+    // A nested mark that is released commits nothing by itself
+    BaaTokenMark inner = baa_token_stream_mark(&stream);
+    baa_token_stream_next(&stream);
+    baa_token_stream_release(&stream, inner);
+
+    baa_token_stream_rewind(&stream, mark);
+    ASSERT_EQ(5, (int)stream.position);
+    for (int i = 0; i < 200; i++)
+    {
+        const BaaToken *token = baa_token_stream_next(&stream);
+        ASSERT_EQ((int)offsets[i], (int)token->start_offset);
+        ASSERT_TRUE(token->lexeme == lexemes[i], L"Replayed tokens should be the same allocations");
+    }
+    ASSERT_EQ((int)lexed + 1, (int)stream.lexed);
+    ASSERT_EQ(0, (int)stream.mark_depth);
+
+    baa_token_stream_free(&stream);
+    baa_cleanup_lexer(&lexer);
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Token stream mark/rewind test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running token stream tests...\n\n");
+
+TEST_CASE(test_stream_matches_lexer);
+TEST_CASE(test_stream_replays_buffer);
+TEST_CASE(test_stream_peek);
+TEST_CASE(test_stream_mark_rewind);
+
+wprintf(L"\n✓ All token stream tests completed!\n");
+
+TEST_SUITE_END()
@@ -23,6 +23,7 @@ void test_parser_creation_and_destruction(void)
     
     // Test parser destruction
     baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
     
     TEST_TEARDOWN();
     wprintf(L"✓ Parser creation and destruction test passed\n");
@@ -46,6 +47,7 @@ void test_parser_creation_with_invalid_input(void)
     ASSERT_NOT_NULL(parser_null_filename, L"Parser creation with NULL filename should still work");
     
     baa_parser_free(parser_null_filename);
+    baa_cleanup_lexer(&lexer);
     
     TEST_TEARDOWN();
     wprintf(L"✓ Parser creation with invalid input test passed\n");
@@ -85,6 +87,7 @@ void test_parser_error_state(void)
         baa_ast_free_node(ast);
     }
     baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
     
     TEST_TEARDOWN();
     wprintf(L"✓ Parser error state test passed\n");
@@ -122,6 +125,7 @@ void test_parse_simple_program(void)
     // Clean up
     baa_ast_free_node(ast);
     baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
     
     TEST_TEARDOWN();
     wprintf(L"✓ Simple program parsing test passed\n");
@@ -154,6 +158,7 @@ void test_parse_empty_program(void)
     // Clean up
     baa_ast_free_node(ast);
     baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
     
     TEST_TEARDOWN();
     wprintf(L"✓ Empty program parsing test passed\n");
@@ -193,6 +198,7 @@ void test_parse_multiple_statements(void)
     // Clean up
     baa_ast_free_node(ast);
     baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
     
     TEST_TEARDOWN();
     wprintf(L"✓ Multiple statements parsing test passed\n");
@@ -225,6 +231,7 @@ void test_parse_with_arabic_identifiers(void)
     // Clean up
     baa_ast_free_node(ast);
     baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
     
     TEST_TEARDOWN();
     wprintf(L"✓ Arabic identifiers parsing test passed\n");
@@ -0,0 +1,154 @@
+#include "test_framework.h"
+#include "baa/parser/parser.h"
+#include "baa/lexer/lexer.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_types.h"
+#include "parser_utils.h" // For baa_parser_mark, baa_parser_rewind, baa_parser_advance
+#include <stdio.h>
+#include <string.h>
+
+// A syntax error on line 2
+static const wchar_t *syntax_error_source =
+    L"عدد_صحيح س = 1.\n"
+    L"عدد_صحيح ص = (2.\n"
+    L"عدد_صحيح ع = 3.\n";
+
+// A lexical error (unexpected character) on line 2
+static const wchar_t *lexical_error_source =
+    L"عدد_صحيح س = 1.\n"
+    L"عدد_صحيح ص = 1 $ 2.\n";
+
+void test_collect_diagnostics(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing that parse errors are collected instead of printed...\n");
+
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, syntax_error_source, L"diag.baa");
+    BaaParser *parser = baa_parser_create(&lexer, L"diag.baa");
+    ASSERT_NOT_NULL(parser, L"Parser should be created");
+    ASSERT_EQ(0, (int)baa_parser_diagnostic_count(parser));
+
+    BaaNode *program = baa_parse_program(parser);
+    ASSERT_NOT_NULL(program, L"Program should parse");
+    ASSERT_TRUE(baa_parser_had_error(parser), L"The error should be flagged");
+    ASSERT_EQ(1, (int)baa_parser_diagnostic_count(parser));
+
+    size_t count = 0;
+    const BaaDiagnostic *diagnostics = baa_parser_get_diagnostics(parser, &count);
+    ASSERT_NOT_NULL(diagnostics, L"Diagnostics should be returned");
+    ASSERT_EQ(1, (int)count);
+
+    ASSERT_EQ(BAA_DIAG_ERROR, diagnostics[0].severity);
+    ASSERT_EQ(BAA_DIAG_SYNTAX, diagnostics[0].category);
+    ASSERT_EQ(2, (int)diagnostics[0].location.line);
+    ASSERT_TRUE(wcscmp(diagnostics[0].location.filename, L"diag.baa") == 0, L"The filename should be kept");
+    ASSERT_TRUE(diagnostics[0].message && diagnostics[0].message[0], L"The message should not be empty");
+    ASSERT_TRUE(diagnostics[0].column_end > diagnostics[0].column_start, L"The token should span columns");
+
+    // A second call returns the same expanded diagnostics
+    ASSERT_TRUE(baa_parser_get_diagnostics(parser, &count) == diagnostics, L"Views should be reused");
+
+    FILE *stream = tmpfile();
+    ASSERT_NOT_NULL(stream, L"Temporary file should open");
+    baa_parser_print_diagnostics(parser, stream);
+    rewind(stream);
+    wchar_t line[256];
+    ASSERT_NOT_NULL(fgetws(line, 256, stream), L"A diagnostic should be printed");
+    ASSERT_TRUE(wcsncmp(line, L"diag.baa:2:", 11) == 0, L"Printed diagnostics start with the location");
+    fclose(stream);
+
+    baa_ast_free_node(program);
+    baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Diagnostic collection test passed\n");
+}
+
+void test_rewind_drops_diagnostics(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing that a rewind drops speculative diagnostics...\n");
+
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, lexical_error_source, L"diag.baa");
+    BaaParser *parser = baa_parser_create(&lexer, L"diag.baa");
+    ASSERT_NOT_NULL(parser, L"Parser should be created");
+
+    BaaParserMark mark = baa_parser_mark(parser);
+    while (!baa_parser_check_token(parser, BAA_TOKEN_EOF))
+        baa_parser_advance(parser);
+    ASSERT_EQ(1, (int)baa_parser_diagnostic_count(parser));
+
+    baa_parser_rewind(parser, &mark);
+    ASSERT_EQ(0, (int)baa_parser_diagnostic_count(parser));
+    ASSERT_TRUE(!baa_parser_had_error(parser), L"The error flag should be restored");
+
+    // Replaying reports the lexical error again, once
+    while (!baa_parser_check_token(parser, BAA_TOKEN_EOF))
+        baa_parser_advance(parser);
+    ASSERT_TRUE(baa_parser_had_error(parser), L"The replayed error should be flagged");
+    size_t count = 0;
+    const BaaDiagnostic *diagnostics = baa_parser_get_diagnostics(parser, &count);
+    ASSERT_EQ(1, (int)count);
+    ASSERT_EQ(2, (int)diagnostics[0].location.line);
+
+    // The message was formatted before the error token's lexeme was released
+    ASSERT_TRUE(wcsncmp(diagnostics[0].message, L"خطأ معجمي: ", 11) == 0, L"Lexical errors keep their prefix");
+    ASSERT_TRUE(wcschr(diagnostics[0].message, L'$') != NULL, L"The lexeme should be part of the message");
+
+    baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Rewind diagnostics test passed\n");
+}
+
+void test_deferred_body_diagnostics(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing diagnostics from deferred function bodies...\n");
+
+    const wchar_t *source = L"فراغ د() {\n"
+                            L"    عدد_صحيح س = (1.\n"
+                            L"}\n";
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"lazy.baa");
+    BaaParser *parser = baa_parser_create(&lexer, L"lazy.baa");
+    ASSERT_NOT_NULL(parser, L"Parser should be created");
+    baa_parser_set_lazy_bodies(parser, true);
+
+    BaaNode *program = baa_parse_program(parser);
+    ASSERT_NOT_NULL(program, L"Program should parse");
+    ASSERT_EQ(0, (int)baa_parser_diagnostic_count(parser));
+
+    // The body's sub-parser hands its diagnostics to the parser
+    BaaNode *function = ((BaaProgramData *)program->data)->top_level_declarations[0];
+    baa_parser_function_body(parser, function);
+    ASSERT_TRUE(baa_parser_had_error(parser), L"The body error should be flagged");
+    size_t count = 0;
+    const BaaDiagnostic *diagnostics = baa_parser_get_diagnostics(parser, &count);
+    ASSERT_EQ(1, (int)count);
+    ASSERT_EQ(2, (int)diagnostics[0].location.line);
+    ASSERT_TRUE(wcscmp(diagnostics[0].location.filename, L"lazy.baa") == 0, L"The filename should be kept");
+
+    baa_ast_free_node(program);
+    baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Deferred body diagnostics test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running parser diagnostics tests...\n\n");
+
+TEST_CASE(test_collect_diagnostics);
+TEST_CASE(test_rewind_drops_diagnostics);
+TEST_CASE(test_deferred_body_diagnostics);
+
+wprintf(L"\n✓ All parser diagnostics tests completed!\n");
+
+TEST_SUITE_END()
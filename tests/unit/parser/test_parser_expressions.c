@@ -3,6 +3,7 @@
 #include "baa/lexer/lexer.h"
 #include "baa/ast/ast.h"
 #include "baa/ast/ast_types.h"
+#include <stdlib.h>
 
 // Helper function to parse a single expression from source
 BaaNode* parse_expression_from_source(const wchar_t* source)
@@ -14,11 +15,14 @@ BaaNode* parse_expression_from_source(const wchar_t* source)
     if (!parser) {
         return NULL;
     }
+    // The expression is detached and outlives the program, so use heap nodes
+    baa_parser_set_ast_arena(parser, false);
     
     // Parse as a program and extract the first expression statement
     BaaNode *ast = baa_parse_program(parser);
     if (!ast || ast->kind != BAA_NODE_KIND_PROGRAM) {
         baa_parser_free(parser);
+        baa_cleanup_lexer(&lexer);
         if (ast) baa_ast_free_node(ast);
         return NULL;
     }
@@ -26,6 +30,7 @@ BaaNode* parse_expression_from_source(const wchar_t* source)
     BaaProgramData *program_data = (BaaProgramData *)ast->data;
     if (program_data->count == 0) {
         baa_parser_free(parser);
+        baa_cleanup_lexer(&lexer);
         baa_ast_free_node(ast);
         return NULL;
     }
@@ -33,6 +38,7 @@ BaaNode* parse_expression_from_source(const wchar_t* source)
     BaaNode *expr_stmt = program_data->top_level_declarations[0];
     if (expr_stmt->kind != BAA_NODE_KIND_EXPR_STMT) {
         baa_parser_free(parser);
+        baa_cleanup_lexer(&lexer);
         baa_ast_free_node(ast);
         return NULL;
     }
@@ -45,6 +51,8 @@ BaaNode* parse_expression_from_source(const wchar_t* source)
     expr_stmt_data->expression = NULL;
     
     baa_parser_free(parser);
+    
+    baa_cleanup_lexer(&lexer);
     baa_ast_free_node(ast);
     
     return expression;
@@ -260,6 +268,113 @@ void test_parse_expression_edge_cases(void)
     wprintf(L"✓ Expression parsing edge cases test passed\n");
 }
 
+void test_parse_operator_precedence(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing operator precedence and associativity...\n");
+
+    // 1 - 2 * -د(3)(4) - 5  =>  (1 - (2 * (-(د(3)(4))))) - 5
+    BaaNode *expr = parse_expression_from_source(L"1 - 2 * -د(3)(4) - 5.");
+    ASSERT_NOT_NULL(expr, L"Expression should parse");
+    ASSERT_EQ(BAA_NODE_KIND_BINARY_EXPR, expr->kind);
+    BaaBinaryExprData *outer = (BaaBinaryExprData *)expr->data;
+    ASSERT_EQ(BAA_BINARY_OP_SUBTRACT, outer->operator_kind);
+    ASSERT_EQ(BAA_NODE_KIND_LITERAL_EXPR, outer->right_operand->kind);
+
+    BaaBinaryExprData *left = (BaaBinaryExprData *)outer->left_operand->data;
+    ASSERT_EQ(BAA_BINARY_OP_SUBTRACT, left->operator_kind);
+    BaaBinaryExprData *product = (BaaBinaryExprData *)left->right_operand->data;
+    ASSERT_EQ(BAA_BINARY_OP_MULTIPLY, product->operator_kind);
+
+    // The prefix minus applies to the whole call chain
+    BaaNode *negated = product->right_operand;
+    ASSERT_EQ(BAA_NODE_KIND_UNARY_EXPR, negated->kind);
+    BaaNode *call = ((BaaUnaryExprData *)negated->data)->operand;
+    ASSERT_EQ(BAA_NODE_KIND_CALL_EXPR, call->kind);
+    ASSERT_EQ(BAA_NODE_KIND_CALL_EXPR, ((BaaCallExprData *)call->data)->callee_expr->kind);
+
+    // Spans cover both operands
+    ASSERT_EQ(1, (int)expr->span.start.column);
+    ASSERT_EQ(21, (int)expr->span.end.column);
+    baa_ast_free_node(expr);
+
+    // Logical operators bind looser than comparisons
+    expr = parse_expression_from_source(L"أ < ب || ج == د && !هـ.");
+    ASSERT_NOT_NULL(expr, L"Expression should parse");
+    ASSERT_EQ(BAA_BINARY_OP_LOGICAL_OR, ((BaaBinaryExprData *)expr->data)->operator_kind);
+    BaaNode *conjunction = ((BaaBinaryExprData *)expr->data)->right_operand;
+    ASSERT_EQ(BAA_BINARY_OP_LOGICAL_AND, ((BaaBinaryExprData *)conjunction->data)->operator_kind);
+    baa_ast_free_node(expr);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Operator precedence test passed\n");
+}
+
+#define DEEP_NESTING 100000
+
+// Builds prefix `depth` times, then core, then suffix `depth` times
+static wchar_t *build_nested_source(size_t depth, const wchar_t *prefix, const wchar_t *core, const wchar_t *suffix)
+{
+    size_t prefix_length = wcslen(prefix);
+    size_t suffix_length = wcslen(suffix);
+    size_t length = depth * (prefix_length + suffix_length) + wcslen(core) + 2;
+    wchar_t *source = malloc((length + 1) * sizeof(wchar_t));
+    if (!source)
+        return NULL;
+    wchar_t *cursor = source;
+    for (size_t i = 0; i < depth; i++, cursor += prefix_length)
+        wmemcpy(cursor, prefix, prefix_length);
+    wcscpy(cursor, core);
+    cursor += wcslen(core);
+    for (size_t i = 0; i < depth; i++, cursor += suffix_length)
+        wmemcpy(cursor, suffix, suffix_length);
+    wcscpy(cursor, L".");
+    return source;
+}
+
+void test_parse_deep_nesting(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing deeply nested expressions...\n");
+
+    // The expression engine keeps its own stack, so depth is not limited by the call stack
+    wchar_t *source = build_nested_source(DEEP_NESTING, L"(", L"أ + 1", L")");
+    ASSERT_NOT_NULL(source, L"Source allocation failed");
+    BaaNode *expr = parse_expression_from_source(source);
+    ASSERT_NOT_NULL(expr, L"Nested parentheses should parse");
+    ASSERT_EQ(BAA_NODE_KIND_BINARY_EXPR, expr->kind);
+    baa_ast_free_node(expr);
+    free(source);
+
+    source = build_nested_source(DEEP_NESTING, L"- ", L"أ", L"");
+    ASSERT_NOT_NULL(source, L"Source allocation failed");
+    expr = parse_expression_from_source(source);
+    ASSERT_NOT_NULL(expr, L"A long prefix chain should parse");
+    size_t depth = 0;
+    for (BaaNode *node = expr; node->kind == BAA_NODE_KIND_UNARY_EXPR; node = ((BaaUnaryExprData *)node->data)->operand)
+        depth++;
+    ASSERT_EQ(DEEP_NESTING, (int)depth);
+    baa_ast_free_node(expr);
+    free(source);
+
+    source = build_nested_source(DEEP_NESTING / 10, L"د(", L"1", L")");
+    ASSERT_NOT_NULL(source, L"Source allocation failed");
+    expr = parse_expression_from_source(source);
+    ASSERT_NOT_NULL(expr, L"Nested calls should parse");
+    ASSERT_EQ(BAA_NODE_KIND_CALL_EXPR, expr->kind);
+    baa_ast_free_node(expr);
+    free(source);
+
+    // An error at the bottom of a deep nest unwinds without recursion
+    source = build_nested_source(DEEP_NESTING / 10, L"(-", L"+", L")");
+    ASSERT_NOT_NULL(source, L"Source allocation failed");
+    ASSERT_NULL(parse_expression_from_source(source), L"The missing operand should be reported");
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Deep nesting test passed\n");
+}
+
 TEST_SUITE_BEGIN()
 
 wprintf(L"Running Parser Expression Function tests...\n\n");
@@ -270,6 +385,8 @@ TEST_CASE(test_parse_identifier_expression);
 TEST_CASE(test_parse_parenthesized_expression);
 TEST_CASE(test_parse_invalid_expressions);
 TEST_CASE(test_parse_expression_edge_cases);
+TEST_CASE(test_parse_operator_precedence);
+TEST_CASE(test_parse_deep_nesting);
 
 wprintf(L"\n✓ All Parser Expression Function tests completed!\n");
 
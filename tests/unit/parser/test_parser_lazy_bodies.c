@@ -0,0 +1,175 @@
+#include "test_framework.h"
+#include "baa/parser/parser.h"
+#include "baa/lexer/lexer.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_types.h"
+#include "baa/ast/ast_flat.h"
+
+static const wchar_t *lazy_source =
+    L"عدد_صحيح س = 1.\n"
+    L"عدد_صحيح مربع(عدد_صحيح أ) {\n"
+    L"    إرجع أ * أ.\n"
+    L"}\n"
+    L"عدد_صحيح أكبر(عدد_صحيح أ, عدد_صحيح ب) {\n"
+    L"    إذا (أ > ب) {\n"
+    L"        إرجع أ.\n"
+    L"    }\n"
+    L"    { إرجع ب. }\n"
+    L"}\n"
+    L"عدد_صحيح فارغة() {}\n";
+
+typedef struct
+{
+    BaaLexer lexer;
+    BaaParser *parser;
+    BaaNode *program;
+} ParsedSource;
+
+static bool parse_source(ParsedSource *parsed, const wchar_t *source, bool lazy, bool use_arena)
+{
+    baa_init_lexer(&parsed->lexer, source, L"lazy.baa");
+    parsed->parser = baa_parser_create(&parsed->lexer, L"lazy.baa");
+    if (!parsed->parser)
+        return false;
+    baa_parser_set_lazy_bodies(parsed->parser, lazy);
+    baa_parser_set_ast_arena(parsed->parser, use_arena);
+    parsed->program = baa_parse_program(parsed->parser);
+    return parsed->program != NULL;
+}
+
+static void free_parsed(ParsedSource *parsed)
+{
+    baa_ast_free_node(parsed->program);
+    baa_parser_free(parsed->parser);
+    baa_cleanup_lexer(&parsed->lexer);
+}
+
+static BaaNode *declaration(ParsedSource *parsed, size_t index)
+{
+    return ((BaaProgramData *)parsed->program->data)->top_level_declarations[index];
+}
+
+static bool programs_equal(BaaNode *a, BaaNode *b)
+{
+    BaaFlatAst *flat_a = baa_flat_ast_from_tree(a);
+    BaaFlatAst *flat_b = baa_flat_ast_from_tree(b);
+    bool equal = flat_a && flat_b && baa_flat_ast_equal(flat_a, flat_b);
+    baa_flat_ast_free(flat_a);
+    baa_flat_ast_free(flat_b);
+    return equal;
+}
+
+void test_lazy_bodies_are_deferred(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing that lazy parsing records body ranges...\n");
+
+    ParsedSource parsed;
+    ASSERT_TRUE(parse_source(&parsed, lazy_source, true, true), L"Lazy parse failed");
+    ASSERT_TRUE(!baa_parser_had_error(parsed.parser), L"Lazy parse should not report errors");
+    ASSERT_EQ(4, (int)((BaaProgramData *)parsed.program->data)->count);
+
+    const size_t parameter_counts[] = {1, 2, 0};
+    for (size_t i = 1; i < 4; i++)
+    {
+        BaaFunctionDefData *data = (BaaFunctionDefData *)declaration(&parsed, i)->data;
+        ASSERT_TRUE(data->body_deferred, L"Function body should be deferred");
+        ASSERT_NULL(data->body, L"Deferred body should not be parsed yet");
+        ASSERT_EQ(L'{', lazy_source[data->body_start_offset]);
+        ASSERT_EQ(L'}', lazy_source[data->body_end_offset - 1]);
+        ASSERT_EQ((int)parameter_counts[i - 1], (int)data->parameter_count);
+    }
+
+    // The nested braces of أكبر are skipped as a whole
+    BaaFunctionDefData *larger = (BaaFunctionDefData *)declaration(&parsed, 2)->data;
+    ASSERT_EQ(L'\n', lazy_source[larger->body_end_offset]);
+
+    // Deferred functions survive a flat round trip
+    BaaFlatAst *flat = baa_flat_ast_from_tree(parsed.program);
+    ASSERT_NOT_NULL(flat, L"Flat encoding failed");
+    BaaNode *rebuilt = baa_flat_ast_to_tree(flat);
+    ASSERT_NOT_NULL(rebuilt, L"Flat decoding failed");
+    ASSERT_TRUE(programs_equal(parsed.program, rebuilt), L"Round trip should keep deferred bodies");
+    baa_ast_free_node(rebuilt);
+    baa_flat_ast_free(flat);
+
+    free_parsed(&parsed);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Deferred body test passed\n");
+}
+
+void test_lazy_bodies_parse_on_demand(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing on-demand body parsing...\n");
+
+    for (int use_arena = 0; use_arena <= 1; use_arena++)
+    {
+        ParsedSource eager;
+        ParsedSource lazy;
+        ASSERT_TRUE(parse_source(&eager, lazy_source, false, use_arena), L"Eager parse failed");
+        ASSERT_TRUE(parse_source(&lazy, lazy_source, true, use_arena), L"Lazy parse failed");
+
+        for (size_t i = 1; i < 4; i++)
+        {
+            BaaNode *function = declaration(&lazy, i);
+            BaaNode *body = baa_parser_function_body(lazy.parser, function);
+            ASSERT_NOT_NULL(body, L"Body should parse on demand");
+            ASSERT_EQ(BAA_NODE_KIND_BLOCK_STMT, body->kind);
+            ASSERT_TRUE(body->arena == function->arena, L"Body should live with its function");
+            ASSERT_TRUE(baa_parser_function_body(lazy.parser, function) == body, L"Body should be parsed once");
+            ASSERT_TRUE(!((BaaFunctionDefData *)function->data)->body_deferred, L"Body should be attached");
+        }
+        ASSERT_TRUE(!baa_parser_had_error(lazy.parser), L"Bodies should parse without errors");
+
+        // With every body parsed, the tree matches the eager one, spans included
+        ASSERT_TRUE(programs_equal(eager.program, lazy.program), L"Lazy and eager ASTs should match");
+
+        // Eager functions return their body directly
+        BaaNode *eager_function = declaration(&eager, 1);
+        ASSERT_TRUE(baa_parser_function_body(eager.parser, eager_function) ==
+                        ((BaaFunctionDefData *)eager_function->data)->body,
+                    L"Eager body should be returned as is");
+
+        free_parsed(&eager);
+        free_parsed(&lazy);
+    }
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ On-demand body test passed\n");
+}
+
+void test_lazy_body_errors(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing errors in deferred bodies...\n");
+
+    // The declaration pass only matches braces; the syntax error shows up when the body is parsed
+    ParsedSource parsed;
+    ASSERT_TRUE(parse_source(&parsed, L"عدد_صحيح معطوبة() { إرجع (1. }\n", true, true), L"Lazy parse failed");
+    ASSERT_TRUE(!baa_parser_had_error(parsed.parser), L"Declaration pass should not see the error");
+    baa_parser_function_body(parsed.parser, declaration(&parsed, 0));
+    ASSERT_TRUE(baa_parser_had_error(parsed.parser), L"Parsing the body should report the error");
+    free_parsed(&parsed);
+
+    // An unterminated body is reported by the declaration pass
+    ASSERT_TRUE(parse_source(&parsed, L"عدد_صحيح ناقصة() { إرجع 1.\n", true, true), L"Lazy parse failed");
+    ASSERT_TRUE(baa_parser_had_error(parsed.parser), L"Missing '}' should be reported");
+    free_parsed(&parsed);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Deferred body error test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running lazy body parsing tests...\n\n");
+
+TEST_CASE(test_lazy_bodies_are_deferred);
+TEST_CASE(test_lazy_bodies_parse_on_demand);
+TEST_CASE(test_lazy_body_errors);
+
+wprintf(L"\n✓ All lazy body parsing tests completed!\n");
+
+TEST_SUITE_END()
@@ -0,0 +1,132 @@
+#include "test_framework.h"
+#include "baa/parser/parser.h"
+#include "baa/lexer/lexer.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_types.h"
+#include "parser_internal.h" // For struct BaaParser
+#include "parser_utils.h"    // For baa_parser_peek_token, baa_parser_mark
+
+static const wchar_t *LOOKAHEAD_SOURCE =
+    L"// تعليق\n"
+    L"ثابت عدد_صحيح س = 10.\n"
+    L"عدد_صحيح[3] م.\n"
+    L"/* تعليق */ عدد_صحيح جمع(عدد_صحيح أ) {\n"
+    L"    إرجع أ + س.\n"
+    L"}\n";
+
+void test_peek_matches_advance(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing that peek(n) returns the tokens advance will produce...\n");
+
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, LOOKAHEAD_SOURCE, L"test.baa");
+    BaaParser *parser = baa_parser_create(&lexer, L"test.baa");
+    ASSERT_NOT_NULL(parser, L"Parser should be created");
+
+    // Comments and whitespace are skipped: ثابت عدد_صحيح س = 10 .
+    BaaTokenType expected[] = {BAA_TOKEN_CONST, BAA_TOKEN_TYPE_INT, BAA_TOKEN_IDENTIFIER,
+                               BAA_TOKEN_EQUAL, BAA_TOKEN_INT_LIT, BAA_TOKEN_DOT};
+    size_t offsets[6];
+    for (size_t n = 0; n < 6; n++)
+    {
+        const BaaToken *token = baa_parser_peek_token(parser, n);
+        ASSERT_NOT_NULL(token, L"Peek should succeed");
+        ASSERT_EQ(expected[n], token->type);
+        offsets[n] = token->start_offset;
+    }
+
+    // Peeking again is served from the ring
+    size_t lexed = parser->tokens.lexed;
+    ASSERT_EQ(BAA_TOKEN_DOT, baa_parser_peek_token(parser, 5)->type);
+    ASSERT_EQ((int)lexed, (int)parser->tokens.lexed);
+    ASSERT_NULL(baa_parser_peek_token(parser, BAA_PARSER_MAX_LOOKAHEAD + 1), L"Peek beyond the bound should fail");
+
+    for (size_t n = 0; n < 6; n++)
+    {
+        ASSERT_EQ(expected[n], parser->current_token.type);
+        ASSERT_EQ((int)offsets[n], (int)parser->current_token.start_offset);
+        baa_parser_advance(parser);
+    }
+
+    baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Peek/advance consistency test passed\n");
+}
+
+void test_mark_rewind(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing parser mark/rewind...\n");
+
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, LOOKAHEAD_SOURCE, L"test.baa");
+    BaaParser *parser = baa_parser_create(&lexer, L"test.baa");
+    ASSERT_NOT_NULL(parser, L"Parser should be created");
+
+    baa_parser_advance(parser);
+    BaaToken saved = parser->current_token;
+    BaaParserMark mark = baa_parser_mark(parser);
+    while (parser->current_token.type != BAA_TOKEN_EOF)
+        baa_parser_advance(parser);
+    size_t lexed = parser->tokens.lexed;
+
+    baa_parser_rewind(parser, &mark);
+    ASSERT_EQ(saved.type, parser->current_token.type);
+    ASSERT_EQ((int)saved.start_offset, (int)parser->current_token.start_offset);
+    ASSERT_EQ(BAA_TOKEN_CONST, parser->previous_token.type);
+    ASSERT_EQ(BAA_TOKEN_IDENTIFIER, baa_parser_peek_token(parser, 1)->type);
+
+    // Replaying does not lex anything again
+    while (parser->current_token.type != BAA_TOKEN_EOF)
+        baa_parser_advance(parser);
+    ASSERT_EQ((int)lexed, (int)parser->tokens.lexed);
+
+    baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Parser mark/rewind test passed\n");
+}
+
+void test_declaration_disambiguation(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing declaration versus function definition lookahead...\n");
+
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, LOOKAHEAD_SOURCE, L"test.baa");
+    BaaParser *parser = baa_parser_create(&lexer, L"test.baa");
+    ASSERT_NOT_NULL(parser, L"Parser should be created");
+
+    BaaNode *program = baa_parse_program(parser);
+    ASSERT_NOT_NULL(program, L"Program should parse");
+    ASSERT_TRUE(!baa_parser_had_error(parser), L"Program should parse without errors");
+
+    BaaProgramData *data = (BaaProgramData *)program->data;
+    ASSERT_EQ(3, (int)data->count);
+    ASSERT_EQ(BAA_NODE_KIND_VAR_DECL_STMT, data->top_level_declarations[0]->kind);
+    ASSERT_EQ(BAA_NODE_KIND_VAR_DECL_STMT, data->top_level_declarations[1]->kind);
+    ASSERT_EQ(BAA_NODE_KIND_FUNCTION_DEF, data->top_level_declarations[2]->kind);
+
+    baa_ast_free_node(program);
+    baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Declaration disambiguation test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running parser lookahead tests...\n\n");
+
+TEST_CASE(test_peek_matches_advance);
+TEST_CASE(test_mark_rewind);
+TEST_CASE(test_declaration_disambiguation);
+
+wprintf(L"\n✓ All parser lookahead tests completed!\n");
+
+TEST_SUITE_END()
@@ -0,0 +1,192 @@
+#include "test_framework.h"
+#include "baa/parser/parser.h"
+#include "baa/lexer/lexer.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_types.h"
+#include "baa/ast/ast_flat.h"
+#include <stdlib.h>
+
+#define PARALLEL_TEST_UNITS 1200
+#define PARALLEL_TEST_THREADS 4
+
+// Appends formatted text to a growing buffer
+static void append(wchar_t **buffer, size_t *length, size_t *capacity, const wchar_t *format, size_t value)
+{
+    if (*capacity - *length < 512)
+    {
+        *capacity = *capacity ? *capacity * 2 : 4096;
+        *buffer = realloc(*buffer, *capacity * sizeof(wchar_t));
+    }
+    int written = swprintf(*buffer + *length, *capacity - *length, format, value, value);
+    if (written > 0)
+        *length += (size_t)written;
+}
+
+// Functions, globals and top-level if/else statements (the else must stay with its if)
+static wchar_t *generate_source(const wchar_t *error_line)
+{
+    wchar_t *source = NULL;
+    size_t length = 0;
+    size_t capacity = 0;
+    for (size_t i = 0; i < PARALLEL_TEST_UNITS; i++)
+    {
+        if (error_line && i == PARALLEL_TEST_UNITS * 3 / 4)
+            append(&source, &length, &capacity, error_line, i);
+        switch (i % 3)
+        {
+        case 0:
+            append(&source, &length, &capacity,
+                   L"// دالة رقم %zu\n"
+                   L"عدد_صحيح دالة_%zu(عدد_صحيح أ) {\n"
+                   L"    عدد_صحيح ب = أ + 7.\n"
+                   L"    طالما (ب) {\n        توقف.\n    }\n"
+                   L"    إرجع ب * 2.\n}\n\n",
+                   i);
+            break;
+        case 1:
+            append(&source, &length, &capacity, L"ثابت عدد_صحيح عام_%zu = %zu.\n", i);
+            break;
+        default:
+            append(&source, &length, &capacity,
+                   L"إذا (عام_%zu) {\n    عام_%zu.\n}\nوإلا {\n    -1.\n}\n", i);
+            break;
+        }
+    }
+    return source;
+}
+
+static BaaNode *parse_source(const wchar_t *source, size_t threads, bool use_arena, bool *had_error)
+{
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"parallel.baa");
+    BaaParser *parser = baa_parser_create(&lexer, L"parallel.baa");
+    if (!parser)
+    {
+        baa_cleanup_lexer(&lexer);
+        return NULL;
+    }
+    baa_parser_set_ast_arena(parser, use_arena);
+    baa_parser_set_parallel(parser, threads);
+
+    BaaNode *program = baa_parse_program(parser);
+    *had_error = baa_parser_had_error(parser);
+
+    baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
+    return program;
+}
+
+// Flattens both trees and compares them node by node, spans included
+static bool programs_equal(BaaNode *a, BaaNode *b)
+{
+    BaaFlatAst *flat_a = baa_flat_ast_from_tree(a);
+    BaaFlatAst *flat_b = baa_flat_ast_from_tree(b);
+    bool equal = flat_a && flat_b && baa_flat_ast_equal(flat_a, flat_b);
+    baa_flat_ast_free(flat_a);
+    baa_flat_ast_free(flat_b);
+    return equal;
+}
+
+static size_t declaration_count(BaaNode *program)
+{
+    return ((BaaProgramData *)program->data)->count;
+}
+
+void test_parallel_matches_sequential(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing that a parallel parse builds the sequential AST...\n");
+
+    wchar_t *source = generate_source(NULL);
+    ASSERT_NOT_NULL(source, L"Source generation failed");
+
+    bool sequential_error = true;
+    bool parallel_error = true;
+    BaaNode *sequential = parse_source(source, 1, true, &sequential_error);
+    BaaNode *parallel = parse_source(source, PARALLEL_TEST_THREADS, true, &parallel_error);
+    ASSERT_NOT_NULL(sequential, L"Sequential parse failed");
+    ASSERT_NOT_NULL(parallel, L"Parallel parse failed");
+    ASSERT_TRUE(!sequential_error && !parallel_error, L"The source should parse without errors");
+
+    ASSERT_EQ(PARALLEL_TEST_UNITS, (int)declaration_count(sequential));
+    ASSERT_EQ(PARALLEL_TEST_UNITS, (int)declaration_count(parallel));
+    ASSERT_TRUE(programs_equal(sequential, parallel), L"Parallel and sequential ASTs should be identical");
+
+    // Slices are parsed into separate arenas, all released with the program
+    BaaProgramData *data = (BaaProgramData *)parallel->data;
+    ASSERT_TRUE(data->top_level_declarations[0]->arena != data->top_level_declarations[data->count - 1]->arena,
+                L"The declarations should come from several worker arenas");
+
+    baa_ast_free_node(sequential);
+    baa_ast_free_node(parallel);
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Parallel parse test passed\n");
+}
+
+void test_parallel_heap_nodes(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing a parallel parse without an arena...\n");
+
+    wchar_t *source = generate_source(NULL);
+    ASSERT_NOT_NULL(source, L"Source generation failed");
+
+    bool sequential_error = true;
+    bool parallel_error = true;
+    BaaNode *sequential = parse_source(source, 1, false, &sequential_error);
+    BaaNode *parallel = parse_source(source, PARALLEL_TEST_THREADS, false, &parallel_error);
+    ASSERT_NOT_NULL(sequential, L"Sequential parse failed");
+    ASSERT_NOT_NULL(parallel, L"Parallel parse failed");
+    ASSERT_TRUE(!parallel_error, L"The source should parse without errors");
+    ASSERT_NULL(((BaaProgramData *)parallel->data)->top_level_declarations[0]->arena,
+                L"Heap mode should not use arenas");
+    ASSERT_TRUE(programs_equal(sequential, parallel), L"Parallel and sequential ASTs should be identical");
+
+    baa_ast_free_node(sequential);
+    baa_ast_free_node(parallel);
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Parallel heap parse test passed\n");
+}
+
+void test_parallel_falls_back_on_errors(void)
+{
+    TEST_SETUP();
+    wprintf(L"Testing that inputs with errors are parsed sequentially...\n");
+
+    // A syntax error in a late slice: the whole input is re-parsed sequentially
+    wchar_t *source = generate_source(L"عدد_صحيح خطأ_%zu = (%zu.\n");
+    ASSERT_NOT_NULL(source, L"Source generation failed");
+
+    bool sequential_error = false;
+    bool parallel_error = false;
+    BaaNode *sequential = parse_source(source, 1, true, &sequential_error);
+    BaaNode *parallel = parse_source(source, PARALLEL_TEST_THREADS, true, &parallel_error);
+    ASSERT_NOT_NULL(sequential, L"Sequential parse failed");
+    ASSERT_NOT_NULL(parallel, L"Parallel parse failed");
+    ASSERT_TRUE(sequential_error && parallel_error, L"Both parses should report the error");
+    ASSERT_EQ((int)declaration_count(sequential), (int)declaration_count(parallel));
+    ASSERT_TRUE(programs_equal(sequential, parallel), L"The fallback should build the sequential AST");
+
+    baa_ast_free_node(sequential);
+    baa_ast_free_node(parallel);
+    free(source);
+
+    TEST_TEARDOWN();
+    wprintf(L"✓ Parallel fallback test passed\n");
+}
+
+TEST_SUITE_BEGIN()
+
+wprintf(L"Running parallel parser tests...\n\n");
+
+TEST_CASE(test_parallel_matches_sequential);
+TEST_CASE(test_parallel_heap_nodes);
+TEST_CASE(test_parallel_falls_back_on_errors);
+
+wprintf(L"\n✓ All parallel parser tests completed!\n");
+
+TEST_SUITE_END()
@@ -14,11 +14,14 @@ BaaNode* parse_statement_from_source(const wchar_t* source)
     if (!parser) {
         return NULL;
     }
+    // The statement is detached and outlives the program, so use heap nodes
+    baa_parser_set_ast_arena(parser, false);
     
     // Parse as a program and extract the first statement
     BaaNode *ast = baa_parse_program(parser);
     if (!ast || ast->kind != BAA_NODE_KIND_PROGRAM) {
         baa_parser_free(parser);
+        baa_cleanup_lexer(&lexer);
         if (ast) baa_ast_free_node(ast);
         return NULL;
     }
@@ -26,6 +29,7 @@ BaaNode* parse_statement_from_source(const wchar_t* source)
     BaaProgramData *program_data = (BaaProgramData *)ast->data;
     if (program_data->count == 0) {
         baa_parser_free(parser);
+        baa_cleanup_lexer(&lexer);
         baa_ast_free_node(ast);
         return NULL;
     }
@@ -37,6 +41,8 @@ BaaNode* parse_statement_from_source(const wchar_t* source)
     program_data->count = 0;
     
     baa_parser_free(parser);
+    
+    baa_cleanup_lexer(&lexer);
     baa_ast_free_node(ast);
     
     return statement;
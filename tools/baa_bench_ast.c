@@ -0,0 +1,439 @@
+// tools/baa_bench_ast.c
+#include "baa/lexer/lexer.h"
+#include "baa/parser/parser.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_arena.h"
+#include "baa/ast/ast_flat.h"
+#include "baa_bench_corpus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <locale.h>
+#include <time.h>
+
+#define BENCH_DEFAULT_SOURCE_CHARS (2u * 1024u * 1024u)
+#define BENCH_DEFAULT_SEED 1
+#define BENCH_DEFAULT_RUNS 5
+
+#ifdef BAA_BENCH_COUNT_ALLOCS
+// Linked with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc (see CMakeLists.txt)
+static size_t allocation_count = 0;
+static size_t allocation_bytes = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    allocation_count++;
+    allocation_bytes += size;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    allocation_count++;
+    allocation_bytes += count * size;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    allocation_count++;
+    allocation_bytes += size;
+    return __real_realloc(ptr, size);
+}
+#endif
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Rebuilds `node` through the public constructors, counting the nodes created
+static BaaNode *clone_node(const BaaNode *node, size_t *count)
+{
+    if (!node)
+        return NULL;
+    (*count)++;
+
+    switch (node->kind)
+    {
+    case BAA_NODE_KIND_LITERAL_EXPR:
+    {
+        const BaaLiteralExprData *data = node->data;
+        if (data->literal_kind == BAA_LITERAL_KIND_STRING)
+            return baa_ast_new_literal_string_node(node->span, data->value.string_value, data->determined_type);
+        return baa_ast_new_literal_int_node(node->span, data->value.int_value, data->determined_type);
+    }
+    case BAA_NODE_KIND_IDENTIFIER_EXPR:
+        return baa_ast_new_identifier_expr_node(node->span, ((const BaaIdentifierExprData *)node->data)->name);
+    case BAA_NODE_KIND_BINARY_EXPR:
+    {
+        const BaaBinaryExprData *data = node->data;
+        BaaNode *left = clone_node(data->left_operand, count);
+        BaaNode *right = clone_node(data->right_operand, count);
+        return baa_ast_new_binary_expr_node(node->span, left, right, data->operator_kind);
+    }
+    case BAA_NODE_KIND_UNARY_EXPR:
+    {
+        const BaaUnaryExprData *data = node->data;
+        return baa_ast_new_unary_expr_node(node->span, clone_node(data->operand, count), data->operator_kind);
+    }
+    case BAA_NODE_KIND_CALL_EXPR:
+    {
+        const BaaCallExprData *data = node->data;
+        BaaNode *call = baa_ast_new_call_expr_node(node->span, clone_node(data->callee_expr, count));
+        for (size_t i = 0; i < data->argument_count; i++)
+            baa_ast_add_call_argument(call, clone_node(data->arguments[i], count));
+        return call;
+    }
+    case BAA_NODE_KIND_TYPE:
+    {
+        const BaaTypeAstData *data = node->data;
+        if (data->type_ast_kind == BAA_TYPE_AST_KIND_ARRAY)
+            return baa_ast_new_array_type_node(node->span, clone_node(data->specifier.array.element_type_node, count),
+                                               clone_node(data->specifier.array.size_expr, count));
+        return baa_ast_new_primitive_type_node(node->span, data->specifier.primitive.name);
+    }
+    case BAA_NODE_KIND_VAR_DECL_STMT:
+    {
+        const BaaVarDeclData *data = node->data;
+        BaaNode *type = clone_node(data->type_node, count);
+        BaaNode *init = clone_node(data->initializer_expr, count);
+        return baa_ast_new_var_decl_node(node->span, data->name, data->modifiers, type, init);
+    }
+    case BAA_NODE_KIND_PARAMETER:
+    {
+        const BaaParameterData *data = node->data;
+        return baa_ast_new_parameter_node(node->span, data->name, clone_node(data->type_node, count));
+    }
+    case BAA_NODE_KIND_FUNCTION_DEF:
+    {
+        const BaaFunctionDefData *data = node->data;
+        BaaNode *type = clone_node(data->return_type_node, count);
+        BaaNode *body = clone_node(data->body, count);
+        BaaNode *function = baa_ast_new_function_def_node(node->span, data->name, data->modifiers, type, body,
+                                                          data->is_variadic);
+        for (size_t i = 0; i < data->parameter_count; i++)
+            baa_ast_add_function_parameter(function, clone_node(data->parameters[i], count));
+        return function;
+    }
+    case BAA_NODE_KIND_EXPR_STMT:
+        return baa_ast_new_expr_stmt_node(node->span, clone_node(((const BaaExprStmtData *)node->data)->expression, count));
+    case BAA_NODE_KIND_BLOCK_STMT:
+    {
+        const BaaBlockStmtData *data = node->data;
+        BaaNode *block = baa_ast_new_block_stmt_node(node->span);
+        for (size_t i = 0; i < data->count; i++)
+            baa_ast_add_stmt_to_block(block, clone_node(data->statements[i], count));
+        return block;
+    }
+    case BAA_NODE_KIND_IF_STMT:
+    {
+        const BaaIfStmtData *data = node->data;
+        BaaNode *condition = clone_node(data->condition_expr, count);
+        BaaNode *then_stmt = clone_node(data->then_stmt, count);
+        BaaNode *else_stmt = clone_node(data->else_stmt, count);
+        return baa_ast_new_if_stmt_node(node->span, condition, then_stmt, else_stmt);
+    }
+    case BAA_NODE_KIND_WHILE_STMT:
+    {
+        const BaaWhileStmtData *data = node->data;
+        BaaNode *condition = clone_node(data->condition_expr, count);
+        return baa_ast_new_while_stmt_node(node->span, condition, clone_node(data->body_stmt, count));
+    }
+    case BAA_NODE_KIND_FOR_STMT:
+    {
+        const BaaForStmtData *data = node->data;
+        BaaNode *init = clone_node(data->initializer_stmt, count);
+        BaaNode *condition = clone_node(data->condition_expr, count);
+        BaaNode *increment = clone_node(data->increment_expr, count);
+        return baa_ast_new_for_stmt_node(node->span, init, condition, increment, clone_node(data->body_stmt, count));
+    }
+    case BAA_NODE_KIND_RETURN_STMT:
+        return baa_ast_new_return_stmt_node(node->span, clone_node(((const BaaReturnStmtData *)node->data)->value_expr, count));
+    case BAA_NODE_KIND_BREAK_STMT:
+        return baa_ast_new_break_stmt_node(node->span);
+    case BAA_NODE_KIND_CONTINUE_STMT:
+        return baa_ast_new_continue_stmt_node(node->span);
+    default:
+        return baa_ast_new_node(node->kind, node->span);
+    }
+}
+
+typedef struct
+{
+    double create_seconds;   // Best-of-N time to build the tree
+    double teardown_seconds; // Best-of-N time to free it
+    size_t nodes;            // Nodes per tree
+    size_t allocations;      // malloc/calloc/realloc calls per tree (0 when not counted)
+    size_t allocated_bytes;  // Bytes requested from the allocator per tree
+    size_t arena_reserved;   // Arena bytes reserved (arena mode)
+} BaaAstBenchResult;
+
+// Clones the program `runs` times, into the heap or into an arena owned by the copy
+static void bench_clone(const BaaNode *program, bool use_arena, int runs, BaaAstBenchResult *result)
+{
+    const BaaProgramData *data = program->data;
+    memset(result, 0, sizeof(*result));
+    result->create_seconds = -1.0;
+    result->teardown_seconds = -1.0;
+
+    for (int run = 0; run < runs; run++)
+    {
+#ifdef BAA_BENCH_COUNT_ALLOCS
+        size_t count_before = allocation_count;
+        size_t bytes_before = allocation_bytes;
+#endif
+        double start = now_seconds();
+        BaaNode *copy = baa_ast_new_program_node(program->span);
+        BaaAstArena *arena = use_arena ? baa_ast_arena_create() : NULL;
+        if (arena)
+            baa_ast_program_adopt_arena(copy, arena);
+        BaaAstArena *previous = baa_ast_arena_activate(arena);
+        size_t nodes = 1;
+        for (size_t i = 0; i < data->count; i++)
+            baa_ast_add_declaration_to_program(copy, clone_node(data->top_level_declarations[i], &nodes));
+        baa_ast_arena_activate(previous);
+        double created = now_seconds();
+
+#ifdef BAA_BENCH_COUNT_ALLOCS
+        result->allocations = allocation_count - count_before;
+        result->allocated_bytes = allocation_bytes - bytes_before;
+#endif
+        if (arena)
+        {
+            BaaAstArenaStats stats;
+            baa_ast_arena_get_stats(arena, &stats);
+            result->arena_reserved = stats.bytes_reserved;
+        }
+
+        baa_ast_free_node(copy);
+        double freed = now_seconds();
+
+        result->nodes = nodes;
+        if (result->create_seconds < 0.0 || created - start < result->create_seconds)
+            result->create_seconds = created - start;
+        if (result->teardown_seconds < 0.0 || freed - created < result->teardown_seconds)
+            result->teardown_seconds = freed - created;
+    }
+}
+
+// Full lex + parse + free with or without the parser's arena
+static void bench_parse(const wchar_t *source, bool use_arena, int runs, double *parse_seconds, double *free_seconds)
+{
+    *parse_seconds = -1.0;
+    *free_seconds = -1.0;
+    for (int run = 0; run < runs; run++)
+    {
+        double start = now_seconds();
+        BaaLexer lexer;
+        baa_init_lexer(&lexer, source, L"bench.baa");
+        BaaParser *parser = baa_parser_create(&lexer, L"bench.baa");
+        baa_parser_set_ast_arena(parser, use_arena);
+        BaaNode *program = baa_parse_program(parser);
+        double parsed = now_seconds();
+        baa_ast_free_node(program);
+        double freed = now_seconds();
+        baa_parser_free(parser);
+        baa_cleanup_lexer(&lexer);
+
+        if (*parse_seconds < 0.0 || parsed - start < *parse_seconds)
+            *parse_seconds = parsed - start;
+        if (*free_seconds < 0.0 || freed - parsed < *free_seconds)
+            *free_seconds = freed - parsed;
+    }
+}
+
+// Pointer-chasing walk: every node kind plus every integer literal value
+static BaaAstVisitResult sum_node(BaaNode *node, BaaNode *parent, size_t depth, void *user_data)
+{
+    (void)parent;
+    (void)depth;
+    long long *sum = (long long *)user_data;
+    *sum += node->kind;
+    if (node->kind == BAA_NODE_KIND_LITERAL_EXPR)
+    {
+        const BaaLiteralExprData *data = node->data;
+        if (data->literal_kind == BAA_LITERAL_KIND_INT)
+            *sum += data->value.int_value;
+    }
+    return BAA_AST_VISIT_CONTINUE;
+}
+
+static long long walk_tree(BaaNode *root)
+{
+    long long sum = 0;
+    BaaAstVisitor visitor = {sum_node, NULL, &sum};
+    baa_ast_walk(root, &visitor);
+    return sum;
+}
+
+// The same visit over a flat AST is a linear scan
+static long long walk_flat(const BaaFlatAst *ast)
+{
+    long long sum = 0;
+    for (size_t i = 0; i < ast->node_count; i++)
+    {
+        const BaaFlatNode *node = &ast->nodes[i];
+        sum += node->kind;
+        if (node->kind == BAA_NODE_KIND_LITERAL_EXPR && node->tag == BAA_LITERAL_KIND_INT)
+            sum += baa_flat_ast_int_value(ast, (BaaFlatIndex)i);
+    }
+    return sum;
+}
+
+// Compares traversal speed and memory of the arena tree and its flat encoding
+static int bench_flat(const BaaNode *program, int runs)
+{
+    BaaNode *tree = baa_ast_new_program_node(program->span);
+    BaaAstArena *arena = baa_ast_arena_create();
+    baa_ast_program_adopt_arena(tree, arena);
+    BaaAstArena *previous = baa_ast_arena_activate(arena);
+    const BaaProgramData *data = program->data;
+    size_t nodes = 1;
+    for (size_t i = 0; i < data->count; i++)
+        baa_ast_add_declaration_to_program(tree, clone_node(data->top_level_declarations[i], &nodes));
+    baa_ast_arena_activate(previous);
+
+    double encode = -1.0, decode = -1.0, tree_walk = -1.0, flat_walk = -1.0;
+    long long tree_sum = 0, flat_sum = 0;
+    BaaFlatAst *flat = NULL;
+    for (int run = 0; run < runs; run++)
+    {
+        baa_flat_ast_free(flat);
+        double start = now_seconds();
+        flat = baa_flat_ast_from_tree(tree);
+        double encoded = now_seconds();
+        BaaNode *decoded = baa_flat_ast_to_tree(flat);
+        double rebuilt = now_seconds();
+        baa_ast_free_node(decoded);
+        if (encode < 0.0 || encoded - start < encode)
+            encode = encoded - start;
+        if (decode < 0.0 || rebuilt - encoded < decode)
+            decode = rebuilt - encoded;
+
+        start = now_seconds();
+        tree_sum = walk_tree(tree);
+        double walked = now_seconds();
+        flat_sum = walk_flat(flat);
+        double scanned = now_seconds();
+        if (tree_walk < 0.0 || walked - start < tree_walk)
+            tree_walk = walked - start;
+        if (flat_walk < 0.0 || scanned - walked < flat_walk)
+            flat_walk = scanned - walked;
+    }
+
+    BaaAstArenaStats stats;
+    baa_ast_arena_get_stats(arena, &stats);
+    printf("Flat encoding (%zu nodes):\n", flat->node_count);
+    printf("%-8s %9.3f ms %8.2f Mnodes/s  %9.1f KiB  %6.1f B/node\n", "tree", tree_walk * 1000.0,
+           (double)nodes / tree_walk / 1e6, (double)stats.bytes_used / 1024.0, (double)stats.bytes_used / (double)nodes);
+    size_t flat_bytes = baa_flat_ast_memory_size(flat);
+    printf("%-8s %9.3f ms %8.2f Mnodes/s  %9.1f KiB  %6.1f B/node\n", "flat", flat_walk * 1000.0,
+           (double)flat->node_count / flat_walk / 1e6, (double)flat_bytes / 1024.0,
+           (double)flat_bytes / (double)flat->node_count);
+    printf("convert  tree->flat %.3f ms, flat->tree %.3f ms\n", encode * 1000.0, decode * 1000.0);
+
+    int status = tree_sum == flat_sum && flat->node_count == nodes ? 0 : 3;
+    if (status)
+        fprintf(stderr, "Error: Tree and flat walks disagree.\n");
+    baa_flat_ast_free(flat);
+    baa_ast_free_node(tree);
+    return status;
+}
+
+static void print_clone_result(const char *label, const BaaAstBenchResult *result)
+{
+    printf("%-8s %9.3f ms %8.2f Mnodes/s  teardown %8.3f ms", label, result->create_seconds * 1000.0,
+           (double)result->nodes / result->create_seconds / 1e6, result->teardown_seconds * 1000.0);
+#ifdef BAA_BENCH_COUNT_ALLOCS
+    printf("  %9zu allocs %9.1f KiB", result->allocations, (double)result->allocated_bytes / 1024.0);
+#endif
+    if (result->arena_reserved)
+        printf("  (arena %.1f KiB)", (double)result->arena_reserved / 1024.0);
+    printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+    setlocale(LC_ALL, "");
+
+    size_t size = BENCH_DEFAULT_SOURCE_CHARS;
+    unsigned long long seed = BENCH_DEFAULT_SEED;
+    int runs = BENCH_DEFAULT_RUNS;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--size=", 7) == 0)
+            size = (size_t)strtoull(argv[i] + 7, NULL, 10);
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+            seed = strtoull(argv[i] + 7, NULL, 10);
+        else if (strncmp(argv[i], "--runs=", 7) == 0)
+            runs = atoi(argv[i] + 7);
+        else
+        {
+            fprintf(stderr, "Usage: %s [--size=CHARS] [--seed=N] [--runs=N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (runs < 1)
+        runs = 1;
+
+    wchar_t *source = baa_bench_generate_parser_source(size, seed);
+    if (!source)
+    {
+        fprintf(stderr, "Error: Could not generate the source.\n");
+        return 1;
+    }
+
+    // Template tree to rebuild
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"bench.baa");
+    BaaParser *parser = baa_parser_create(&lexer, L"bench.baa");
+    if (!parser)
+    {
+        free(source);
+        return 1;
+    }
+    baa_parser_set_ast_arena(parser, false);
+    BaaNode *program = baa_parse_program(parser);
+    bool had_error = baa_parser_had_error(parser);
+    baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
+    if (!program || had_error)
+    {
+        fprintf(stderr, "Error: The generated source did not parse.\n");
+        baa_ast_free_node(program);
+        free(source);
+        return 2;
+    }
+
+    printf("Source: %zu characters, %zu declarations, %d runs\n", wcslen(source),
+           ((BaaProgramData *)program->data)->count, runs);
+
+    BaaAstBenchResult heap, arena;
+    bench_clone(program, false, runs, &heap);
+    bench_clone(program, true, runs, &arena);
+    printf("Node creation (%zu nodes):\n", heap.nodes);
+    print_clone_result("heap", &heap);
+    print_clone_result("arena", &arena);
+
+    int status = bench_flat(program, runs);
+
+    double parse_seconds, free_seconds;
+    printf("Full parse:\n");
+    bench_parse(source, false, runs, &parse_seconds, &free_seconds);
+    printf("%-8s %9.3f ms  teardown %8.3f ms\n", "heap", parse_seconds * 1000.0, free_seconds * 1000.0);
+    bench_parse(source, true, runs, &parse_seconds, &free_seconds);
+    printf("%-8s %9.3f ms  teardown %8.3f ms\n", "arena", parse_seconds * 1000.0, free_seconds * 1000.0);
+
+    baa_ast_free_node(program);
+    free(source);
+    return status;
+}
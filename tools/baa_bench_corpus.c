@@ -0,0 +1,585 @@
+// tools/baa_bench_corpus.c
+#include "baa_bench_corpus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+    wchar_t *text;
+    size_t length;
+    size_t capacity;
+    bool failed;
+    uint64_t rng;
+} BaaCorpusWriter;
+
+// xorshift64*: deterministic across platforms
+static uint64_t corpus_random(BaaCorpusWriter *writer)
+{
+    writer->rng ^= writer->rng >> 12;
+    writer->rng ^= writer->rng << 25;
+    writer->rng ^= writer->rng >> 27;
+    return writer->rng * 0x2545F4914F6CDD1DULL;
+}
+
+static size_t corpus_pick(BaaCorpusWriter *writer, size_t count)
+{
+    return (size_t)(corpus_random(writer) % count);
+}
+
+static void corpus_append(BaaCorpusWriter *writer, const wchar_t *text)
+{
+    if (writer->failed)
+        return;
+
+    size_t length = wcslen(text);
+    if (writer->length + length + 1 > writer->capacity)
+    {
+        size_t capacity = writer->capacity ? writer->capacity : 4096;
+        while (writer->length + length + 1 > capacity)
+            capacity *= 2;
+        wchar_t *grown = realloc(writer->text, capacity * sizeof(wchar_t));
+        if (!grown)
+        {
+            writer->failed = true;
+            return;
+        }
+        writer->text = grown;
+        writer->capacity = capacity;
+    }
+    wmemcpy(writer->text + writer->length, text, length);
+    writer->length += length;
+    writer->text[writer->length] = L'\0';
+}
+
+static void corpus_append_char(BaaCorpusWriter *writer, wchar_t c)
+{
+    wchar_t text[2] = {c, L'\0'};
+    corpus_append(writer, text);
+}
+
+// --- Lexical building blocks ---
+
+static const wchar_t ARABIC_LETTERS[] = L"ابتثجحدذرزسشصضطظعغفقكلمنهوي";
+
+static void emit_identifier(BaaCorpusWriter *writer)
+{
+    size_t letter_count = wcslen(ARABIC_LETTERS);
+    size_t length = 2 + corpus_pick(writer, 7);
+    for (size_t i = 0; i < length; i++)
+        corpus_append_char(writer, ARABIC_LETTERS[corpus_pick(writer, letter_count)]);
+
+    // Some identifiers carry a separator and a numeric suffix (e.g. قيمة_2)
+    if (corpus_pick(writer, 4) == 0)
+    {
+        wchar_t suffix[16];
+        swprintf(suffix, 16, L"_%u", (unsigned)corpus_pick(writer, 100));
+        corpus_append(writer, suffix);
+    }
+}
+
+static void emit_digits(BaaCorpusWriter *writer, size_t count, bool arabic, bool separators)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (separators && i > 0 && (count - i) % 3 == 0)
+            corpus_append_char(writer, L'_');
+        int digit = (int)corpus_pick(writer, 10);
+        if (i == 0 && digit == 0 && count > 1)
+            digit = 1;
+        corpus_append_char(writer, arabic ? (wchar_t)(0x0660 + digit) : (wchar_t)(L'0' + digit));
+    }
+}
+
+static void emit_number(BaaCorpusWriter *writer)
+{
+    static const wchar_t *int_suffixes[] = {L"غ", L"ط", L"طط", L"غطط"};
+    static const wchar_t HEX_DIGITS[] = L"0123456789ABCDEF";
+    bool arabic = corpus_pick(writer, 2) == 0;
+
+    switch (corpus_pick(writer, 9))
+    {
+    case 0: // Decimal integer
+        emit_digits(writer, 1 + corpus_pick(writer, 6), arabic, false);
+        break;
+    case 1: // Integer with digit separators
+        emit_digits(writer, 4 + corpus_pick(writer, 6), arabic, true);
+        break;
+    case 2: // Hexadecimal
+        corpus_append(writer, L"0x");
+        for (size_t i = 0, n = 1 + corpus_pick(writer, 6); i < n; i++)
+            corpus_append_char(writer, HEX_DIGITS[corpus_pick(writer, 16)]);
+        break;
+    case 3: // Binary
+        corpus_append(writer, L"0b");
+        for (size_t i = 0, n = 1 + corpus_pick(writer, 12); i < n; i++)
+            corpus_append_char(writer, corpus_pick(writer, 2) ? L'1' : L'0');
+        break;
+    case 4: // Float with '.' or the Arabic decimal separator
+    case 5:
+        emit_digits(writer, 1 + corpus_pick(writer, 4), arabic, false);
+        corpus_append_char(writer, corpus_pick(writer, 2) ? L'٫' : L'.');
+        emit_digits(writer, 1 + corpus_pick(writer, 6), arabic, false);
+        break;
+    case 6: // Scientific notation with the أ exponent marker
+    {
+        emit_digits(writer, 1 + corpus_pick(writer, 3), arabic, false);
+        corpus_append_char(writer, arabic ? L'٫' : L'.');
+        emit_digits(writer, 1 + corpus_pick(writer, 4), arabic, false);
+        corpus_append_char(writer, L'أ');
+        size_t sign = corpus_pick(writer, 3);
+        if (sign == 1)
+            corpus_append_char(writer, L'+');
+        else if (sign == 2)
+            corpus_append_char(writer, L'-');
+        emit_digits(writer, 1 + corpus_pick(writer, 2), arabic, false);
+        break;
+    }
+    case 7: // Integer suffixes
+        emit_digits(writer, 1 + corpus_pick(writer, 5), arabic, false);
+        corpus_append(writer, int_suffixes[corpus_pick(writer, 4)]);
+        break;
+    default: // Float suffix
+        emit_digits(writer, 1 + corpus_pick(writer, 3), arabic, false);
+        corpus_append_char(writer, L'.');
+        emit_digits(writer, 1 + corpus_pick(writer, 3), arabic, false);
+        corpus_append(writer, L"ح");
+        break;
+    }
+}
+
+static void emit_words(BaaCorpusWriter *writer, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i > 0)
+            corpus_append_char(writer, L' ');
+        emit_identifier(writer);
+    }
+}
+
+static void emit_string(BaaCorpusWriter *writer)
+{
+    static const wchar_t *escapes[] = {L"\\س", L"\\م", L"\\\"", L"\\\\", L"\\ي0623", L"\\هـ41"};
+
+    switch (corpus_pick(writer, 8))
+    {
+    case 0: // Escapes
+    case 1:
+        corpus_append_char(writer, L'"');
+        emit_words(writer, 1 + corpus_pick(writer, 3));
+        for (size_t i = 0, n = 1 + corpus_pick(writer, 3); i < n; i++)
+        {
+            corpus_append(writer, escapes[corpus_pick(writer, 6)]);
+            emit_words(writer, 1);
+        }
+        corpus_append_char(writer, L'"');
+        break;
+    case 2: // Multiline
+        corpus_append(writer, L"\"\"\"");
+        emit_words(writer, 2 + corpus_pick(writer, 3));
+        corpus_append_char(writer, L'\n');
+        emit_words(writer, 2 + corpus_pick(writer, 3));
+        corpus_append(writer, L"\"\"\"");
+        break;
+    case 3: // Raw
+        corpus_append(writer, L"خ\"");
+        emit_words(writer, 1 + corpus_pick(writer, 3));
+        corpus_append(writer, L"\\م\"");
+        break;
+    case 4: // Raw multiline
+        corpus_append(writer, L"خ\"\"\"");
+        emit_words(writer, 2);
+        corpus_append(writer, L"\n\\س ");
+        emit_words(writer, 2);
+        corpus_append(writer, L"\"\"\"");
+        break;
+    default: // Plain, the common case
+        corpus_append_char(writer, L'"');
+        emit_words(writer, 1 + corpus_pick(writer, 5));
+        corpus_append_char(writer, L'"');
+        break;
+    }
+}
+
+static void emit_char_literal(BaaCorpusWriter *writer)
+{
+    static const wchar_t *escaped[] = {L"'\\س'", L"'\\م'", L"'\\''", L"'\\ي0628'"};
+    if (corpus_pick(writer, 4) == 0)
+    {
+        corpus_append(writer, escaped[corpus_pick(writer, 4)]);
+        return;
+    }
+    corpus_append_char(writer, L'\'');
+    corpus_append_char(writer, ARABIC_LETTERS[corpus_pick(writer, wcslen(ARABIC_LETTERS))]);
+    corpus_append_char(writer, L'\'');
+}
+
+static void emit_comment(BaaCorpusWriter *writer, const wchar_t *indent)
+{
+    corpus_append(writer, indent);
+    switch (corpus_pick(writer, 3))
+    {
+    case 0:
+        corpus_append(writer, L"// ");
+        emit_words(writer, 2 + corpus_pick(writer, 6));
+        break;
+    case 1:
+        corpus_append(writer, L"/* ");
+        emit_words(writer, 2 + corpus_pick(writer, 4));
+        corpus_append(writer, L"\n");
+        corpus_append(writer, indent);
+        corpus_append(writer, L"   ");
+        emit_words(writer, 2 + corpus_pick(writer, 4));
+        corpus_append(writer, L" */");
+        break;
+    default:
+        corpus_append(writer, L"/** ");
+        emit_words(writer, 2 + corpus_pick(writer, 6));
+        corpus_append(writer, L" */");
+        break;
+    }
+    corpus_append_char(writer, L'\n');
+}
+
+static void emit_operand(BaaCorpusWriter *writer)
+{
+    if (corpus_pick(writer, 2))
+        emit_identifier(writer);
+    else
+        emit_number(writer);
+}
+
+static void emit_statement(BaaCorpusWriter *writer)
+{
+    static const wchar_t *operators[] = {L" + ", L" - ", L" * ", L" / ", L" < ", L" >= ", L" == ",
+                                         L" != ", L" && ", L" || "};
+    static const wchar_t *types[] = {L"عدد_صحيح", L"عدد_حقيقي", L"منطقي"};
+    const wchar_t *indent = L"    ";
+
+    switch (corpus_pick(writer, 7))
+    {
+    case 0:
+    case 1: // Declaration with an expression
+        corpus_append(writer, indent);
+        corpus_append(writer, types[corpus_pick(writer, 3)]);
+        corpus_append_char(writer, L' ');
+        emit_identifier(writer);
+        corpus_append(writer, L" = ");
+        emit_operand(writer);
+        for (size_t i = 0, n = corpus_pick(writer, 4); i < n; i++)
+        {
+            corpus_append(writer, operators[corpus_pick(writer, 10)]);
+            emit_operand(writer);
+        }
+        corpus_append(writer, L".\n");
+        break;
+    case 2: // Call with a string argument
+        corpus_append(writer, indent);
+        corpus_append(writer, L"اطبع(");
+        emit_string(writer);
+        corpus_append(writer, L", ");
+        emit_operand(writer);
+        corpus_append(writer, L").\n");
+        break;
+    case 3: // Character literal
+        corpus_append(writer, indent);
+        corpus_append(writer, L"حرف ");
+        emit_identifier(writer);
+        corpus_append(writer, L" = ");
+        emit_char_literal(writer);
+        corpus_append(writer, L".\n");
+        break;
+    case 4: // Control flow
+        corpus_append(writer, indent);
+        corpus_append(writer, L"إذا (");
+        emit_identifier(writer);
+        corpus_append(writer, operators[4 + corpus_pick(writer, 4)]);
+        emit_operand(writer);
+        corpus_append(writer, L") {\n        إرجع ");
+        emit_operand(writer);
+        corpus_append(writer, L".\n    } وإلا {\n        ");
+        emit_identifier(writer);
+        corpus_append(writer, L" = ");
+        emit_operand(writer);
+        corpus_append(writer, L".\n    }\n");
+        break;
+    case 5:
+        emit_comment(writer, indent);
+        break;
+    default: // Loop
+        corpus_append(writer, indent);
+        corpus_append(writer, L"طالما (");
+        emit_identifier(writer);
+        corpus_append(writer, L" < ");
+        emit_number(writer);
+        corpus_append(writer, L") {\n        ");
+        emit_identifier(writer);
+        corpus_append(writer, L" = ");
+        emit_identifier(writer);
+        corpus_append(writer, L" + 1.\n    }\n");
+        break;
+    }
+}
+
+static void emit_function(BaaCorpusWriter *writer)
+{
+    if (corpus_pick(writer, 2) == 0)
+        emit_comment(writer, L"");
+
+    corpus_append(writer, L"عدد_صحيح ");
+    emit_identifier(writer);
+    corpus_append_char(writer, L'(');
+    for (size_t i = 0, n = corpus_pick(writer, 4); i < n; i++)
+    {
+        if (i > 0)
+            corpus_append(writer, L", ");
+        corpus_append(writer, corpus_pick(writer, 2) ? L"عدد_صحيح " : L"عدد_حقيقي ");
+        emit_identifier(writer);
+    }
+    corpus_append(writer, L") {\n");
+
+    for (size_t i = 0, n = 3 + corpus_pick(writer, 10); i < n; i++)
+        emit_statement(writer);
+
+    corpus_append(writer, L"    إرجع ");
+    emit_operand(writer);
+    corpus_append(writer, L".\n}\n\n");
+}
+
+// --- Parser subset: constructs the parser accepts today (no calls, assignments or float/char literals) ---
+
+// Always suffixed so a random letter sequence can never spell a keyword (e.g. حرف)
+static void emit_parser_identifier(BaaCorpusWriter *writer)
+{
+    size_t letter_count = wcslen(ARABIC_LETTERS);
+    wchar_t suffix[16];
+    for (size_t i = 0, n = 2 + corpus_pick(writer, 7); i < n; i++)
+        corpus_append_char(writer, ARABIC_LETTERS[corpus_pick(writer, letter_count)]);
+    swprintf(suffix, 16, L"_%u", (unsigned)corpus_pick(writer, 100));
+    corpus_append(writer, suffix);
+}
+
+static void emit_parser_operand(BaaCorpusWriter *writer)
+{
+    switch (corpus_pick(writer, 6))
+    {
+    case 0:
+    case 1:
+    case 2:
+        emit_parser_identifier(writer);
+        break;
+    case 3:
+        emit_digits(writer, 1 + corpus_pick(writer, 6), corpus_pick(writer, 2) == 0, false);
+        break;
+    case 4:
+        corpus_append_char(writer, L'"');
+        emit_words(writer, 1 + corpus_pick(writer, 4));
+        corpus_append_char(writer, L'"');
+        break;
+    default:
+        corpus_append(writer, L"-");
+        emit_parser_identifier(writer);
+        break;
+    }
+}
+
+static void emit_parser_expression(BaaCorpusWriter *writer, size_t depth)
+{
+    static const wchar_t *operators[] = {L" + ", L" - ", L" * ", L" / ", L" % ", L" < ", L" >= ",
+                                         L" == ", L" != ", L" && ", L" || "};
+
+    if (depth < 2 && corpus_pick(writer, 5) == 0)
+    {
+        corpus_append_char(writer, L'(');
+        emit_parser_expression(writer, depth + 1);
+        corpus_append_char(writer, L')');
+    }
+    else
+    {
+        emit_parser_operand(writer);
+    }
+    for (size_t i = 0, n = corpus_pick(writer, 5); i < n; i++)
+    {
+        corpus_append(writer, operators[corpus_pick(writer, 11)]);
+        emit_parser_operand(writer);
+    }
+}
+
+static void emit_parser_declaration(BaaCorpusWriter *writer, const wchar_t *indent)
+{
+    static const wchar_t *types[] = {L"عدد_صحيح", L"عدد_حقيقي", L"منطقي", L"ثابت عدد_صحيح"};
+
+    corpus_append(writer, indent);
+    corpus_append(writer, types[corpus_pick(writer, 4)]);
+    corpus_append_char(writer, L' ');
+    emit_parser_identifier(writer);
+    corpus_append(writer, L" = ");
+    emit_parser_expression(writer, 0);
+    corpus_append(writer, L".\n");
+}
+
+static void emit_parser_statement(BaaCorpusWriter *writer)
+{
+    const wchar_t *indent = L"    ";
+
+    switch (corpus_pick(writer, 6))
+    {
+    case 0:
+    case 1:
+        emit_parser_declaration(writer, indent);
+        break;
+    case 2: // Expression statement
+        corpus_append(writer, indent);
+        emit_parser_expression(writer, 0);
+        corpus_append(writer, L".\n");
+        break;
+    case 3: // Conditional
+        corpus_append(writer, indent);
+        corpus_append(writer, L"إذا (");
+        emit_parser_expression(writer, 0);
+        corpus_append(writer, L") {\n        إرجع ");
+        emit_parser_expression(writer, 0);
+        corpus_append(writer, L".\n    } وإلا {\n");
+        emit_parser_declaration(writer, L"        ");
+        corpus_append(writer, L"    }\n");
+        break;
+    case 4:
+        emit_comment(writer, indent);
+        break;
+    default: // Loop
+        corpus_append(writer, indent);
+        corpus_append(writer, L"طالما (");
+        emit_parser_identifier(writer);
+        corpus_append(writer, L" < ");
+        emit_digits(writer, 1 + corpus_pick(writer, 4), false, false);
+        corpus_append(writer, L") {\n");
+        emit_parser_declaration(writer, L"        ");
+        corpus_append(writer, L"        توقف.\n    }\n");
+        break;
+    }
+}
+
+static void emit_parser_function(BaaCorpusWriter *writer)
+{
+    if (corpus_pick(writer, 2) == 0)
+        emit_comment(writer, L"");
+    if (corpus_pick(writer, 4) == 0)
+        emit_parser_declaration(writer, L"");
+
+    corpus_append(writer, L"عدد_صحيح ");
+    emit_parser_identifier(writer);
+    corpus_append_char(writer, L'(');
+    for (size_t i = 0, n = corpus_pick(writer, 4); i < n; i++)
+    {
+        if (i > 0)
+            corpus_append(writer, L", ");
+        corpus_append(writer, corpus_pick(writer, 2) ? L"عدد_صحيح " : L"عدد_حقيقي ");
+        emit_parser_identifier(writer);
+    }
+    corpus_append(writer, L") {\n");
+
+    for (size_t i = 0, n = 3 + corpus_pick(writer, 10); i < n; i++)
+        emit_parser_statement(writer);
+
+    corpus_append(writer, L"    إرجع ");
+    emit_parser_expression(writer, 0);
+    corpus_append(writer, L".\n}\n\n");
+}
+
+static wchar_t *generate(size_t target_chars, uint64_t seed, void (*emit_unit)(BaaCorpusWriter *))
+{
+    BaaCorpusWriter writer;
+    memset(&writer, 0, sizeof(writer));
+    writer.rng = seed ? seed : 0x9E3779B97F4A7C15ULL; // xorshift must not start at zero
+
+    corpus_append(&writer, L"");
+    while (!writer.failed && writer.length < target_chars)
+        emit_unit(&writer);
+
+    if (writer.failed)
+    {
+        free(writer.text);
+        return NULL;
+    }
+    return writer.text;
+}
+
+wchar_t *baa_bench_generate_source(size_t target_chars, uint64_t seed)
+{
+    return generate(target_chars, seed, emit_function);
+}
+
+wchar_t *baa_bench_generate_parser_source(size_t target_chars, uint64_t seed)
+{
+    return generate(target_chars, seed, emit_parser_function);
+}
+
+// Decodes one code point, combining UTF-16 surrogate pairs where wchar_t is 16 bits
+static uint32_t next_code_point(const wchar_t *text, size_t length, size_t *index)
+{
+    uint32_t c = (uint32_t)text[(*index)++];
+    if (c >= 0xD800 && c <= 0xDBFF && *index < length)
+    {
+        uint32_t low = (uint32_t)text[*index];
+        if (low >= 0xDC00 && low <= 0xDFFF)
+        {
+            (*index)++;
+            c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+        }
+    }
+    return c;
+}
+
+static size_t utf8_length(uint32_t c)
+{
+    return c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+}
+
+size_t baa_bench_utf8_size(const wchar_t *text, size_t length)
+{
+    size_t size = 0;
+    size_t i = 0;
+    while (i < length)
+        size += utf8_length(next_code_point(text, length, &i));
+    return size;
+}
+
+bool baa_bench_write_utf8(const char *path, const wchar_t *text, size_t length)
+{
+    FILE *file = fopen(path, "wb");
+    if (!file)
+        return false;
+
+    size_t i = 0;
+    bool ok = true;
+    while (ok && i < length)
+    {
+        uint32_t c = next_code_point(text, length, &i);
+        unsigned char bytes[4];
+        size_t n = utf8_length(c);
+        switch (n)
+        {
+        case 1:
+            bytes[0] = (unsigned char)c;
+            break;
+        case 2:
+            bytes[0] = (unsigned char)(0xC0 | (c >> 6));
+            bytes[1] = (unsigned char)(0x80 | (c & 0x3F));
+            break;
+        case 3:
+            bytes[0] = (unsigned char)(0xE0 | (c >> 12));
+            bytes[1] = (unsigned char)(0x80 | ((c >> 6) & 0x3F));
+            bytes[2] = (unsigned char)(0x80 | (c & 0x3F));
+            break;
+        default:
+            bytes[0] = (unsigned char)(0xF0 | (c >> 18));
+            bytes[1] = (unsigned char)(0x80 | ((c >> 12) & 0x3F));
+            bytes[2] = (unsigned char)(0x80 | ((c >> 6) & 0x3F));
+            bytes[3] = (unsigned char)(0x80 | (c & 0x3F));
+            break;
+        }
+        ok = fwrite(bytes, 1, n, file) == n;
+    }
+    return fclose(file) == 0 && ok;
+}
@@ -0,0 +1,58 @@
+#ifndef BAA_BENCH_CORPUS_H
+#define BAA_BENCH_CORPUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <wchar.h>
+
+/**
+ * Deterministic synthetic Baa source generator for the benchmark tools.
+ *
+ * The output is a sequence of function definitions exercising every lexical
+ * feature: Arabic identifiers, integer and float literals in all supported
+ * formats (Arabic-Indic digits, ٫, أ exponents, _ separators, 0x/0b, suffixes),
+ * line, block and doc comments, strings with and without escapes, multiline
+ * and raw strings, and character literals. The same size and seed always give
+ * the same text, and the text lexes without errors.
+ */
+
+/**
+ * @brief Generates about `target_chars` characters of Baa source.
+ *
+ * @param target_chars Approximate size of the result (stops after the function
+ *                     that crosses this size).
+ * @param seed Random seed; any value is valid.
+ * @return Newly allocated, null-terminated source (caller frees), or NULL on
+ *         allocation failure.
+ */
+wchar_t *baa_bench_generate_source(size_t target_chars, uint64_t seed);
+
+/**
+ * @brief Generates about `target_chars` characters of source the parser accepts.
+ *
+ * Restricted to the grammar the parser currently implements: global and local
+ * declarations with initializers, binary, unary and parenthesized expressions
+ * over identifiers, decimal integers and plain strings, expression statements,
+ * إذا/وإلا, طالما, توقف and إرجع. Parses without errors.
+ *
+ * @param target_chars Approximate size of the result.
+ * @param seed Random seed; any value is valid.
+ * @return Newly allocated, null-terminated source (caller frees), or NULL on
+ *         allocation failure.
+ */
+wchar_t *baa_bench_generate_parser_source(size_t target_chars, uint64_t seed);
+
+/**
+ * @brief Returns the UTF-8 encoded size of a wide string in bytes.
+ */
+size_t baa_bench_utf8_size(const wchar_t *text, size_t length);
+
+/**
+ * @brief Writes a wide string to a file as UTF-8.
+ *
+ * @return true on success.
+ */
+bool baa_bench_write_utf8(const char *path, const wchar_t *text, size_t length);
+
+#endif /* BAA_BENCH_CORPUS_H */
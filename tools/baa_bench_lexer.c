@@ -0,0 +1,379 @@
+// tools/baa_bench_lexer.c
+#include "baa/lexer/lexer.h"
+#include "baa/lexer/lexer_parallel.h"
+#include "baa/utils/threads.h"
+#include "baa/utils/utils.h" // For baa_file_content
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <locale.h>
+#include <time.h>
+#include "baa_bench_corpus.h"
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#define BENCH_DEFAULT_SOURCE_CHARS (4u * 1024u * 1024u)
+#define BENCH_DEFAULT_SEED 1
+#define BENCH_DEFAULT_RUNS 5
+#define BENCH_FLOAT_LITERALS 200000
+
+static int bench_runs = BENCH_DEFAULT_RUNS;
+
+#ifdef BAA_BENCH_COUNT_ALLOCS
+// Linked with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc (see CMakeLists.txt)
+static size_t allocation_count = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    allocation_count++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    allocation_count++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    allocation_count++;
+    return __real_realloc(ptr, size);
+}
+#endif
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Peak resident set size of the process in KiB, or 0 if unknown
+static size_t peak_rss_kb(void)
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return (size_t)(counters.PeakWorkingSetSize / 1024);
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(__APPLE__)
+    return (size_t)usage.ru_maxrss / 1024; // Bytes on macOS
+#else
+    return (size_t)usage.ru_maxrss;
+#endif
+#endif
+}
+
+typedef struct
+{
+    double seconds;          // Best-of-N wall time
+    size_t tokens;           // Tokens including EOF
+    size_t error_tokens;     // Should be zero for the generated corpus
+    double allocs_per_token; // Negative if allocations are not counted
+} BaaSequentialResult;
+
+// Best-of-N sequential baa_lex_all, plus one extra run that counts allocations
+static bool bench_sequential(const wchar_t *source, BaaSequentialResult *result)
+{
+    result->seconds = -1.0;
+    result->allocs_per_token = -1.0;
+    for (int run = 0; run < bench_runs; run++)
+    {
+        BaaTokenBuffer tokens;
+        double start = now_seconds();
+        if (!baa_lex_all(source, &tokens))
+            return false;
+        double elapsed = now_seconds() - start;
+        if (run == 0)
+        {
+            result->tokens = tokens.count;
+            result->error_tokens = tokens.error_count;
+        }
+        baa_token_buffer_free(&tokens);
+        if (result->seconds < 0.0 || elapsed < result->seconds)
+            result->seconds = elapsed;
+    }
+
+#ifdef BAA_BENCH_COUNT_ALLOCS
+    BaaTokenBuffer tokens;
+    size_t before = allocation_count;
+    if (!baa_lex_all(source, &tokens))
+        return false;
+    result->allocs_per_token = tokens.count ? (double)(allocation_count - before) / (double)tokens.count : 0.0;
+    baa_token_buffer_free(&tokens);
+#endif
+    return true;
+}
+
+// Best-of-N wall time for lexing the whole buffer with the given thread count
+static double time_parallel_lex(const wchar_t *source, size_t threads, size_t *out_token_count)
+{
+    double best = -1.0;
+    for (int run = 0; run < bench_runs; run++)
+    {
+        BaaTokenBuffer tokens;
+        double start = now_seconds();
+        if (!baa_lex_parallel(source, threads, &tokens))
+            return -1.0;
+        double elapsed = now_seconds() - start;
+        *out_token_count = tokens.count;
+        baa_token_buffer_free(&tokens);
+        if (best < 0.0 || elapsed < best)
+            best = elapsed;
+    }
+    return best;
+}
+
+// Compares float literal conversion against strtod on the same values (ns per literal)
+static bool bench_float_conversion(double *baa_ns, double *strtod_ns)
+{
+    wchar_t(*baa_literals)[48] = malloc(BENCH_FLOAT_LITERALS * sizeof(*baa_literals));
+    char(*c_literals)[48] = malloc(BENCH_FLOAT_LITERALS * sizeof(*c_literals));
+    if (!baa_literals || !c_literals)
+    {
+        free(baa_literals);
+        free(c_literals);
+        return false;
+    }
+
+    unsigned int seed = 12345;
+    for (size_t i = 0; i < BENCH_FLOAT_LITERALS; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        unsigned int whole = seed % 100000;
+        seed = seed * 1103515245u + 12345u;
+        unsigned int fraction = seed % 10000000;
+        int exponent = (int)(seed >> 16) % 600 - 300;
+        swprintf(baa_literals[i], 48, L"%u٫%07uأ%d", whole, fraction, exponent);
+        snprintf(c_literals[i], 48, "%u%07ue%d", whole, fraction, exponent - 7);
+    }
+
+    double checksum = 0.0;
+    double start = now_seconds();
+    for (size_t i = 0; i < BENCH_FLOAT_LITERALS; i++)
+    {
+        BaaLiteralValue value;
+        baa_parse_number_value(baa_literals[i], wcslen(baa_literals[i]), &value);
+        checksum += value.float_value;
+    }
+    double baa_elapsed = now_seconds() - start;
+
+    start = now_seconds();
+    for (size_t i = 0; i < BENCH_FLOAT_LITERALS; i++)
+        checksum -= strtod(c_literals[i], NULL);
+    double strtod_elapsed = now_seconds() - start;
+
+    *baa_ns = baa_elapsed * 1e9 / BENCH_FLOAT_LITERALS;
+    *strtod_ns = strtod_elapsed * 1e9 / BENCH_FLOAT_LITERALS;
+    if (checksum == 1.0) // Keeps the loops from being optimized away
+        fputc('\0', stderr);
+
+    free(baa_literals);
+    free(c_literals);
+    return true;
+}
+
+static void print_json_string(const char *text)
+{
+    putchar('"');
+    for (; *text; text++)
+    {
+        if (*text == '"' || *text == '\\')
+            putchar('\\');
+        putchar(*text);
+    }
+    putchar('"');
+}
+
+static void print_usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [--size=CHARS] [--seed=N] [--runs=N] [--json] [--emit=PATH] [file]\n"
+            "  --size=CHARS  Size of the generated corpus (default %u)\n"
+            "  --seed=N      Seed of the generated corpus (default %d)\n"
+            "  --runs=N      Timed runs per measurement, best is reported (default %d)\n"
+            "  --json        Print a single JSON object instead of tables\n"
+            "  --emit=PATH   Also write the corpus to PATH as UTF-8\n"
+            "  file          Benchmark this file instead of a generated corpus\n",
+            program, BENCH_DEFAULT_SOURCE_CHARS, BENCH_DEFAULT_SEED, BENCH_DEFAULT_RUNS);
+}
+
+static wchar_t *load_file(const char *path)
+{
+    size_t len_needed = mbstowcs(NULL, path, 0);
+    if (len_needed == (size_t)-1)
+    {
+        fprintf(stderr, "Error: Invalid multibyte sequence in filename.\n");
+        return NULL;
+    }
+    wchar_t *w_filename = malloc((len_needed + 1) * sizeof(wchar_t));
+    if (!w_filename)
+        return NULL;
+    mbstowcs(w_filename, path, len_needed + 1);
+    wchar_t *source = baa_file_content(w_filename);
+    free(w_filename);
+    if (!source)
+        fprintf(stderr, "Error: Could not read file: %s\n", path);
+    return source;
+}
+
+int main(int argc, char *argv[])
+{
+    setlocale(LC_ALL, "");
+
+    size_t size = BENCH_DEFAULT_SOURCE_CHARS;
+    unsigned long long seed = BENCH_DEFAULT_SEED;
+    bool json = false;
+    const char *emit_path = NULL;
+    const char *input_path = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--size=", 7) == 0)
+            size = (size_t)strtoull(argv[i] + 7, NULL, 10);
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+            seed = strtoull(argv[i] + 7, NULL, 10);
+        else if (strncmp(argv[i], "--runs=", 7) == 0)
+            bench_runs = atoi(argv[i] + 7);
+        else if (strcmp(argv[i], "--json") == 0)
+            json = true;
+        else if (strncmp(argv[i], "--emit=", 7) == 0)
+            emit_path = argv[i] + 7;
+        else if (argv[i][0] == '-')
+        {
+            print_usage(argv[0]);
+            return 1;
+        }
+        else
+            input_path = argv[i];
+    }
+    if (bench_runs < 1)
+        bench_runs = 1;
+
+    wchar_t *source = input_path ? load_file(input_path) : baa_bench_generate_source(size, seed);
+    if (!source)
+        return 1;
+
+    size_t length = wcslen(source);
+    size_t utf8_bytes = baa_bench_utf8_size(source, length);
+    if (emit_path && !baa_bench_write_utf8(emit_path, source, length))
+    {
+        fprintf(stderr, "Error: Could not write corpus to %s\n", emit_path);
+        free(source);
+        return 1;
+    }
+
+    BaaSequentialResult sequential;
+    if (!bench_sequential(source, &sequential))
+    {
+        fprintf(stderr, "Error: Lexing failed.\n");
+        free(source);
+        return 1;
+    }
+    double megabytes = (double)utf8_bytes / (1024.0 * 1024.0);
+
+    size_t hardware = baa_thread_hardware_concurrency();
+    if (json)
+    {
+        printf("{\n  \"source\": {\"path\": ");
+        if (input_path)
+        {
+            print_json_string(input_path);
+            printf(", \"seed\": null");
+        }
+        else
+            printf("null, \"seed\": %llu", seed);
+        printf(", \"chars\": %zu, \"utf8_bytes\": %zu},\n", length, utf8_bytes);
+        printf("  \"runs\": %d,\n", bench_runs);
+        printf("  \"hardware_threads\": %zu,\n", hardware);
+        printf("  \"sequential\": {\"tokens\": %zu, \"error_tokens\": %zu, \"seconds\": %.6f, "
+               "\"mb_per_s\": %.2f, \"tokens_per_s\": %.0f, \"allocs_per_token\": ",
+               sequential.tokens, sequential.error_tokens, sequential.seconds,
+               megabytes / sequential.seconds, (double)sequential.tokens / sequential.seconds);
+        if (sequential.allocs_per_token < 0.0)
+            printf("null},\n");
+        else
+            printf("%.4f},\n", sequential.allocs_per_token);
+        printf("  \"parallel\": [");
+    }
+    else
+    {
+        printf("Source: %zu characters (%zu UTF-8 bytes), hardware threads: %zu\n", length, utf8_bytes, hardware);
+        printf("Sequential baa_lex_all: %zu tokens (%zu errors), %.3f ms\n", sequential.tokens,
+               sequential.error_tokens, sequential.seconds * 1000.0);
+        printf("  %.2f MB/s, %.0f tokens/s", megabytes / sequential.seconds,
+               (double)sequential.tokens / sequential.seconds);
+        if (sequential.allocs_per_token >= 0.0)
+            printf(", %.4f allocs/token", sequential.allocs_per_token);
+        printf("\n\n%8s %12s %12s %10s\n", "threads", "tokens", "time (ms)", "speedup");
+    }
+
+    size_t thread_counts[] = {1, 2, 4, 8, 16};
+    double baseline = 0.0;
+    for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++)
+    {
+        size_t threads = thread_counts[i];
+        if (threads > 1 && threads > hardware * 2)
+            break;
+
+        size_t token_count = 0;
+        double elapsed = time_parallel_lex(source, threads, &token_count);
+        if (elapsed < 0.0)
+        {
+            fprintf(stderr, "Error: Parallel lexing failed with %zu threads.\n", threads);
+            free(source);
+            return 1;
+        }
+        if (threads == 1)
+            baseline = elapsed;
+
+        double speedup = elapsed > 0.0 ? baseline / elapsed : 0.0;
+        if (json)
+            printf("%s\n    {\"threads\": %zu, \"tokens\": %zu, \"seconds\": %.6f, \"speedup\": %.3f}",
+                   i ? "," : "", threads, token_count, elapsed, speedup);
+        else
+            printf("%8zu %12zu %12.3f %9.2fx\n", threads, token_count, elapsed * 1000.0, speedup);
+    }
+
+    free(source);
+
+    double baa_ns = 0.0, strtod_ns = 0.0;
+    bool have_float = bench_float_conversion(&baa_ns, &strtod_ns);
+    size_t rss = peak_rss_kb();
+
+    if (json)
+    {
+        printf("\n  ],\n  \"float_conversion\": ");
+        if (have_float)
+            printf("{\"literals\": %d, \"baa_ns_per_literal\": %.2f, \"strtod_ns_per_literal\": %.2f},\n",
+                   BENCH_FLOAT_LITERALS, baa_ns, strtod_ns);
+        else
+            printf("null,\n");
+        printf("  \"peak_rss_kb\": %zu\n}\n", rss);
+    }
+    else
+    {
+        if (have_float)
+        {
+            printf("\nFloat literals: %d conversions\n", BENCH_FLOAT_LITERALS);
+            printf("  baa_parse_number_value: %8.1f ns/literal\n", baa_ns);
+            printf("  strtod:                 %8.1f ns/literal\n", strtod_ns);
+        }
+        printf("\nPeak RSS: %zu KiB\n", rss);
+    }
+    return sequential.error_tokens == 0 || input_path ? 0 : 2;
+}
@@ -0,0 +1,309 @@
+// tools/baa_bench_parser.c
+#include "baa/lexer/lexer.h"
+#include "baa/parser/parser.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_flat.h"
+#include "baa/ast/ast_serialize.h"
+#include "baa/utils/utils.h" // For baa_file_content
+#include "baa/utils/trace.h"
+#include "baa_bench_corpus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <locale.h>
+#include <time.h>
+
+#define BENCH_DEFAULT_SOURCE_CHARS (1u * 1024u * 1024u)
+#define BENCH_DEFAULT_SEED 1
+#define BENCH_DEFAULT_RUNS 5
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+typedef struct
+{
+    double seconds;      // Best-of-N wall time for lexing and parsing
+    size_t declarations; // Top-level declarations in the AST
+    size_t ast_bytes;    // Bytes reserved by the program's arena (sequential parses only)
+    bool had_error;      // Whether the parser reported errors
+} BaaParseResult;
+
+// Lexes and parses the whole source `runs` times on `threads` threads, keeping the best time
+static bool bench_parse(const wchar_t *source, int runs, size_t threads, bool lazy, BaaParseResult *result)
+{
+    result->seconds = -1.0;
+    for (int run = 0; run < runs; run++)
+    {
+        double start = now_seconds();
+        BaaLexer lexer;
+        baa_init_lexer(&lexer, source, L"bench.baa");
+        BaaParser *parser = baa_parser_create(&lexer, L"bench.baa");
+        if (!parser)
+        {
+            baa_cleanup_lexer(&lexer);
+            return false;
+        }
+        baa_parser_set_parallel(parser, threads);
+        baa_parser_set_lazy_bodies(parser, lazy);
+        BaaNode *program = baa_parse_program(parser);
+        double elapsed = now_seconds() - start;
+
+        result->had_error = baa_parser_had_error(parser);
+        result->declarations = 0;
+        result->ast_bytes = 0;
+        if (program && program->kind == BAA_NODE_KIND_PROGRAM)
+        {
+            BaaProgramData *data = (BaaProgramData *)program->data;
+            BaaAstArenaStats stats;
+            baa_ast_arena_get_stats(data->owned_arena, &stats);
+            result->declarations = data->count;
+            result->ast_bytes = stats.bytes_reserved;
+        }
+
+        baa_ast_free_node(program);
+        baa_parser_free(parser);
+        baa_cleanup_lexer(&lexer);
+        if (result->seconds < 0.0 || elapsed < result->seconds)
+            result->seconds = elapsed;
+    }
+    return true;
+}
+
+// Lexes the whole source `runs` times without parsing, keeping the best time
+static double bench_lex(const wchar_t *source, int runs)
+{
+    double best = -1.0;
+    for (int run = 0; run < runs; run++)
+    {
+        double start = now_seconds();
+        BaaLexer lexer;
+        baa_init_lexer(&lexer, source, L"bench.baa");
+        for (;;)
+        {
+            BaaToken *token = baa_lexer_next_token(&lexer);
+            if (!token)
+                break;
+            BaaTokenType type = token->type;
+            baa_free_token(token);
+            if (type == BAA_TOKEN_EOF)
+                break;
+        }
+        baa_cleanup_lexer(&lexer);
+        double elapsed = now_seconds() - start;
+        if (best < 0.0 || elapsed < best)
+            best = elapsed;
+    }
+    return best;
+}
+
+// Parses the source once, stores it in the AST cache and times cache hits (load and rebuild)
+static bool bench_cache(const wchar_t *source, int runs, const char *cache_dir, double *seconds, size_t *image_bytes)
+{
+    BaaLexer lexer;
+    baa_init_lexer(&lexer, source, L"bench.baa");
+    BaaParser *parser = baa_parser_create(&lexer, L"bench.baa");
+    if (!parser)
+    {
+        baa_cleanup_lexer(&lexer);
+        return false;
+    }
+    BaaNode *program = baa_parse_program(parser);
+    BaaAstCacheKey key = baa_ast_cache_key(source, wcslen(source), L"bench.baa");
+    bool stored = program && baa_ast_cache_store(cache_dir, key, program);
+    baa_ast_free_node(program);
+    baa_parser_free(parser);
+    baa_cleanup_lexer(&lexer);
+    if (!stored)
+        return false;
+
+    *seconds = -1.0;
+    *image_bytes = 0;
+    bool hit = true;
+    for (int run = 0; hit && run < runs; run++)
+    {
+        // The key is computed on every run: a real lookup hashes the preprocessed source first.
+        // The tree is rebuilt into an arena, as baa_parse_program builds it.
+        double start = now_seconds();
+        BaaAstArena *arena = baa_ast_arena_create();
+        BaaAstArena *previous_arena = baa_ast_arena_activate(arena);
+        BaaAstImage *image = NULL;
+        BaaNode *cached = baa_ast_cache_load(cache_dir, baa_ast_cache_key(source, wcslen(source), L"bench.baa"), &image);
+        baa_ast_arena_activate(previous_arena);
+        double elapsed = now_seconds() - start;
+
+        hit = cached != NULL;
+        if (image)
+        {
+            const BaaFlatAst *flat = baa_ast_image_flat(image);
+            *image_bytes = baa_flat_ast_memory_size(flat);
+        }
+        baa_ast_arena_destroy(arena);
+        baa_ast_image_free(image);
+        if (*seconds < 0.0 || elapsed < *seconds)
+            *seconds = elapsed;
+    }
+
+    char path[1024];
+    if (baa_ast_cache_path(cache_dir, key, path, sizeof(path)) < sizeof(path))
+        remove(path);
+    return hit;
+}
+
+static void print_result(const char *label, const BaaParseResult *result, double megabytes)
+{
+    printf("%-12s %10.3f ms %10.2f MB/s %10zu decls%s\n", label, result->seconds * 1000.0,
+           megabytes / result->seconds, result->declarations, result->had_error ? " (parse errors)" : "");
+}
+
+int main(int argc, char *argv[])
+{
+    setlocale(LC_ALL, "");
+
+    size_t size = BENCH_DEFAULT_SOURCE_CHARS;
+    unsigned long long seed = BENCH_DEFAULT_SEED;
+    int runs = BENCH_DEFAULT_RUNS;
+    size_t threads = 0; // Hardware concurrency
+    const char *trace_path = NULL;
+    const char *input_path = NULL;
+    const char *cache_dir = ".";
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--size=", 7) == 0)
+            size = (size_t)strtoull(argv[i] + 7, NULL, 10);
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+            seed = strtoull(argv[i] + 7, NULL, 10);
+        else if (strncmp(argv[i], "--runs=", 7) == 0)
+            runs = atoi(argv[i] + 7);
+        else if (strncmp(argv[i], "--threads=", 10) == 0)
+            threads = (size_t)strtoull(argv[i] + 10, NULL, 10);
+        else if (strncmp(argv[i], "--trace-file=", 13) == 0)
+            trace_path = argv[i] + 13;
+        else if (strncmp(argv[i], "--cache-dir=", 12) == 0)
+            cache_dir = argv[i] + 12;
+        else if (argv[i][0] == '-')
+        {
+            fprintf(stderr, "Usage: %s [--size=CHARS] [--seed=N] [--runs=N] [--threads=N] [--trace-file=PATH] [--cache-dir=DIR] [file]\n", argv[0]);
+            return 1;
+        }
+        else
+            input_path = argv[i];
+    }
+    if (runs < 1)
+        runs = 1;
+
+    wchar_t *source = NULL;
+    if (input_path)
+    {
+        size_t len_needed = mbstowcs(NULL, input_path, 0);
+        if (len_needed == (size_t)-1)
+        {
+            fprintf(stderr, "Error: Invalid multibyte sequence in filename.\n");
+            return 1;
+        }
+        wchar_t *w_filename = malloc((len_needed + 1) * sizeof(wchar_t));
+        if (!w_filename)
+            return 1;
+        mbstowcs(w_filename, input_path, len_needed + 1);
+        source = baa_file_content(w_filename);
+        free(w_filename);
+    }
+    else
+    {
+        source = baa_bench_generate_parser_source(size, seed);
+    }
+    if (!source)
+    {
+        fprintf(stderr, "Error: Could not load or generate the source.\n");
+        return 1;
+    }
+
+    size_t length = wcslen(source);
+    double megabytes = (double)baa_bench_utf8_size(source, length) / (1024.0 * 1024.0);
+    printf("Source: %zu characters, %d runs\n", length, runs);
+
+    // Tracing off: with BAA_ENABLE_TRACE compiled in this is the cost of the mask tests
+    BaaParseResult result;
+    baa_trace_enable(0);
+    double lex_seconds = bench_lex(source, runs);
+    printf("%-12s %10.3f ms %10.2f MB/s\n", "lex only", lex_seconds * 1000.0, megabytes / lex_seconds);
+
+    if (!bench_parse(source, runs, 1, false, &result))
+    {
+        fprintf(stderr, "Error: Parser creation failed.\n");
+        free(source);
+        return 1;
+    }
+    print_result("trace off", &result, megabytes);
+    size_t eager_bytes = result.ast_bytes;
+
+    // Declaration-only pass: function bodies are skipped by brace matching
+    if (!bench_parse(source, runs, 1, true, &result))
+    {
+        fprintf(stderr, "Error: Parser creation failed.\n");
+        free(source);
+        return 1;
+    }
+    print_result("lazy bodies", &result, megabytes);
+    printf("  (AST arena %.1f KiB eager, %.1f KiB lazy)\n", (double)eager_bytes / 1024.0,
+           (double)result.ast_bytes / 1024.0);
+
+    // Top-level declarations parsed on worker threads (falls back to sequential on errors)
+    if (!bench_parse(source, runs, threads, false, &result))
+    {
+        fprintf(stderr, "Error: Parser creation failed.\n");
+        free(source);
+        return 1;
+    }
+    print_result("parallel", &result, megabytes);
+
+    // Unchanged unit: the AST comes from the on-disk cache instead of the front end
+    double cache_seconds = 0.0;
+    size_t image_bytes = 0;
+    if (bench_cache(source, runs, cache_dir, &cache_seconds, &image_bytes))
+    {
+        printf("%-12s %10.3f ms %10.2f MB/s   (%.1f KiB image)\n", "cache hit", cache_seconds * 1000.0,
+               megabytes / cache_seconds, (double)image_bytes / 1024.0);
+    }
+    else
+    {
+        printf("cache hit    (could not write the AST cache in %s)\n", cache_dir);
+    }
+
+#ifdef BAA_ENABLE_TRACE
+    // Tracing on: every parser event goes through the buffered sink
+    FILE *sink = trace_path ? fopen(trace_path, "w") : tmpfile();
+    if (!sink)
+    {
+        fprintf(stderr, "Error: Could not open the trace sink.\n");
+        free(source);
+        return 1;
+    }
+    baa_trace_set_sink(sink);
+    baa_trace_enable(BAA_TRACE_PARSER);
+    bool traced = bench_parse(source, runs, 1, false, &result);
+    baa_trace_enable(0);
+    baa_trace_flush();
+    baa_trace_set_sink(NULL);
+    long trace_bytes = ftell(sink);
+    fclose(sink);
+    if (!traced)
+    {
+        free(source);
+        return 1;
+    }
+    print_result("trace on", &result, megabytes);
+    printf("  (%.1f KiB of trace per run)\n", (double)trace_bytes / 1024.0 / runs);
+#else
+    (void)trace_path;
+    printf("trace on     (compiled out; configure with -DBAA_ENABLE_TRACE=ON)\n");
+#endif
+
+    free(source);
+    return 0;
+}
@@ -0,0 +1,248 @@
+// tools/baa_bench_sema.c
+#include "baa/analysis/type_checker.h"
+#include "baa/ast/ast.h"
+#include "baa/ast/ast_arena.h"
+#include "baa/types/types.h"
+#include "baa/utils/threads.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <locale.h>
+#include <time.h>
+
+#define BENCH_DEFAULT_NODES 1000000u
+#define BENCH_DEFAULT_RUNS 5
+#define BENCH_STATEMENTS_PER_FUNCTION 8
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static BaaAstSourceSpan bench_span(size_t line)
+{
+    BaaAstSourceSpan span = {
+        .start = {.filename = L"bench.baa", .line = line, .column = 1},
+        .end = {.filename = L"bench.baa", .line = line, .column = 40}};
+    return span;
+}
+
+static BaaNode *int_type(size_t line)
+{
+    return baa_ast_new_primitive_type_node(bench_span(line), L"عدد_صحيح");
+}
+
+static BaaNode *identifier(size_t line, const wchar_t *name)
+{
+    return baa_ast_new_identifier_expr_node(bench_span(line), name);
+}
+
+static BaaNode *binary(size_t line, BaaNode *left, BaaNode *right, BaaBinaryOperatorKind op)
+{
+    return baa_ast_new_binary_expr_node(bench_span(line), left, right, op);
+}
+
+// عدد_صحيح دالة_N(عدد_صحيح أ, عدد_صحيح ب) { ... } : locals, arithmetic chains,
+// a branch and a call to the previous function
+static BaaNode *build_function(size_t index, size_t *line)
+{
+    static const BaaBinaryOperatorKind operators[] = {BAA_BINARY_OP_ADD, BAA_BINARY_OP_SUBTRACT,
+                                                      BAA_BINARY_OP_MULTIPLY, BAA_BINARY_OP_MODULO};
+    wchar_t name[32], local[32], previous_local[32];
+    size_t first_line = (*line)++;
+
+    swprintf(name, 32, L"دالة_%zu", index);
+    BaaNode *body = baa_ast_new_block_stmt_node(bench_span(first_line));
+    BaaNode *function = baa_ast_new_function_def_node(bench_span(first_line), name, BAA_MOD_NONE,
+                                                      int_type(first_line), body, false);
+    baa_ast_add_function_parameter(function, baa_ast_new_parameter_node(bench_span(first_line), L"أ",
+                                                                        int_type(first_line)));
+    baa_ast_add_function_parameter(function, baa_ast_new_parameter_node(bench_span(first_line), L"ب",
+                                                                        int_type(first_line)));
+
+    // عدد_صحيح م_k = م_(k-1) op أ * k + ب.
+    wcscpy(previous_local, L"أ");
+    for (size_t k = 0; k < BENCH_STATEMENTS_PER_FUNCTION; k++)
+    {
+        size_t at = (*line)++;
+        swprintf(local, 32, L"م_%zu", k);
+        BaaNode *scaled = binary(at, identifier(at, L"أ"),
+                                 baa_ast_new_literal_int_node(bench_span(at), (long long)k + 1, baa_get_int_type()),
+                                 BAA_BINARY_OP_MULTIPLY);
+        BaaNode *chain = binary(at, identifier(at, previous_local), scaled, operators[k % 4]);
+        chain = binary(at, chain, identifier(at, L"ب"), BAA_BINARY_OP_ADD);
+        baa_ast_add_stmt_to_block(body, baa_ast_new_var_decl_node(bench_span(at), local, BAA_MOD_NONE,
+                                                                  int_type(at), chain));
+        wcscpy(previous_local, local);
+    }
+
+    // إذا (م > أ) { إرجع دالة_(N-1)(م, ب). }
+    size_t at = (*line)++;
+    BaaNode *branch = baa_ast_new_block_stmt_node(bench_span(at));
+    if (index > 0)
+    {
+        swprintf(name, 32, L"دالة_%zu", index - 1);
+        BaaNode *call = baa_ast_new_call_expr_node(bench_span(at), identifier(at, name));
+        baa_ast_add_call_argument(call, identifier(at, previous_local));
+        baa_ast_add_call_argument(call, identifier(at, L"ب"));
+        baa_ast_add_stmt_to_block(branch, baa_ast_new_return_stmt_node(bench_span(at), call));
+    }
+    BaaNode *condition = binary(at, identifier(at, previous_local), identifier(at, L"أ"),
+                                BAA_BINARY_OP_GREATER_THAN);
+    baa_ast_add_stmt_to_block(body, baa_ast_new_if_stmt_node(bench_span(at), condition, branch, NULL));
+
+    at = (*line)++;
+    baa_ast_add_stmt_to_block(body, baa_ast_new_return_stmt_node(bench_span(at), identifier(at, previous_local)));
+    (*line)++;
+    return function;
+}
+
+static BaaAstVisitResult count_node(BaaNode *node, BaaNode *parent, size_t depth, void *user_data)
+{
+    (void)node;
+    (void)parent;
+    (void)depth;
+    (*(size_t *)user_data)++;
+    return BAA_AST_VISIT_CONTINUE;
+}
+
+// Builds a well-typed program of at least `target_nodes` nodes in its own arena
+static BaaNode *build_program(size_t target_nodes, size_t *out_nodes)
+{
+    BaaNode *program = baa_ast_new_program_node(bench_span(1));
+    BaaAstArena *arena = baa_ast_arena_create();
+    if (!program || !arena || !baa_ast_program_adopt_arena(program, arena))
+    {
+        baa_ast_arena_destroy(arena);
+        baa_ast_free_node(program);
+        return NULL;
+    }
+    BaaAstArena *previous = baa_ast_arena_activate(arena);
+
+    size_t line = 1, nodes = 1;
+    for (size_t index = 0; nodes < target_nodes; index++)
+    {
+        BaaNode *function = build_function(index, &line);
+        BaaAstVisitor counter = {.pre = count_node, .user_data = &nodes};
+        baa_ast_walk(function, &counter);
+        baa_ast_add_declaration_to_program(program, function);
+    }
+
+    baa_ast_arena_activate(previous);
+    *out_nodes = nodes;
+    return program;
+}
+
+typedef struct
+{
+    double build_seconds;    // Best-of-N time to build the tree
+    double check_seconds;    // Best-of-N time to check it
+    double teardown_seconds; // Best-of-N time to free the checker and the tree
+    size_t nodes;            // Nodes per tree
+    size_t functions;        // Top-level declarations
+    size_t visited;          // Nodes visited by the checker
+    size_t errors;           // Errors reported
+} BaaSemaBenchResult;
+
+// Every run checks a fresh tree: the checker annotates the nodes it visits
+static bool bench_check(size_t target_nodes, size_t threads, int runs, BaaSemaBenchResult *result)
+{
+    memset(result, 0, sizeof(*result));
+    result->build_seconds = -1.0;
+    result->check_seconds = -1.0;
+    result->teardown_seconds = -1.0;
+    for (int run = 0; run < runs; run++)
+    {
+        double start = now_seconds();
+        BaaNode *program = build_program(target_nodes, &result->nodes);
+        if (!program)
+            return false;
+        double built = now_seconds();
+
+        BaaTypeChecker *checker = baa_type_checker_create();
+        if (!checker)
+        {
+            baa_ast_free_node(program);
+            return false;
+        }
+        baa_type_checker_set_parallel(checker, threads);
+        baa_type_check_program(checker, program);
+        double checked = now_seconds();
+        result->visited = baa_type_checker_node_count(checker);
+        result->errors = baa_type_checker_error_count(checker);
+        result->functions = ((BaaProgramData *)program->data)->count;
+
+        baa_type_checker_free(checker);
+        baa_ast_free_node(program);
+        double freed = now_seconds();
+
+        if (result->build_seconds < 0.0 || built - start < result->build_seconds)
+            result->build_seconds = built - start;
+        if (result->check_seconds < 0.0 || checked - built < result->check_seconds)
+            result->check_seconds = checked - built;
+        if (result->teardown_seconds < 0.0 || freed - checked < result->teardown_seconds)
+            result->teardown_seconds = freed - checked;
+    }
+    return true;
+}
+
+static void print_check_result(const char *label, const BaaSemaBenchResult *result)
+{
+    printf("%-10s %9.3f ms %8.2f Mnodes/s  %zu nodes visited, %zu errors\n", label, result->check_seconds * 1000.0,
+           (double)result->nodes / result->check_seconds / 1e6, result->visited, result->errors);
+}
+
+int main(int argc, char *argv[])
+{
+    setlocale(LC_ALL, "");
+
+    size_t target_nodes = BENCH_DEFAULT_NODES;
+    size_t threads = 0;
+    int runs = BENCH_DEFAULT_RUNS;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strncmp(argv[i], "--nodes=", 8) == 0)
+            target_nodes = (size_t)strtoull(argv[i] + 8, NULL, 10);
+        else if (strncmp(argv[i], "--threads=", 10) == 0)
+            threads = (size_t)strtoull(argv[i] + 10, NULL, 10);
+        else if (strncmp(argv[i], "--runs=", 7) == 0)
+            runs = atoi(argv[i] + 7);
+        else
+        {
+            fprintf(stderr, "Usage: %s [--nodes=N] [--threads=N] [--runs=N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (runs < 1)
+        runs = 1;
+    if (threads == 0)
+        threads = baa_thread_hardware_concurrency();
+
+    BaaSemaBenchResult sequential, parallel;
+    if (!bench_check(target_nodes, 1, runs, &sequential) || !bench_check(target_nodes, threads, runs, &parallel))
+    {
+        fprintf(stderr, "Error: Could not build or check the program.\n");
+        return 1;
+    }
+
+    printf("Program: %zu nodes, %zu functions, %d runs\n", sequential.nodes, sequential.functions, runs);
+    printf("%-10s %9.3f ms %8.2f Mnodes/s\n", "build", sequential.build_seconds * 1000.0,
+           (double)sequential.nodes / sequential.build_seconds / 1e6);
+    char label[32];
+    print_check_result("check", &sequential);
+    snprintf(label, sizeof(label), "check x%zu", threads);
+    print_check_result(label, &parallel);
+    printf("%-10s %9.3f ms\n", "free", sequential.teardown_seconds * 1000.0);
+
+    if (sequential.visited != sequential.nodes || sequential.errors != 0 || parallel.visited != parallel.nodes ||
+        parallel.errors != 0)
+    {
+        fprintf(stderr, "Error: Expected every node visited once and no errors.\n");
+        return 2;
+    }
+    return 0;
+}
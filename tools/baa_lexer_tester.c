@@ -30,7 +30,7 @@ void print_wide_string_tester(FILE *stream, const wchar_t *wstr)
     }
 }
 
-void print_token_for_tester(const BaaToken *token, int count)
+void print_token_for_tester(BaaLexer *lexer, const BaaToken *token, int count)
 {
     if (!token)
     {
@@ -38,10 +38,13 @@ void print_token_for_tester(const BaaToken *token, int count)
         return;
     }
     const wchar_t *type_str = baa_token_type_to_string(token->type);
+    // Line/column are computed on demand from the token's start offset
+    size_t line = 0, column = 0;
+    baa_lexer_get_position(lexer, token->start_offset, &line, &column);
     // Simplified single-line output
     wprintf(L"[%03d] %-30ls (L%zu C%zu Len%zu) '",
             count, type_str ? type_str : L"UNKNOWN_TYPE_STR",
-            token->line, token->column, token->length);
+            line, column, token->length);
     print_wide_string_tester(stdout, token->lexeme);
     wprintf(L"' [Hex: ");
     if (token->lexeme) {
@@ -51,26 +54,28 @@ void print_token_for_tester(const BaaToken *token, int count)
     }
     wprintf(L"]\n");
 
-    // Print enhanced error information if available
-    if (token->error) {
+    // Print enhanced error information if available (built on demand from the token)
+    BaaErrorContext *error = baa_token_error_context(token, lexer->source);
+    if (error) {
         wprintf(L"      ERROR INFO:\n");
-        wprintf(L"        Code: %u\n", token->error->error_code);
-        wprintf(L"        Category: %hs\n", token->error->category ? token->error->category : "(null)");
-        if (token->error->suggestion) {
+        wprintf(L"        Code: %u\n", error->error_code);
+        wprintf(L"        Category: %hs\n", error->category ? error->category : "(null)");
+        if (error->suggestion) {
             wprintf(L"        Suggestion: ");
-            print_wide_string_tester(stdout, token->error->suggestion);
+            print_wide_string_tester(stdout, error->suggestion);
             wprintf(L"\n");
         }
-        if (token->error->context_before) {
+        if (error->context_before) {
             wprintf(L"        Context Before: ");
-            print_wide_string_tester(stdout, token->error->context_before);
+            print_wide_string_tester(stdout, error->context_before);
             wprintf(L"\n");
         }
-        if (token->error->context_after) {
+        if (error->context_after) {
             wprintf(L"        Context After: ");
-            print_wide_string_tester(stdout, token->error->context_after);
+            print_wide_string_tester(stdout, error->context_after);
             wprintf(L"\n");
         }
+        baa_free_error_context(error);
     }
 }
 
@@ -167,7 +172,7 @@ int main(int argc, char *argv_char[])
     do
     {
         token = baa_lexer_next_token(&lexer);
-        print_token_for_tester(token, token_count++);
+        print_token_for_tester(&lexer, token, token_count++);
 
         BaaTokenType current_type = BAA_TOKEN_UNKNOWN; // Default if token is NULL
         if (token)
@@ -187,6 +192,7 @@ int main(int argc, char *argv_char[])
     } while (true);
 
     wprintf(L"--- End Lexer Tokens ---\n");
+    baa_cleanup_lexer(&lexer);
 
     if (file_content_buffer)
     {
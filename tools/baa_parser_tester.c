@@ -51,7 +51,7 @@ void print_wide_string_parser_tester(FILE *stream, const wchar_t *wstr)
     }
 }
 
-void print_token_details(const char *label, const BaaToken *token)
+void print_token_details(const char *label, BaaLexer *lexer, const BaaToken *token)
 {
     if (!token)
     {
@@ -60,7 +60,9 @@ void print_token_details(const char *label, const BaaToken *token)
     }
     wprintf(L"%hs: Type=%ls (%d), Lexeme='", label, baa_token_type_to_string(token->type), token->type);
     print_wide_string_parser_tester(stdout, token->lexeme);
-    wprintf(L"', Line=%zu, Col=%zu, Len=%zu\n", token->line, token->column, token->length);
+    size_t line = 0, column = 0;
+    baa_lexer_get_position(lexer, token->start_offset, &line, &column);
+    wprintf(L"', Line=%zu, Col=%zu, Len=%zu\n", line, column, token->length);
 }
 
 int main(int argc, char *argv[])
@@ -206,6 +208,9 @@ int main(int argc, char *argv[])
            parser_inspect_direct->panic_mode);
     // --- End direct inspection ---
 
+    // Errors found by the initial advance are collected, not printed
+    baa_parser_print_diagnostics(parser, stderr);
+
     BaaParser_TestInspect *parser_inspect = (BaaParser_TestInspect *)parser;
 
     int token_count = 0;
@@ -213,8 +218,8 @@ int main(int argc, char *argv[])
     do
     {
         wprintf(L"\nIteration %d:\n", token_count);
-        print_token_details("  Parser->previous_token", &parser_inspect->previous_token);
-        print_token_details("  Parser->current_token ", &parser_inspect->current_token);
+        print_token_details("  Parser->previous_token", parser_inspect->lexer, &parser_inspect->previous_token);
+        print_token_details("  Parser->current_token ", parser_inspect->lexer, &parser_inspect->current_token);
 
         // --- Direct inspection inside the loop ---
         printf("  Direct check in loop: had_error=%d, panic_mode=%d\n",
@@ -309,6 +314,7 @@ int main(int argc, char *argv[])
     wprintf(L"\n[PHASE 5: CLEANUP]\n");
     baa_parser_free(parser);
     wprintf(L"Parser freed.\n");
+    baa_cleanup_lexer(&lexer);
     free(source_code);
     wprintf(L"Source code buffer freed.\n");
     baa_free((void *)w_input_filename); // Cast as it might be const from szArgList path originally